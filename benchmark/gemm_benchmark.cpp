@@ -0,0 +1,88 @@
+// Compares the GFLOP/s of gemm with the naive product of dynamic matrices
+// Usage: gemm_benchmark [max_size] [thread_count]
+// Sizes double from 64 to `max_size` (4096 by default), the naive product
+//  stops at 1024 where it already takes seconds
+
+// project headers
+#include "matrix/matrix_gemm.h"
+
+// standard headers
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <random>
+
+namespace {
+
+// Make a matrix of random values in [-1, 1]
+template<class T>
+ft::math::dynamic_matrix<T> make_random_matrix(const std::size_t p_size, const unsigned p_seed)
+{
+    std::mt19937 generator(p_seed);
+    std::uniform_real_distribution<T> distribution(-1, 1);
+
+    ft::math::dynamic_matrix<T> result(p_size, p_size);
+    std::generate(result.data(), result.data() + result.elements(), [&]() { return distribution(generator); });
+    return result;
+}
+
+
+// Get the best time of `p_func` over runs totalling about half a second
+template<class F>
+double best_seconds(F && p_func)
+{
+    auto best = 1e30;
+    auto total = 0.0;
+    for (int run = 0; run < 3 || (total < 0.5 && run < 100); ++run)
+    {
+        const auto start = std::chrono::steady_clock::now();
+        p_func();
+        const auto seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+        best = std::min(best, seconds);
+        total += seconds;
+    }
+    return best;
+}
+
+
+// Print the GFLOP/s of both products for square matrices up to `p_max_size`
+template<class T>
+void run(const char * p_name, const std::size_t p_max_size, ft::math::thread_pool & p_pool)
+{
+    std::printf("%s\n%8s %12s %12s\n", p_name, "size", "gemm", "naive");
+    for (std::size_t size = 64; size <= p_max_size; size *= 2)
+    {
+        const auto a = make_random_matrix<T>(size, 1);
+        const auto b = make_random_matrix<T>(size, 2);
+        ft::math::dynamic_matrix<T> c(size, size);
+        const auto flops = 2.0 * size * size * size * 1e-9;
+
+        const auto gemm_seconds = best_seconds([&]() {
+            ft::math::gemm<T>(1, a, ft::math::matrix_operation::none, b, ft::math::matrix_operation::none, 0, c, p_pool);
+        });
+        std::printf("%8zu %12.2f", size, flops / gemm_seconds);
+
+        if (size <= 1024)
+        {
+            const auto naive_seconds = best_seconds([&]() { c = a * b; });
+            std::printf(" %12.2f", flops / naive_seconds);
+        }
+        std::printf("\n");
+    }
+}
+
+}   // namespace
+
+
+int main(int p_argc, char ** p_argv)
+{
+    const auto max_size = (p_argc > 1) ? std::strtoull(p_argv[1], nullptr, 10) : 4096;
+    const auto thread_count = (p_argc > 2) ? std::strtoull(p_argv[2], nullptr, 10) : 0;
+
+    ft::math::thread_pool pool(thread_count);
+    std::printf("%zu threads, GFLOP/s\n", pool.thread_count());
+    run<float>("float", max_size, pool);
+    run<double>("double", max_size, pool);
+    return 0;
+}
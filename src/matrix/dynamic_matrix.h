@@ -0,0 +1,121 @@
+#pragma once
+
+// Represents a row major matrix whose dimensions are only known at runtime
+// Implemented as a flat heap allocated array
+// Prefer `matrix<T, R, C>` when the dimensions are known at compile time
+
+// project headers
+#include "matrix.h"
+
+// standard headers
+#include <cstddef>  // std::size_t
+#include <initializer_list>
+#include <vector>
+
+namespace ft {
+namespace math {
+
+template<class T>
+class dynamic_matrix
+{
+public:
+    using value_type = T;
+
+public:
+    // Default constructor
+    // Makes an empty 0 by 0 matrix
+    dynamic_matrix() = default;
+
+    // Construct a matrix of `p_rows` by `p_cols` elements
+    // Values are zero initialized
+    dynamic_matrix(const std::size_t p_rows, const std::size_t p_cols);
+
+    // Construct a matrix of `p_rows` by `p_cols` elements from an initializer list
+    // The list contains the values row by row
+    dynamic_matrix(const std::size_t p_rows, const std::size_t p_cols, const std::initializer_list<T> & p_list);
+
+    // Construct from a fixed size matrix
+    template<std::size_t R, std::size_t C>
+    dynamic_matrix(const matrix<T, R, C> & p_matrix);
+
+
+    // Convert to a fixed size matrix
+    // The dimensions must match
+    template<std::size_t R, std::size_t C>
+    matrix<T, R, C> to_matrix() const;
+
+
+    // Get the number of rows
+    std::size_t rows() const;
+
+    // Get the number of columns
+    std::size_t cols() const;
+
+    // Get the total number of elements
+    std::size_t elements() const;
+
+
+    // Change the dimensions of the matrix
+    // Existing values are not preserved, all values are zero initialized
+    void resize(const std::size_t p_rows, const std::size_t p_cols);
+
+    // Assign values to all elements
+    void fill(const value_type & p_value);
+
+
+    // Access a matrix's row (mutable)
+    // Returns a pointer to the first element of the row
+    value_type * operator[](const std::size_t p_row);
+
+    // Access a matrix's row (const)
+    // Returns a pointer to the first element of the row
+    const value_type * operator[](const std::size_t p_row) const;
+
+
+    // Compare this matrix with another with the same dimensions
+    // Returns true if the difference between each element
+    // is within a rounding error
+    bool compare_epsilon(const dynamic_matrix & p_ref, const T p_error) const;
+
+    // Compare this matrix with another
+    // Matrices of different dimensions are never equal
+    bool operator==(const dynamic_matrix & p_ref) const;
+
+    // Compare this matrix with another
+    bool operator!=(const dynamic_matrix & p_ref) const;
+
+
+    // Add a matrix to this matrix
+    dynamic_matrix & operator+=(const dynamic_matrix & p_ref);
+
+    // Substract a matrix from this matrix
+    dynamic_matrix & operator-=(const dynamic_matrix & p_ref);
+
+    // Multiply this matrix by a scalar
+    dynamic_matrix & operator*=(const value_type & p_scalar);
+
+    // Divide this matrix by a scalar
+    dynamic_matrix & operator/=(const value_type & p_scalar);
+
+
+    // Get direct access to the underlying data
+    value_type * data();
+
+    // Get direct access to the underlying data
+    const value_type * data() const;
+
+private:
+    // Dimensions
+    std::size_t m_rows = 0;
+    std::size_t m_cols = 0;
+
+    // Stored as an array of rows
+    std::vector<T> m_data;
+
+};  // class dynamic_matrix
+
+};	// namespace math
+};	// namespace ft
+
+#include "dynamic_matrix.hpp"
+#include "dynamic_matrix_operators.h"
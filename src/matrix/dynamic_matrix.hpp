@@ -0,0 +1,229 @@
+#pragma once
+
+// Implementation for the dynamic_matrix class
+
+// project headers
+#include "dynamic_matrix.h"
+
+// other headers
+#include "error/ft_assert.h"
+
+// standard headers
+#include <algorithm>
+
+namespace ft {
+namespace math {
+
+// Construct a matrix of `p_rows` by `p_cols` elements
+// Values are zero initialized
+template<class T>
+dynamic_matrix<T>::dynamic_matrix(const std::size_t p_rows, const std::size_t p_cols) :
+    m_rows(p_rows),
+    m_cols(p_cols),
+    m_data(p_rows * p_cols, T{})
+{ }
+
+
+// Construct a matrix of `p_rows` by `p_cols` elements from an initializer list
+// The list contains the values row by row
+template<class T>
+dynamic_matrix<T>::dynamic_matrix(
+    const std::size_t p_rows,
+    const std::size_t p_cols,
+    const std::initializer_list<T> & p_list) :
+    m_rows(p_rows),
+    m_cols(p_cols),
+    m_data(p_list)
+{
+    FT_ASSERT(p_list.size() == p_rows * p_cols);
+}
+
+
+// Construct from a fixed size matrix
+template<class T>
+template<std::size_t R, std::size_t C>
+dynamic_matrix<T>::dynamic_matrix(const matrix<T, R, C> & p_matrix) :
+    m_rows(R),
+    m_cols(C),
+    m_data(p_matrix.data(), p_matrix.data() + R * C)
+{ }
+
+
+// Convert to a fixed size matrix
+// The dimensions must match
+template<class T>
+template<std::size_t R, std::size_t C>
+matrix<T, R, C> dynamic_matrix<T>::to_matrix() const
+{
+    FT_ASSERT(m_rows == R);
+    FT_ASSERT(m_cols == C);
+    return matrix<T, R, C>(m_data.data());
+}
+
+
+// Get the number of rows
+template<class T>
+std::size_t dynamic_matrix<T>::rows() const
+{
+    return m_rows;
+}
+
+
+// Get the number of columns
+template<class T>
+std::size_t dynamic_matrix<T>::cols() const
+{
+    return m_cols;
+}
+
+
+// Get the total number of elements
+template<class T>
+std::size_t dynamic_matrix<T>::elements() const
+{
+    return m_data.size();
+}
+
+
+// Change the dimensions of the matrix
+// Existing values are not preserved, all values are zero initialized
+template<class T>
+void dynamic_matrix<T>::resize(const std::size_t p_rows, const std::size_t p_cols)
+{
+    m_rows = p_rows;
+    m_cols = p_cols;
+    m_data.assign(p_rows * p_cols, T{});
+}
+
+
+// Assign values to all elements
+template<class T>
+void dynamic_matrix<T>::fill(const value_type & p_value)
+{
+    std::fill(m_data.begin(), m_data.end(), p_value);
+}
+
+
+// Access a matrix's row (mutable)
+template<class T>
+typename dynamic_matrix<T>::value_type * dynamic_matrix<T>::operator[](const std::size_t p_row)
+{
+    FT_ASSERT(p_row < m_rows);
+    return m_data.data() + p_row * m_cols;
+}
+
+
+// Access a matrix's row (const)
+template<class T>
+const typename dynamic_matrix<T>::value_type * dynamic_matrix<T>::operator[](const std::size_t p_row) const
+{
+    FT_ASSERT(p_row < m_rows);
+    return m_data.data() + p_row * m_cols;
+}
+
+
+// Compare this matrix with another with the same dimensions
+// Returns true if the difference between each element
+// is within a rounding error
+template<class T>
+bool dynamic_matrix<T>::compare_epsilon(const dynamic_matrix & p_ref, const T p_error) const
+{
+    FT_ASSERT(m_rows == p_ref.m_rows);
+    FT_ASSERT(m_cols == p_ref.m_cols);
+
+    const auto minus_error = -p_error;
+    for (std::size_t i = 0; i < m_data.size(); ++i)
+    {
+        const auto delta = m_data[i] - p_ref.m_data[i];
+        if (delta > p_error || delta < minus_error) {
+            return false;
+        }
+    }
+
+    // No difference found
+    return true;
+}
+
+
+// Compare this matrix with another
+// Matrices of different dimensions are never equal
+template<class T>
+bool dynamic_matrix<T>::operator==(const dynamic_matrix & p_ref) const
+{
+    return m_rows == p_ref.m_rows && m_cols == p_ref.m_cols && m_data == p_ref.m_data;
+}
+
+
+// Compare this matrix with another
+template<class T>
+bool dynamic_matrix<T>::operator!=(const dynamic_matrix & p_ref) const
+{
+    return operator==(p_ref) == false;
+}
+
+
+// Add a matrix to this matrix
+template<class T>
+dynamic_matrix<T> & dynamic_matrix<T>::operator+=(const dynamic_matrix & p_ref)
+{
+    FT_ASSERT(m_rows == p_ref.m_rows);
+    FT_ASSERT(m_cols == p_ref.m_cols);
+    for (std::size_t i = 0; i < m_data.size(); ++i) {
+        m_data[i] += p_ref.m_data[i];
+    }
+    return *this;
+}
+
+
+// Substract a matrix from this matrix
+template<class T>
+dynamic_matrix<T> & dynamic_matrix<T>::operator-=(const dynamic_matrix & p_ref)
+{
+    FT_ASSERT(m_rows == p_ref.m_rows);
+    FT_ASSERT(m_cols == p_ref.m_cols);
+    for (std::size_t i = 0; i < m_data.size(); ++i) {
+        m_data[i] -= p_ref.m_data[i];
+    }
+    return *this;
+}
+
+
+// Multiply this matrix by a scalar
+template<class T>
+dynamic_matrix<T> & dynamic_matrix<T>::operator*=(const value_type & p_scalar)
+{
+    for (auto & cell : m_data) {
+        cell *= p_scalar;
+    }
+    return *this;
+}
+
+
+// Divide this matrix by a scalar
+template<class T>
+dynamic_matrix<T> & dynamic_matrix<T>::operator/=(const value_type & p_scalar)
+{
+    for (auto & cell : m_data) {
+        cell /= p_scalar;
+    }
+    return *this;
+}
+
+
+// Get direct access to the underlying data
+template<class T>
+typename dynamic_matrix<T>::value_type * dynamic_matrix<T>::data()
+{
+    return m_data.data();
+}
+
+
+// Get direct access to the underlying data
+template<class T>
+const typename dynamic_matrix<T>::value_type * dynamic_matrix<T>::data() const
+{
+    return m_data.data();
+}
+
+};	// namespace math
+};	// namespace ft
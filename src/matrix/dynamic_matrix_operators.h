@@ -0,0 +1,48 @@
+#pragma once
+
+// Implements free operators for dynamic matrices
+// Included by dynamic_matrix.h
+
+#include "dynamic_matrix.h"
+
+namespace ft {
+namespace math {
+
+
+// Add two matrices of the same dimensions together
+// Gets the sum of matching cells
+template<class T>
+dynamic_matrix<T> operator+(dynamic_matrix<T> p_left, const dynamic_matrix<T> & p_right);
+
+
+// Substract a matrix from another with the same dimensions
+// Gets the difference between matching cells
+template<class T>
+dynamic_matrix<T> operator-(dynamic_matrix<T> p_left, const dynamic_matrix<T> & p_right);
+
+
+// Multiply a matrix by a scalar
+template<class T>
+dynamic_matrix<T> operator*(dynamic_matrix<T> p_left, const T p_scalar);
+
+
+// Multiply a matrix by a scalar
+template<class T>
+dynamic_matrix<T> operator*(const T p_scalar, dynamic_matrix<T> p_right);
+
+
+// Divide a matrix by a scalar
+template<class T>
+dynamic_matrix<T> operator/(dynamic_matrix<T> p_left, const T p_scalar);
+
+
+// matrix product operation
+// Multiplies an [R, I] sized matrix by a [I, C] matrix
+// Single threaded and unblocked, use gemm (matrix_gemm.h) for large matrices
+template<class T>
+dynamic_matrix<T> operator*(const dynamic_matrix<T> & p_left, const dynamic_matrix<T> & p_right);
+
+};  // namespace math
+};  // namespace ft
+
+#include "dynamic_matrix_operators.hpp"
@@ -0,0 +1,85 @@
+#pragma once
+
+// Implements free operators for dynamic matrices
+// Included by dynamic_matrix.h
+
+#include "dynamic_matrix_operators.h"
+
+
+// Add two matrices of the same dimensions together
+// Gets the sum of matching cells
+template<class T>
+ft::math::dynamic_matrix<T> ft::math::operator+(dynamic_matrix<T> p_left, const dynamic_matrix<T> & p_right)
+{
+    p_left += p_right;
+    return p_left;
+}
+
+
+// Substract a matrix from another with the same dimensions
+// Gets the difference between matching cells
+template<class T>
+ft::math::dynamic_matrix<T> ft::math::operator-(dynamic_matrix<T> p_left, const dynamic_matrix<T> & p_right)
+{
+    p_left -= p_right;
+    return p_left;
+}
+
+
+// Multiply a matrix by a scalar
+template<class T>
+ft::math::dynamic_matrix<T> ft::math::operator*(dynamic_matrix<T> p_left, const T p_scalar)
+{
+    p_left *= p_scalar;
+    return p_left;
+}
+
+
+// Multiply a matrix by a scalar
+template<class T>
+ft::math::dynamic_matrix<T> ft::math::operator*(const T p_scalar, dynamic_matrix<T> p_right)
+{
+    p_right *= p_scalar;
+    return p_right;
+}
+
+
+// Divide a matrix by a scalar
+template<class T>
+ft::math::dynamic_matrix<T> ft::math::operator/(dynamic_matrix<T> p_left, const T p_scalar)
+{
+    p_left /= p_scalar;
+    return p_left;
+}
+
+
+// matrix product operation
+// Multiplies an [R, I] sized matrix by a [I, C] matrix
+template<class T>
+ft::math::dynamic_matrix<T> ft::math::operator*(const dynamic_matrix<T> & p_left, const dynamic_matrix<T> & p_right)
+{
+    FT_ASSERT(p_left.cols() == p_right.rows());
+
+    const auto rows = p_left.rows();
+    const auto cols = p_right.cols();
+    const auto inner = p_left.cols();
+
+    // Zero initialized
+    ft::math::dynamic_matrix<T> result(rows, cols);
+
+    for (std::size_t y = 0; y < rows; ++y) {
+        // The row to modify
+        auto row = result[y];
+
+        // Accumulate whole rows of the right matrix to keep accesses contiguous
+        for (std::size_t k = 0; k < inner; ++k) {
+            const auto factor = p_left[y][k];
+            const auto right_row = p_right[k];
+            for (std::size_t x = 0; x < cols; ++x) {
+                row[x] += factor * right_row[x];
+            }
+        }
+    }
+
+    return result;
+}
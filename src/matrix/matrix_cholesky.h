@@ -0,0 +1,249 @@
+#pragma once
+
+// Cholesky (L * Lt) and square root free LDLt factorizations of symmetric matrices
+// A factorization is computed once and can then solve any number of
+//  right hand sides, which is faster and more accurate than multiplying
+//  by the result of `make_inverse_matrix`
+// Only the lower triangle of the factored matrix is read
+// Fixed sizes up to `max_unrolled_size` are fully unrolled
+
+// project headers
+#include "dynamic_matrix.h"
+#include "matrix.h"
+#include "vector/vector.h"
+
+// standard headers
+#include <cstddef>  // std::size_t
+#include <span>
+#include <vector>
+
+namespace ft {
+namespace math {
+
+// Cholesky factorization of a fixed size symmetric positive definite matrix
+template<class T, std::size_t S>
+class cholesky_factorization
+{
+public:
+    // Factor a symmetric positive definite matrix
+    explicit cholesky_factorization(const matrix<T, S, S> & p_matrix);
+
+
+    // Returns false if the matrix was not positive definite
+    // A failed factorization can't be used to solve
+    bool is_valid() const;
+
+
+    // Solve A * x = b in-place
+    // `p_rhs` holds b and is replaced by x
+    void solve(vector<T, S> & p_rhs) const;
+
+    // Solve A * X = B in-place for multiple right hand sides
+    // Each column of `p_rhs` is a right hand side
+    template<std::size_t N>
+    void solve(matrix<T, S, N> & p_rhs) const;
+
+
+    // Get the determinant of the factored matrix
+    T determinant() const;
+
+    // Get the natural logarithm of the determinant of the factored matrix
+    // Does not overflow for large matrices
+    T log_determinant() const;
+
+
+    // Get the lower triangular factor L
+    const matrix<T, S, S> & get_lower() const;
+
+private:
+    // Lower triangular factor, upper triangle is zero
+    matrix<T, S, S> m_lower;
+
+    // Inverse of the diagonal of L, avoids divisions when solving
+    vector<T, S> m_inverse_diagonal;
+
+    // False if the matrix was not positive definite
+    bool m_valid;
+
+};  // class cholesky_factorization
+
+
+// LDLt factorization of a fixed size symmetric matrix
+// Does not require the matrix to be positive definite, only that
+//  no pivot is zero
+template<class T, std::size_t S>
+class ldlt_factorization
+{
+public:
+    // Factor a symmetric matrix
+    explicit ldlt_factorization(const matrix<T, S, S> & p_matrix);
+
+
+    // Returns false if a zero pivot was encountered
+    // A failed factorization can't be used to solve
+    bool is_valid() const;
+
+
+    // Solve A * x = b in-place
+    // `p_rhs` holds b and is replaced by x
+    void solve(vector<T, S> & p_rhs) const;
+
+    // Solve A * X = B in-place for multiple right hand sides
+    // Each column of `p_rhs` is a right hand side
+    template<std::size_t N>
+    void solve(matrix<T, S, N> & p_rhs) const;
+
+
+    // Get the determinant of the factored matrix
+    T determinant() const;
+
+    // Get the natural logarithm of the absolute value of the determinant
+    // Does not overflow for large matrices
+    T log_determinant() const;
+
+
+    // Get the unit lower triangular factor L
+    matrix<T, S, S> get_lower() const;
+
+    // Get the diagonal factor D
+    vector<T, S> get_diagonal() const;
+
+private:
+    // L strictly below the diagonal, D on the diagonal
+    matrix<T, S, S> m_factors;
+
+    // Inverse of D, avoids divisions when solving
+    vector<T, S> m_inverse_diagonal;
+
+    // False if a zero pivot was encountered
+    bool m_valid;
+
+};  // class ldlt_factorization
+
+
+// Cholesky factorization of a runtime sized symmetric positive definite matrix
+template<class T>
+class dynamic_cholesky_factorization
+{
+public:
+    // Factor a symmetric positive definite matrix
+    explicit dynamic_cholesky_factorization(dynamic_matrix<T> p_matrix);
+
+
+    // Returns false if the matrix was not positive definite
+    // A failed factorization can't be used to solve
+    bool is_valid() const;
+
+    // Get the number of rows (and columns) of the factored matrix
+    std::size_t size() const;
+
+
+    // Solve A * x = b in-place
+    // `p_rhs` holds b and is replaced by x
+    void solve(std::span<T> p_rhs) const;
+
+    // Solve A * X = B in-place for multiple right hand sides
+    // Each column of `p_rhs` is a right hand side
+    void solve(dynamic_matrix<T> & p_rhs) const;
+
+
+    // Get the determinant of the factored matrix
+    T determinant() const;
+
+    // Get the natural logarithm of the determinant of the factored matrix
+    // Does not overflow for large matrices
+    T log_determinant() const;
+
+
+    // Get the lower triangular factor L
+    const dynamic_matrix<T> & get_lower() const;
+
+private:
+    // Lower triangular factor, upper triangle is zero
+    dynamic_matrix<T> m_lower;
+
+    // Inverse of the diagonal of L, avoids divisions when solving
+    std::vector<T> m_inverse_diagonal;
+
+    // False if the matrix was not positive definite
+    bool m_valid;
+
+};  // class dynamic_cholesky_factorization
+
+
+// LDLt factorization of a runtime sized symmetric matrix
+// Does not require the matrix to be positive definite, only that
+//  no pivot is zero
+template<class T>
+class dynamic_ldlt_factorization
+{
+public:
+    // Factor a symmetric matrix
+    explicit dynamic_ldlt_factorization(dynamic_matrix<T> p_matrix);
+
+
+    // Returns false if a zero pivot was encountered
+    // A failed factorization can't be used to solve
+    bool is_valid() const;
+
+    // Get the number of rows (and columns) of the factored matrix
+    std::size_t size() const;
+
+
+    // Solve A * x = b in-place
+    // `p_rhs` holds b and is replaced by x
+    void solve(std::span<T> p_rhs) const;
+
+    // Solve A * X = B in-place for multiple right hand sides
+    // Each column of `p_rhs` is a right hand side
+    void solve(dynamic_matrix<T> & p_rhs) const;
+
+
+    // Get the determinant of the factored matrix
+    T determinant() const;
+
+    // Get the natural logarithm of the absolute value of the determinant
+    // Does not overflow for large matrices
+    T log_determinant() const;
+
+
+    // Get the unit lower triangular factor L
+    dynamic_matrix<T> get_lower() const;
+
+    // Get the diagonal factor D
+    std::vector<T> get_diagonal() const;
+
+private:
+    // L strictly below the diagonal, D on the diagonal
+    dynamic_matrix<T> m_factors;
+
+    // Inverse of D, avoids divisions when solving
+    std::vector<T> m_inverse_diagonal;
+
+    // False if a zero pivot was encountered
+    bool m_valid;
+
+};  // class dynamic_ldlt_factorization
+
+
+// Compute the Cholesky factorization of a symmetric positive definite matrix
+template<class T, std::size_t S>
+cholesky_factorization<T, S> cholesky_decompose(const matrix<T, S, S> & p_matrix);
+
+// Compute the Cholesky factorization of a symmetric positive definite matrix
+template<class T>
+dynamic_cholesky_factorization<T> cholesky_decompose(const dynamic_matrix<T> & p_matrix);
+
+
+// Compute the LDLt factorization of a symmetric matrix
+template<class T, std::size_t S>
+ldlt_factorization<T, S> ldlt_decompose(const matrix<T, S, S> & p_matrix);
+
+// Compute the LDLt factorization of a symmetric matrix
+template<class T>
+dynamic_ldlt_factorization<T> ldlt_decompose(const dynamic_matrix<T> & p_matrix);
+
+};  // namespace math
+};  // namespace ft
+
+#include "matrix_cholesky.hpp"
@@ -0,0 +1,612 @@
+#pragma once
+
+// Implements the factorizations of matrix_cholesky.h
+
+// project headers
+#include "matrix_cholesky.h"
+#include "matrix_unroll.h"
+
+// other headers
+#include "error/ft_assert.h"
+
+// standard headers
+#include <cmath>
+
+namespace ft {
+namespace math {
+namespace details {
+namespace matrix_cholesky_ns {
+
+// Clear the strict upper triangle of a row major square matrix
+template<class T, class N>
+void clear_upper(T * p_data, const N p_size)
+{
+    for_range(zero_index, p_size, [&](auto y) {
+        for_range(next_index(y), p_size, [&](auto x) {
+            p_data[y * p_size + x] = 0;
+        });
+    });
+}
+
+
+// Factor a row major matrix in-place into L * Lt
+// Only the lower triangle is read, L is written to the lower triangle
+// Returns false if the matrix is not positive definite
+template<class T, class N>
+bool factor_cholesky(T * p_data, T * p_inverse_diagonal, const N p_size)
+{
+    bool valid = true;
+
+    for_range(zero_index, p_size, [&](auto j)
+    {
+        const auto row_j = p_data + j * p_size;
+
+        // Diagonal element
+        auto diagonal = row_j[j];
+        for_range(zero_index, j, [&](auto k) {
+            diagonal -= row_j[k] * row_j[k];
+        });
+
+        // Keep going on failure, it keeps the unrolled code branchless
+        valid = valid && (diagonal > 0);
+
+        const auto l_jj = static_cast<T>(std::sqrt(diagonal));
+        const auto inverse = static_cast<T>(1) / l_jj;
+        row_j[j] = l_jj;
+        p_inverse_diagonal[j] = inverse;
+
+        // Elements below the diagonal
+        for_range(next_index(j), p_size, [&](auto i)
+        {
+            const auto row_i = p_data + i * p_size;
+            auto sum = row_i[j];
+            for_range(zero_index, j, [&](auto k) {
+                sum -= row_i[k] * row_j[k];
+            });
+            row_i[j] = sum * inverse;
+        });
+    });
+
+    return valid;
+}
+
+
+// Factor a row major matrix in-place into L * D * Lt
+// Only the lower triangle is read, L is written below the diagonal
+//  and D on the diagonal
+// Returns false if a zero pivot is encountered
+template<class T, class N>
+bool factor_ldlt(T * p_data, T * p_inverse_diagonal, const N p_size)
+{
+    bool valid = true;
+
+    for_range(zero_index, p_size, [&](auto j)
+    {
+        const auto row_j = p_data + j * p_size;
+
+        // Diagonal element
+        auto diagonal = row_j[j];
+        for_range(zero_index, j, [&](auto k) {
+            diagonal -= row_j[k] * row_j[k] * p_data[k * p_size + k];
+        });
+
+        // Keep going on failure, it keeps the unrolled code branchless
+        valid = valid && (diagonal != 0);
+
+        const auto inverse = static_cast<T>(1) / diagonal;
+        row_j[j] = diagonal;
+        p_inverse_diagonal[j] = inverse;
+
+        // Elements below the diagonal
+        for_range(next_index(j), p_size, [&](auto i)
+        {
+            const auto row_i = p_data + i * p_size;
+            auto sum = row_i[j];
+            for_range(zero_index, j, [&](auto k) {
+                sum -= row_i[k] * row_j[k] * p_data[k * p_size + k];
+            });
+            row_i[j] = sum * inverse;
+        });
+    });
+
+    return valid;
+}
+
+
+// Solve L * Lt * X = B in-place
+// `p_rhs` is a row major matrix of `p_size` rows by `p_count` columns
+template<class T, class N, class M>
+void solve_cholesky(
+    const T * p_lower,
+    const T * p_inverse_diagonal,
+    const N p_size,
+    T * p_rhs,
+    const M p_count)
+{
+    // Forward substitution, L * Y = B
+    for_range(zero_index, p_size, [&](auto i)
+    {
+        const auto row_l = p_lower + i * p_size;
+        const auto row_x = p_rhs + i * p_count;
+        for_range(zero_index, i, [&](auto k)
+        {
+            const auto factor = row_l[k];
+            const auto row_k = p_rhs + k * p_count;
+            for_range(zero_index, p_count, [&](auto c) {
+                row_x[c] -= factor * row_k[c];
+            });
+        });
+        for_range(zero_index, p_count, [&](auto c) {
+            row_x[c] *= p_inverse_diagonal[i];
+        });
+    });
+
+    // Back substitution, Lt * X = Y
+    for_range_reverse(zero_index, p_size, [&](auto i)
+    {
+        const auto row_x = p_rhs + i * p_count;
+        for_range(next_index(i), p_size, [&](auto k)
+        {
+            const auto factor = p_lower[k * p_size + i];
+            const auto row_k = p_rhs + k * p_count;
+            for_range(zero_index, p_count, [&](auto c) {
+                row_x[c] -= factor * row_k[c];
+            });
+        });
+        for_range(zero_index, p_count, [&](auto c) {
+            row_x[c] *= p_inverse_diagonal[i];
+        });
+    });
+}
+
+
+// Solve L * D * Lt * X = B in-place
+// `p_rhs` is a row major matrix of `p_size` rows by `p_count` columns
+template<class T, class N, class M>
+void solve_ldlt(
+    const T * p_factors,
+    const T * p_inverse_diagonal,
+    const N p_size,
+    T * p_rhs,
+    const M p_count)
+{
+    // Forward substitution, L * Z = B
+    for_range(zero_index, p_size, [&](auto i)
+    {
+        const auto row_l = p_factors + i * p_size;
+        const auto row_x = p_rhs + i * p_count;
+        for_range(zero_index, i, [&](auto k)
+        {
+            const auto factor = row_l[k];
+            const auto row_k = p_rhs + k * p_count;
+            for_range(zero_index, p_count, [&](auto c) {
+                row_x[c] -= factor * row_k[c];
+            });
+        });
+    });
+
+    // Diagonal, D * Y = Z
+    for_range(zero_index, p_size, [&](auto i)
+    {
+        const auto row_x = p_rhs + i * p_count;
+        for_range(zero_index, p_count, [&](auto c) {
+            row_x[c] *= p_inverse_diagonal[i];
+        });
+    });
+
+    // Back substitution, Lt * X = Y
+    for_range_reverse(zero_index, p_size, [&](auto i)
+    {
+        const auto row_x = p_rhs + i * p_count;
+        for_range(next_index(i), p_size, [&](auto k)
+        {
+            const auto factor = p_factors[k * p_size + i];
+            const auto row_k = p_rhs + k * p_count;
+            for_range(zero_index, p_count, [&](auto c) {
+                row_x[c] -= factor * row_k[c];
+            });
+        });
+    });
+}
+
+
+// Product of the diagonal of a row major square matrix
+template<class T, class N>
+T diagonal_product(const T * p_data, const N p_size)
+{
+    auto result = static_cast<T>(1);
+    for_range(zero_index, p_size, [&](auto i) {
+        result *= p_data[i * p_size + i];
+    });
+    return result;
+}
+
+
+// Sum of the log of the absolute value of the diagonal of a row major square matrix
+template<class T, class N>
+T diagonal_log_sum(const T * p_data, const N p_size)
+{
+    auto result = static_cast<T>(0);
+    for_range(zero_index, p_size, [&](auto i) {
+        result += static_cast<T>(std::log(std::abs(p_data[i * p_size + i])));
+    });
+    return result;
+}
+
+
+// Copy the strict lower triangle of a row major square matrix and set a unit diagonal
+template<class T, class N>
+void copy_unit_lower(const T * p_from, T * p_to, const N p_size)
+{
+    for_range(zero_index, p_size, [&](auto y) {
+        for_range(zero_index, y, [&](auto x) {
+            p_to[y * p_size + x] = p_from[y * p_size + x];
+        });
+        p_to[y * p_size + y] = 1;
+        for_range(next_index(y), p_size, [&](auto x) {
+            p_to[y * p_size + x] = 0;
+        });
+    });
+}
+
+};  // namespace matrix_cholesky_ns
+};  // namespace details
+
+
+//////////////////////////////////////////////
+// cholesky_factorization
+
+// Factor a symmetric positive definite matrix
+template<class T, std::size_t S>
+cholesky_factorization<T, S>::cholesky_factorization(const matrix<T, S, S> & p_matrix) :
+    m_lower(p_matrix)
+{
+    constexpr auto size = make_unrolled_size<S>();
+    m_valid = details::matrix_cholesky_ns::factor_cholesky(m_lower.data(), m_inverse_diagonal.data(), size);
+    details::matrix_cholesky_ns::clear_upper(m_lower.data(), size);
+}
+
+
+// Returns false if the matrix was not positive definite
+template<class T, std::size_t S>
+bool cholesky_factorization<T, S>::is_valid() const
+{
+    return m_valid;
+}
+
+
+// Solve A * x = b in-place
+template<class T, std::size_t S>
+void cholesky_factorization<T, S>::solve(vector<T, S> & p_rhs) const
+{
+    FT_ASSERT(m_valid);
+    details::matrix_cholesky_ns::solve_cholesky(
+        m_lower.data(), m_inverse_diagonal.data(), make_unrolled_size<S>(),
+        p_rhs.data(), make_unrolled_size<1>());
+}
+
+
+// Solve A * X = B in-place for multiple right hand sides
+template<class T, std::size_t S>
+template<std::size_t N>
+void cholesky_factorization<T, S>::solve(matrix<T, S, N> & p_rhs) const
+{
+    FT_ASSERT(m_valid);
+    details::matrix_cholesky_ns::solve_cholesky(
+        m_lower.data(), m_inverse_diagonal.data(), make_unrolled_size<S>(),
+        p_rhs.data(), make_unrolled_size<N>());
+}
+
+
+// Get the determinant of the factored matrix
+template<class T, std::size_t S>
+T cholesky_factorization<T, S>::determinant() const
+{
+    const auto product = details::matrix_cholesky_ns::diagonal_product(m_lower.data(), make_unrolled_size<S>());
+    return product * product;
+}
+
+
+// Get the natural logarithm of the determinant of the factored matrix
+template<class T, std::size_t S>
+T cholesky_factorization<T, S>::log_determinant() const
+{
+    return 2 * details::matrix_cholesky_ns::diagonal_log_sum(m_lower.data(), make_unrolled_size<S>());
+}
+
+
+// Get the lower triangular factor L
+template<class T, std::size_t S>
+const matrix<T, S, S> & cholesky_factorization<T, S>::get_lower() const
+{
+    return m_lower;
+}
+
+
+//////////////////////////////////////////////
+// ldlt_factorization
+
+// Factor a symmetric matrix
+template<class T, std::size_t S>
+ldlt_factorization<T, S>::ldlt_factorization(const matrix<T, S, S> & p_matrix) :
+    m_factors(p_matrix)
+{
+    m_valid = details::matrix_cholesky_ns::factor_ldlt(
+        m_factors.data(), m_inverse_diagonal.data(), make_unrolled_size<S>());
+}
+
+
+// Returns false if a zero pivot was encountered
+template<class T, std::size_t S>
+bool ldlt_factorization<T, S>::is_valid() const
+{
+    return m_valid;
+}
+
+
+// Solve A * x = b in-place
+template<class T, std::size_t S>
+void ldlt_factorization<T, S>::solve(vector<T, S> & p_rhs) const
+{
+    FT_ASSERT(m_valid);
+    details::matrix_cholesky_ns::solve_ldlt(
+        m_factors.data(), m_inverse_diagonal.data(), make_unrolled_size<S>(),
+        p_rhs.data(), make_unrolled_size<1>());
+}
+
+
+// Solve A * X = B in-place for multiple right hand sides
+template<class T, std::size_t S>
+template<std::size_t N>
+void ldlt_factorization<T, S>::solve(matrix<T, S, N> & p_rhs) const
+{
+    FT_ASSERT(m_valid);
+    details::matrix_cholesky_ns::solve_ldlt(
+        m_factors.data(), m_inverse_diagonal.data(), make_unrolled_size<S>(),
+        p_rhs.data(), make_unrolled_size<N>());
+}
+
+
+// Get the determinant of the factored matrix
+template<class T, std::size_t S>
+T ldlt_factorization<T, S>::determinant() const
+{
+    return details::matrix_cholesky_ns::diagonal_product(m_factors.data(), make_unrolled_size<S>());
+}
+
+
+// Get the natural logarithm of the absolute value of the determinant
+template<class T, std::size_t S>
+T ldlt_factorization<T, S>::log_determinant() const
+{
+    return details::matrix_cholesky_ns::diagonal_log_sum(m_factors.data(), make_unrolled_size<S>());
+}
+
+
+// Get the unit lower triangular factor L
+template<class T, std::size_t S>
+matrix<T, S, S> ldlt_factorization<T, S>::get_lower() const
+{
+    matrix<T, S, S> result;
+    details::matrix_cholesky_ns::copy_unit_lower(m_factors.data(), result.data(), make_unrolled_size<S>());
+    return result;
+}
+
+
+// Get the diagonal factor D
+template<class T, std::size_t S>
+vector<T, S> ldlt_factorization<T, S>::get_diagonal() const
+{
+    vector<T, S> result;
+    for (std::size_t i = 0; i < S; ++i) {
+        result[i] = m_factors[i][i];
+    }
+    return result;
+}
+
+
+//////////////////////////////////////////////
+// dynamic_cholesky_factorization
+
+// Factor a symmetric positive definite matrix
+template<class T>
+dynamic_cholesky_factorization<T>::dynamic_cholesky_factorization(dynamic_matrix<T> p_matrix) :
+    m_lower(std::move(p_matrix)),
+    m_inverse_diagonal(m_lower.rows())
+{
+    FT_ASSERT(m_lower.rows() == m_lower.cols());
+    m_valid = details::matrix_cholesky_ns::factor_cholesky(m_lower.data(), m_inverse_diagonal.data(), size());
+    details::matrix_cholesky_ns::clear_upper(m_lower.data(), size());
+}
+
+
+// Returns false if the matrix was not positive definite
+template<class T>
+bool dynamic_cholesky_factorization<T>::is_valid() const
+{
+    return m_valid;
+}
+
+
+// Get the number of rows (and columns) of the factored matrix
+template<class T>
+std::size_t dynamic_cholesky_factorization<T>::size() const
+{
+    return m_lower.rows();
+}
+
+
+// Solve A * x = b in-place
+template<class T>
+void dynamic_cholesky_factorization<T>::solve(std::span<T> p_rhs) const
+{
+    FT_ASSERT(m_valid);
+    FT_ASSERT(p_rhs.size() == size());
+    details::matrix_cholesky_ns::solve_cholesky(
+        m_lower.data(), m_inverse_diagonal.data(), size(),
+        p_rhs.data(), make_unrolled_size<1>());
+}
+
+
+// Solve A * X = B in-place for multiple right hand sides
+template<class T>
+void dynamic_cholesky_factorization<T>::solve(dynamic_matrix<T> & p_rhs) const
+{
+    FT_ASSERT(m_valid);
+    FT_ASSERT(p_rhs.rows() == size());
+    details::matrix_cholesky_ns::solve_cholesky(
+        m_lower.data(), m_inverse_diagonal.data(), size(),
+        p_rhs.data(), p_rhs.cols());
+}
+
+
+// Get the determinant of the factored matrix
+template<class T>
+T dynamic_cholesky_factorization<T>::determinant() const
+{
+    const auto product = details::matrix_cholesky_ns::diagonal_product(m_lower.data(), size());
+    return product * product;
+}
+
+
+// Get the natural logarithm of the determinant of the factored matrix
+template<class T>
+T dynamic_cholesky_factorization<T>::log_determinant() const
+{
+    return 2 * details::matrix_cholesky_ns::diagonal_log_sum(m_lower.data(), size());
+}
+
+
+// Get the lower triangular factor L
+template<class T>
+const dynamic_matrix<T> & dynamic_cholesky_factorization<T>::get_lower() const
+{
+    return m_lower;
+}
+
+
+//////////////////////////////////////////////
+// dynamic_ldlt_factorization
+
+// Factor a symmetric matrix
+template<class T>
+dynamic_ldlt_factorization<T>::dynamic_ldlt_factorization(dynamic_matrix<T> p_matrix) :
+    m_factors(std::move(p_matrix)),
+    m_inverse_diagonal(m_factors.rows())
+{
+    FT_ASSERT(m_factors.rows() == m_factors.cols());
+    m_valid = details::matrix_cholesky_ns::factor_ldlt(m_factors.data(), m_inverse_diagonal.data(), size());
+}
+
+
+// Returns false if a zero pivot was encountered
+template<class T>
+bool dynamic_ldlt_factorization<T>::is_valid() const
+{
+    return m_valid;
+}
+
+
+// Get the number of rows (and columns) of the factored matrix
+template<class T>
+std::size_t dynamic_ldlt_factorization<T>::size() const
+{
+    return m_factors.rows();
+}
+
+
+// Solve A * x = b in-place
+template<class T>
+void dynamic_ldlt_factorization<T>::solve(std::span<T> p_rhs) const
+{
+    FT_ASSERT(m_valid);
+    FT_ASSERT(p_rhs.size() == size());
+    details::matrix_cholesky_ns::solve_ldlt(
+        m_factors.data(), m_inverse_diagonal.data(), size(),
+        p_rhs.data(), make_unrolled_size<1>());
+}
+
+
+// Solve A * X = B in-place for multiple right hand sides
+template<class T>
+void dynamic_ldlt_factorization<T>::solve(dynamic_matrix<T> & p_rhs) const
+{
+    FT_ASSERT(m_valid);
+    FT_ASSERT(p_rhs.rows() == size());
+    details::matrix_cholesky_ns::solve_ldlt(
+        m_factors.data(), m_inverse_diagonal.data(), size(),
+        p_rhs.data(), p_rhs.cols());
+}
+
+
+// Get the determinant of the factored matrix
+template<class T>
+T dynamic_ldlt_factorization<T>::determinant() const
+{
+    return details::matrix_cholesky_ns::diagonal_product(m_factors.data(), size());
+}
+
+
+// Get the natural logarithm of the absolute value of the determinant
+template<class T>
+T dynamic_ldlt_factorization<T>::log_determinant() const
+{
+    return details::matrix_cholesky_ns::diagonal_log_sum(m_factors.data(), size());
+}
+
+
+// Get the unit lower triangular factor L
+template<class T>
+dynamic_matrix<T> dynamic_ldlt_factorization<T>::get_lower() const
+{
+    dynamic_matrix<T> result(size(), size());
+    details::matrix_cholesky_ns::copy_unit_lower(m_factors.data(), result.data(), size());
+    return result;
+}
+
+
+// Get the diagonal factor D
+template<class T>
+std::vector<T> dynamic_ldlt_factorization<T>::get_diagonal() const
+{
+    std::vector<T> result(size());
+    for (std::size_t i = 0; i < size(); ++i) {
+        result[i] = m_factors[i][i];
+    }
+    return result;
+}
+
+};  // namespace math
+};  // namespace ft
+
+
+// Compute the Cholesky factorization of a symmetric positive definite matrix
+template<class T, std::size_t S>
+ft::math::cholesky_factorization<T, S> ft::math::cholesky_decompose(const matrix<T, S, S> & p_matrix)
+{
+    return cholesky_factorization<T, S>(p_matrix);
+}
+
+
+// Compute the Cholesky factorization of a symmetric positive definite matrix
+template<class T>
+ft::math::dynamic_cholesky_factorization<T> ft::math::cholesky_decompose(const dynamic_matrix<T> & p_matrix)
+{
+    return dynamic_cholesky_factorization<T>(p_matrix);
+}
+
+
+// Compute the LDLt factorization of a symmetric matrix
+template<class T, std::size_t S>
+ft::math::ldlt_factorization<T, S> ft::math::ldlt_decompose(const matrix<T, S, S> & p_matrix)
+{
+    return ldlt_factorization<T, S>(p_matrix);
+}
+
+
+// Compute the LDLt factorization of a symmetric matrix
+template<class T>
+ft::math::dynamic_ldlt_factorization<T> ft::math::ldlt_decompose(const dynamic_matrix<T> & p_matrix)
+{
+    return dynamic_ldlt_factorization<T>(p_matrix);
+}
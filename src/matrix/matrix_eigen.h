@@ -0,0 +1,98 @@
+#pragma once
+
+// Eigen decomposition of symmetric matrices using cyclic Jacobi rotations
+// A = V * diag(eigenvalues) * Vt where the columns of V are orthonormal eigenvectors
+// Eigenvalues are sorted in increasing order
+// Only the lower triangle of the input matrix is read
+//
+// 3x3 matrices (inertia, covariance and stress tensors) use a fixed number
+//  of sweeps with no convergence test or data dependant branch, so that
+//  batches of them can be vectorized by the compiler
+// The structure of arrays batches run those sweeps across blocks of matrices,
+//  one matrix per vector lane
+// The full decomposition is larger than the -O2 inlining limits of GCC and
+//  needs -O3 to be vectorized, the eigenvalues alone are vectorized at -O2
+
+// project headers
+#include "matrix.h"
+#include "vector/vector.h"
+#include "vector/vector_soa.h"
+
+// standard headers
+#include <cstddef>  // std::size_t
+#include <span>
+
+namespace ft {
+namespace math {
+
+// Result of a symmetric eigen decomposition
+template<class T, std::size_t S>
+struct symmetric_eigen_decomposition
+{
+    // Eigenvalues in increasing order
+    vector<T, S> eigenvalues;
+
+    // Eigenvector `i` is column `i`, matching `eigenvalues[i]`
+    matrix<T, S, S> eigenvectors;
+};
+
+
+// Number of Jacobi sweeps used by the 3x3 path
+// Cyclic Jacobi converges quadratically, these are enough to reach
+//  full precision for any input
+template<class T>
+inline constexpr std::size_t symmetric_eigen_3x3_sweeps = (sizeof(T) <= sizeof(float)) ? 4 : 5;
+
+// Upper bound on the sweeps of the general path
+inline constexpr std::size_t symmetric_eigen_max_sweeps = 50;
+
+
+// Decompose a symmetric matrix
+// 3x3 matrices use a fixed number of sweeps, larger ones sweep until
+//  the off diagonal elements are negligible
+template<class T, std::size_t S>
+symmetric_eigen_decomposition<T, S> symmetric_eigen_decompose(const matrix<T, S, S> & p_matrix);
+
+// Decompose a symmetric matrix with a fixed number of sweeps and no branches
+template<class T, std::size_t S>
+symmetric_eigen_decomposition<T, S> symmetric_eigen_decompose_fixed(
+    const matrix<T, S, S> & p_matrix,
+    const std::size_t p_sweeps);
+
+
+// Decompose an array of symmetric matrices
+// `p_results` must be at least as large as `p_matrices`
+template<class T, std::size_t S>
+void symmetric_eigen_decompose_batch(
+    std::span<const matrix<T, S, S>> p_matrices,
+    std::span<symmetric_eigen_decomposition<T, S>> p_results);
+
+// Get the eigenvalues of an array of symmetric 3x3 matrices
+// Cheaper than a full decomposition since no eigenvector is accumulated
+// `p_results` must be at least as large as `p_matrices`
+template<class T>
+void symmetric_eigenvalues_batch(
+    std::span<const matrix<T, 3, 3>> p_matrices,
+    std::span<vector<T, 3>> p_results);
+
+
+// Decompose an array of symmetric 3x3 matrices stored as structures of arrays
+// Eigenvector `i` of matrix `n` is column `i` of `p_eigenvectors.get(n)`
+// `p_eigenvalues` and `p_eigenvectors` must be at least as large as `p_matrices`
+template<class T>
+void symmetric_eigen_decompose_batch(
+    const matrix_soa_span<const T, 3, 3> & p_matrices,
+    const vector_soa_span<T, 3> & p_eigenvalues,
+    const matrix_soa_span<T, 3, 3> & p_eigenvectors);
+
+// Get the eigenvalues of an array of symmetric 3x3 matrices stored as structures of arrays
+// `p_results` must be at least as large as `p_matrices`
+template<class T>
+void symmetric_eigenvalues_batch(
+    const matrix_soa_span<const T, 3, 3> & p_matrices,
+    const vector_soa_span<T, 3> & p_results);
+
+};  // namespace math
+};  // namespace ft
+
+#include "matrix_eigen.hpp"
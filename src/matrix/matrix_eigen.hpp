@@ -0,0 +1,376 @@
+#pragma once
+
+// Implements the eigen decompositions of matrix_eigen.h
+
+// project headers
+#include "matrix_eigen.h"
+#include "matrix_unroll.h"
+#include "matrix_utility.h"
+
+// other headers
+#include "error/ft_assert.h"
+
+// standard headers
+#include <array>
+#include <cmath>
+#include <limits>
+#include <type_traits>
+
+namespace ft {
+namespace math {
+namespace details {
+namespace matrix_eigen_ns {
+
+// Copy the lower triangle of a square matrix over its upper triangle
+template<class T, class N>
+void mirror_lower(T * p_data, const N p_size)
+{
+    for_range(zero_index, p_size, [&](auto y) {
+        for_range(next_index(y), p_size, [&](auto x) {
+            p_data[y * p_size + x] = p_data[x * p_size + y];
+        });
+    });
+}
+
+
+// Sum of the squares of the elements above the diagonal
+template<class T, class N>
+T off_diagonal_norm2(const T * p_data, const N p_size)
+{
+    auto result = static_cast<T>(0);
+    for_range(zero_index, p_size, [&](auto y) {
+        for_range(next_index(y), p_size, [&](auto x) {
+            const auto value = p_data[y * p_size + x];
+            result += value * value;
+        });
+    });
+    return result;
+}
+
+
+// Get t = tan(angle), c = cos(angle) and s = sin(angle) of the Jacobi rotation
+//  annihilating a_pq, picking the smaller angle
+// A zero a_pq gives the identity rotation without a branch
+template<class T>
+inline void jacobi_angle(const T p_pp, const T p_qq, const T p_pq, T & p_t, T & p_c, T & p_s)
+{
+    const auto tau = p_qq - p_pp;
+    const auto two_a_pq = 2 * p_pq;
+    const auto denominator = static_cast<T>(std::abs(tau) + std::sqrt(tau * tau + two_a_pq * two_a_pq));
+    const auto safe_denominator = (denominator > 0) ? denominator : static_cast<T>(1);
+    const auto sign = (tau < 0) ? static_cast<T>(-1) : static_cast<T>(1);
+    p_t = sign * two_a_pq / safe_denominator;
+    p_c = static_cast<T>(1 / std::sqrt(p_t * p_t + 1));
+    p_s = p_t * p_c;
+}
+
+
+// Do one cyclic sweep of Jacobi rotations over every pair of rows and columns
+// `p_data` must be symmetric and is kept symmetric
+// Rotations are accumulated into `p_vectors` when `V` is true
+// Has no data dependant branch, a zero element produces an identity rotation
+template<bool V, class T, class N>
+void jacobi_sweep(T * p_data, T * p_vectors, const N p_size)
+{
+    for_range(zero_index, p_size, [&](auto p) {
+    for_range(next_index(p), p_size, [&](auto q)
+    {
+        const auto a_pp = p_data[p * p_size + p];
+        const auto a_qq = p_data[q * p_size + q];
+        const auto a_pq = p_data[p * p_size + q];
+
+        T t;
+        T c;
+        T s;
+        jacobi_angle(a_pp, a_qq, a_pq, t, c, s);
+
+        p_data[p * p_size + p] = a_pp - t * a_pq;
+        p_data[q * p_size + q] = a_qq + t * a_pq;
+        p_data[p * p_size + q] = 0;
+        p_data[q * p_size + p] = 0;
+
+        for_range(zero_index, p_size, [&](auto r)
+        {
+            if (r != p && r != q)
+            {
+                const auto a_rp = p_data[r * p_size + p];
+                const auto a_rq = p_data[r * p_size + q];
+                const auto new_rp = c * a_rp - s * a_rq;
+                const auto new_rq = s * a_rp + c * a_rq;
+                p_data[r * p_size + p] = new_rp;
+                p_data[p * p_size + r] = new_rp;
+                p_data[r * p_size + q] = new_rq;
+                p_data[q * p_size + r] = new_rq;
+            }
+        });
+
+        if constexpr (V)
+        {
+            for_range(zero_index, p_size, [&](auto r)
+            {
+                const auto v_rp = p_vectors[r * p_size + p];
+                const auto v_rq = p_vectors[r * p_size + q];
+                p_vectors[r * p_size + p] = c * v_rp - s * v_rq;
+                p_vectors[r * p_size + q] = s * v_rp + c * v_rq;
+            });
+        }
+    });
+    });
+}
+
+
+// Sort eigenvalues in increasing order with an odd-even transposition network
+// Eigenvector columns follow their eigenvalue when `V` is true
+// Uses selects instead of branches
+template<bool V, class T, class N>
+inline void sort_eigenvalues(T * p_values, T * p_vectors, const N p_size)
+{
+    for_range(zero_index, p_size, [&](auto round) {
+    for_range(zero_index, p_size, [&](auto i)
+    {
+        if ((i % 2) == (round % 2) && i + 1 < p_size)
+        {
+            const auto j = next_index(i);
+            const auto a = p_values[i];
+            const auto b = p_values[j];
+            const auto swap = a > b;
+            p_values[i] = swap ? b : a;
+            p_values[j] = swap ? a : b;
+
+            if constexpr (V)
+            {
+                for_range(zero_index, p_size, [&](auto r)
+                {
+                    const auto v_i = p_vectors[r * p_size + i];
+                    const auto v_j = p_vectors[r * p_size + j];
+                    p_vectors[r * p_size + i] = swap ? v_j : v_i;
+                    p_vectors[r * p_size + j] = swap ? v_i : v_j;
+                });
+            }
+        }
+    });
+    });
+}
+
+
+// Decompose a symmetric matrix in-place
+// `p_sweeps` sweeps are done, or until convergence if `p_converge` is true
+// On return `p_values` holds sorted eigenvalues and `p_vectors` the matching columns
+template<bool V, class T, class N>
+void decompose(T * p_data, T * p_values, T * p_vectors, const N p_size, const std::size_t p_sweeps, const bool p_converge)
+{
+    mirror_lower(p_data, p_size);
+
+    // Frobenius norm is preserved by rotations
+    auto total2 = static_cast<T>(0);
+    if (p_converge)
+    {
+        for_range(zero_index, p_size, [&](auto i) {
+            const auto value = p_data[i * p_size + i];
+            total2 += value * value;
+        });
+        total2 += 2 * off_diagonal_norm2(p_data, p_size);
+    }
+    const auto epsilon = std::numeric_limits<T>::epsilon();
+    const auto threshold = epsilon * epsilon * total2;
+
+    for (std::size_t sweep = 0; sweep < p_sweeps; ++sweep)
+    {
+        if (p_converge && off_diagonal_norm2(p_data, p_size) <= threshold) {
+            break;
+        }
+        jacobi_sweep<V>(p_data, p_vectors, p_size);
+    }
+
+    for_range(zero_index, p_size, [&](auto i) {
+        p_values[i] = p_data[i * p_size + i];
+    });
+    sort_eigenvalues<V>(p_values, p_vectors, p_size);
+}
+
+
+// Apply the Jacobi rotation of the (p, q) plane to a symmetric 3x3 matrix
+//  given by its diagonal elements `p_pp`, `p_qq` and the elements a_pq,
+//  a_rp and a_rq, where r is the third index
+// Rotations are accumulated into the columns `P` and `Q` of `p_vectors` when `V` is true
+// Written out on scalars so batches keep every element in registers
+template<bool V, std::size_t P, std::size_t Q, class T>
+inline void jacobi_rotation_3x3(T & p_pp, T & p_qq, T & p_pq, T & p_rp, T & p_rq, T * p_vectors)
+{
+    T t;
+    T c;
+    T s;
+    jacobi_angle(p_pp, p_qq, p_pq, t, c, s);
+
+    p_pp -= t * p_pq;
+    p_qq += t * p_pq;
+    p_pq = 0;
+
+    const auto a_rp = p_rp;
+    const auto a_rq = p_rq;
+    p_rp = c * a_rp - s * a_rq;
+    p_rq = s * a_rp + c * a_rq;
+
+    if constexpr (V)
+    {
+        for_range(zero_index, std::integral_constant<std::size_t, 3>{}, [&](auto r)
+        {
+            const auto v_rp = p_vectors[r * 3 + P];
+            const auto v_rq = p_vectors[r * 3 + Q];
+            p_vectors[r * 3 + P] = c * v_rp - s * v_rq;
+            p_vectors[r * 3 + Q] = s * v_rp + c * v_rq;
+        });
+    }
+}
+
+
+// Decompose a symmetric 3x3 matrix with the sweeps of the 3x3 path
+// Only reads the lower triangle of `p_matrix`
+// Has no loop or branch left once inlined, so batches vectorize it across matrices
+template<bool V, class T>
+inline void decompose_3x3(const matrix<T, 3, 3> & p_matrix, T * p_values, T * p_vectors)
+{
+    auto a_00 = p_matrix[0][0];
+    auto a_11 = p_matrix[1][1];
+    auto a_22 = p_matrix[2][2];
+    auto a_01 = p_matrix[1][0];
+    auto a_02 = p_matrix[2][0];
+    auto a_12 = p_matrix[2][1];
+
+    constexpr auto sweeps = std::integral_constant<std::size_t, symmetric_eigen_3x3_sweeps<T>>{};
+    for_range(zero_index, sweeps, [&](auto)
+    {
+        jacobi_rotation_3x3<V, 0, 1>(a_00, a_11, a_01, a_02, a_12, p_vectors);
+        jacobi_rotation_3x3<V, 0, 2>(a_00, a_22, a_02, a_01, a_12, p_vectors);
+        jacobi_rotation_3x3<V, 1, 2>(a_11, a_22, a_12, a_01, a_02, p_vectors);
+    });
+
+    p_values[0] = a_00;
+    p_values[1] = a_11;
+    p_values[2] = a_22;
+    sort_eigenvalues<V>(p_values, p_vectors, std::integral_constant<std::size_t, 3>{});
+}
+
+};  // namespace matrix_eigen_ns
+};  // namespace details
+};  // namespace math
+};  // namespace ft
+
+
+// Decompose a symmetric matrix
+template<class T, std::size_t S>
+ft::math::symmetric_eigen_decomposition<T, S>
+ft::math::symmetric_eigen_decompose(const matrix<T, S, S> & p_matrix)
+{
+    if constexpr (S == 3) {
+        return symmetric_eigen_decompose_fixed(p_matrix, symmetric_eigen_3x3_sweeps<T>);
+    }
+    else
+    {
+        auto data = p_matrix;
+        auto result = symmetric_eigen_decomposition<T, S>{};
+        result.eigenvectors = make_identity_matrix<T, S>();
+        details::matrix_eigen_ns::decompose<true>(
+            data.data(), result.eigenvalues.data(), result.eigenvectors.data(),
+            make_unrolled_size<S>(), symmetric_eigen_max_sweeps, true);
+        return result;
+    }
+}
+
+
+// Decompose a symmetric matrix with a fixed number of sweeps and no branches
+template<class T, std::size_t S>
+ft::math::symmetric_eigen_decomposition<T, S>
+ft::math::symmetric_eigen_decompose_fixed(const matrix<T, S, S> & p_matrix, const std::size_t p_sweeps)
+{
+    auto data = p_matrix;
+    auto result = symmetric_eigen_decomposition<T, S>{};
+    result.eigenvectors = make_identity_matrix<T, S>();
+    details::matrix_eigen_ns::decompose<true>(
+        data.data(), result.eigenvalues.data(), result.eigenvectors.data(),
+        make_unrolled_size<S>(), p_sweeps, false);
+    return result;
+}
+
+
+// Decompose an array of symmetric matrices
+template<class T, std::size_t S>
+void ft::math::symmetric_eigen_decompose_batch(
+    std::span<const matrix<T, S, S>> p_matrices,
+    std::span<symmetric_eigen_decomposition<T, S>> p_results)
+{
+    FT_ASSERT(p_results.size() >= p_matrices.size());
+
+    for (std::size_t i = 0; i < p_matrices.size(); ++i) {
+        p_results[i] = symmetric_eigen_decompose(p_matrices[i]);
+    }
+}
+
+
+// Get the eigenvalues of an array of symmetric 3x3 matrices
+template<class T>
+void ft::math::symmetric_eigenvalues_batch(
+    std::span<const matrix<T, 3, 3>> p_matrices,
+    std::span<vector<T, 3>> p_results)
+{
+    FT_ASSERT(p_results.size() >= p_matrices.size());
+
+    for (std::size_t i = 0; i < p_matrices.size(); ++i)
+    {
+        auto data = p_matrices[i];
+        details::matrix_eigen_ns::decompose<false>(
+            data.data(), p_results[i].data(), static_cast<T *>(nullptr),
+            make_unrolled_size<3>(), symmetric_eigen_3x3_sweeps<T>, false);
+    }
+}
+
+
+// Decompose an array of symmetric 3x3 matrices stored as structures of arrays
+template<class T>
+void ft::math::symmetric_eigen_decompose_batch(
+    const matrix_soa_span<const T, 3, 3> & p_matrices,
+    const vector_soa_span<T, 3> & p_eigenvalues,
+    const matrix_soa_span<T, 3, 3> & p_eigenvectors)
+{
+    FT_ASSERT(p_eigenvalues.size() >= p_matrices.size());
+    FT_ASSERT(p_eigenvectors.size() >= p_matrices.size());
+
+    // Eigenvalues and eigenvectors are mapped together as 12 components
+    std::array<T *, 12> components;
+    for (std::size_t e = 0; e < 3; ++e) {
+        components[e] = p_eigenvalues.component(e);
+    }
+    for (std::size_t e = 0; e < 9; ++e) {
+        components[3 + e] = p_eigenvectors.component(e);
+    }
+    const auto results = vector_soa_span<T, 12>(components, p_matrices.size());
+
+    map_soa<matrix<T, 3, 3>, vector<T, 12>>(p_matrices, results, [](const matrix<T, 3, 3> & p_matrix)
+    {
+        vector<T, 12> result;
+        auto * const vectors = result.data() + 3;
+        for_range(zero_index, std::integral_constant<std::size_t, 9>{}, [&](auto e) {
+            vectors[e] = (e % 4 == 0) ? static_cast<T>(1) : static_cast<T>(0);
+        });
+
+        details::matrix_eigen_ns::decompose_3x3<true>(p_matrix, result.data(), vectors);
+        return result;
+    });
+}
+
+
+// Get the eigenvalues of an array of symmetric 3x3 matrices stored as structures of arrays
+template<class T>
+void ft::math::symmetric_eigenvalues_batch(
+    const matrix_soa_span<const T, 3, 3> & p_matrices,
+    const vector_soa_span<T, 3> & p_results)
+{
+    FT_ASSERT(p_results.size() >= p_matrices.size());
+
+    map_soa<matrix<T, 3, 3>, vector<T, 3>>(p_matrices, p_results, [](const matrix<T, 3, 3> & p_matrix)
+    {
+        vector<T, 3> result;
+        details::matrix_eigen_ns::decompose_3x3<false>(p_matrix, result.data(), static_cast<T *>(nullptr));
+        return result;
+    });
+}
@@ -0,0 +1,64 @@
+#pragma once
+
+// General matrix multiplication of runtime sized matrices
+// C = alpha * op(A) * op(B) + beta * C, op transposing its operand or not
+//
+// Follows the GotoBLAS layout: panels of B sized for the L3 cache and
+//  blocks of A sized for the L2 cache are copied to contiguous buffers,
+//  then a micro kernel multiplies slivers of them while keeping a block of
+//  C in registers and the current sliver of B in the L1 cache
+// The micro kernel is written with fixed size loops the compiler turns into
+//  SIMD code for the targeted instruction set
+// Blocks of C are computed in parallel on the thread pool, each element of C
+//  is always computed by the same sequence of operations, so the result does
+//  not depend on the number of threads
+
+// project headers
+#include "dynamic_matrix.h"
+#include "memory/math_workspace.h"
+#include "parallel/thread_pool.h"
+
+// standard headers
+#include <cstddef>  // std::size_t
+
+namespace ft {
+namespace math {
+
+// Operation applied to an operand of gemm
+enum class matrix_operation
+{
+    none,
+    transpose
+};
+
+
+// Compute `p_c = p_alpha * op(p_a) * op(p_b) + p_beta * p_c`
+// `p_c` must already have the dimensions of the product
+// When `p_beta` is zero `p_c` is only written, so it may hold anything
+// Packed panels are taken from `p_workspace`, and from the default workspace
+//  of each thread of `p_pool`
+template<class T>
+void gemm(
+    const T p_alpha,
+    const dynamic_matrix<T> & p_a,
+    const matrix_operation p_operation_a,
+    const dynamic_matrix<T> & p_b,
+    const matrix_operation p_operation_b,
+    const T p_beta,
+    dynamic_matrix<T> & p_c,
+    thread_pool & p_pool = default_thread_pool(),
+    math_workspace & p_workspace = default_workspace());
+
+// Compute `op(p_a) * op(p_b)`
+template<class T>
+dynamic_matrix<T> gemm(
+    const dynamic_matrix<T> & p_a,
+    const dynamic_matrix<T> & p_b,
+    const matrix_operation p_operation_a = matrix_operation::none,
+    const matrix_operation p_operation_b = matrix_operation::none,
+    thread_pool & p_pool = default_thread_pool());
+
+};  // namespace math
+};  // namespace ft
+
+#include "matrix_gemm.hpp"
@@ -0,0 +1,334 @@
+#pragma once
+
+// Implements the matrix multiplication of matrix_gemm.h
+
+// project headers
+#include "matrix_gemm.h"
+#include "matrix_unroll.h"
+
+// other headers
+#include "error/ft_assert.h"
+
+// standard headers
+#include <algorithm>
+
+namespace ft {
+namespace math {
+namespace details {
+namespace matrix_gemm_ns {
+
+// Bytes of the widest SIMD registers the compiler targets
+#if defined(__AVX512F__)
+inline constexpr std::size_t simd_register_bytes = 64;
+#elif defined(__AVX__)
+inline constexpr std::size_t simd_register_bytes = 32;
+#else
+inline constexpr std::size_t simd_register_bytes = 16;
+#endif
+
+// Rows and columns of the block of C the micro kernel keeps in registers
+// 6 rows of two SIMD registers fit the 16 registers of SSE and AVX with
+//  room left for the slivers of A and B
+inline constexpr std::size_t micro_rows = 6;
+template<class T>
+inline constexpr std::size_t micro_cols = std::max<std::size_t>(2 * simd_register_bytes / sizeof(T), 2);
+
+// Depth of the packed panels, a sliver of B of `panel_depth * micro_cols`
+//  elements stays in the L1 cache
+inline constexpr std::size_t panel_depth = 256;
+
+// Rows of a packed block of A, sized for half of a 256 KB L2 cache
+template<class T>
+inline constexpr std::size_t block_rows = (128 * 1024 / (panel_depth * sizeof(T))) / micro_rows * micro_rows;
+
+// Columns of a packed panel of B, sized for the L3 cache
+inline constexpr std::size_t panel_cols = 4096;
+
+// Columns of C computed by one parallel task
+inline constexpr std::size_t task_cols = 512;
+
+
+// Operand of a product, possibly transposed
+template<class T>
+struct operand
+{
+    const T * data;
+    std::size_t row_stride;
+    std::size_t col_stride;
+
+    // Get element (`p_row`, `p_col`) of the operand
+    const T & operator()(const std::size_t p_row, const std::size_t p_col) const
+    {
+        return data[p_row * row_stride + p_col * col_stride];
+    }
+};
+
+
+// Get the operand `op(p_matrix)`
+template<class T>
+operand<T> make_operand(const dynamic_matrix<T> & p_matrix, const matrix_operation p_operation)
+{
+    if (p_operation == matrix_operation::transpose) {
+        return { p_matrix.data(), 1, p_matrix.cols() };
+    }
+    return { p_matrix.data(), p_matrix.cols(), 1 };
+}
+
+
+// Round `p_size` up to a multiple of `p_multiple`
+constexpr std::size_t round_up(const std::size_t p_size, const std::size_t p_multiple)
+{
+    return (p_size + p_multiple - 1) / p_multiple * p_multiple;
+}
+
+
+// Copy rows [p_row, p_row + p_rows) and columns [p_col, p_col + p_depth) of `p_a`
+//  to slivers of `micro_rows` rows stored column after column
+// Rows past the end are padded with zeros
+template<class T>
+void pack_a(const operand<T> & p_a, const std::size_t p_row, const std::size_t p_rows, const std::size_t p_col, const std::size_t p_depth, T * p_packed)
+{
+    for (std::size_t s = 0; s < p_rows; s += micro_rows)
+    {
+        const auto rows = std::min(micro_rows, p_rows - s);
+        for (std::size_t k = 0; k < p_depth; ++k)
+        {
+            for (std::size_t r = 0; r < micro_rows; ++r) {
+                p_packed[r] = (r < rows) ? p_a(p_row + s + r, p_col + k) : static_cast<T>(0);
+            }
+            p_packed += micro_rows;
+        }
+    }
+}
+
+
+// Copy slivers [p_first, p_last) of `micro_cols` columns of rows
+//  [p_row, p_row + p_depth) and columns [p_col, p_col + p_cols) of `p_b`,
+//  each sliver stored row after row
+// Columns past the end are padded with zeros
+template<class T>
+void pack_b(
+    const operand<T> & p_b,
+    const std::size_t p_row,
+    const std::size_t p_depth,
+    const std::size_t p_col,
+    const std::size_t p_cols,
+    const std::size_t p_first,
+    const std::size_t p_last,
+    T * p_packed)
+{
+    constexpr auto nr = micro_cols<T>;
+
+    for (auto sliver = p_first; sliver < p_last; ++sliver)
+    {
+        const auto col = sliver * nr;
+        const auto cols = std::min(nr, p_cols - col);
+        auto packed = p_packed + sliver * nr * p_depth;
+        for (std::size_t k = 0; k < p_depth; ++k)
+        {
+            for (std::size_t c = 0; c < nr; ++c) {
+                packed[c] = (c < cols) ? p_b(p_row + k, p_col + col + c) : static_cast<T>(0);
+            }
+            packed += nr;
+        }
+    }
+}
+
+
+// Multiply a packed sliver of A by a packed sliver of B over `p_depth` and
+//  accumulate the result in the `p_rows` by `p_cols` block of C at `p_c`
+// `p_c = p_alpha * A * B + p_beta * p_c`, `p_c` is not read when `p_beta` is zero
+template<class T>
+void micro_kernel(
+    const std::size_t p_depth,
+    const T * p_a,
+    const T * p_b,
+    T * p_c,
+    const std::size_t p_c_stride,
+    const std::size_t p_rows,
+    const std::size_t p_cols,
+    const T p_alpha,
+    const T p_beta)
+{
+    constexpr auto nr = micro_cols<T>;
+
+    // Fully unrolled so the compiler keeps the accumulators in SIMD registers
+    T accumulators[micro_rows][nr] = {};
+    for (std::size_t k = 0; k < p_depth; ++k)
+    {
+        for_range(zero_index, std::integral_constant<std::size_t, micro_rows>{}, [&](auto r)
+        {
+            const auto a = p_a[r];
+            for_range(zero_index, std::integral_constant<std::size_t, nr>{}, [&](auto c) {
+                accumulators[r][c] += a * p_b[c];
+            });
+        });
+        p_a += micro_rows;
+        p_b += nr;
+    }
+
+    for (std::size_t r = 0; r < p_rows; ++r)
+    {
+        auto row = p_c + r * p_c_stride;
+        if (p_beta == static_cast<T>(0))
+        {
+            for (std::size_t c = 0; c < p_cols; ++c) {
+                row[c] = p_alpha * accumulators[r][c];
+            }
+        }
+        else
+        {
+            for (std::size_t c = 0; c < p_cols; ++c) {
+                row[c] = p_alpha * accumulators[r][c] + p_beta * row[c];
+            }
+        }
+    }
+}
+
+
+// Multiply a block of A by a packed panel of B into C
+// Rows [p_row, p_row + p_rows) of C and columns [p_col, p_col + p_cols) of the panel
+template<class T>
+void multiply_block(
+    const operand<T> & p_a,
+    const std::size_t p_row,
+    const std::size_t p_rows,
+    const std::size_t p_depth_begin,
+    const std::size_t p_depth,
+    const T * p_packed_b,
+    const std::size_t p_col,
+    const std::size_t p_cols,
+    T * p_c,
+    const std::size_t p_c_stride,
+    const T p_alpha,
+    const T p_beta)
+{
+    constexpr auto nr = micro_cols<T>;
+
+    auto & workspace = default_workspace();
+    const math_workspace_scope scope(workspace);
+    const auto packed_a = workspace.allocate<T>(round_up(p_rows, micro_rows) * p_depth);
+    pack_a(p_a, p_row, p_rows, p_depth_begin, p_depth, packed_a.data());
+
+    for (std::size_t c = 0; c < p_cols; c += nr)
+    {
+        const auto sliver_b = p_packed_b + (p_col + c) * p_depth;
+        for (std::size_t r = 0; r < p_rows; r += micro_rows)
+        {
+            micro_kernel(
+                p_depth,
+                packed_a.data() + r * p_depth,
+                sliver_b,
+                p_c + (p_row + r) * p_c_stride + p_col + c,
+                p_c_stride,
+                std::min(micro_rows, p_rows - r),
+                std::min(nr, p_cols - c),
+                p_alpha,
+                p_beta);
+        }
+    }
+}
+
+};  // namespace matrix_gemm_ns
+};  // namespace details
+};  // namespace math
+};  // namespace ft
+
+
+// Compute `p_c = p_alpha * op(p_a) * op(p_b) + p_beta * p_c`
+template<class T>
+void ft::math::gemm(
+    const T p_alpha,
+    const dynamic_matrix<T> & p_a,
+    const matrix_operation p_operation_a,
+    const dynamic_matrix<T> & p_b,
+    const matrix_operation p_operation_b,
+    const T p_beta,
+    dynamic_matrix<T> & p_c,
+    thread_pool & p_pool,
+    math_workspace & p_workspace)
+{
+    using namespace details::matrix_gemm_ns;
+    constexpr auto nr = micro_cols<T>;
+    constexpr auto mc = block_rows<T>;
+
+    const auto transpose_a = p_operation_a == matrix_operation::transpose;
+    const auto transpose_b = p_operation_b == matrix_operation::transpose;
+    const auto rows = transpose_a ? p_a.cols() : p_a.rows();
+    const auto depth = transpose_a ? p_a.rows() : p_a.cols();
+    const auto cols = transpose_b ? p_b.rows() : p_b.cols();
+    FT_ASSERT(depth == (transpose_b ? p_b.cols() : p_b.rows()));
+    FT_ASSERT(p_c.rows() == rows && p_c.cols() == cols);
+
+    if (rows == 0 || cols == 0) {
+        return;
+    }
+
+    // Nothing to multiply, only scale C
+    if (depth == 0 || p_alpha == static_cast<T>(0))
+    {
+        if (p_beta == static_cast<T>(0)) {
+            p_c.fill(0);
+        }
+        else {
+            p_c *= p_beta;
+        }
+        return;
+    }
+
+    const auto a = make_operand(p_a, p_operation_a);
+    const auto b = make_operand(p_b, p_operation_b);
+
+    const math_workspace_scope scope(p_workspace);
+    const auto packed_b = p_workspace.allocate<T>(round_up(std::min(panel_cols, cols), nr) * std::min(panel_depth, depth));
+
+    for (std::size_t jc = 0; jc < cols; jc += panel_cols)
+    {
+        const auto panel_width = std::min(panel_cols, cols - jc);
+        const auto slivers = chunk_count(panel_width, nr);
+
+        for (std::size_t pc = 0; pc < depth; pc += panel_depth)
+        {
+            const auto panel_height = std::min(panel_depth, depth - pc);
+
+            // C is only scaled by beta once, later panels accumulate
+            const auto beta = (pc == 0) ? p_beta : static_cast<T>(1);
+
+            parallel_for_chunks(slivers, task_cols / nr, [&](const std::size_t, const std::size_t p_first, const std::size_t p_last) {
+                pack_b(b, pc, panel_height, jc, panel_width, p_first, p_last, packed_b.data());
+            }, p_pool);
+
+            const auto row_blocks = chunk_count(rows, mc);
+            const auto col_blocks = chunk_count(panel_width, task_cols);
+            p_pool.run(row_blocks * col_blocks, [&](const std::size_t p_task)
+            {
+                const auto row = (p_task / col_blocks) * mc;
+                const auto col = (p_task % col_blocks) * task_cols;
+                multiply_block(
+                    a, row, std::min(mc, rows - row),
+                    pc, panel_height,
+                    packed_b.data(), col, std::min(task_cols, panel_width - col),
+                    p_c.data() + jc, cols,
+                    p_alpha, beta);
+            });
+        }
+    }
+}
+
+
+// Compute `op(p_a) * op(p_b)`
+template<class T>
+ft::math::dynamic_matrix<T> ft::math::gemm(
+    const dynamic_matrix<T> & p_a,
+    const dynamic_matrix<T> & p_b,
+    const matrix_operation p_operation_a,
+    const matrix_operation p_operation_b,
+    thread_pool & p_pool)
+{
+    const auto rows = (p_operation_a == matrix_operation::transpose) ? p_a.cols() : p_a.rows();
+    const auto cols = (p_operation_b == matrix_operation::transpose) ? p_b.rows() : p_b.cols();
+
+    dynamic_matrix<T> result(rows, cols);
+    gemm(static_cast<T>(1), p_a, p_operation_a, p_b, p_operation_b, static_cast<T>(0), result, p_pool);
+    return result;
+}
@@ -0,0 +1,242 @@
+#pragma once
+
+// Householder QR factorization of tall (or square) matrices and least squares solvers
+// A = Q * R where Q has orthonormal columns and R is upper triangular
+// Least squares solutions go through Qt * b and never form At * A,
+//  which would square the condition number of the problem
+// The streaming solvers fold rows in one at a time using Givens rotations
+//  and only keep a C by C triangle, so data sets don't need to fit in memory
+
+// project headers
+#include "dynamic_matrix.h"
+#include "matrix.h"
+#include "memory/math_workspace.h"
+#include "vector/vector.h"
+
+// standard headers
+#include <cstddef>  // std::size_t
+#include <span>
+#include <vector>
+
+namespace ft {
+namespace math {
+
+// Number of columns processed per panel by the blocked factorization
+inline constexpr std::size_t qr_block_size = 32;
+
+
+// QR factorization of a fixed size matrix of `R` rows by `C` columns
+// Requires R >= C
+template<class T, std::size_t R, std::size_t C>
+class qr_factorization
+{
+    static_assert(R >= C, "QR factorization requires at least as many rows as columns");
+
+public:
+    // Factor a matrix
+    explicit qr_factorization(const matrix<T, R, C> & p_matrix);
+
+
+    // Returns false if a diagonal element of R is zero
+    // A rank deficient factorization can't be used to solve
+    bool is_full_rank() const;
+
+
+    // Replace `p_vector` by Qt * p_vector
+    void apply_transposed_q(vector<T, R> & p_vector) const;
+
+    // Find x minimizing |A * x - b|
+    vector<T, C> solve_least_squares(vector<T, R> p_rhs) const;
+
+
+    // Get the upper triangular factor R
+    matrix<T, C, C> get_r() const;
+
+    // Get the thin orthonormal factor Q
+    matrix<T, R, C> get_q() const;
+
+private:
+    // R on and above the diagonal, Householder vectors below it
+    matrix<T, R, C> m_factors;
+
+    // Householder reflector scales
+    vector<T, C> m_tau;
+
+};  // class qr_factorization
+
+
+// QR factorization of a runtime sized matrix
+// Requires rows >= cols
+// Wide matrices are factored in panels of `qr_block_size` columns
+//  and the trailing columns are updated with block reflectors
+template<class T>
+class dynamic_qr_factorization
+{
+public:
+    // Factor a matrix
+    // Temporaries are taken from `p_workspace`
+    explicit dynamic_qr_factorization(dynamic_matrix<T> p_matrix, math_workspace & p_workspace = default_workspace());
+
+
+    // Get the number of rows of the factored matrix
+    std::size_t rows() const;
+
+    // Get the number of columns of the factored matrix
+    std::size_t cols() const;
+
+
+    // Returns false if a diagonal element of R is zero
+    // A rank deficient factorization can't be used to solve
+    bool is_full_rank() const;
+
+
+    // Replace `p_vector` by Qt * p_vector
+    void apply_transposed_q(std::span<T> p_vector) const;
+
+    // Find x minimizing |A * x - b|
+    std::vector<T> solve_least_squares(std::span<const T> p_rhs) const;
+
+
+    // Get the upper triangular factor R
+    dynamic_matrix<T> get_r() const;
+
+    // Get the thin orthonormal factor Q
+    // Temporaries are taken from `p_workspace`
+    dynamic_matrix<T> get_q(math_workspace & p_workspace = default_workspace()) const;
+
+private:
+    // R on and above the diagonal, Householder vectors below it
+    dynamic_matrix<T> m_factors;
+
+    // Householder reflector scales
+    std::vector<T> m_tau;
+
+};  // class dynamic_qr_factorization
+
+
+// Incremental least squares solver for `C` unknowns
+// Rows are folded into an upper triangular factor with Givens rotations
+//  as they arrive, memory use does not depend on the number of rows
+template<class T, std::size_t C>
+class streaming_least_squares
+{
+public:
+    // Start with no rows
+    streaming_least_squares();
+
+
+    // Fold in the equation `p_row . x = p_rhs`
+    // `p_weight` scales the squared residual of this row
+    void add_row(vector<T, C> p_row, T p_rhs, const T p_weight = 1);
+
+    // Fold in all the rows of another solver
+    // Allows independent chunks of data to be processed in parallel
+    void merge(const streaming_least_squares & p_other);
+
+
+    // Get the number of rows folded in so far
+    std::size_t row_count() const;
+
+    // Returns false if the rows seen so far do not determine the solution
+    bool is_full_rank() const;
+
+    // Find x minimizing the (weighted) sum of squared residuals
+    vector<T, C> solve() const;
+
+    // Get the (weighted) sum of squared residuals of the solution
+    T residual_norm2() const;
+
+private:
+    // Upper triangular factor
+    matrix<T, C, C> m_r;
+
+    // Rotated right hand side
+    vector<T, C> m_qtb;
+
+    // Part of the right hand side that can't be fitted
+    T m_residual2;
+
+    // Rows folded in so far
+    std::size_t m_row_count;
+
+};  // class streaming_least_squares
+
+
+// Incremental least squares solver for a runtime number of unknowns
+// Rows are folded into an upper triangular factor with Givens rotations
+//  as they arrive, memory use does not depend on the number of rows
+template<class T>
+class dynamic_streaming_least_squares
+{
+public:
+    // Start with no rows for a problem of `p_cols` unknowns
+    explicit dynamic_streaming_least_squares(const std::size_t p_cols);
+
+
+    // Fold in the equation `p_row . x = p_rhs`
+    // `p_weight` scales the squared residual of this row
+    void add_row(std::span<const T> p_row, T p_rhs, const T p_weight = 1);
+
+    // Fold in all the rows of another solver with the same number of unknowns
+    // Allows independent chunks of data to be processed in parallel
+    void merge(const dynamic_streaming_least_squares & p_other);
+
+
+    // Get the number of unknowns
+    std::size_t cols() const;
+
+    // Get the number of rows folded in so far
+    std::size_t row_count() const;
+
+    // Returns false if the rows seen so far do not determine the solution
+    bool is_full_rank() const;
+
+    // Find x minimizing the (weighted) sum of squared residuals
+    std::vector<T> solve() const;
+
+    // Get the (weighted) sum of squared residuals of the solution
+    T residual_norm2() const;
+
+private:
+    // Upper triangular factor
+    dynamic_matrix<T> m_r;
+
+    // Rotated right hand side
+    std::vector<T> m_qtb;
+
+    // Scratch row used while folding
+    mutable std::vector<T> m_row;
+
+    // Part of the right hand side that can't be fitted
+    T m_residual2;
+
+    // Rows folded in so far
+    std::size_t m_row_count;
+
+};  // class dynamic_streaming_least_squares
+
+
+// Compute the QR factorization of a matrix
+template<class T, std::size_t R, std::size_t C>
+qr_factorization<T, R, C> qr_decompose(const matrix<T, R, C> & p_matrix);
+
+// Compute the QR factorization of a matrix
+// Temporaries are taken from `p_workspace`
+template<class T>
+dynamic_qr_factorization<T> qr_decompose(const dynamic_matrix<T> & p_matrix, math_workspace & p_workspace = default_workspace());
+
+
+// Find x minimizing |A * x - b|
+// Uses a QR factorization of A
+template<class T, std::size_t R, std::size_t C>
+vector<T, C> least_squares_solve(const matrix<T, R, C> & p_matrix, const vector<T, R> & p_rhs);
+
+// Find x minimizing |A * x - b|
+// Uses a QR factorization of A, temporaries are taken from `p_workspace`
+template<class T>
+std::vector<T> least_squares_solve(const dynamic_matrix<T> & p_matrix, std::span<const T> p_rhs, math_workspace & p_workspace = default_workspace());
+
+};  // namespace math
+};  // namespace ft
+
+#include "matrix_qr.hpp"
@@ -0,0 +1,729 @@
+#pragma once
+
+// Implements the factorizations and solvers of matrix_qr.h
+
+// project headers
+#include "matrix_qr.h"
+
+// other headers
+#include "error/ft_assert.h"
+
+// standard headers
+#include <algorithm>
+#include <array>
+#include <cmath>
+
+namespace ft {
+namespace math {
+namespace details {
+namespace matrix_qr_ns {
+
+// Make the Householder reflector that zeroes column `p_col` below the diagonal
+// `p_data` is a row major matrix of `p_rows` rows with `p_stride` elements per row
+// The diagonal receives the new value and the reflector vector is stored below it
+//  with an implicit 1 on the diagonal
+// Returns the scale `tau` of the reflector I - tau * v * vt
+template<class T>
+T make_reflector(T * p_data, const std::size_t p_rows, const std::size_t p_stride, const std::size_t p_col)
+{
+    auto sigma = static_cast<T>(0);
+    for (std::size_t i = p_col + 1; i < p_rows; ++i)
+    {
+        const auto value = p_data[i * p_stride + p_col];
+        sigma += value * value;
+    }
+
+    // Nothing to eliminate
+    if (sigma == 0) {
+        return 0;
+    }
+
+    auto & diagonal = p_data[p_col * p_stride + p_col];
+    const auto alpha = diagonal;
+    const auto norm = static_cast<T>(std::sqrt(alpha * alpha + sigma));
+
+    // Pick the sign that avoids cancellation
+    const auto beta = (alpha <= 0) ? norm : -norm;
+    const auto scale = static_cast<T>(1) / (alpha - beta);
+
+    for (std::size_t i = p_col + 1; i < p_rows; ++i) {
+        p_data[i * p_stride + p_col] *= scale;
+    }
+    diagonal = beta;
+
+    return (beta - alpha) / beta;
+}
+
+
+// Apply the reflector stored in column `p_col` of `p_factors` to columns
+//  [p_begin, p_end) of `p_target`, from the left
+// `p_work` must hold at least `p_end - p_begin` elements
+template<class T>
+void apply_reflector(
+    const T * p_factors,
+    const std::size_t p_rows,
+    const std::size_t p_stride,
+    const std::size_t p_col,
+    const T p_tau,
+    T * p_target,
+    const std::size_t p_target_stride,
+    const std::size_t p_begin,
+    const std::size_t p_end,
+    T * p_work)
+{
+    if (p_tau == 0 || p_begin >= p_end) {
+        return;
+    }
+
+    const auto width = p_end - p_begin;
+
+    // w = tau * vt * target, accumulated row by row to keep accesses contiguous
+    {
+        const auto row = p_target + p_col * p_target_stride + p_begin;
+        for (std::size_t k = 0; k < width; ++k) {
+            p_work[k] = row[k];
+        }
+    }
+    for (std::size_t i = p_col + 1; i < p_rows; ++i)
+    {
+        const auto v = p_factors[i * p_stride + p_col];
+        const auto row = p_target + i * p_target_stride + p_begin;
+        for (std::size_t k = 0; k < width; ++k) {
+            p_work[k] += v * row[k];
+        }
+    }
+    for (std::size_t k = 0; k < width; ++k) {
+        p_work[k] *= p_tau;
+    }
+
+    // target -= v * w
+    {
+        const auto row = p_target + p_col * p_target_stride + p_begin;
+        for (std::size_t k = 0; k < width; ++k) {
+            row[k] -= p_work[k];
+        }
+    }
+    for (std::size_t i = p_col + 1; i < p_rows; ++i)
+    {
+        const auto v = p_factors[i * p_stride + p_col];
+        const auto row = p_target + i * p_target_stride + p_begin;
+        for (std::size_t k = 0; k < width; ++k) {
+            row[k] -= v * p_work[k];
+        }
+    }
+}
+
+
+// Factor columns [p_begin, p_end) one reflector at a time
+// Only the columns of the panel are updated
+// `p_work` must hold at least `p_end - p_begin` elements
+template<class T>
+void factor_panel(
+    T * p_data,
+    const std::size_t p_rows,
+    const std::size_t p_stride,
+    const std::size_t p_begin,
+    const std::size_t p_end,
+    T * p_tau,
+    T * p_work)
+{
+    for (std::size_t j = p_begin; j < p_end; ++j)
+    {
+        p_tau[j] = make_reflector(p_data, p_rows, p_stride, j);
+        apply_reflector(p_data, p_rows, p_stride, j, p_tau[j], p_data, p_stride, j + 1, p_end, p_work);
+    }
+}
+
+
+// Factor a row major matrix in-place using panels of `qr_block_size` columns
+// Each panel is factored unblocked, then its reflectors are combined into
+//  a block reflector I - V * Tm * Vt that updates the trailing columns at once
+// Temporaries are taken from `p_workspace`
+template<class T>
+void factor_blocked(T * p_data, const std::size_t p_rows, const std::size_t p_cols, T * p_tau, math_workspace & p_workspace)
+{
+    const auto stride = p_cols;
+    const auto block = std::min(qr_block_size, p_cols);
+
+    const math_workspace_scope scope(p_workspace);
+    const auto work = p_workspace.allocate<T>(p_cols);
+    const auto block_t = p_workspace.allocate<T>(block * block);
+    const auto block_w = p_workspace.allocate<T>(block * p_cols);
+
+    for (std::size_t j0 = 0; j0 < p_cols; j0 += block)
+    {
+        const auto j1 = std::min(j0 + block, p_cols);
+        const auto width = j1 - j0;
+
+        factor_panel(p_data, p_rows, stride, j0, j1, p_tau, work.data());
+
+        // Last panel, no trailing columns to update
+        if (j1 == p_cols) {
+            break;
+        }
+
+        // Access to reflector `p` of this panel at row `i`, with its implicit unit diagonal
+        const auto v = [&](const std::size_t p, const std::size_t i) -> T {
+            return (i == j0 + p) ? static_cast<T>(1) : p_data[i * stride + j0 + p];
+        };
+
+        // Build the upper triangular Tm of the block reflector
+        for (std::size_t i = 0; i < width; ++i)
+        {
+            const auto tau = p_tau[j0 + i];
+
+            // z = -tau * Vt * v_i
+            for (std::size_t q = 0; q < i; ++q)
+            {
+                auto dot = static_cast<T>(0);
+                for (std::size_t r = j0 + i; r < p_rows; ++r) {
+                    dot += v(q, r) * v(i, r);
+                }
+                work[q] = -tau * dot;
+            }
+
+            // Tm[0:i, i] = Tm[0:i, 0:i] * z
+            for (std::size_t r = 0; r < i; ++r)
+            {
+                auto sum = static_cast<T>(0);
+                for (std::size_t s = r; s < i; ++s) {
+                    sum += block_t[r * block + s] * work[s];
+                }
+                block_t[r * block + i] = sum;
+            }
+            block_t[i * block + i] = tau;
+        }
+
+        const auto trailing = p_cols - j1;
+
+        // W = Vt * A2
+        std::fill(block_w.begin(), block_w.begin() + width * trailing, static_cast<T>(0));
+        for (std::size_t i = j0; i < p_rows; ++i)
+        {
+            const auto row = p_data + i * stride + j1;
+            const auto last = std::min(width, i - j0 + 1);
+            for (std::size_t p = 0; p < last; ++p)
+            {
+                const auto factor = v(p, i);
+                const auto row_w = block_w.data() + p * trailing;
+                for (std::size_t k = 0; k < trailing; ++k) {
+                    row_w[k] += factor * row[k];
+                }
+            }
+        }
+
+        // W = Tmt * W, in-place from the bottom since Tmt is lower triangular
+        for (std::size_t p = width; p > 0; --p)
+        {
+            const auto row_p = block_w.data() + (p - 1) * trailing;
+            const auto diagonal = block_t[(p - 1) * block + (p - 1)];
+            for (std::size_t k = 0; k < trailing; ++k) {
+                row_p[k] *= diagonal;
+            }
+            for (std::size_t q = 0; q + 1 < p; ++q)
+            {
+                const auto factor = block_t[q * block + (p - 1)];
+                const auto row_q = block_w.data() + q * trailing;
+                for (std::size_t k = 0; k < trailing; ++k) {
+                    row_p[k] += factor * row_q[k];
+                }
+            }
+        }
+
+        // A2 -= V * W
+        for (std::size_t i = j0; i < p_rows; ++i)
+        {
+            const auto row = p_data + i * stride + j1;
+            const auto last = std::min(width, i - j0 + 1);
+            for (std::size_t p = 0; p < last; ++p)
+            {
+                const auto factor = v(p, i);
+                const auto row_w = block_w.data() + p * trailing;
+                for (std::size_t k = 0; k < trailing; ++k) {
+                    row[k] -= factor * row_w[k];
+                }
+            }
+        }
+    }
+}
+
+
+// Replace `p_vector` by Qt * p_vector
+template<class T>
+void apply_transposed_q(
+    const T * p_factors,
+    const T * p_tau,
+    const std::size_t p_rows,
+    const std::size_t p_cols,
+    T * p_vector)
+{
+    T work;
+    for (std::size_t j = 0; j < p_cols; ++j) {
+        apply_reflector(p_factors, p_rows, p_cols, j, p_tau[j], p_vector, 1, 0, 1, &work);
+    }
+}
+
+
+// Build the thin Q factor in a row major matrix of `p_rows` by `p_cols`
+// `p_work` must hold at least `p_cols` elements
+template<class T>
+void build_q(
+    const T * p_factors,
+    const T * p_tau,
+    const std::size_t p_rows,
+    const std::size_t p_cols,
+    T * p_q,
+    T * p_work)
+{
+    // Start from the first columns of the identity
+    for (std::size_t y = 0; y < p_rows; ++y) {
+        for (std::size_t x = 0; x < p_cols; ++x) {
+            p_q[y * p_cols + x] = (x == y) ? static_cast<T>(1) : static_cast<T>(0);
+        }
+    }
+
+    // Q = H0 * H1 * ... * Hn, applied from the last reflector
+    for (std::size_t j = p_cols; j > 0; --j) {
+        apply_reflector(p_factors, p_rows, p_cols, j - 1, p_tau[j - 1], p_q, p_cols, j - 1, p_cols, p_work);
+    }
+}
+
+
+// Copy the upper triangle of the first `p_cols` rows into a square matrix
+template<class T>
+void copy_r(const T * p_factors, const std::size_t p_cols, T * p_r)
+{
+    for (std::size_t y = 0; y < p_cols; ++y) {
+        for (std::size_t x = 0; x < p_cols; ++x) {
+            p_r[y * p_cols + x] = (x >= y) ? p_factors[y * p_cols + x] : static_cast<T>(0);
+        }
+    }
+}
+
+
+// Checks that no diagonal element of a row major triangle is zero
+template<class T>
+bool has_full_rank(const T * p_r, const std::size_t p_stride, const std::size_t p_size)
+{
+    for (std::size_t i = 0; i < p_size; ++i)
+    {
+        if (p_r[i * p_stride + i] == 0) {
+            return false;
+        }
+    }
+    return true;
+}
+
+
+// Solve R * x = y in-place where R is upper triangular
+// `p_r` has `p_stride` elements per row
+template<class T>
+void back_substitute(const T * p_r, const std::size_t p_stride, const std::size_t p_size, T * p_vector)
+{
+    for (std::size_t i = p_size; i > 0; --i)
+    {
+        const auto row = p_r + (i - 1) * p_stride;
+        auto sum = p_vector[i - 1];
+        for (std::size_t k = i; k < p_size; ++k) {
+            sum -= row[k] * p_vector[k];
+        }
+        p_vector[i - 1] = sum / row[i - 1];
+    }
+}
+
+
+// Fold the equation `p_row . x = p_rhs` into an upper triangular factor
+// `p_row` is used as scratch, on return `p_rhs` holds the part of the
+//  equation that can't be fitted
+template<class T>
+void fold_row(T * p_r, T * p_qtb, const std::size_t p_size, T * p_row, T & p_rhs)
+{
+    for (std::size_t j = 0; j < p_size; ++j)
+    {
+        const auto b = p_row[j];
+        if (b == 0) {
+            continue;
+        }
+
+        const auto row_r = p_r + j * p_size;
+        const auto a = row_r[j];
+
+        // Givens rotation zeroing p_row[j] against the diagonal
+        const auto h = static_cast<T>(std::sqrt(a * a + b * b));
+        const auto c = a / h;
+        const auto s = b / h;
+
+        row_r[j] = h;
+        for (std::size_t k = j + 1; k < p_size; ++k)
+        {
+            const auto t = row_r[k];
+            row_r[k] = c * t + s * p_row[k];
+            p_row[k] = c * p_row[k] - s * t;
+        }
+
+        const auto t = p_qtb[j];
+        p_qtb[j] = c * t + s * p_rhs;
+        p_rhs = c * p_rhs - s * t;
+    }
+}
+
+};  // namespace matrix_qr_ns
+};  // namespace details
+
+
+//////////////////////////////////////////////
+// qr_factorization
+
+// Factor a matrix
+template<class T, std::size_t R, std::size_t C>
+qr_factorization<T, R, C>::qr_factorization(const matrix<T, R, C> & p_matrix) :
+    m_factors(p_matrix)
+{
+    // Fixed sizes fit in a single panel
+    std::array<T, C> work;
+    details::matrix_qr_ns::factor_panel(m_factors.data(), R, C, 0, C, m_tau.data(), work.data());
+}
+
+
+// Returns false if a diagonal element of R is zero
+template<class T, std::size_t R, std::size_t C>
+bool qr_factorization<T, R, C>::is_full_rank() const
+{
+    return details::matrix_qr_ns::has_full_rank(m_factors.data(), C, C);
+}
+
+
+// Replace `p_vector` by Qt * p_vector
+template<class T, std::size_t R, std::size_t C>
+void qr_factorization<T, R, C>::apply_transposed_q(vector<T, R> & p_vector) const
+{
+    details::matrix_qr_ns::apply_transposed_q(m_factors.data(), m_tau.data(), R, C, p_vector.data());
+}
+
+
+// Find x minimizing |A * x - b|
+template<class T, std::size_t R, std::size_t C>
+vector<T, C> qr_factorization<T, R, C>::solve_least_squares(vector<T, R> p_rhs) const
+{
+    FT_ASSERT(is_full_rank());
+    apply_transposed_q(p_rhs);
+    details::matrix_qr_ns::back_substitute(m_factors.data(), C, C, p_rhs.data());
+    return vector<T, C>(p_rhs.data());
+}
+
+
+// Get the upper triangular factor R
+template<class T, std::size_t R, std::size_t C>
+matrix<T, C, C> qr_factorization<T, R, C>::get_r() const
+{
+    matrix<T, C, C> result;
+    details::matrix_qr_ns::copy_r(m_factors.data(), C, result.data());
+    return result;
+}
+
+
+// Get the thin orthonormal factor Q
+template<class T, std::size_t R, std::size_t C>
+matrix<T, R, C> qr_factorization<T, R, C>::get_q() const
+{
+    matrix<T, R, C> result;
+    std::array<T, C> work;
+    details::matrix_qr_ns::build_q(m_factors.data(), m_tau.data(), R, C, result.data(), work.data());
+    return result;
+}
+
+
+//////////////////////////////////////////////
+// dynamic_qr_factorization
+
+// Factor a matrix
+template<class T>
+dynamic_qr_factorization<T>::dynamic_qr_factorization(dynamic_matrix<T> p_matrix, math_workspace & p_workspace) :
+    m_factors(std::move(p_matrix)),
+    m_tau(m_factors.cols())
+{
+    FT_ASSERT(rows() >= cols());
+    details::matrix_qr_ns::factor_blocked(m_factors.data(), rows(), cols(), m_tau.data(), p_workspace);
+}
+
+
+// Get the number of rows of the factored matrix
+template<class T>
+std::size_t dynamic_qr_factorization<T>::rows() const
+{
+    return m_factors.rows();
+}
+
+
+// Get the number of columns of the factored matrix
+template<class T>
+std::size_t dynamic_qr_factorization<T>::cols() const
+{
+    return m_factors.cols();
+}
+
+
+// Returns false if a diagonal element of R is zero
+template<class T>
+bool dynamic_qr_factorization<T>::is_full_rank() const
+{
+    return details::matrix_qr_ns::has_full_rank(m_factors.data(), cols(), cols());
+}
+
+
+// Replace `p_vector` by Qt * p_vector
+template<class T>
+void dynamic_qr_factorization<T>::apply_transposed_q(std::span<T> p_vector) const
+{
+    FT_ASSERT(p_vector.size() == rows());
+    details::matrix_qr_ns::apply_transposed_q(m_factors.data(), m_tau.data(), rows(), cols(), p_vector.data());
+}
+
+
+// Find x minimizing |A * x - b|
+template<class T>
+std::vector<T> dynamic_qr_factorization<T>::solve_least_squares(std::span<const T> p_rhs) const
+{
+    FT_ASSERT(is_full_rank());
+    std::vector<T> result(p_rhs.begin(), p_rhs.end());
+    apply_transposed_q(result);
+    result.resize(cols());
+    details::matrix_qr_ns::back_substitute(m_factors.data(), cols(), cols(), result.data());
+    return result;
+}
+
+
+// Get the upper triangular factor R
+template<class T>
+dynamic_matrix<T> dynamic_qr_factorization<T>::get_r() const
+{
+    dynamic_matrix<T> result(cols(), cols());
+    details::matrix_qr_ns::copy_r(m_factors.data(), cols(), result.data());
+    return result;
+}
+
+
+// Get the thin orthonormal factor Q
+template<class T>
+dynamic_matrix<T> dynamic_qr_factorization<T>::get_q(math_workspace & p_workspace) const
+{
+    dynamic_matrix<T> result(rows(), cols());
+    const math_workspace_scope scope(p_workspace);
+    const auto work = p_workspace.allocate<T>(cols());
+    details::matrix_qr_ns::build_q(m_factors.data(), m_tau.data(), rows(), cols(), result.data(), work.data());
+    return result;
+}
+
+
+//////////////////////////////////////////////
+// streaming_least_squares
+
+// Start with no rows
+template<class T, std::size_t C>
+streaming_least_squares<T, C>::streaming_least_squares() :
+    m_residual2(0),
+    m_row_count(0)
+{
+    m_r.fill(0);
+    m_qtb = make_zero_vector<T, C>();
+}
+
+
+// Fold in the equation `p_row . x = p_rhs`
+template<class T, std::size_t C>
+void streaming_least_squares<T, C>::add_row(vector<T, C> p_row, T p_rhs, const T p_weight)
+{
+    if (p_weight != 1)
+    {
+        const auto scale = static_cast<T>(std::sqrt(p_weight));
+        p_row *= scale;
+        p_rhs *= scale;
+    }
+
+    details::matrix_qr_ns::fold_row(m_r.data(), m_qtb.data(), C, p_row.data(), p_rhs);
+    m_residual2 += p_rhs * p_rhs;
+    m_row_count += 1;
+}
+
+
+// Fold in all the rows of another solver
+template<class T, std::size_t C>
+void streaming_least_squares<T, C>::merge(const streaming_least_squares & p_other)
+{
+    // The other factor's rows are equations with the same solution
+    for (std::size_t j = 0; j < C; ++j)
+    {
+        auto row = vector<T, C>(p_other.m_r[j]);
+        auto rhs = p_other.m_qtb[j];
+        details::matrix_qr_ns::fold_row(m_r.data(), m_qtb.data(), C, row.data(), rhs);
+        m_residual2 += rhs * rhs;
+    }
+
+    m_residual2 += p_other.m_residual2;
+    m_row_count += p_other.m_row_count;
+}
+
+
+// Get the number of rows folded in so far
+template<class T, std::size_t C>
+std::size_t streaming_least_squares<T, C>::row_count() const
+{
+    return m_row_count;
+}
+
+
+// Returns false if the rows seen so far do not determine the solution
+template<class T, std::size_t C>
+bool streaming_least_squares<T, C>::is_full_rank() const
+{
+    return details::matrix_qr_ns::has_full_rank(m_r.data(), C, C);
+}
+
+
+// Find x minimizing the (weighted) sum of squared residuals
+template<class T, std::size_t C>
+vector<T, C> streaming_least_squares<T, C>::solve() const
+{
+    FT_ASSERT(is_full_rank());
+    auto result = m_qtb;
+    details::matrix_qr_ns::back_substitute(m_r.data(), C, C, result.data());
+    return result;
+}
+
+
+// Get the (weighted) sum of squared residuals of the solution
+template<class T, std::size_t C>
+T streaming_least_squares<T, C>::residual_norm2() const
+{
+    return m_residual2;
+}
+
+
+//////////////////////////////////////////////
+// dynamic_streaming_least_squares
+
+// Start with no rows for a problem of `p_cols` unknowns
+template<class T>
+dynamic_streaming_least_squares<T>::dynamic_streaming_least_squares(const std::size_t p_cols) :
+    m_r(p_cols, p_cols),
+    m_qtb(p_cols),
+    m_row(p_cols),
+    m_residual2(0),
+    m_row_count(0)
+{ }
+
+
+// Fold in the equation `p_row . x = p_rhs`
+template<class T>
+void dynamic_streaming_least_squares<T>::add_row(std::span<const T> p_row, T p_rhs, const T p_weight)
+{
+    FT_ASSERT(p_row.size() == cols());
+
+    const auto scale = static_cast<T>(std::sqrt(p_weight));
+    for (std::size_t i = 0; i < cols(); ++i) {
+        m_row[i] = p_row[i] * scale;
+    }
+    p_rhs *= scale;
+
+    details::matrix_qr_ns::fold_row(m_r.data(), m_qtb.data(), cols(), m_row.data(), p_rhs);
+    m_residual2 += p_rhs * p_rhs;
+    m_row_count += 1;
+}
+
+
+// Fold in all the rows of another solver with the same number of unknowns
+template<class T>
+void dynamic_streaming_least_squares<T>::merge(const dynamic_streaming_least_squares & p_other)
+{
+    FT_ASSERT(p_other.cols() == cols());
+
+    // The other factor's rows are equations with the same solution
+    for (std::size_t j = 0; j < cols(); ++j)
+    {
+        std::copy(p_other.m_r[j], p_other.m_r[j] + cols(), m_row.begin());
+        auto rhs = p_other.m_qtb[j];
+        details::matrix_qr_ns::fold_row(m_r.data(), m_qtb.data(), cols(), m_row.data(), rhs);
+        m_residual2 += rhs * rhs;
+    }
+
+    m_residual2 += p_other.m_residual2;
+    m_row_count += p_other.m_row_count;
+}
+
+
+// Get the number of unknowns
+template<class T>
+std::size_t dynamic_streaming_least_squares<T>::cols() const
+{
+    return m_r.cols();
+}
+
+
+// Get the number of rows folded in so far
+template<class T>
+std::size_t dynamic_streaming_least_squares<T>::row_count() const
+{
+    return m_row_count;
+}
+
+
+// Returns false if the rows seen so far do not determine the solution
+template<class T>
+bool dynamic_streaming_least_squares<T>::is_full_rank() const
+{
+    return details::matrix_qr_ns::has_full_rank(m_r.data(), cols(), cols());
+}
+
+
+// Find x minimizing the (weighted) sum of squared residuals
+template<class T>
+std::vector<T> dynamic_streaming_least_squares<T>::solve() const
+{
+    FT_ASSERT(is_full_rank());
+    auto result = m_qtb;
+    details::matrix_qr_ns::back_substitute(m_r.data(), cols(), cols(), result.data());
+    return result;
+}
+
+
+// Get the (weighted) sum of squared residuals of the solution
+template<class T>
+T dynamic_streaming_least_squares<T>::residual_norm2() const
+{
+    return m_residual2;
+}
+
+};  // namespace math
+};  // namespace ft
+
+
+// Compute the QR factorization of a matrix
+template<class T, std::size_t R, std::size_t C>
+ft::math::qr_factorization<T, R, C> ft::math::qr_decompose(const matrix<T, R, C> & p_matrix)
+{
+    return qr_factorization<T, R, C>(p_matrix);
+}
+
+
+// Compute the QR factorization of a matrix
+template<class T>
+ft::math::dynamic_qr_factorization<T> ft::math::qr_decompose(const dynamic_matrix<T> & p_matrix, math_workspace & p_workspace)
+{
+    return dynamic_qr_factorization<T>(p_matrix, p_workspace);
+}
+
+
+// Find x minimizing |A * x - b|
+template<class T, std::size_t R, std::size_t C>
+ft::math::vector<T, C> ft::math::least_squares_solve(const matrix<T, R, C> & p_matrix, const vector<T, R> & p_rhs)
+{
+    return qr_decompose(p_matrix).solve_least_squares(p_rhs);
+}
+
+
+// Find x minimizing |A * x - b|
+template<class T>
+std::vector<T> ft::math::least_squares_solve(const dynamic_matrix<T> & p_matrix, std::span<const T> p_rhs, math_workspace & p_workspace)
+{
+    return qr_decompose(p_matrix, p_workspace).solve_least_squares(p_rhs);
+}
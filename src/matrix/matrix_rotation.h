@@ -0,0 +1,92 @@
+#pragma once
+
+// Exponential and logarithm maps of 3x3 rotation matrices, and
+//  re-orthonormalization of rotation matrices that drifted
+// A rotation vector is the rotation axis scaled by the angle in radians
+//
+// The exponential is the Rodrigues formula R = I + a * K + b * K^2, where K
+//  is the cross product matrix of the rotation vector, a = sin(x) / x and
+//  b = (1 - cos(x)) / x^2 for an angle x
+// The logarithm goes through the unit quaternion of the matrix, which is
+//  stable for every angle up to pi, unlike acos((trace - 1) / 2)
+// Small angles use series for a, b and atan(x) / x, which are accurate where
+//  the closed forms divide by a vanishing angle, and skip the trigonometric
+//  functions in the single matrix versions
+//
+// Integrating many small increments leaves rotation matrices slightly
+//  skewed and scaled, two corrections are available:
+//  Gram-Schmidt makes the first column unit, the second orthogonal to it and
+//  the third their cross product, exact but biased towards the first column
+//  The first order correction R' = R * (3 * I - Rt * R) / 2 needs no square
+//  root and treats the columns alike, it squares the deviation from
+//  orthonormality, so calling it every step keeps the drift at rounding level
+//
+// The batch functions call branch free kernels in one loop over structures
+//  of arrays, and use the approximations of numeric/elementary_functions.h
+//  so the loops can be vectorized
+
+// project headers
+#include "matrix.h"
+#include "numeric/elementary_functions.h"
+#include "vector/vector.h"
+#include "vector/vector_soa.h"
+
+namespace ft {
+namespace math {
+
+// Make the rotation matrix of a rotation vector
+template<class T>
+matrix<T, 3, 3> rotation_exp(const vector<T, 3> & p_rotation);
+
+// Get the rotation vector of a rotation matrix
+// The angle is in [0, pi]
+// Tolerates matrices that drifted slightly from a rotation
+template<class T>
+vector<T, 3> rotation_log(const matrix<T, 3, 3> & p_matrix);
+
+
+// Re-orthonormalize a rotation matrix with Gram-Schmidt on its columns
+// The result is a rotation if the matrix is close to one
+template<class T>
+matrix<T, 3, 3> orthonormalized(const matrix<T, 3, 3> & p_matrix);
+
+// Reduce the deviation of a rotation matrix from orthonormality with a first order step
+// The deviation must be small, |Rt * R - I| well below 1
+template<class T>
+matrix<T, 3, 3> orthonormalized_first_order(const matrix<T, 3, 3> & p_matrix);
+
+
+// Make the rotation matrices of an array of rotation vectors
+// `p_results` must be at least as large as `p_rotations`
+template<approximation_tier A = approximation_tier::precise, class T>
+void rotation_exp_batch(
+    const vector_soa_span<const T, 3> & p_rotations,
+    const matrix_soa_span<T, 3, 3> & p_results);
+
+// Get the rotation vectors of an array of rotation matrices
+// `p_results` must be at least as large as `p_matrices`
+template<approximation_tier A = approximation_tier::precise, class T>
+void rotation_log_batch(
+    const matrix_soa_span<const T, 3, 3> & p_matrices,
+    const vector_soa_span<T, 3> & p_results);
+
+
+// Re-orthonormalize an array of rotation matrices with Gram-Schmidt
+// `p_results` must be at least as large as `p_matrices` and may alias it
+template<class T>
+void orthonormalize_batch(
+    const matrix_soa_span<const T, 3, 3> & p_matrices,
+    const matrix_soa_span<T, 3, 3> & p_results);
+
+// Reduce the deviation of an array of rotation matrices from orthonormality
+//  with first order steps
+// `p_results` must be at least as large as `p_matrices` and may alias it
+template<class T>
+void orthonormalize_first_order_batch(
+    const matrix_soa_span<const T, 3, 3> & p_matrices,
+    const matrix_soa_span<T, 3, 3> & p_results);
+
+};  // namespace math
+};  // namespace ft
+
+#include "matrix_rotation.hpp"
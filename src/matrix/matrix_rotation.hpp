@@ -0,0 +1,313 @@
+#pragma once
+
+// Implements the rotation maps of matrix_rotation.h
+
+// project headers
+#include "matrix_rotation.h"
+#include "quaternion/quaternion_rotation.h"
+#include "vector/vector_functions.h"
+
+// other headers
+#include "error/ft_assert.h"
+
+// standard headers
+#include <cmath>
+
+namespace ft {
+namespace math {
+namespace details {
+namespace matrix_rotation_ns {
+
+// Squared angle below which the series are used
+// The first terms left out are below x^6 / 5040 for the Rodrigues
+//  coefficients and x^8 / 9 for atan(x) / x, under the rounding error of T
+template<class T>
+inline constexpr T series_angle2 = (sizeof(T) <= sizeof(float)) ? static_cast<T>(1e-2) : static_cast<T>(1e-6);
+
+
+// Coefficients a = sin(x) / x and b = (1 - cos(x)) / x^2 of the Rodrigues formula
+// `p_sine` and `p_cosine` are only used when the angle is above the series threshold
+template<class T>
+inline void rodrigues_coefficients(const T p_angle2, const T p_angle, const T p_sine, const T p_cosine, T & p_a, T & p_b)
+{
+    const auto small = p_angle2 < series_angle2<T>;
+    const auto angle = small ? static_cast<T>(1) : p_angle;
+    const auto angle2 = small ? static_cast<T>(1) : p_angle2;
+
+    const auto series_a = 1 - p_angle2 / 6 * (1 - p_angle2 / 20);
+    const auto series_b = static_cast<T>(0.5) - p_angle2 / 24 * (1 - p_angle2 / 30);
+    p_a = small ? series_a : p_sine / angle;
+    p_b = small ? series_b : (1 - p_cosine) / angle2;
+}
+
+
+// Make the rotation matrix I + a * K + b * K^2 of a rotation vector
+template<class T>
+inline matrix<T, 3, 3> rodrigues_matrix(const vector<T, 3> & p_rotation, const T p_a, const T p_b)
+{
+    const auto [x, y, z] = p_rotation;
+
+    const auto xx = x * x;
+    const auto yy = y * y;
+    const auto zz = z * z;
+    const auto xy = p_b * x * y;
+    const auto xz = p_b * x * z;
+    const auto yz = p_b * y * z;
+    const auto ax = p_a * x;
+    const auto ay = p_a * y;
+    const auto az = p_a * z;
+
+    matrix<T, 3, 3> result;
+    result[0][0] = 1 - p_b * (yy + zz);
+    result[0][1] = xy - az;
+    result[0][2] = xz + ay;
+    result[1][0] = xy + az;
+    result[1][1] = 1 - p_b * (xx + zz);
+    result[1][2] = yz - ax;
+    result[2][0] = xz - ay;
+    result[2][1] = yz + ax;
+    result[2][2] = 1 - p_b * (xx + yy);
+    return result;
+}
+
+
+// Get the rotation vector of the (r, i, j, k) components of a quaternion
+//  with a non negative real part, the quaternion does not need to be unit
+// `p_length2` is the squared norm of the imaginary part and `p_half_angle`
+//  is atan2(|v|, r), only used when the angle is above the series threshold
+template<class T>
+inline vector<T, 3> components_to_rotation(const vector<T, 4> & p_q, const T p_length2, const T p_half_angle)
+{
+    // The rotation vector is 2 * atan(x) / x * v / r with x = |v| / r
+    const auto real2 = p_q[0] * p_q[0];
+    const auto small = p_length2 < series_angle2<T> * real2;
+    const auto real = small ? p_q[0] : static_cast<T>(1);
+    const auto x2 = p_length2 / (real * real);
+    const auto length = small ? static_cast<T>(1) : static_cast<T>(std::sqrt(p_length2));
+
+    const auto series = 2 / real * (1 - x2 / 3 * (1 - x2 * 3 / 5 * (1 - x2 * 5 / 7)));
+    const auto scale = small ? series : 2 * p_half_angle / length;
+    return { p_q[1] * scale, p_q[2] * scale, p_q[3] * scale };
+}
+
+
+// Re-orthonormalize the columns of a matrix with Gram-Schmidt
+// Written out so batches keep every element in registers
+template<class T>
+inline matrix<T, 3, 3> gram_schmidt(const matrix<T, 3, 3> & p_m)
+{
+    const auto x_scale = 1 / static_cast<T>(std::sqrt(p_m[0][0] * p_m[0][0] + p_m[1][0] * p_m[1][0] + p_m[2][0] * p_m[2][0]));
+    const auto x0 = p_m[0][0] * x_scale;
+    const auto x1 = p_m[1][0] * x_scale;
+    const auto x2 = p_m[2][0] * x_scale;
+
+    // Remove the part of the second column along the first
+    const auto dot = x0 * p_m[0][1] + x1 * p_m[1][1] + x2 * p_m[2][1];
+    const auto u0 = p_m[0][1] - x0 * dot;
+    const auto u1 = p_m[1][1] - x1 * dot;
+    const auto u2 = p_m[2][1] - x2 * dot;
+
+    const auto y_scale = 1 / static_cast<T>(std::sqrt(u0 * u0 + u1 * u1 + u2 * u2));
+    const auto y0 = u0 * y_scale;
+    const auto y1 = u1 * y_scale;
+    const auto y2 = u2 * y_scale;
+
+    matrix<T, 3, 3> result;
+    result[0][0] = x0;
+    result[1][0] = x1;
+    result[2][0] = x2;
+    result[0][1] = y0;
+    result[1][1] = y1;
+    result[2][1] = y2;
+
+    // The third column is the cross product of the first two
+    result[0][2] = x1 * y2 - x2 * y1;
+    result[1][2] = x2 * y0 - x0 * y2;
+    result[2][2] = x0 * y1 - x1 * y0;
+    return result;
+}
+
+
+// First order step towards the closest orthonormal matrix
+// R' = R * (3 * I - Rt * R) / 2
+// Written out so batches keep every element in registers
+template<class T>
+inline matrix<T, 3, 3> first_order_orthonormalization(const matrix<T, 3, 3> & p_m)
+{
+    const auto m00 = p_m[0][0];
+    const auto m01 = p_m[0][1];
+    const auto m02 = p_m[0][2];
+    const auto m10 = p_m[1][0];
+    const auto m11 = p_m[1][1];
+    const auto m12 = p_m[1][2];
+    const auto m20 = p_m[2][0];
+    const auto m21 = p_m[2][1];
+    const auto m22 = p_m[2][2];
+
+    // Symmetric correction (3 * I - Rt * R) / 2, from the dot products of the columns
+    const auto half = static_cast<T>(0.5);
+    const auto three_halves = static_cast<T>(1.5);
+    const auto c00 = three_halves - (m00 * m00 + m10 * m10 + m20 * m20) * half;
+    const auto c11 = three_halves - (m01 * m01 + m11 * m11 + m21 * m21) * half;
+    const auto c22 = three_halves - (m02 * m02 + m12 * m12 + m22 * m22) * half;
+    const auto c01 = -(m00 * m01 + m10 * m11 + m20 * m21) * half;
+    const auto c02 = -(m00 * m02 + m10 * m12 + m20 * m22) * half;
+    const auto c12 = -(m01 * m02 + m11 * m12 + m21 * m22) * half;
+
+    matrix<T, 3, 3> result;
+    result[0][0] = m00 * c00 + m01 * c01 + m02 * c02;
+    result[0][1] = m00 * c01 + m01 * c11 + m02 * c12;
+    result[0][2] = m00 * c02 + m01 * c12 + m02 * c22;
+    result[1][0] = m10 * c00 + m11 * c01 + m12 * c02;
+    result[1][1] = m10 * c01 + m11 * c11 + m12 * c12;
+    result[1][2] = m10 * c02 + m11 * c12 + m12 * c22;
+    result[2][0] = m20 * c00 + m21 * c01 + m22 * c02;
+    result[2][1] = m20 * c01 + m21 * c11 + m22 * c12;
+    result[2][2] = m20 * c02 + m21 * c12 + m22 * c22;
+    return result;
+}
+
+};  // namespace matrix_rotation_ns
+};  // namespace details
+};  // namespace math
+};  // namespace ft
+
+
+// Make the rotation matrix of a rotation vector
+template<class T>
+ft::math::matrix<T, 3, 3> ft::math::rotation_exp(const vector<T, 3> & p_rotation)
+{
+    using namespace details::matrix_rotation_ns;
+
+    const auto angle2 = length2(p_rotation);
+
+    // Small angles only need the series
+    auto angle = static_cast<T>(0);
+    auto sine = static_cast<T>(0);
+    auto cosine = static_cast<T>(1);
+    if (angle2 >= series_angle2<T>)
+    {
+        angle = static_cast<T>(std::sqrt(angle2));
+        sine = static_cast<T>(std::sin(angle));
+        cosine = static_cast<T>(std::cos(angle));
+    }
+
+    T a;
+    T b;
+    rodrigues_coefficients(angle2, angle, sine, cosine, a, b);
+    return rodrigues_matrix(p_rotation, a, b);
+}
+
+
+// Get the rotation vector of a rotation matrix
+template<class T>
+ft::math::vector<T, 3> ft::math::rotation_log(const matrix<T, 3, 3> & p_matrix)
+{
+    using namespace details::matrix_rotation_ns;
+
+    const auto q = details::quaternion_rotation_ns::matrix_to_components(p_matrix);
+    const auto length2 = q[1] * q[1] + q[2] * q[2] + q[3] * q[3];
+
+    // Small angles only need the series
+    auto half_angle = static_cast<T>(0);
+    if (length2 >= series_angle2<T> * q[0] * q[0]) {
+        half_angle = static_cast<T>(std::atan2(std::sqrt(length2), q[0]));
+    }
+    return components_to_rotation(q, length2, half_angle);
+}
+
+
+// Re-orthonormalize a rotation matrix with Gram-Schmidt on its columns
+template<class T>
+ft::math::matrix<T, 3, 3> ft::math::orthonormalized(const matrix<T, 3, 3> & p_matrix)
+{
+    return details::matrix_rotation_ns::gram_schmidt(p_matrix);
+}
+
+
+// Reduce the deviation of a rotation matrix from orthonormality with a first order step
+template<class T>
+ft::math::matrix<T, 3, 3> ft::math::orthonormalized_first_order(const matrix<T, 3, 3> & p_matrix)
+{
+    return details::matrix_rotation_ns::first_order_orthonormalization(p_matrix);
+}
+
+
+// Make the rotation matrices of an array of rotation vectors
+template<ft::math::approximation_tier A, class T>
+void ft::math::rotation_exp_batch(
+    const vector_soa_span<const T, 3> & p_rotations,
+    const matrix_soa_span<T, 3, 3> & p_results)
+{
+    using namespace details::matrix_rotation_ns;
+
+    FT_ASSERT(p_results.size() >= p_rotations.size());
+
+    map_soa<vector<T, 3>, matrix<T, 3, 3>>(p_rotations, p_results, [](const vector<T, 3> & p_rotation)
+    {
+        const auto angle2 = p_rotation[0] * p_rotation[0] + p_rotation[1] * p_rotation[1] + p_rotation[2] * p_rotation[2];
+        const auto angle = static_cast<T>(std::sqrt(angle2));
+
+        T sine;
+        T cosine;
+        approx_sincos<A>(angle, sine, cosine);
+
+        T a;
+        T b;
+        rodrigues_coefficients(angle2, angle, sine, cosine, a, b);
+        return rodrigues_matrix(p_rotation, a, b);
+    });
+}
+
+
+// Get the rotation vectors of an array of rotation matrices
+template<ft::math::approximation_tier A, class T>
+void ft::math::rotation_log_batch(
+    const matrix_soa_span<const T, 3, 3> & p_matrices,
+    const vector_soa_span<T, 3> & p_results)
+{
+    using namespace details::matrix_rotation_ns;
+
+    FT_ASSERT(p_results.size() >= p_matrices.size());
+
+    map_soa<matrix<T, 3, 3>, vector<T, 3>>(p_matrices, p_results, [](const matrix<T, 3, 3> & p_matrix)
+    {
+        const auto q = details::quaternion_rotation_ns::matrix_to_components(p_matrix);
+        const auto length2 = q[1] * q[1] + q[2] * q[2] + q[3] * q[3];
+        const auto half_angle = approx_atan2<A>(static_cast<T>(std::sqrt(length2)), q[0]);
+        return components_to_rotation(q, length2, half_angle);
+    });
+}
+
+
+// Re-orthonormalize an array of rotation matrices with Gram-Schmidt
+template<class T>
+void ft::math::orthonormalize_batch(
+    const matrix_soa_span<const T, 3, 3> & p_matrices,
+    const matrix_soa_span<T, 3, 3> & p_results)
+{
+    using namespace details::matrix_rotation_ns;
+
+    FT_ASSERT(p_results.size() >= p_matrices.size());
+
+    map_soa<matrix<T, 3, 3>, matrix<T, 3, 3>>(p_matrices, p_results, [](const matrix<T, 3, 3> & p_matrix) {
+        return gram_schmidt(p_matrix);
+    });
+}
+
+
+// Reduce the deviation of an array of rotation matrices from orthonormality
+//  with first order steps
+template<class T>
+void ft::math::orthonormalize_first_order_batch(
+    const matrix_soa_span<const T, 3, 3> & p_matrices,
+    const matrix_soa_span<T, 3, 3> & p_results)
+{
+    using namespace details::matrix_rotation_ns;
+
+    FT_ASSERT(p_results.size() >= p_matrices.size());
+
+    map_soa<matrix<T, 3, 3>, matrix<T, 3, 3>>(p_matrices, p_results, [](const matrix<T, 3, 3> & p_matrix) {
+        return first_order_orthonormalization(p_matrix);
+    });
+}
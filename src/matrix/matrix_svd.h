@@ -0,0 +1,97 @@
+#pragma once
+
+// Singular value and polar decompositions of 3x3 matrices
+// A = U * diag(sigma) * Vt where U and V are rotations
+// Singular values are sorted in decreasing order, the last one is negative
+//  when A is a reflection (its determinant is negative)
+//
+// Uses a fixed number of Jacobi sweeps on At * A, sorts the columns of A * V
+//  by decreasing norm and finishes with a Givens QR, in the manner of the
+//  minimal branching 3x3 SVD used for corotational FEM and shape matching
+// Every step uses selects instead of branches, so loops over many matrices
+//  (in particular the structure of arrays batches) can be vectorized
+
+// project headers
+#include "matrix.h"
+#include "quaternion/quaternion.h"
+#include "vector/vector.h"
+#include "vector/vector_soa.h"
+
+namespace ft {
+namespace math {
+
+// Result of a 3x3 singular value decomposition with matrix rotations
+template<class T>
+struct svd_3x3_decomposition
+{
+    matrix<T, 3, 3> u;
+    vector<T, 3> sigma;
+    matrix<T, 3, 3> v;
+};
+
+// Result of a 3x3 singular value decomposition with quaternion rotations
+template<class T>
+struct svd_3x3_quaternion_decomposition
+{
+    quaternion<T> u;
+    vector<T, 3> sigma;
+    quaternion<T> v;
+};
+
+// Result of a 3x3 polar decomposition A = rotation * stretch
+template<class T>
+struct polar_3x3_decomposition
+{
+    // Always a proper rotation
+    matrix<T, 3, 3> rotation;
+
+    // Symmetric, has a negative eigenvalue when A is a reflection
+    matrix<T, 3, 3> stretch;
+};
+
+
+// Compute the singular value decomposition of a 3x3 matrix
+template<class T>
+svd_3x3_decomposition<T> svd_decompose(const matrix<T, 3, 3> & p_matrix);
+
+// Compute the singular value decomposition of a 3x3 matrix
+// U and V are returned as unit quaternions
+template<class T>
+svd_3x3_quaternion_decomposition<T> svd_decompose_quaternion(const matrix<T, 3, 3> & p_matrix);
+
+// Compute the polar decomposition of a 3x3 matrix
+template<class T>
+polar_3x3_decomposition<T> polar_decompose(const matrix<T, 3, 3> & p_matrix);
+
+
+// Compute the singular value decomposition of an array of 3x3 matrices
+// All the views must be at least as large as `p_matrices`
+template<class T>
+void svd_decompose_batch(
+    const matrix_soa_span<const T, 3, 3> & p_matrices,
+    const matrix_soa_span<T, 3, 3> & p_u,
+    const vector_soa_span<T, 3> & p_sigma,
+    const matrix_soa_span<T, 3, 3> & p_v);
+
+// Compute the singular value decomposition of an array of 3x3 matrices
+// U and V are written as (r, i, j, k) unit quaternion components
+// All the views must be at least as large as `p_matrices`
+template<class T>
+void svd_decompose_quaternion_batch(
+    const matrix_soa_span<const T, 3, 3> & p_matrices,
+    const vector_soa_span<T, 4> & p_u,
+    const vector_soa_span<T, 3> & p_sigma,
+    const vector_soa_span<T, 4> & p_v);
+
+// Compute the polar decomposition of an array of 3x3 matrices
+// All the views must be at least as large as `p_matrices`
+template<class T>
+void polar_decompose_batch(
+    const matrix_soa_span<const T, 3, 3> & p_matrices,
+    const matrix_soa_span<T, 3, 3> & p_rotation,
+    const matrix_soa_span<T, 3, 3> & p_stretch);
+
+};  // namespace math
+};  // namespace ft
+
+#include "matrix_svd.hpp"
@@ -0,0 +1,403 @@
+#pragma once
+
+// Implements the decompositions of matrix_svd.h
+
+// project headers
+#include "matrix_eigen.h"
+#include "matrix_svd.h"
+#include "matrix_unroll.h"
+#include "matrix_utility.h"
+#include "quaternion/quaternion_rotation.h"
+
+// other headers
+#include "error/ft_assert.h"
+
+// standard headers
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <limits>
+#include <type_traits>
+
+namespace ft {
+namespace math {
+namespace details {
+namespace matrix_svd_ns {
+
+// The decompositions work on row major 3x3 matrices given by pointers
+// Every function is written out on scalars with compile time indices, so
+//  that once inlined no loop or branch is left and batches vectorize them
+
+// Swap columns `I` and `J` of `p_b` and `p_v` if column `J` of `p_b` is longer
+// The swapped column is negated to keep V a rotation
+template<std::size_t I, std::size_t J, class T>
+inline void sort_columns(T * p_b, T * p_v, T * p_norms2)
+{
+    const auto swap = p_norms2[I] < p_norms2[J];
+
+    for_range(zero_index, std::integral_constant<std::size_t, 3>{}, [&](auto r)
+    {
+        const auto b_i = p_b[r * 3 + I];
+        const auto b_j = p_b[r * 3 + J];
+        p_b[r * 3 + I] = swap ? b_j : b_i;
+        p_b[r * 3 + J] = swap ? -b_i : b_j;
+
+        const auto v_i = p_v[r * 3 + I];
+        const auto v_j = p_v[r * 3 + J];
+        p_v[r * 3 + I] = swap ? v_j : v_i;
+        p_v[r * 3 + J] = swap ? -v_i : v_j;
+    });
+
+    const auto n_i = p_norms2[I];
+    const auto n_j = p_norms2[J];
+    p_norms2[I] = swap ? n_j : n_i;
+    p_norms2[J] = swap ? n_i : n_j;
+}
+
+
+// Zero the element [`J`][`C`] of `p_b` by rotating its rows `I` and `J`
+// The inverse rotation is accumulated in the columns of `p_u`
+template<std::size_t I, std::size_t J, std::size_t C, class T>
+inline void givens_eliminate(T * p_b, T * p_u)
+{
+    const auto a = p_b[I * 3 + C];
+    const auto b = p_b[J * 3 + C];
+    const auto length2 = a * a + b * b;
+
+    // Identity rotation if there is nothing to rotate
+    const auto valid = length2 > std::numeric_limits<T>::min();
+    const auto inverse = static_cast<T>(1 / std::sqrt(valid ? length2 : static_cast<T>(1)));
+    const auto c = valid ? a * inverse : static_cast<T>(1);
+    const auto s = valid ? b * inverse : static_cast<T>(0);
+
+    for_range(zero_index, std::integral_constant<std::size_t, 3>{}, [&](auto k)
+    {
+        const auto b_i = p_b[I * 3 + k];
+        const auto b_j = p_b[J * 3 + k];
+        p_b[I * 3 + k] = c * b_i + s * b_j;
+        p_b[J * 3 + k] = c * b_j - s * b_i;
+
+        const auto u_i = p_u[k * 3 + I];
+        const auto u_j = p_u[k * 3 + J];
+        p_u[k * 3 + I] = c * u_i + s * u_j;
+        p_u[k * 3 + J] = c * u_j - s * u_i;
+    });
+}
+
+
+// Set a 3x3 matrix to identity
+template<class T>
+inline void set_identity(T * p_data)
+{
+    for_range(zero_index, std::integral_constant<std::size_t, 9>{}, [&](auto e) {
+        p_data[e] = (e % 4 == 0) ? static_cast<T>(1) : static_cast<T>(0);
+    });
+}
+
+
+// Compute the right singular vectors of `p_a`, unsorted
+// They are the eigenvectors of At * A
+template<class T>
+inline void right_vectors(const T * p_a, T * p_v)
+{
+    const auto column_dot = [&](auto p_x, auto p_y) {
+        return p_a[p_x] * p_a[p_y] + p_a[3 + p_x] * p_a[3 + p_y] + p_a[6 + p_x] * p_a[6 + p_y];
+    };
+    auto ata_00 = column_dot(0, 0);
+    auto ata_11 = column_dot(1, 1);
+    auto ata_22 = column_dot(2, 2);
+    auto ata_01 = column_dot(0, 1);
+    auto ata_02 = column_dot(0, 2);
+    auto ata_12 = column_dot(1, 2);
+
+    set_identity(p_v);
+    constexpr auto sweeps = std::integral_constant<std::size_t, symmetric_eigen_3x3_sweeps<T>>{};
+    for_range(zero_index, sweeps, [&](auto)
+    {
+        using matrix_eigen_ns::jacobi_rotation_3x3;
+        jacobi_rotation_3x3<true, 0, 1>(ata_00, ata_11, ata_01, ata_02, ata_12, p_v);
+        jacobi_rotation_3x3<true, 0, 2>(ata_00, ata_22, ata_02, ata_01, ata_12, p_v);
+        jacobi_rotation_3x3<true, 1, 2>(ata_11, ata_22, ata_12, ata_01, ata_02, p_v);
+    });
+}
+
+
+// Sort the unsorted right singular vectors `p_v` of `p_a` by decreasing singular value
+// `p_b` gets A * V, whose columns are the left singular vectors scaled by the singular values
+template<class T>
+inline void sort_vectors(const T * p_a, T * p_v, T * p_b)
+{
+    T norms2[3];
+    for_range(zero_index, std::integral_constant<std::size_t, 3>{}, [&](auto x)
+    {
+        for_range(zero_index, std::integral_constant<std::size_t, 3>{}, [&](auto y) {
+            p_b[y * 3 + x] = p_a[y * 3] * p_v[x] + p_a[y * 3 + 1] * p_v[3 + x] + p_a[y * 3 + 2] * p_v[6 + x];
+        });
+        norms2[x] = p_b[x] * p_b[x] + p_b[3 + x] * p_b[3 + x] + p_b[6 + x] * p_b[6 + x];
+    });
+    sort_columns<0, 1>(p_b, p_v, norms2);
+    sort_columns<1, 2>(p_b, p_v, norms2);
+    sort_columns<0, 1>(p_b, p_v, norms2);
+}
+
+
+// Compute the left singular vectors and the singular values from the sorted A * V
+// B = U * R, R is diagonal up to rounding since the columns of B are orthogonal
+// `p_b` is overwritten
+template<class T>
+inline void left_vectors(T * p_b, T * p_u, T * p_sigma)
+{
+    set_identity(p_u);
+    givens_eliminate<0, 1, 0>(p_b, p_u);
+    givens_eliminate<0, 2, 0>(p_b, p_u);
+    givens_eliminate<1, 2, 1>(p_b, p_u);
+
+    p_sigma[0] = p_b[0];
+    p_sigma[1] = p_b[4];
+    p_sigma[2] = p_b[8];
+}
+
+
+// Compute the polar decomposition from a singular value decomposition
+// R = U * Vt, S = V * diag(sigma) * Vt
+template<class T>
+inline void compose_polar(const T * p_u, const T * p_sigma, const T * p_v, T * p_rotation, T * p_stretch)
+{
+    for_range(zero_index, std::integral_constant<std::size_t, 3>{}, [&](auto y)
+    {
+        for_range(zero_index, std::integral_constant<std::size_t, 3>{}, [&](auto x)
+        {
+            p_rotation[y * 3 + x] = p_u[y * 3] * p_v[x * 3] + p_u[y * 3 + 1] * p_v[x * 3 + 1] + p_u[y * 3 + 2] * p_v[x * 3 + 2];
+            p_stretch[y * 3 + x] =
+                p_v[y * 3] * p_sigma[0] * p_v[x * 3] +
+                p_v[y * 3 + 1] * p_sigma[1] * p_v[x * 3 + 1] +
+                p_v[y * 3 + 2] * p_sigma[2] * p_v[x * 3 + 2];
+        });
+    });
+}
+
+
+// View the components of several views as a single view of `p_size` elements
+template<class T, std::size_t ... S>
+vector_soa_span<T, (S + ...)> join_views(const std::size_t p_size, const vector_soa_span<T, S> & ... p_views)
+{
+    std::array<T *, (S + ...)> components;
+    auto offset = std::size_t{ 0 };
+    const auto append = [&](const auto & p_view, const std::size_t p_count)
+    {
+        for (std::size_t e = 0; e < p_count; ++e) {
+            components[offset + e] = p_view.component(e);
+        }
+        offset += p_count;
+    };
+    (append(p_views, S), ...);
+    return vector_soa_span<T, (S + ...)>(components, p_size);
+}
+
+
+// Matrices decomposed together by the quaternion and polar batches
+// Their singular value decompositions are kept in local buffers of this size
+inline constexpr std::size_t batch_block_size = 64;
+
+};  // namespace matrix_svd_ns
+};  // namespace details
+};  // namespace math
+};  // namespace ft
+
+
+// Compute the singular value decomposition of a 3x3 matrix
+template<class T>
+ft::math::svd_3x3_decomposition<T> ft::math::svd_decompose(const matrix<T, 3, 3> & p_matrix)
+{
+    svd_3x3_decomposition<T> result;
+    matrix<T, 3, 3> b;
+    details::matrix_svd_ns::right_vectors(p_matrix.data(), result.v.data());
+    details::matrix_svd_ns::sort_vectors(p_matrix.data(), result.v.data(), b.data());
+    details::matrix_svd_ns::left_vectors(b.data(), result.u.data(), result.sigma.data());
+    return result;
+}
+
+
+// Compute the singular value decomposition of a 3x3 matrix
+template<class T>
+ft::math::svd_3x3_quaternion_decomposition<T> ft::math::svd_decompose_quaternion(const matrix<T, 3, 3> & p_matrix)
+{
+    const auto decomposition = svd_decompose(p_matrix);
+    return {
+        make_rotation_quaternion(decomposition.u),
+        decomposition.sigma,
+        make_rotation_quaternion(decomposition.v)
+    };
+}
+
+
+// Compute the polar decomposition of a 3x3 matrix
+template<class T>
+ft::math::polar_3x3_decomposition<T> ft::math::polar_decompose(const matrix<T, 3, 3> & p_matrix)
+{
+    const auto decomposition = svd_decompose(p_matrix);
+
+    polar_3x3_decomposition<T> result;
+    details::matrix_svd_ns::compose_polar(
+        decomposition.u.data(), decomposition.sigma.data(), decomposition.v.data(),
+        result.rotation.data(), result.stretch.data());
+    return result;
+}
+
+
+// Compute the singular value decomposition of an array of 3x3 matrices
+template<class T>
+void ft::math::svd_decompose_batch(
+    const matrix_soa_span<const T, 3, 3> & p_matrices,
+    const matrix_soa_span<T, 3, 3> & p_u,
+    const vector_soa_span<T, 3> & p_sigma,
+    const matrix_soa_span<T, 3, 3> & p_v)
+{
+    FT_ASSERT(p_u.size() >= p_matrices.size());
+    FT_ASSERT(p_sigma.size() >= p_matrices.size());
+    FT_ASSERT(p_v.size() >= p_matrices.size());
+
+    using details::matrix_svd_ns::join_views;
+
+    // Three passes keep each kernel small enough to be inlined and vectorized
+    // The unsorted V is sorted in place and A * V is kept in U until the last pass
+    map_soa<matrix<T, 3, 3>, matrix<T, 3, 3>>(p_matrices, p_v, [](const matrix<T, 3, 3> & p_matrix)
+    {
+        matrix<T, 3, 3> v;
+        details::matrix_svd_ns::right_vectors(p_matrix.data(), v.data());
+        return v;
+    });
+
+    const auto sources = join_views(p_matrices.size(), p_matrices, vector_soa_span<const T, 9>(p_v));
+    const auto sorted = join_views(p_matrices.size(), p_v, p_u);
+    map_soa<vector<T, 18>, vector<T, 18>>(sources, sorted, [](const vector<T, 18> & p_source)
+    {
+        vector<T, 18> result;
+        for_range(zero_index, std::integral_constant<std::size_t, 9>{}, [&](auto e) {
+            result[e] = p_source[9 + e];
+        });
+
+        details::matrix_svd_ns::sort_vectors(p_source.data(), result.data(), result.data() + 9);
+        return result;
+    });
+
+    const auto results = join_views(p_matrices.size(), p_u, p_sigma);
+    map_soa<matrix<T, 3, 3>, vector<T, 12>>(matrix_soa_span<const T, 3, 3>(p_u), results, [](matrix<T, 3, 3> p_b)
+    {
+        vector<T, 12> result;
+        details::matrix_svd_ns::left_vectors(p_b.data(), result.data(), result.data() + 9);
+        return result;
+    });
+}
+
+
+// Compute the singular value decomposition of an array of 3x3 matrices
+template<class T>
+void ft::math::svd_decompose_quaternion_batch(
+    const matrix_soa_span<const T, 3, 3> & p_matrices,
+    const vector_soa_span<T, 4> & p_u,
+    const vector_soa_span<T, 3> & p_sigma,
+    const vector_soa_span<T, 4> & p_v)
+{
+    FT_ASSERT(p_u.size() >= p_matrices.size());
+    FT_ASSERT(p_sigma.size() >= p_matrices.size());
+    FT_ASSERT(p_v.size() >= p_matrices.size());
+
+    using details::matrix_svd_ns::batch_block_size;
+    using details::matrix_svd_ns::join_views;
+
+    // U and V of a block as matrices
+    T u_block[9][batch_block_size];
+    T v_block[9][batch_block_size];
+    std::array<T *, 9> u_components;
+    std::array<T *, 9> v_components;
+    for (std::size_t e = 0; e < 9; ++e)
+    {
+        u_components[e] = u_block[e];
+        v_components[e] = v_block[e];
+    }
+
+    for (std::size_t begin = 0; begin < p_matrices.size(); begin += batch_block_size)
+    {
+        const auto count = std::min(batch_block_size, p_matrices.size() - begin);
+        const auto u = matrix_soa_span<T, 3, 3>(u_components, count);
+        const auto v = matrix_soa_span<T, 3, 3>(v_components, count);
+        svd_decompose_batch(p_matrices.subspan(begin, count), u, p_sigma.subspan(begin, count), v);
+
+        const auto rotations = join_views(count, vector_soa_span<const T, 9>(u), vector_soa_span<const T, 9>(v));
+        const auto quaternions = join_views(count, p_u.subspan(begin, count), p_v.subspan(begin, count));
+        map_soa<vector<T, 18>, vector<T, 8>>(rotations, quaternions, [](const vector<T, 18> & p_rotations)
+        {
+            matrix<T, 3, 3> u_matrix;
+            matrix<T, 3, 3> v_matrix;
+            for_range(zero_index, std::integral_constant<std::size_t, 9>{}, [&](auto e)
+            {
+                u_matrix.data()[e] = p_rotations[e];
+                v_matrix.data()[e] = p_rotations[9 + e];
+            });
+
+            const auto u_quaternion = details::quaternion_rotation_ns::matrix_to_components(u_matrix);
+            const auto v_quaternion = details::quaternion_rotation_ns::matrix_to_components(v_matrix);
+
+            vector<T, 8> result;
+            for_range(zero_index, std::integral_constant<std::size_t, 4>{}, [&](auto e)
+            {
+                result[e] = u_quaternion[e];
+                result[4 + e] = v_quaternion[e];
+            });
+            return result;
+        });
+    }
+}
+
+
+// Compute the polar decomposition of an array of 3x3 matrices
+template<class T>
+void ft::math::polar_decompose_batch(
+    const matrix_soa_span<const T, 3, 3> & p_matrices,
+    const matrix_soa_span<T, 3, 3> & p_rotation,
+    const matrix_soa_span<T, 3, 3> & p_stretch)
+{
+    FT_ASSERT(p_rotation.size() >= p_matrices.size());
+    FT_ASSERT(p_stretch.size() >= p_matrices.size());
+
+    using details::matrix_svd_ns::batch_block_size;
+    using details::matrix_svd_ns::join_views;
+
+    // U, sigma and V of a block
+    T u_block[9][batch_block_size];
+    T sigma_block[3][batch_block_size];
+    T v_block[9][batch_block_size];
+    std::array<T *, 9> u_components;
+    std::array<T *, 3> sigma_components;
+    std::array<T *, 9> v_components;
+    for (std::size_t e = 0; e < 9; ++e)
+    {
+        u_components[e] = u_block[e];
+        v_components[e] = v_block[e];
+    }
+    for (std::size_t e = 0; e < 3; ++e) {
+        sigma_components[e] = sigma_block[e];
+    }
+
+    for (std::size_t begin = 0; begin < p_matrices.size(); begin += batch_block_size)
+    {
+        const auto count = std::min(batch_block_size, p_matrices.size() - begin);
+        const auto u = matrix_soa_span<T, 3, 3>(u_components, count);
+        const auto sigma = vector_soa_span<T, 3>(sigma_components, count);
+        const auto v = matrix_soa_span<T, 3, 3>(v_components, count);
+        svd_decompose_batch(p_matrices.subspan(begin, count), u, sigma, v);
+
+        const auto decompositions = join_views(count,
+            vector_soa_span<const T, 9>(u), vector_soa_span<const T, 3>(sigma), vector_soa_span<const T, 9>(v));
+        const auto results = join_views(count, p_rotation.subspan(begin, count), p_stretch.subspan(begin, count));
+        map_soa<vector<T, 21>, vector<T, 18>>(decompositions, results, [](const vector<T, 21> & p_decomposition)
+        {
+            vector<T, 18> result;
+            details::matrix_svd_ns::compose_polar(
+                p_decomposition.data(), p_decomposition.data() + 9, p_decomposition.data() + 12,
+                result.data(), result.data() + 9);
+            return result;
+        });
+    }
+}
@@ -0,0 +1,63 @@
+#pragma once
+
+// Loop helpers used to write a matrix kernel once and have it fully
+//  unrolled for small fixed sizes while still running as a normal loop
+//  for large or runtime sizes
+// A size is either a `std::integral_constant<std::size_t, N>` (unrolled)
+//  or a plain `std::size_t` (regular loop)
+
+// standard headers
+#include <cstddef>  // std::size_t
+#include <type_traits>
+
+namespace ft {
+namespace math {
+
+// Fixed sizes up to this value are fully unrolled by the kernels
+inline constexpr std::size_t max_unrolled_size = 6;
+
+// The first index of a range, usable as both an unrolled or a runtime bound
+inline constexpr std::integral_constant<std::size_t, 0> zero_index{};
+
+
+// The index type used by kernels for a fixed size of `S`
+// Is an integral constant for small sizes and a plain size otherwise
+template<std::size_t S>
+using unrolled_size_t = std::conditional_t<
+    (S <= max_unrolled_size),
+    std::integral_constant<std::size_t, S>,
+    std::size_t>;
+
+// Make the index value used by kernels for a fixed size of `S`
+template<std::size_t S>
+constexpr unrolled_size_t<S> make_unrolled_size();
+
+
+// Checks if an index type is a compile time constant
+template<class I>
+inline constexpr bool is_unrolled_index_v = false;
+
+template<std::size_t N>
+inline constexpr bool is_unrolled_index_v<std::integral_constant<std::size_t, N>> = true;
+
+
+// Get the index following `p_index`
+// Preserves compile time constants
+template<class I>
+constexpr auto next_index(const I p_index);
+
+
+// Call `p_func` for each index in [p_begin, p_end)
+// Unrolled if both bounds are compile time constants
+template<class B, class E, class F>
+constexpr void for_range(const B p_begin, const E p_end, F && p_func);
+
+// Call `p_func` for each index in [p_begin, p_end) in reverse order
+// Unrolled if both bounds are compile time constants
+template<class B, class E, class F>
+constexpr void for_range_reverse(const B p_begin, const E p_end, F && p_func);
+
+};  // namespace math
+};  // namespace ft
+
+#include "matrix_unroll.hpp"
@@ -0,0 +1,81 @@
+#pragma once
+
+// Implements the loop helpers of matrix_unroll.h
+
+// project headers
+#include "matrix_unroll.h"
+
+// standard headers
+#include <utility>
+
+// Make the index value used by kernels for a fixed size of `S`
+template<std::size_t S>
+constexpr ft::math::unrolled_size_t<S> ft::math::make_unrolled_size()
+{
+    if constexpr (is_unrolled_index_v<unrolled_size_t<S>>) {
+        return unrolled_size_t<S>{};
+    }
+    else {
+        return S;
+    }
+}
+
+
+// Get the index following `p_index`
+// Preserves compile time constants
+template<class I>
+constexpr auto ft::math::next_index(const I p_index)
+{
+    if constexpr (is_unrolled_index_v<I>) {
+        return std::integral_constant<std::size_t, I::value + 1>{};
+    }
+    else {
+        return static_cast<std::size_t>(p_index + 1);
+    }
+}
+
+
+// Call `p_func` for each index in [p_begin, p_end)
+// Unrolled if both bounds are compile time constants
+template<class B, class E, class F>
+constexpr void ft::math::for_range(const B p_begin, const E p_end, F && p_func)
+{
+    if constexpr (is_unrolled_index_v<B> && is_unrolled_index_v<E>)
+    {
+        if constexpr (B::value < E::value)
+        {
+            [&]<std::size_t ... I>(std::index_sequence<I...>) {
+                (p_func(std::integral_constant<std::size_t, B::value + I>{}), ...);
+            }(std::make_index_sequence<E::value - B::value>{});
+        }
+    }
+    else
+    {
+        for (std::size_t i = p_begin; i < static_cast<std::size_t>(p_end); ++i) {
+            p_func(i);
+        }
+    }
+}
+
+
+// Call `p_func` for each index in [p_begin, p_end) in reverse order
+// Unrolled if both bounds are compile time constants
+template<class B, class E, class F>
+constexpr void ft::math::for_range_reverse(const B p_begin, const E p_end, F && p_func)
+{
+    if constexpr (is_unrolled_index_v<B> && is_unrolled_index_v<E>)
+    {
+        if constexpr (B::value < E::value)
+        {
+            [&]<std::size_t ... I>(std::index_sequence<I...>) {
+                (p_func(std::integral_constant<std::size_t, E::value - 1 - I>{}), ...);
+            }(std::make_index_sequence<E::value - B::value>{});
+        }
+    }
+    else
+    {
+        for (std::size_t i = p_end; i > static_cast<std::size_t>(p_begin); --i) {
+            p_func(i - 1);
+        }
+    }
+}
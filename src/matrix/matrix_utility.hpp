@@ -4,6 +4,7 @@
 
 // oroject heaers
 #include "matrix_utility.h"
+#include "numeric/special_values.h"
 
 // other headers
 #include "error/ft_assert.h"
@@ -256,18 +257,21 @@ constexpr O ft::math::calculate_matrix_cell_cofactor(
     const auto minor = make_minor_matrix(p_matrix, p_row_index, p_col_index);
     const auto subdeterminant = calculate_matrix_determinant<T, S-1, O>(minor);
     const auto sign = // Simplifed (-1 ^ (p_Row + p_Col))
-        static_cast<O>(1 - 2 * ((p_row_index + p_col_index) % 2));
+        static_cast<O>(1 - 2 * static_cast<int>((p_row_index + p_col_index) % 2));
 
     return sign * subdeterminant;
 }
 
 
 
-// Inverse a matrix in-place
+namespace ft {
+namespace math {
+namespace details {
+namespace matrix_utility_ns {
+
 // Make a new matrix that is the inverse of another
 template<class T, std::size_t S>
-constexpr ft::math::matrix<T, S, S> 
-ft::math::make_inverse_matrix(const matrix<T, S, S> & p_matrix)
+constexpr matrix<T, S, S> make_inverse(const matrix<T, S, S> & p_matrix)
 {
     static_assert(S > 0);
 
@@ -284,7 +288,7 @@ ft::math::make_inverse_matrix(const matrix<T, S, S> & p_matrix)
         matrix<T, 2, 2> result;
 	    result[0][0] = p_matrix[1][1];
 	    result[0][1] = -p_matrix[0][1];
-	    result[1][0] = -p_matrix[0][1];
+	    result[1][0] = -p_matrix[1][0];
 	    result[1][1] = p_matrix[0][0];
 	    result /= calculate_matrix_determinant(p_matrix);
 	    return result;
@@ -298,6 +302,7 @@ ft::math::make_inverse_matrix(const matrix<T, S, S> & p_matrix)
         {
             for (std::size_t j = 0; j < 3; ++j)
             {
+                // Cofactor of the transposed cell, which builds the adjugate directly
                 auto minor = make_minor_matrix(p_matrix, j, i);
                 result[i][j] = calculate_matrix_determinant(minor);
 
@@ -308,8 +313,6 @@ ft::math::make_inverse_matrix(const matrix<T, S, S> & p_matrix)
             }
         }
 
-        transpose_matrix(result);
-
         result /= calculate_matrix_determinant(p_matrix);
 
         return result;
@@ -320,7 +323,7 @@ ft::math::make_inverse_matrix(const matrix<T, S, S> & p_matrix)
         // https://en.wikipedia.org/wiki/Invertible_matrix#Analytic_solution
 
         const auto cofactors = make_cofactor_matrix(p_matrix);
-        const auto transposed = make_transpose_matrix(cofactors);
+        const auto transposed = transposed_matrix(cofactors);
         const auto determinant = calculate_matrix_determinant(p_matrix);
 
         // Check for non invertible matrix
@@ -329,3 +332,21 @@ ft::math::make_inverse_matrix(const matrix<T, S, S> & p_matrix)
         return transposed / determinant;
     }
 }
+
+};  // namespace matrix_utility_ns
+};  // namespace details
+};  // namespace math
+};  // namespace ft
+
+
+// Make a new matrix that is the inverse of another
+// Near singular matrices give huge or denormal elements, checked in
+//  debug mode
+template<class T, std::size_t S>
+constexpr ft::math::matrix<T, S, S> 
+ft::math::make_inverse_matrix(const matrix<T, S, S> & p_matrix)
+{
+    const auto result = details::matrix_utility_ns::make_inverse(p_matrix);
+    FT_MATH_CHECK_DENORMALS("make_inverse_matrix", result);
+    return result;
+}
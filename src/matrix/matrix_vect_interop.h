@@ -6,6 +6,9 @@
 #include "matrix.h"
 #include "vector/vector.h"
 
+// standard headers
+#include <span>
+
 namespace ft {
 namespace math {
 
@@ -41,6 +44,19 @@ template<class T, std::size_t R, std::size_t C>
 constexpr matrix<T, R, C> vector_tensor_product(const vector<T, C> & p_cols, const vector<T, R> & p_rows);
 
 
+// Transform a point by a 4x4 matrix
+// The point is extended with w = 1 and the result divided by its w
+template<class T>
+constexpr vector<T, 3> transform_point(const matrix<T, 4, 4> & p_matrix, const vector<T, 3> & p_point);
+
+// Transform an array of points by a 4x4 matrix
+// `p_result` must be at least as large as `p_points` and may alias it
+template<class T>
+void transform_points_batch(
+    const matrix<T, 4, 4> & p_matrix,
+    std::span<const vector<T, 3>> p_points,
+    std::span<vector<T, 3>> p_result);
+
 };  // namespace math
 };  // namespace ft
 
@@ -71,3 +71,33 @@ ft::math::vector_tensor_product(const vector<T, C> & p_cols, const vector<T, R>
 {
     return vect_to_col_matrix(p_cols) * vect_to_row_matrix(p_rows);
 }
+
+
+// Transform a point by a 4x4 matrix
+template<class T>
+constexpr ft::math::vector<T, 3>
+ft::math::transform_point(const matrix<T, 4, 4> & p_matrix, const vector<T, 3> & p_point)
+{
+    T result[4];
+    for (std::size_t y = 0; y < 4; ++y) {
+        result[y] = p_matrix[y][0] * p_point[0] + p_matrix[y][1] * p_point[1] + p_matrix[y][2] * p_point[2] + p_matrix[y][3];
+    }
+
+    const auto inverse_w = static_cast<T>(1) / result[3];
+    return vector<T, 3>{ result[0] * inverse_w, result[1] * inverse_w, result[2] * inverse_w };
+}
+
+
+// Transform an array of points by a 4x4 matrix
+template<class T>
+void ft::math::transform_points_batch(
+    const matrix<T, 4, 4> & p_matrix,
+    std::span<const vector<T, 3>> p_points,
+    std::span<vector<T, 3>> p_result)
+{
+    FT_ASSERT(p_result.size() >= p_points.size());
+
+    for (std::size_t i = 0; i < p_points.size(); ++i) {
+        p_result[i] = transform_point(p_matrix, p_points[i]);
+    }
+}
@@ -0,0 +1,324 @@
+#pragma once
+
+// Square matrices with a known structure, only storing the elements that
+//  may be non zero:
+//  - diagonal_matrix: the diagonal, S elements
+//  - lower_triangular / upper_triangular: one triangle packed row after
+//    row, S * (S + 1) / 2 elements
+//  - symmetric_matrix: the lower triangle packed row after row, the upper
+//    triangle mirrors it
+//  - banded_matrix: `L` diagonals below and `U` above the main one, stored
+//    row after row, S * (L + U + 1) elements
+//
+// Products with these types only visit the stored elements (see
+//  structured_matrix_operators.h), products keeping the structure return a
+//  structured matrix and the others a `matrix`
+// Elements outside the structure read as zero and can't be written
+
+// project headers
+#include "matrix.h"
+#include "vector/vector.h"
+
+// standard headers
+#include <array>
+#include <cstddef>  // std::size_t
+
+namespace ft {
+namespace math {
+
+// Triangle stored by a triangular matrix
+enum class matrix_triangle
+{
+    lower,
+    upper
+};
+
+
+// Square matrix whose elements outside the diagonal are zero
+template<class T, std::size_t S>
+class diagonal_matrix
+{
+public:
+    // Matrix type information
+    static constexpr auto size_rows = S;
+    static constexpr auto size_cols = S;
+    static constexpr std::size_t stored_elements = S;
+    using value_type = T;
+
+public:
+    // Default constructor
+    // Values are uninitialized
+    constexpr diagonal_matrix() = default;
+
+    // Construct from the values of the diagonal
+    constexpr explicit diagonal_matrix(const vector<T, S> & p_diagonal);
+
+    // Construct from the diagonal of a matrix
+    constexpr explicit diagonal_matrix(const matrix<T, S, S> & p_matrix);
+
+
+    // Convert to a full matrix
+    constexpr matrix<T, S, S> to_matrix() const;
+
+
+    // Returns true if element (`p_row`, `p_col`) is stored
+    static constexpr bool is_stored(const std::size_t p_row, const std::size_t p_col);
+
+    // Get the first column of the stored elements of row `p_row`
+    static constexpr std::size_t row_begin(const std::size_t p_row);
+
+    // Get the column after the last stored element of row `p_row`
+    static constexpr std::size_t row_end(const std::size_t p_row);
+
+
+    // Read element (`p_row`, `p_col`), zero if it is not stored
+    constexpr T get(const std::size_t p_row, const std::size_t p_col) const;
+
+    // Write element (`p_row`, `p_col`), which must be stored
+    constexpr void set(const std::size_t p_row, const std::size_t p_col, const T p_value);
+
+
+    // Get the values of the diagonal
+    constexpr const vector<T, S> & diagonal() const;
+
+    // Get the values of the diagonal
+    constexpr vector<T, S> & diagonal();
+
+
+    // Solve A * x = b in-place
+    // `p_rhs` holds b and is replaced by x
+    constexpr void solve(vector<T, S> & p_rhs) const;
+
+    // Solve A * X = B in-place for multiple right hand sides
+    // Each column of `p_rhs` is a right hand side
+    template<std::size_t N>
+    constexpr void solve(matrix<T, S, N> & p_rhs) const;
+
+private:
+    // The diagonal elements
+    vector<T, S> m_diagonal;
+
+};  // class diagonal_matrix
+
+
+// Square matrix whose elements outside one triangle are zero
+// The triangle is packed row after row
+template<class T, std::size_t S, matrix_triangle G>
+class triangular_matrix
+{
+public:
+    // Matrix type information
+    static constexpr auto size_rows = S;
+    static constexpr auto size_cols = S;
+    static constexpr auto triangle = G;
+    static constexpr std::size_t stored_elements = S * (S + 1) / 2;
+    using value_type = T;
+
+public:
+    // Default constructor
+    // Values are uninitialized
+    constexpr triangular_matrix() = default;
+
+    // Construct from the triangle of a matrix, the other elements are ignored
+    constexpr explicit triangular_matrix(const matrix<T, S, S> & p_matrix);
+
+
+    // Convert to a full matrix
+    constexpr matrix<T, S, S> to_matrix() const;
+
+
+    // Returns true if element (`p_row`, `p_col`) is stored
+    static constexpr bool is_stored(const std::size_t p_row, const std::size_t p_col);
+
+    // Get the first column of the stored elements of row `p_row`
+    static constexpr std::size_t row_begin(const std::size_t p_row);
+
+    // Get the column after the last stored element of row `p_row`
+    static constexpr std::size_t row_end(const std::size_t p_row);
+
+
+    // Read element (`p_row`, `p_col`), zero if it is not stored
+    constexpr T get(const std::size_t p_row, const std::size_t p_col) const;
+
+    // Write element (`p_row`, `p_col`), which must be stored
+    constexpr void set(const std::size_t p_row, const std::size_t p_col, const T p_value);
+
+
+    // Solve A * x = b in-place by forward (lower) or back (upper) substitution
+    // `p_rhs` holds b and is replaced by x
+    constexpr void solve(vector<T, S> & p_rhs) const;
+
+    // Solve A * X = B in-place for multiple right hand sides
+    // Each column of `p_rhs` is a right hand side
+    template<std::size_t N>
+    constexpr void solve(matrix<T, S, N> & p_rhs) const;
+
+
+    // Get direct access to the packed elements
+    constexpr T * data();
+
+    // Get direct access to the packed elements
+    constexpr const T * data() const;
+
+private:
+    // Get the index of stored element (`p_row`, `p_col`) in the packed array
+    static constexpr std::size_t index(const std::size_t p_row, const std::size_t p_col);
+
+    // Packed triangle
+    std::array<T, stored_elements> m_data;
+
+};  // class triangular_matrix
+
+// Square matrix whose elements above the diagonal are zero
+template<class T, std::size_t S>
+using lower_triangular = triangular_matrix<T, S, matrix_triangle::lower>;
+
+// Square matrix whose elements below the diagonal are zero
+template<class T, std::size_t S>
+using upper_triangular = triangular_matrix<T, S, matrix_triangle::upper>;
+
+
+// Square matrix equal to its transpose
+// Only the lower triangle is stored, packed row after row
+template<class T, std::size_t S>
+class symmetric_matrix
+{
+public:
+    // Matrix type information
+    static constexpr auto size_rows = S;
+    static constexpr auto size_cols = S;
+    static constexpr std::size_t stored_elements = S * (S + 1) / 2;
+    using value_type = T;
+
+public:
+    // Default constructor
+    // Values are uninitialized
+    constexpr symmetric_matrix() = default;
+
+    // Construct from the lower triangle of a matrix, the upper triangle is ignored
+    constexpr explicit symmetric_matrix(const matrix<T, S, S> & p_matrix);
+
+
+    // Convert to a full matrix
+    constexpr matrix<T, S, S> to_matrix() const;
+
+
+    // Returns true if element (`p_row`, `p_col`) is stored, always true
+    static constexpr bool is_stored(const std::size_t p_row, const std::size_t p_col);
+
+    // Get the first column of the stored elements of row `p_row`
+    static constexpr std::size_t row_begin(const std::size_t p_row);
+
+    // Get the column after the last stored element of row `p_row`
+    static constexpr std::size_t row_end(const std::size_t p_row);
+
+
+    // Read element (`p_row`, `p_col`)
+    constexpr T get(const std::size_t p_row, const std::size_t p_col) const;
+
+    // Write element (`p_row`, `p_col`), also writes (`p_col`, `p_row`)
+    constexpr void set(const std::size_t p_row, const std::size_t p_col, const T p_value);
+
+
+    // Get direct access to the packed lower triangle
+    constexpr T * data();
+
+    // Get direct access to the packed lower triangle
+    constexpr const T * data() const;
+
+private:
+    // Get the index of element (`p_row`, `p_col`) in the packed array
+    static constexpr std::size_t index(const std::size_t p_row, const std::size_t p_col);
+
+    // Packed lower triangle
+    std::array<T, stored_elements> m_data;
+
+};  // class symmetric_matrix
+
+
+// Square matrix whose elements more than `L` below or `U` above the
+//  diagonal are zero
+// Each row stores `L + U + 1` elements centered on the diagonal, the
+//  elements falling outside the matrix in the first and last rows are unused
+template<class T, std::size_t S, std::size_t L, std::size_t U>
+class banded_matrix
+{
+    static_assert(L < S && U < S, "Bandwidths must be smaller than the matrix size");
+
+public:
+    // Matrix type information
+    static constexpr auto size_rows = S;
+    static constexpr auto size_cols = S;
+    static constexpr auto lower_bandwidth = L;
+    static constexpr auto upper_bandwidth = U;
+    static constexpr std::size_t band_width = L + U + 1;
+    static constexpr std::size_t stored_elements = S * band_width;
+    using value_type = T;
+
+public:
+    // Default constructor
+    // Values are uninitialized
+    constexpr banded_matrix() = default;
+
+    // Construct from the band of a matrix, the other elements are ignored
+    constexpr explicit banded_matrix(const matrix<T, S, S> & p_matrix);
+
+
+    // Convert to a full matrix
+    constexpr matrix<T, S, S> to_matrix() const;
+
+
+    // Returns true if element (`p_row`, `p_col`) is stored
+    static constexpr bool is_stored(const std::size_t p_row, const std::size_t p_col);
+
+    // Get the first column of the stored elements of row `p_row`
+    static constexpr std::size_t row_begin(const std::size_t p_row);
+
+    // Get the column after the last stored element of row `p_row`
+    static constexpr std::size_t row_end(const std::size_t p_row);
+
+
+    // Read element (`p_row`, `p_col`), zero if it is not stored
+    constexpr T get(const std::size_t p_row, const std::size_t p_col) const;
+
+    // Write element (`p_row`, `p_col`), which must be stored
+    constexpr void set(const std::size_t p_row, const std::size_t p_col, const T p_value);
+
+
+    // Get direct access to the rows of the band
+    constexpr T * data();
+
+    // Get direct access to the rows of the band
+    constexpr const T * data() const;
+
+private:
+    // Get the index of stored element (`p_row`, `p_col`) in the band array
+    static constexpr std::size_t index(const std::size_t p_row, const std::size_t p_col);
+
+    // Rows of the band
+    std::array<T, stored_elements> m_data;
+
+};  // class banded_matrix
+
+
+// Checks if `M` is a structured matrix of `S` by `S` elements of type `T`
+template<class M, class T, std::size_t S>
+inline constexpr bool is_structured_matrix_v = false;
+
+template<class T, std::size_t S>
+inline constexpr bool is_structured_matrix_v<diagonal_matrix<T, S>, T, S> = true;
+
+template<class T, std::size_t S, matrix_triangle G>
+inline constexpr bool is_structured_matrix_v<triangular_matrix<T, S, G>, T, S> = true;
+
+template<class T, std::size_t S>
+inline constexpr bool is_structured_matrix_v<symmetric_matrix<T, S>, T, S> = true;
+
+template<class T, std::size_t S, std::size_t L, std::size_t U>
+inline constexpr bool is_structured_matrix_v<banded_matrix<T, S, L, U>, T, S> = true;
+
+};  // namespace math
+};  // namespace ft
+
+#include "structured_matrix.hpp"
+#include "structured_matrix_operators.h"
@@ -0,0 +1,481 @@
+#pragma once
+
+// Implements the structured matrices of structured_matrix.h
+
+// project headers
+#include "structured_matrix.h"
+
+// other headers
+#include "error/ft_assert.h"
+
+// standard headers
+#include <algorithm>
+
+namespace ft {
+namespace math {
+namespace details {
+namespace structured_matrix_ns {
+
+// Fill a full matrix from the stored elements of a structured matrix
+template<class M, class T, std::size_t S>
+constexpr matrix<T, S, S> to_matrix(const M & p_matrix)
+{
+    matrix<T, S, S> result;
+    result.fill(0);
+    for (std::size_t row = 0; row < S; ++row)
+    {
+        for (auto col = M::row_begin(row); col < M::row_end(row); ++col) {
+            result[row][col] = p_matrix.get(row, col);
+        }
+    }
+    return result;
+}
+
+
+// Copy the stored elements of a structured matrix from a full matrix
+template<class M, class T, std::size_t S>
+constexpr void from_matrix(M & p_result, const matrix<T, S, S> & p_matrix)
+{
+    for (std::size_t row = 0; row < S; ++row)
+    {
+        for (auto col = M::row_begin(row); col < M::row_end(row); ++col) {
+            p_result.set(row, col, p_matrix[row][col]);
+        }
+    }
+}
+
+};  // namespace structured_matrix_ns
+};  // namespace details
+};  // namespace math
+};  // namespace ft
+
+
+// Construct from the values of the diagonal
+template<class T, std::size_t S>
+constexpr ft::math::diagonal_matrix<T, S>::diagonal_matrix(const vector<T, S> & p_diagonal) :
+    m_diagonal(p_diagonal)
+{ }
+
+
+// Construct from the diagonal of a matrix
+template<class T, std::size_t S>
+constexpr ft::math::diagonal_matrix<T, S>::diagonal_matrix(const matrix<T, S, S> & p_matrix)
+{
+    for (std::size_t i = 0; i < S; ++i) {
+        m_diagonal[i] = p_matrix[i][i];
+    }
+}
+
+
+// Convert to a full matrix
+template<class T, std::size_t S>
+constexpr ft::math::matrix<T, S, S> ft::math::diagonal_matrix<T, S>::to_matrix() const
+{
+    return details::structured_matrix_ns::to_matrix<diagonal_matrix, T, S>(*this);
+}
+
+
+// Returns true if element (`p_row`, `p_col`) is stored
+template<class T, std::size_t S>
+constexpr bool ft::math::diagonal_matrix<T, S>::is_stored(const std::size_t p_row, const std::size_t p_col)
+{
+    return p_row == p_col;
+}
+
+
+// Get the first column of the stored elements of row `p_row`
+template<class T, std::size_t S>
+constexpr std::size_t ft::math::diagonal_matrix<T, S>::row_begin(const std::size_t p_row)
+{
+    return p_row;
+}
+
+
+// Get the column after the last stored element of row `p_row`
+template<class T, std::size_t S>
+constexpr std::size_t ft::math::diagonal_matrix<T, S>::row_end(const std::size_t p_row)
+{
+    return p_row + 1;
+}
+
+
+// Read element (`p_row`, `p_col`), zero if it is not stored
+template<class T, std::size_t S>
+constexpr T ft::math::diagonal_matrix<T, S>::get(const std::size_t p_row, const std::size_t p_col) const
+{
+    FT_ASSERT(p_row < S && p_col < S);
+    return is_stored(p_row, p_col) ? m_diagonal[p_row] : static_cast<T>(0);
+}
+
+
+// Write element (`p_row`, `p_col`), which must be stored
+template<class T, std::size_t S>
+constexpr void ft::math::diagonal_matrix<T, S>::set(const std::size_t p_row, const std::size_t p_col, const T p_value)
+{
+    FT_ASSERT(p_row < S && is_stored(p_row, p_col));
+    m_diagonal[p_row] = p_value;
+}
+
+
+// Get the values of the diagonal
+template<class T, std::size_t S>
+constexpr const ft::math::vector<T, S> & ft::math::diagonal_matrix<T, S>::diagonal() const
+{
+    return m_diagonal;
+}
+
+
+// Get the values of the diagonal
+template<class T, std::size_t S>
+constexpr ft::math::vector<T, S> & ft::math::diagonal_matrix<T, S>::diagonal()
+{
+    return m_diagonal;
+}
+
+
+// Solve A * x = b in-place
+template<class T, std::size_t S>
+constexpr void ft::math::diagonal_matrix<T, S>::solve(vector<T, S> & p_rhs) const
+{
+    for (std::size_t i = 0; i < S; ++i) {
+        p_rhs[i] /= m_diagonal[i];
+    }
+}
+
+
+// Solve A * X = B in-place for multiple right hand sides
+template<class T, std::size_t S>
+template<std::size_t N>
+constexpr void ft::math::diagonal_matrix<T, S>::solve(matrix<T, S, N> & p_rhs) const
+{
+    for (std::size_t i = 0; i < S; ++i)
+    {
+        const auto inverse = 1 / m_diagonal[i];
+        auto row = p_rhs[i];
+        for (std::size_t j = 0; j < N; ++j) {
+            row[j] *= inverse;
+        }
+    }
+}
+
+
+
+// Construct from the triangle of a matrix, the other elements are ignored
+template<class T, std::size_t S, ft::math::matrix_triangle G>
+constexpr ft::math::triangular_matrix<T, S, G>::triangular_matrix(const matrix<T, S, S> & p_matrix)
+{
+    details::structured_matrix_ns::from_matrix(*this, p_matrix);
+}
+
+
+// Convert to a full matrix
+template<class T, std::size_t S, ft::math::matrix_triangle G>
+constexpr ft::math::matrix<T, S, S> ft::math::triangular_matrix<T, S, G>::to_matrix() const
+{
+    return details::structured_matrix_ns::to_matrix<triangular_matrix, T, S>(*this);
+}
+
+
+// Returns true if element (`p_row`, `p_col`) is stored
+template<class T, std::size_t S, ft::math::matrix_triangle G>
+constexpr bool ft::math::triangular_matrix<T, S, G>::is_stored(const std::size_t p_row, const std::size_t p_col)
+{
+    return (G == matrix_triangle::lower) ? p_col <= p_row : p_col >= p_row;
+}
+
+
+// Get the first column of the stored elements of row `p_row`
+template<class T, std::size_t S, ft::math::matrix_triangle G>
+constexpr std::size_t ft::math::triangular_matrix<T, S, G>::row_begin(const std::size_t p_row)
+{
+    return (G == matrix_triangle::lower) ? 0 : p_row;
+}
+
+
+// Get the column after the last stored element of row `p_row`
+template<class T, std::size_t S, ft::math::matrix_triangle G>
+constexpr std::size_t ft::math::triangular_matrix<T, S, G>::row_end(const std::size_t p_row)
+{
+    return (G == matrix_triangle::lower) ? p_row + 1 : S;
+}
+
+
+// Read element (`p_row`, `p_col`), zero if it is not stored
+template<class T, std::size_t S, ft::math::matrix_triangle G>
+constexpr T ft::math::triangular_matrix<T, S, G>::get(const std::size_t p_row, const std::size_t p_col) const
+{
+    FT_ASSERT(p_row < S && p_col < S);
+    return is_stored(p_row, p_col) ? m_data[index(p_row, p_col)] : static_cast<T>(0);
+}
+
+
+// Write element (`p_row`, `p_col`), which must be stored
+template<class T, std::size_t S, ft::math::matrix_triangle G>
+constexpr void ft::math::triangular_matrix<T, S, G>::set(const std::size_t p_row, const std::size_t p_col, const T p_value)
+{
+    FT_ASSERT(p_row < S && p_col < S && is_stored(p_row, p_col));
+    m_data[index(p_row, p_col)] = p_value;
+}
+
+
+// Solve A * x = b in-place by forward (lower) or back (upper) substitution
+template<class T, std::size_t S, ft::math::matrix_triangle G>
+constexpr void ft::math::triangular_matrix<T, S, G>::solve(vector<T, S> & p_rhs) const
+{
+    for (std::size_t step = 0; step < S; ++step)
+    {
+        // Rows are solved from the one with a single unknown
+        const auto i = (G == matrix_triangle::lower) ? step : S - 1 - step;
+
+        auto value = p_rhs[i];
+        for (auto k = row_begin(i); k < row_end(i); ++k)
+        {
+            if (k != i) {
+                value -= m_data[index(i, k)] * p_rhs[k];
+            }
+        }
+        p_rhs[i] = value / m_data[index(i, i)];
+    }
+}
+
+
+// Solve A * X = B in-place for multiple right hand sides
+template<class T, std::size_t S, ft::math::matrix_triangle G>
+template<std::size_t N>
+constexpr void ft::math::triangular_matrix<T, S, G>::solve(matrix<T, S, N> & p_rhs) const
+{
+    for (std::size_t step = 0; step < S; ++step)
+    {
+        // Rows are solved from the one with a single unknown, whole rows of
+        //  the right hand sides are updated at once
+        const auto i = (G == matrix_triangle::lower) ? step : S - 1 - step;
+
+        auto row = p_rhs[i];
+        for (auto k = row_begin(i); k < row_end(i); ++k)
+        {
+            if (k == i) {
+                continue;
+            }
+
+            const auto factor = m_data[index(i, k)];
+            const auto solved = p_rhs[k];
+            for (std::size_t j = 0; j < N; ++j) {
+                row[j] -= factor * solved[j];
+            }
+        }
+
+        const auto inverse = 1 / m_data[index(i, i)];
+        for (std::size_t j = 0; j < N; ++j) {
+            row[j] *= inverse;
+        }
+    }
+}
+
+
+// Get direct access to the packed elements
+template<class T, std::size_t S, ft::math::matrix_triangle G>
+constexpr T * ft::math::triangular_matrix<T, S, G>::data()
+{
+    return m_data.data();
+}
+
+
+// Get direct access to the packed elements
+template<class T, std::size_t S, ft::math::matrix_triangle G>
+constexpr const T * ft::math::triangular_matrix<T, S, G>::data() const
+{
+    return m_data.data();
+}
+
+
+// Get the index of stored element (`p_row`, `p_col`) in the packed array
+template<class T, std::size_t S, ft::math::matrix_triangle G>
+constexpr std::size_t ft::math::triangular_matrix<T, S, G>::index(const std::size_t p_row, const std::size_t p_col)
+{
+    if constexpr (G == matrix_triangle::lower)
+    {
+        // Row r starts after the r * (r + 1) / 2 elements of the rows above
+        return p_row * (p_row + 1) / 2 + p_col;
+    }
+    else
+    {
+        // Row r holds S - r elements starting at its diagonal
+        return p_row * S - p_row * (p_row - 1) / 2 + (p_col - p_row);
+    }
+}
+
+
+
+// Construct from the lower triangle of a matrix, the upper triangle is ignored
+template<class T, std::size_t S>
+constexpr ft::math::symmetric_matrix<T, S>::symmetric_matrix(const matrix<T, S, S> & p_matrix)
+{
+    for (std::size_t row = 0; row < S; ++row)
+    {
+        for (std::size_t col = 0; col <= row; ++col) {
+            m_data[index(row, col)] = p_matrix[row][col];
+        }
+    }
+}
+
+
+// Convert to a full matrix
+template<class T, std::size_t S>
+constexpr ft::math::matrix<T, S, S> ft::math::symmetric_matrix<T, S>::to_matrix() const
+{
+    return details::structured_matrix_ns::to_matrix<symmetric_matrix, T, S>(*this);
+}
+
+
+// Returns true if element (`p_row`, `p_col`) is stored, always true
+template<class T, std::size_t S>
+constexpr bool ft::math::symmetric_matrix<T, S>::is_stored(const std::size_t, const std::size_t)
+{
+    return true;
+}
+
+
+// Get the first column of the stored elements of row `p_row`
+template<class T, std::size_t S>
+constexpr std::size_t ft::math::symmetric_matrix<T, S>::row_begin(const std::size_t)
+{
+    return 0;
+}
+
+
+// Get the column after the last stored element of row `p_row`
+template<class T, std::size_t S>
+constexpr std::size_t ft::math::symmetric_matrix<T, S>::row_end(const std::size_t)
+{
+    return S;
+}
+
+
+// Read element (`p_row`, `p_col`)
+template<class T, std::size_t S>
+constexpr T ft::math::symmetric_matrix<T, S>::get(const std::size_t p_row, const std::size_t p_col) const
+{
+    FT_ASSERT(p_row < S && p_col < S);
+    return m_data[index(p_row, p_col)];
+}
+
+
+// Write element (`p_row`, `p_col`), also writes (`p_col`, `p_row`)
+template<class T, std::size_t S>
+constexpr void ft::math::symmetric_matrix<T, S>::set(const std::size_t p_row, const std::size_t p_col, const T p_value)
+{
+    FT_ASSERT(p_row < S && p_col < S);
+    m_data[index(p_row, p_col)] = p_value;
+}
+
+
+// Get direct access to the packed lower triangle
+template<class T, std::size_t S>
+constexpr T * ft::math::symmetric_matrix<T, S>::data()
+{
+    return m_data.data();
+}
+
+
+// Get direct access to the packed lower triangle
+template<class T, std::size_t S>
+constexpr const T * ft::math::symmetric_matrix<T, S>::data() const
+{
+    return m_data.data();
+}
+
+
+// Get the index of element (`p_row`, `p_col`) in the packed array
+template<class T, std::size_t S>
+constexpr std::size_t ft::math::symmetric_matrix<T, S>::index(const std::size_t p_row, const std::size_t p_col)
+{
+    // Elements of the upper triangle are read from the lower one
+    const auto row = std::max(p_row, p_col);
+    const auto col = std::min(p_row, p_col);
+    return row * (row + 1) / 2 + col;
+}
+
+
+
+// Construct from the band of a matrix, the other elements are ignored
+template<class T, std::size_t S, std::size_t L, std::size_t U>
+constexpr ft::math::banded_matrix<T, S, L, U>::banded_matrix(const matrix<T, S, S> & p_matrix) :
+    m_data{}
+{
+    details::structured_matrix_ns::from_matrix(*this, p_matrix);
+}
+
+
+// Convert to a full matrix
+template<class T, std::size_t S, std::size_t L, std::size_t U>
+constexpr ft::math::matrix<T, S, S> ft::math::banded_matrix<T, S, L, U>::to_matrix() const
+{
+    return details::structured_matrix_ns::to_matrix<banded_matrix, T, S>(*this);
+}
+
+
+// Returns true if element (`p_row`, `p_col`) is stored
+template<class T, std::size_t S, std::size_t L, std::size_t U>
+constexpr bool ft::math::banded_matrix<T, S, L, U>::is_stored(const std::size_t p_row, const std::size_t p_col)
+{
+    return p_col + L >= p_row && p_col <= p_row + U;
+}
+
+
+// Get the first column of the stored elements of row `p_row`
+template<class T, std::size_t S, std::size_t L, std::size_t U>
+constexpr std::size_t ft::math::banded_matrix<T, S, L, U>::row_begin(const std::size_t p_row)
+{
+    return (p_row > L) ? p_row - L : 0;
+}
+
+
+// Get the column after the last stored element of row `p_row`
+template<class T, std::size_t S, std::size_t L, std::size_t U>
+constexpr std::size_t ft::math::banded_matrix<T, S, L, U>::row_end(const std::size_t p_row)
+{
+    return std::min(S, p_row + U + 1);
+}
+
+
+// Read element (`p_row`, `p_col`), zero if it is not stored
+template<class T, std::size_t S, std::size_t L, std::size_t U>
+constexpr T ft::math::banded_matrix<T, S, L, U>::get(const std::size_t p_row, const std::size_t p_col) const
+{
+    FT_ASSERT(p_row < S && p_col < S);
+    return is_stored(p_row, p_col) ? m_data[index(p_row, p_col)] : static_cast<T>(0);
+}
+
+
+// Write element (`p_row`, `p_col`), which must be stored
+template<class T, std::size_t S, std::size_t L, std::size_t U>
+constexpr void ft::math::banded_matrix<T, S, L, U>::set(const std::size_t p_row, const std::size_t p_col, const T p_value)
+{
+    FT_ASSERT(p_row < S && p_col < S && is_stored(p_row, p_col));
+    m_data[index(p_row, p_col)] = p_value;
+}
+
+
+// Get direct access to the rows of the band
+template<class T, std::size_t S, std::size_t L, std::size_t U>
+constexpr T * ft::math::banded_matrix<T, S, L, U>::data()
+{
+    return m_data.data();
+}
+
+
+// Get direct access to the rows of the band
+template<class T, std::size_t S, std::size_t L, std::size_t U>
+constexpr const T * ft::math::banded_matrix<T, S, L, U>::data() const
+{
+    return m_data.data();
+}
+
+
+// Get the index of stored element (`p_row`, `p_col`) in the band array
+template<class T, std::size_t S, std::size_t L, std::size_t U>
+constexpr std::size_t ft::math::banded_matrix<T, S, L, U>::index(const std::size_t p_row, const std::size_t p_col)
+{
+    // The diagonal element of each row is at offset L
+    return p_row * band_width + (p_col + L - p_row);
+}
@@ -0,0 +1,101 @@
+#pragma once
+
+// Products of structured matrices with each other, with matrices and
+//  with vectors
+// Included by structured_matrix.h
+//
+// Overloads are picked at compile time from the operand types:
+//  - products keeping a structure return it: diagonal by diagonal,
+//    triangular by diagonal or by the same triangle, banded by diagonal or
+//    banded (the bandwidths add up)
+//  - other products return a `matrix`
+// Every kernel only visits the stored elements of its structured operands,
+//  a diagonal scaling of a matrix costs S * C multiplications instead of
+//  S * S * C for the full product
+
+#include "structured_matrix.h"
+
+// standard headers
+#include <algorithm>
+
+namespace ft {
+namespace math {
+
+// Multiply a structured matrix by a matrix
+template<class M, class T, std::size_t S, std::size_t C, class = std::enable_if_t<is_structured_matrix_v<M, T, S>>>
+constexpr matrix<T, S, C> operator*(const M & p_left, const matrix<T, S, C> & p_right);
+
+// Multiply a matrix by a structured matrix
+template<class M, class T, std::size_t R, std::size_t S, class = std::enable_if_t<is_structured_matrix_v<M, T, S>>>
+constexpr matrix<T, R, S> operator*(const matrix<T, R, S> & p_left, const M & p_right);
+
+// Multiply two structured matrices whose product has no structure
+template<
+    class A,
+    class B,
+    class = std::enable_if_t<
+        is_structured_matrix_v<A, typename A::value_type, A::size_rows> &&
+        is_structured_matrix_v<B, typename A::value_type, A::size_rows>>>
+constexpr matrix<typename A::value_type, A::size_rows, A::size_rows> operator*(const A & p_left, const B & p_right);
+
+
+// Multiply two diagonal matrices
+template<class T, std::size_t S>
+constexpr diagonal_matrix<T, S> operator*(const diagonal_matrix<T, S> & p_left, const diagonal_matrix<T, S> & p_right);
+
+// Scale the rows of a triangular matrix
+template<class T, std::size_t S, matrix_triangle G>
+constexpr triangular_matrix<T, S, G> operator*(const diagonal_matrix<T, S> & p_left, const triangular_matrix<T, S, G> & p_right);
+
+// Scale the columns of a triangular matrix
+template<class T, std::size_t S, matrix_triangle G>
+constexpr triangular_matrix<T, S, G> operator*(const triangular_matrix<T, S, G> & p_left, const diagonal_matrix<T, S> & p_right);
+
+// Multiply two triangular matrices of the same triangle
+template<class T, std::size_t S, matrix_triangle G>
+constexpr triangular_matrix<T, S, G> operator*(const triangular_matrix<T, S, G> & p_left, const triangular_matrix<T, S, G> & p_right);
+
+// Scale the rows of a banded matrix
+template<class T, std::size_t S, std::size_t L, std::size_t U>
+constexpr banded_matrix<T, S, L, U> operator*(const diagonal_matrix<T, S> & p_left, const banded_matrix<T, S, L, U> & p_right);
+
+// Scale the columns of a banded matrix
+template<class T, std::size_t S, std::size_t L, std::size_t U>
+constexpr banded_matrix<T, S, L, U> operator*(const banded_matrix<T, S, L, U> & p_left, const diagonal_matrix<T, S> & p_right);
+
+// Multiply two banded matrices
+// The bandwidths of the result are the sums of the bandwidths of the operands
+template<class T, std::size_t S, std::size_t L1, std::size_t U1, std::size_t L2, std::size_t U2>
+constexpr banded_matrix<T, S, std::min(L1 + L2, S - 1), std::min(U1 + U2, S - 1)> operator*(
+    const banded_matrix<T, S, L1, U1> & p_left,
+    const banded_matrix<T, S, L2, U2> & p_right);
+
+
+// Multiply a structured matrix by a column vector
+// Not an operator, vectors already multiply component wise with anything
+template<class M, class T, std::size_t S, class = std::enable_if_t<is_structured_matrix_v<M, T, S>>>
+constexpr vector<T, S> matrix_vector_product(const M & p_matrix, const vector<T, S> & p_vector);
+
+
+// Make a new matrix that is the transposed of another
+template<class T, std::size_t S>
+constexpr diagonal_matrix<T, S> transposed_matrix(const diagonal_matrix<T, S> & p_matrix);
+
+// Make a new matrix that is the transposed of another
+// The transposed of a lower triangular matrix is upper triangular and conversely
+template<class T, std::size_t S, matrix_triangle G>
+constexpr triangular_matrix<T, S, (G == matrix_triangle::lower) ? matrix_triangle::upper : matrix_triangle::lower>
+transposed_matrix(const triangular_matrix<T, S, G> & p_matrix);
+
+// Make a new matrix that is the transposed of another
+template<class T, std::size_t S>
+constexpr symmetric_matrix<T, S> transposed_matrix(const symmetric_matrix<T, S> & p_matrix);
+
+// Make a new matrix that is the transposed of another
+template<class T, std::size_t S, std::size_t L, std::size_t U>
+constexpr banded_matrix<T, S, U, L> transposed_matrix(const banded_matrix<T, S, L, U> & p_matrix);
+
+};  // namespace math
+};  // namespace ft
+
+#include "structured_matrix_operators.hpp"
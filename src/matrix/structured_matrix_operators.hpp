@@ -0,0 +1,250 @@
+#pragma once
+
+// Implements the structured matrix products of structured_matrix_operators.h
+
+#include "structured_matrix_operators.h"
+
+namespace ft {
+namespace math {
+namespace details {
+namespace structured_matrix_ns {
+
+// Multiply two structured matrices into a structured result
+// The stored elements of `R` must cover every non zero element of the product
+template<class R, class A, class B>
+constexpr R multiply_structured(const A & p_left, const B & p_right)
+{
+    constexpr auto size = R::size_rows;
+
+    R result;
+    for (std::size_t i = 0; i < size; ++i)
+    {
+        for (auto j = R::row_begin(i); j < R::row_end(i); ++j) {
+            result.set(i, j, 0);
+        }
+    }
+
+    for (std::size_t i = 0; i < size; ++i)
+    {
+        for (auto k = A::row_begin(i); k < A::row_end(i); ++k)
+        {
+            const auto left = p_left.get(i, k);
+            for (auto j = B::row_begin(k); j < B::row_end(k); ++j) {
+                result.set(i, j, result.get(i, j) + left * p_right.get(k, j));
+            }
+        }
+    }
+    return result;
+}
+
+
+// Make the transposed of a structured matrix
+template<class R, class M>
+constexpr R transpose_structured(const M & p_matrix)
+{
+    R result;
+    for (std::size_t i = 0; i < M::size_rows; ++i)
+    {
+        for (auto j = M::row_begin(i); j < M::row_end(i); ++j) {
+            result.set(j, i, p_matrix.get(i, j));
+        }
+    }
+    return result;
+}
+
+};  // namespace structured_matrix_ns
+};  // namespace details
+};  // namespace math
+};  // namespace ft
+
+
+// Multiply a structured matrix by a matrix
+template<class M, class T, std::size_t S, std::size_t C, class>
+constexpr ft::math::matrix<T, S, C> ft::math::operator*(const M & p_left, const matrix<T, S, C> & p_right)
+{
+    matrix<T, S, C> result;
+    result.fill(0);
+
+    for (std::size_t i = 0; i < S; ++i)
+    {
+        // Row i of the result combines the rows of the right matrix
+        //  selected by the stored elements of row i
+        auto row = result[i];
+        for (auto k = M::row_begin(i); k < M::row_end(i); ++k)
+        {
+            const auto left = p_left.get(i, k);
+            const auto right = p_right[k];
+            for (std::size_t j = 0; j < C; ++j) {
+                row[j] += left * right[j];
+            }
+        }
+    }
+    return result;
+}
+
+
+// Multiply a matrix by a structured matrix
+template<class M, class T, std::size_t R, std::size_t S, class>
+constexpr ft::math::matrix<T, R, S> ft::math::operator*(const matrix<T, R, S> & p_left, const M & p_right)
+{
+    matrix<T, R, S> result;
+    result.fill(0);
+
+    for (std::size_t i = 0; i < R; ++i)
+    {
+        auto row = result[i];
+        const auto left = p_left[i];
+        for (std::size_t k = 0; k < S; ++k)
+        {
+            // Only the stored elements of row k of the right matrix contribute
+            for (auto j = M::row_begin(k); j < M::row_end(k); ++j) {
+                row[j] += left[k] * p_right.get(k, j);
+            }
+        }
+    }
+    return result;
+}
+
+
+// Multiply two structured matrices whose product has no structure
+template<class A, class B, class>
+constexpr ft::math::matrix<typename A::value_type, A::size_rows, A::size_rows>
+ft::math::operator*(const A & p_left, const B & p_right)
+{
+    constexpr auto size = A::size_rows;
+
+    matrix<typename A::value_type, size, size> result;
+    result.fill(0);
+
+    for (std::size_t i = 0; i < size; ++i)
+    {
+        auto row = result[i];
+        for (auto k = A::row_begin(i); k < A::row_end(i); ++k)
+        {
+            const auto left = p_left.get(i, k);
+            for (auto j = B::row_begin(k); j < B::row_end(k); ++j) {
+                row[j] += left * p_right.get(k, j);
+            }
+        }
+    }
+    return result;
+}
+
+
+// Multiply two diagonal matrices
+template<class T, std::size_t S>
+constexpr ft::math::diagonal_matrix<T, S> ft::math::operator*(const diagonal_matrix<T, S> & p_left, const diagonal_matrix<T, S> & p_right)
+{
+    auto result = p_left;
+    for (std::size_t i = 0; i < S; ++i) {
+        result.diagonal()[i] *= p_right.diagonal()[i];
+    }
+    return result;
+}
+
+
+// Scale the rows of a triangular matrix
+template<class T, std::size_t S, ft::math::matrix_triangle G>
+constexpr ft::math::triangular_matrix<T, S, G>
+ft::math::operator*(const diagonal_matrix<T, S> & p_left, const triangular_matrix<T, S, G> & p_right)
+{
+    return details::structured_matrix_ns::multiply_structured<triangular_matrix<T, S, G>>(p_left, p_right);
+}
+
+
+// Scale the columns of a triangular matrix
+template<class T, std::size_t S, ft::math::matrix_triangle G>
+constexpr ft::math::triangular_matrix<T, S, G>
+ft::math::operator*(const triangular_matrix<T, S, G> & p_left, const diagonal_matrix<T, S> & p_right)
+{
+    return details::structured_matrix_ns::multiply_structured<triangular_matrix<T, S, G>>(p_left, p_right);
+}
+
+
+// Multiply two triangular matrices of the same triangle
+template<class T, std::size_t S, ft::math::matrix_triangle G>
+constexpr ft::math::triangular_matrix<T, S, G>
+ft::math::operator*(const triangular_matrix<T, S, G> & p_left, const triangular_matrix<T, S, G> & p_right)
+{
+    return details::structured_matrix_ns::multiply_structured<triangular_matrix<T, S, G>>(p_left, p_right);
+}
+
+
+// Scale the rows of a banded matrix
+template<class T, std::size_t S, std::size_t L, std::size_t U>
+constexpr ft::math::banded_matrix<T, S, L, U>
+ft::math::operator*(const diagonal_matrix<T, S> & p_left, const banded_matrix<T, S, L, U> & p_right)
+{
+    return details::structured_matrix_ns::multiply_structured<banded_matrix<T, S, L, U>>(p_left, p_right);
+}
+
+
+// Scale the columns of a banded matrix
+template<class T, std::size_t S, std::size_t L, std::size_t U>
+constexpr ft::math::banded_matrix<T, S, L, U>
+ft::math::operator*(const banded_matrix<T, S, L, U> & p_left, const diagonal_matrix<T, S> & p_right)
+{
+    return details::structured_matrix_ns::multiply_structured<banded_matrix<T, S, L, U>>(p_left, p_right);
+}
+
+
+// Multiply two banded matrices
+template<class T, std::size_t S, std::size_t L1, std::size_t U1, std::size_t L2, std::size_t U2>
+constexpr ft::math::banded_matrix<T, S, std::min(L1 + L2, S - 1), std::min(U1 + U2, S - 1)> ft::math::operator*(
+    const banded_matrix<T, S, L1, U1> & p_left,
+    const banded_matrix<T, S, L2, U2> & p_right)
+{
+    using result_type = banded_matrix<T, S, std::min(L1 + L2, S - 1), std::min(U1 + U2, S - 1)>;
+    return details::structured_matrix_ns::multiply_structured<result_type>(p_left, p_right);
+}
+
+
+// Multiply a structured matrix by a column vector
+template<class M, class T, std::size_t S, class>
+constexpr ft::math::vector<T, S> ft::math::matrix_vector_product(const M & p_matrix, const vector<T, S> & p_vector)
+{
+    vector<T, S> result;
+    for (std::size_t i = 0; i < S; ++i)
+    {
+        T sum = 0;
+        for (auto k = M::row_begin(i); k < M::row_end(i); ++k) {
+            sum += p_matrix.get(i, k) * p_vector[k];
+        }
+        result[i] = sum;
+    }
+    return result;
+}
+
+
+// Make a new matrix that is the transposed of another
+template<class T, std::size_t S>
+constexpr ft::math::diagonal_matrix<T, S> ft::math::transposed_matrix(const diagonal_matrix<T, S> & p_matrix)
+{
+    return p_matrix;
+}
+
+
+// Make a new matrix that is the transposed of another
+template<class T, std::size_t S, ft::math::matrix_triangle G>
+constexpr ft::math::triangular_matrix<T, S, (G == ft::math::matrix_triangle::lower) ? ft::math::matrix_triangle::upper : ft::math::matrix_triangle::lower>
+ft::math::transposed_matrix(const triangular_matrix<T, S, G> & p_matrix)
+{
+    using result_type = triangular_matrix<T, S, (G == matrix_triangle::lower) ? matrix_triangle::upper : matrix_triangle::lower>;
+    return details::structured_matrix_ns::transpose_structured<result_type>(p_matrix);
+}
+
+
+// Make a new matrix that is the transposed of another
+template<class T, std::size_t S>
+constexpr ft::math::symmetric_matrix<T, S> ft::math::transposed_matrix(const symmetric_matrix<T, S> & p_matrix)
+{
+    return p_matrix;
+}
+
+
+// Make a new matrix that is the transposed of another
+template<class T, std::size_t S, std::size_t L, std::size_t U>
+constexpr ft::math::banded_matrix<T, S, U, L> ft::math::transposed_matrix(const banded_matrix<T, S, L, U> & p_matrix)
+{
+    return details::structured_matrix_ns::transpose_structured<banded_matrix<T, S, U, L>>(p_matrix);
+}
@@ -0,0 +1,196 @@
+// project headers
+#include "math_workspace.h"
+
+// other headers
+#include "error/ft_assert.h"
+
+// standard headers
+#include <algorithm>
+#include <new>
+
+namespace {
+
+// Round a size up to the allocation alignment
+std::size_t align_size(const std::size_t p_size)
+{
+    constexpr auto mask = ft::math::math_workspace_alignment - 1;
+    return (p_size + mask) & ~mask;
+}
+
+}   // namespace
+
+
+// Make a workspace with `p_capacity` bytes available
+ft::math::math_workspace::math_workspace(const std::size_t p_capacity)
+{
+    if (p_capacity > 0) {
+        add_block(p_capacity);
+    }
+}
+
+
+// Frees the blocks, nothing may still be in use
+ft::math::math_workspace::~math_workspace()
+{
+    FT_ASSERT(m_block == 0 && m_offset == 0);
+    free_blocks();
+}
+
+
+// Allocate `p_size` uninitialized bytes aligned to `math_workspace_alignment`
+void * ft::math::math_workspace::allocate_bytes(const std::size_t p_size)
+{
+    const auto size = align_size(p_size);
+
+    // Skip to the next block that fits, the end of the current one is wasted
+    while (m_blocks.empty() || m_offset + size > m_blocks[m_block].size)
+    {
+        if (m_blocks.empty() || m_block + 1 == m_blocks.size())
+        {
+            grow(size);
+            continue;
+        }
+        m_used_before += m_blocks[m_block].size;
+        m_block += 1;
+        m_offset = 0;
+    }
+
+    auto * result = m_blocks[m_block].data + m_offset;
+    m_offset += size;
+    m_high_water_mark = std::max(m_high_water_mark, m_used_before + m_offset);
+    return result;
+}
+
+
+// Get the current position
+ft::math::math_workspace::marker ft::math::math_workspace::mark() const
+{
+    return { m_block, m_offset };
+}
+
+
+// Give back every allocation made since `p_marker` was taken
+void ft::math::math_workspace::release(const marker & p_marker)
+{
+    FT_ASSERT(p_marker.block < m_block || (p_marker.block == m_block && p_marker.offset <= m_offset));
+
+    m_block = p_marker.block;
+    m_offset = p_marker.offset;
+    m_used_before = 0;
+    for (std::size_t i = 0; i < m_block; ++i) {
+        m_used_before += m_blocks[i].size;
+    }
+}
+
+
+// Give back every allocation
+void ft::math::math_workspace::reset()
+{
+    m_block = 0;
+    m_offset = 0;
+    m_used_before = 0;
+
+    // Merge the blocks so a working set that grew them fits in one next time
+    if (m_blocks.size() > 1) {
+        reserve(m_capacity);
+    }
+}
+
+
+// Make sure `p_capacity` bytes can be allocated without growing
+void ft::math::math_workspace::reserve(const std::size_t p_capacity)
+{
+    FT_ASSERT(m_block == 0 && m_offset == 0);
+
+    if (m_blocks.size() <= 1 && m_capacity >= p_capacity) {
+        return;
+    }
+
+    const auto capacity = std::max(p_capacity, m_capacity);
+    free_blocks();
+    add_block(capacity);
+}
+
+
+// Get the current memory use
+ft::math::math_workspace_statistics ft::math::math_workspace::get_statistics() const
+{
+    math_workspace_statistics result;
+    result.used = m_used_before + m_offset;
+    result.high_water_mark = m_high_water_mark;
+    result.capacity = m_capacity;
+    result.block_count = m_blocks.size();
+    result.growth_count = m_growth_count;
+    return result;
+}
+
+
+// Restart the high water mark from the current use
+void ft::math::math_workspace::reset_high_water_mark()
+{
+    m_high_water_mark = m_used_before + m_offset;
+}
+
+
+// Set the function called when the workspace grows, empty to remove it
+void ft::math::math_workspace::set_statistics_hook(statistics_hook p_hook)
+{
+    m_hook = std::move(p_hook);
+}
+
+
+// Add a block for an allocation of `p_size` bytes that did not fit
+void ft::math::math_workspace::grow(const std::size_t p_size)
+{
+    // Double the capacity to keep the number of blocks logarithmic
+    add_block(std::max({ p_size, m_capacity, math_workspace_default_block_size }));
+    m_growth_count += 1;
+
+    if (m_hook) {
+        m_hook(get_statistics());
+    }
+}
+
+
+// Add a block of `p_size` bytes after the last one
+void ft::math::math_workspace::add_block(const std::size_t p_size)
+{
+    const auto size = align_size(p_size);
+    auto * data = static_cast<std::byte *>(::operator new(size, std::align_val_t{ math_workspace_alignment }));
+    m_blocks.push_back({ data, size });
+    m_capacity += size;
+}
+
+
+// Free every block
+void ft::math::math_workspace::free_blocks()
+{
+    for (const auto & b : m_blocks) {
+        ::operator delete(b.data, std::align_val_t{ math_workspace_alignment });
+    }
+    m_blocks.clear();
+    m_capacity = 0;
+}
+
+
+// Mark `p_workspace`
+ft::math::math_workspace_scope::math_workspace_scope(math_workspace & p_workspace) :
+    m_workspace(p_workspace),
+    m_marker(p_workspace.mark())
+{
+}
+
+
+// Release to the mark
+ft::math::math_workspace_scope::~math_workspace_scope()
+{
+    m_workspace.release(m_marker);
+}
+
+
+// Get the workspace of the calling thread
+ft::math::math_workspace & ft::math::default_workspace()
+{
+    thread_local math_workspace workspace;
+    return workspace;
+}
@@ -0,0 +1,176 @@
+#pragma once
+
+// Scratch memory for the temporaries of heavy operations
+// A workspace is a bump allocator: allocations move a pointer forward and
+//  are given back all at once by releasing to a marker taken earlier
+// Memory is kept between uses, once the workspace has grown to the largest
+//  working set of a program, operations using it stop allocating
+//
+// Operations taking a workspace release everything they allocated before
+//  returning, so one workspace can be passed down a chain of calls
+// A workspace must only be used by one thread at a time, each thread has
+//  its own default workspace
+
+// standard headers
+#include <cstddef>  // std::size_t
+#include <functional>
+#include <span>
+#include <type_traits>
+#include <vector>
+
+namespace ft {
+namespace math {
+
+// Alignment of every allocation, enough for any vector register
+inline constexpr std::size_t math_workspace_alignment = 64;
+
+// Size of the first block of a workspace created without a capacity
+inline constexpr std::size_t math_workspace_default_block_size = 64 * 1024;
+
+
+// Memory use of a workspace
+struct math_workspace_statistics
+{
+    // Bytes currently allocated
+    // Includes the ends of blocks too small for a later allocation
+    std::size_t used = 0;
+
+    // Most bytes allocated at once since creation or the last `reset_high_water_mark`
+    // Passing it to `reserve` at startup avoids any later growth
+    std::size_t high_water_mark = 0;
+
+    // Bytes owned by the workspace
+    std::size_t capacity = 0;
+
+    // Number of blocks the capacity is split in
+    std::size_t block_count = 0;
+
+    // Number of times a new block had to be allocated
+    std::size_t growth_count = 0;
+};
+
+
+class math_workspace
+{
+public:
+    // Position to release to
+    struct marker
+    {
+        std::size_t block = 0;
+        std::size_t offset = 0;
+    };
+
+    // Called with the new statistics each time the workspace grows
+    using statistics_hook = std::function<void(const math_workspace_statistics &)>;
+
+public:
+    // Make a workspace with `p_capacity` bytes available
+    // Zero allocates nothing until the first allocation, which allocates
+    //  at least `math_workspace_default_block_size` bytes
+    explicit math_workspace(const std::size_t p_capacity = 0);
+
+    // Frees the blocks, nothing may still be in use
+    ~math_workspace();
+
+    math_workspace(const math_workspace &) = delete;
+    math_workspace & operator=(const math_workspace &) = delete;
+
+
+    // Allocate `p_count` uninitialized elements
+    // Only for trivially destructible types, no destructor is ever run
+    template<class T>
+    std::span<T> allocate(const std::size_t p_count);
+
+    // Allocate `p_size` uninitialized bytes aligned to `math_workspace_alignment`
+    void * allocate_bytes(const std::size_t p_size);
+
+
+    // Get the current position
+    marker mark() const;
+
+    // Give back every allocation made since `p_marker` was taken
+    void release(const marker & p_marker);
+
+    // Give back every allocation
+    // Blocks added by growth are merged into one so the next use is contiguous
+    void reset();
+
+
+    // Make sure `p_capacity` bytes can be allocated without growing
+    // Must be called with nothing in use
+    void reserve(const std::size_t p_capacity);
+
+    // Get the current memory use
+    math_workspace_statistics get_statistics() const;
+
+    // Restart the high water mark from the current use
+    void reset_high_water_mark();
+
+    // Set the function called when the workspace grows, empty to remove it
+    void set_statistics_hook(statistics_hook p_hook);
+
+private:
+    // Heap block allocations are carved from
+    struct block
+    {
+        std::byte * data = nullptr;
+        std::size_t size = 0;
+    };
+
+    // Add a block for an allocation of `p_size` bytes that did not fit
+    void grow(const std::size_t p_size);
+
+    // Add a block of `p_size` bytes after the last one
+    void add_block(const std::size_t p_size);
+
+    // Free every block
+    void free_blocks();
+
+private:
+    // Blocks in allocation order, those after `m_block` are empty
+    std::vector<block> m_blocks;
+
+    // Current block and offset in it
+    std::size_t m_block = 0;
+    std::size_t m_offset = 0;
+
+    // Bytes used in the blocks before `m_block`
+    std::size_t m_used_before = 0;
+
+    // Statistics
+    std::size_t m_capacity = 0;
+    std::size_t m_high_water_mark = 0;
+    std::size_t m_growth_count = 0;
+    statistics_hook m_hook;
+
+};  // class math_workspace
+
+
+// Releases a workspace to the position it had at construction
+class math_workspace_scope
+{
+public:
+    // Mark `p_workspace`
+    explicit math_workspace_scope(math_workspace & p_workspace);
+
+    // Release to the mark
+    ~math_workspace_scope();
+
+    math_workspace_scope(const math_workspace_scope &) = delete;
+    math_workspace_scope & operator=(const math_workspace_scope &) = delete;
+
+private:
+    math_workspace & m_workspace;
+    math_workspace::marker m_marker;
+
+};  // class math_workspace_scope
+
+
+// Get the workspace of the calling thread
+// Created on first use, freed when the thread exits
+math_workspace & default_workspace();
+
+};  // namespace math
+};  // namespace ft
+
+#include "math_workspace.hpp"
@@ -0,0 +1,16 @@
+#pragma once
+
+// Implements the templates of math_workspace.h
+
+// project headers
+#include "math_workspace.h"
+
+// Allocate `p_count` uninitialized elements
+template<class T>
+std::span<T> ft::math::math_workspace::allocate(const std::size_t p_count)
+{
+    static_assert(std::is_trivially_destructible_v<T>, "Workspace allocations are never destroyed");
+    static_assert(alignof(T) <= math_workspace_alignment, "Over aligned type");
+
+    return { static_cast<T *>(allocate_bytes(p_count * sizeof(T))), p_count };
+}
@@ -0,0 +1,106 @@
+#pragma once
+
+// Element wise comparison of two arrays of scalars, vectors or matrices,
+//  to find the elements that changed between two versions of an array
+// A vector or matrix differs when any of its components differs
+//
+// The comparison is given by one of the policies below, each decides if two
+//  scalars differ without branches
+// Elements are compared in blocks of 64: the components of a block are
+//  compared in one vectorized loop, then packed into a 64 bit mask, so the
+//  cost does not depend on how many elements changed
+// `any_differs` stops at the end of the first block holding a difference
+//
+// Results are bitmasks, bit `i % 64` of word `i / 64` is set when element
+//  `i` differs, or lists of the indices of the elements that differ
+
+// project headers
+#include "matrix/matrix.h"
+#include "vector/vector.h"
+
+// standard headers
+#include <cstddef>  // std::size_t
+#include <cstdint>
+#include <span>
+#include <vector>
+
+namespace ft {
+namespace math {
+
+// Values differ unless they are equal, same as operator==
+// NaN differs from everything, zeros of both signs are equal
+struct exact_comparison
+{
+    template<class T>
+    constexpr bool differs(const T p_left, const T p_right) const;
+};
+
+// Values differ when their difference is larger than `epsilon`
+// NaN differs from everything, equal infinities are equal
+template<class T>
+struct absolute_comparison
+{
+    T epsilon;
+
+    constexpr bool differs(const T p_left, const T p_right) const;
+};
+
+// Values differ when their difference is larger than `epsilon` times the
+//  largest magnitude of the two
+// NaN differs from everything, equal infinities are equal
+template<class T>
+struct relative_comparison
+{
+    T epsilon;
+
+    constexpr bool differs(const T p_left, const T p_right) const;
+};
+
+// Values differ when more than `max_ulps` representable values separate them
+// Only for float and double
+// NaN differs from everything, zeros of both signs are equal, the largest
+//  finite value is one unit away from infinity
+struct ulp_comparison
+{
+    std::uint64_t max_ulps;
+
+    template<class T>
+    constexpr bool differs(const T p_left, const T p_right) const;
+};
+
+
+// Number of 64 bit words in the mask of an array of `p_elements` elements
+constexpr std::size_t comparison_mask_size(const std::size_t p_elements);
+
+// Compare two arrays element by element
+// `E` is a floating point type, a `vector` or a `matrix` of floating points
+// Sets the bits of the elements that differ in `p_mask` and clears the
+//  others, bits past the last element are cleared
+// `p_mask` must hold at least `comparison_mask_size(p_left.size())` words
+// Returns the number of elements that differ
+template<class E, class C>
+std::size_t compare_batch(
+    std::span<const E> p_left,
+    std::span<const E> p_right,
+    const C & p_comparison,
+    std::span<std::uint64_t> p_mask);
+
+// Compare two arrays element by element
+// `p_indices` is overwritten with the indices of the elements that differ,
+//  in increasing order
+template<class E, class C>
+void find_differences(
+    std::span<const E> p_left,
+    std::span<const E> p_right,
+    const C & p_comparison,
+    std::vector<std::size_t> & p_indices);
+
+// Returns true if any element of two arrays differs
+// Stops at the first block of elements holding a difference
+template<class E, class C>
+bool any_differs(std::span<const E> p_left, std::span<const E> p_right, const C & p_comparison);
+
+};  // namespace math
+};  // namespace ft
+
+#include "batch_compare.hpp"
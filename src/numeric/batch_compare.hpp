@@ -0,0 +1,321 @@
+#pragma once
+
+// Implements the batch comparisons of batch_compare.h
+
+// project headers
+#include "batch_compare.h"
+
+// other headers
+#include "error/ft_assert.h"
+
+// standard headers
+#include <algorithm>
+#include <bit>
+#include <cmath>
+#include <cstring>
+#include <limits>
+#include <type_traits>
+
+namespace ft {
+namespace math {
+namespace details {
+namespace batch_compare_ns {
+
+// Elements compared per mask word
+constexpr std::size_t block_size = 64;
+
+
+// Layout of an array element as consecutive scalars
+template<class E>
+struct element_layout
+{
+    static_assert(std::is_floating_point_v<E>, "Elements are floating points, vectors or matrices");
+
+    using value_type = E;
+    static constexpr std::size_t components = 1;
+
+    static const E * data(std::span<const E> p_elements) { return p_elements.data(); }
+};
+
+template<class T, std::size_t S>
+struct element_layout<vector<T, S>>
+{
+    static_assert(std::is_floating_point_v<T>, "Elements are floating points, vectors or matrices");
+    static_assert(sizeof(vector<T, S>) == S * sizeof(T));
+
+    using value_type = T;
+    static constexpr std::size_t components = S;
+
+    static const T * data(std::span<const vector<T, S>> p_elements)
+    {
+        return p_elements.empty() ? nullptr : p_elements.front().data();
+    }
+};
+
+template<class T, std::size_t R, std::size_t C>
+struct element_layout<matrix<T, R, C>>
+{
+    static_assert(std::is_floating_point_v<T>, "Elements are floating points, vectors or matrices");
+    static_assert(sizeof(matrix<T, R, C>) == R * C * sizeof(T));
+
+    using value_type = T;
+    static constexpr std::size_t components = R * C;
+
+    static const T * data(std::span<const matrix<T, R, C>> p_elements)
+    {
+        return p_elements.empty() ? nullptr : p_elements.front().data();
+    }
+};
+
+
+// Signed and unsigned integers with the size of `T` when `T` is float or double
+template<class T>
+using signed_bits = std::conditional_t<std::is_same_v<T, double>, std::int64_t, std::int32_t>;
+template<class T>
+using unsigned_bits = std::make_unsigned_t<signed_bits<T>>;
+
+// Map a value to an integer in the order of the values
+// Consecutive values map to consecutive integers, both zeros map to zero
+template<class T>
+constexpr signed_bits<T> to_ordered(const T p_value)
+{
+    using I = signed_bits<T>;
+
+    const auto bits = std::bit_cast<I>(p_value);
+    const auto sign = bits >> (sizeof(I) * 8 - 1);
+    const auto magnitude = bits & std::numeric_limits<I>::max();
+
+    // Negate the magnitude of negative values
+    return (magnitude ^ sign) - sign;
+}
+
+
+// Pack 8 flags of 0 or 1 into the bits of a byte, the first flag in the
+//  lowest bit
+inline std::uint64_t pack_flags(const unsigned char * p_flags)
+{
+    std::uint64_t flags;
+    std::memcpy(&flags, p_flags, sizeof(flags));
+
+    // The multiplication shifts the flag of every byte to its bit of the top
+    //  byte, the other partial products never reach it
+    constexpr std::uint64_t gather = (std::endian::native == std::endian::little) ?
+        0x0102040810204080 :
+        0x8040201008040201;
+    return (flags * gather) >> 56;
+}
+
+
+// Compare the elements of a block
+// Returns the mask of the elements that differ
+template<std::size_t K, class T, class C>
+inline std::uint64_t compare_block(const T * p_left, const T * p_right, const C & p_comparison)
+{
+    // Compare all components in one loop the compiler vectorizes
+    unsigned char differs[block_size * K];
+    for (std::size_t i = 0; i < block_size * K; ++i) {
+        differs[i] = p_comparison.differs(p_left[i], p_right[i]);
+    }
+
+    // An element differs when any of its components differs
+    unsigned char elements[block_size];
+    if constexpr (K == 1)
+    {
+        std::memcpy(elements, differs, block_size);
+    }
+    else
+    {
+        for (std::size_t i = 0; i < block_size; ++i)
+        {
+            unsigned char element = 0;
+            for (std::size_t k = 0; k < K; ++k) {
+                element |= differs[i * K + k];
+            }
+            elements[i] = element;
+        }
+    }
+
+    std::uint64_t mask = 0;
+    for (std::size_t i = 0; i < block_size; i += 8) {
+        mask |= pack_flags(elements + i) << i;
+    }
+    return mask;
+}
+
+
+// Compare two arrays block by block
+// Calls `p_visitor(block_index, mask)` for every block
+template<class E, class C, class V>
+void compare_blocks(std::span<const E> p_left, std::span<const E> p_right, const C & p_comparison, V && p_visitor)
+{
+    FT_ASSERT(p_left.size() == p_right.size());
+
+    using layout = element_layout<E>;
+    using T = typename layout::value_type;
+    constexpr auto components = layout::components;
+
+    const auto * left = layout::data(p_left);
+    const auto * right = layout::data(p_right);
+    const auto size = p_left.size();
+    const auto full_blocks = size / block_size;
+
+    for (std::size_t block = 0; block < full_blocks; ++block)
+    {
+        const auto offset = block * block_size * components;
+        p_visitor(block, compare_block<components>(left + offset, right + offset, p_comparison));
+    }
+
+    const auto remainder = size - full_blocks * block_size;
+    if (remainder != 0)
+    {
+        // Pad the last block with zeros, which never differ
+        T left_block[block_size * components] = {};
+        T right_block[block_size * components] = {};
+
+        const auto offset = full_blocks * block_size * components;
+        std::copy_n(left + offset, remainder * components, left_block);
+        std::copy_n(right + offset, remainder * components, right_block);
+        p_visitor(full_blocks, compare_block<components>(left_block, right_block, p_comparison));
+    }
+}
+
+};  // namespace batch_compare_ns
+};  // namespace details
+};  // namespace math
+};  // namespace ft
+
+
+// Values differ unless they are equal
+template<class T>
+constexpr bool ft::math::exact_comparison::differs(const T p_left, const T p_right) const
+{
+    return p_left != p_right;
+}
+
+
+// Values differ when their difference is larger than `epsilon`
+template<class T>
+constexpr bool ft::math::absolute_comparison<T>::differs(const T p_left, const T p_right) const
+{
+    // Equal infinities have a NaN difference, they are tested separately
+    return !((p_left == p_right) | (std::abs(p_left - p_right) <= epsilon));
+}
+
+
+// Values differ when their difference is larger than `epsilon` times the
+//  largest magnitude of the two
+template<class T>
+constexpr bool ft::math::relative_comparison<T>::differs(const T p_left, const T p_right) const
+{
+    const auto magnitude = std::max(std::abs(p_left), std::abs(p_right));
+    return !((p_left == p_right) | (std::abs(p_left - p_right) <= epsilon * magnitude));
+}
+
+
+// Values differ when more than `max_ulps` representable values separate them
+template<class T>
+constexpr bool ft::math::ulp_comparison::differs(const T p_left, const T p_right) const
+{
+    static_assert(
+        std::is_same_v<T, float> || std::is_same_v<T, double>,
+        "ULP distances are computed from the float or double bit patterns");
+
+    using U = details::batch_compare_ns::unsigned_bits<T>;
+
+    const auto left = details::batch_compare_ns::to_ordered(p_left);
+    const auto right = details::batch_compare_ns::to_ordered(p_right);
+
+    // The difference of two ordered values always fits in the unsigned type
+    const auto difference = static_cast<U>(left) - static_cast<U>(right);
+    const auto distance = left < right ? U{ 0 } - difference : difference;
+
+    const auto limit = static_cast<U>(std::min<std::uint64_t>(max_ulps, std::numeric_limits<U>::max()));
+    const auto is_nan = (p_left != p_left) | (p_right != p_right);
+    return (distance > limit) | is_nan;
+}
+
+
+// Number of 64 bit words in the mask of an array of `p_elements` elements
+constexpr std::size_t ft::math::comparison_mask_size(const std::size_t p_elements)
+{
+    return (p_elements + details::batch_compare_ns::block_size - 1) / details::batch_compare_ns::block_size;
+}
+
+
+// Compare two arrays element by element
+template<class E, class C>
+std::size_t ft::math::compare_batch(
+    std::span<const E> p_left,
+    std::span<const E> p_right,
+    const C & p_comparison,
+    std::span<std::uint64_t> p_mask)
+{
+    FT_ASSERT(p_mask.size() >= comparison_mask_size(p_left.size()));
+
+    std::size_t count = 0;
+    details::batch_compare_ns::compare_blocks(p_left, p_right, p_comparison,
+        [&](const std::size_t p_block, const std::uint64_t p_bits)
+        {
+            p_mask[p_block] = p_bits;
+            count += std::popcount(p_bits);
+        });
+    return count;
+}
+
+
+// Compare two arrays element by element
+template<class E, class C>
+void ft::math::find_differences(
+    std::span<const E> p_left,
+    std::span<const E> p_right,
+    const C & p_comparison,
+    std::vector<std::size_t> & p_indices)
+{
+    p_indices.clear();
+    details::batch_compare_ns::compare_blocks(p_left, p_right, p_comparison,
+        [&](const std::size_t p_block, std::uint64_t p_bits)
+        {
+            // Visit the set bits only, unchanged blocks cost one test
+            while (p_bits != 0)
+            {
+                p_indices.push_back(p_block * details::batch_compare_ns::block_size + std::countr_zero(p_bits));
+                p_bits &= p_bits - 1;
+            }
+        });
+}
+
+
+// Returns true if any element of two arrays differs
+template<class E, class C>
+bool ft::math::any_differs(std::span<const E> p_left, std::span<const E> p_right, const C & p_comparison)
+{
+    FT_ASSERT(p_left.size() == p_right.size());
+
+    using layout = details::batch_compare_ns::element_layout<E>;
+    constexpr auto block_size = details::batch_compare_ns::block_size * layout::components;
+
+    // The elements do not need to be told apart, compare the arrays as scalars
+    const auto * left = layout::data(p_left);
+    const auto * right = layout::data(p_right);
+    const auto size = p_left.size() * layout::components;
+    const auto full_blocks_end = size - size % block_size;
+
+    for (std::size_t offset = 0; offset < full_blocks_end; offset += block_size)
+    {
+        // Accumulate without branches so the block is compared in one vectorized loop
+        unsigned char differs = 0;
+        for (std::size_t i = 0; i < block_size; ++i) {
+            differs |= p_comparison.differs(left[offset + i], right[offset + i]);
+        }
+
+        if (differs) {
+            return true;
+        }
+    }
+
+    unsigned char differs = 0;
+    for (std::size_t i = full_blocks_end; i < size; ++i) {
+        differs |= p_comparison.differs(left[i], right[i]);
+    }
+    return differs != 0;
+}
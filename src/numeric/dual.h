@@ -0,0 +1,208 @@
+#pragma once
+
+// Dual numbers for forward mode automatic differentiation
+//
+// A `dual<T, N>` holds a value and its partial derivatives with respect to
+//  `N` independent variables, every operation applies the chain rule to all
+//  of them at once: evaluating a function of `N` variables on duals gives its
+//  value and its full gradient in a single pass, and evaluating a function
+//  returning a vector gives the full Jacobian (one row per output)
+//
+// Duals can be used as the element type of `vector`, `matrix` and
+//  `quaternion`, generic code must call the math functions unqualified
+//  (`using std::sqrt; sqrt(x)`) so the overloads below are found
+//
+// The derivatives are stored contiguously and every operation updates them
+//  with a plain loop over the `N` lanes, which the compiler turns into packed
+//  SIMD instructions: a product of duals costs two packed multiply-adds
+//  instead of `2 * N` scalar ones
+// Comparisons only look at the values, branching on a comparison
+//  differentiates the branch taken
+
+// project headers
+#include "matrix/matrix.h"
+#include "vector/vector.h"
+
+// standard headers
+#include <array>
+#include <compare>
+#include <cstddef>  // std::size_t
+#include <type_traits>
+
+namespace ft {
+namespace math {
+
+template<class T, std::size_t N>
+class dual
+{
+    static_assert(std::is_floating_point_v<T>, "Dual numbers hold floating point values");
+    static_assert(N > 0, "Dual numbers need at least one variable");
+
+public:
+    using value_type = T;
+    using derivatives_type = std::array<T, N>;
+    static constexpr auto variables = N;
+
+public:
+    // Default constructor
+    // Values are uninitialized, value initialization sets them to zero
+    constexpr dual() = default;
+
+    // Initialize to a constant, all derivatives are zero
+    constexpr dual(const T p_value);
+
+    // Initialize to these values
+    constexpr dual(const T p_value, const derivatives_type & p_derivatives);
+
+
+    // Get the value
+    constexpr T get_value() const;
+
+    // Get the derivatives with respect to every variable
+    constexpr const derivatives_type & get_derivatives() const;
+
+    // Get the derivative with respect to one variable
+    constexpr T get_derivative(const std::size_t p_variable) const;
+
+
+    // Set the value, the derivatives are unchanged
+    constexpr void set_value(const T p_value);
+
+    // Set the derivative with respect to one variable
+    constexpr void set_derivative(const std::size_t p_variable, const T p_derivative);
+
+
+    // Arithmetic operators
+    constexpr dual & operator+=(const dual & p_other);
+    constexpr dual & operator-=(const dual & p_other);
+    constexpr dual & operator*=(const dual & p_other);
+    constexpr dual & operator/=(const dual & p_other);
+
+    // Arithmetic operators with a constant
+    constexpr dual & operator+=(const T p_scalar);
+    constexpr dual & operator-=(const T p_scalar);
+    constexpr dual & operator*=(const T p_scalar);
+    constexpr dual & operator/=(const T p_scalar);
+
+private:
+    T m_value;
+    derivatives_type m_derivatives;
+
+};  // class dual
+
+
+// Check if a type is a dual number
+template<class T>
+struct is_dual : std::false_type {};
+
+template<class T, std::size_t N>
+struct is_dual<dual<T, N>> : std::true_type {};
+
+template<class T>
+constexpr bool is_dual_v = is_dual<T>::value;
+
+
+// Unary minus
+template<class T, std::size_t N>
+constexpr dual<T, N> operator-(const dual<T, N> & p_value);
+
+// Arithmetic operators
+template<class T, std::size_t N>
+constexpr dual<T, N> operator+(dual<T, N> p_left, const dual<T, N> & p_right);
+template<class T, std::size_t N>
+constexpr dual<T, N> operator-(dual<T, N> p_left, const dual<T, N> & p_right);
+template<class T, std::size_t N>
+constexpr dual<T, N> operator*(dual<T, N> p_left, const dual<T, N> & p_right);
+template<class T, std::size_t N>
+constexpr dual<T, N> operator/(dual<T, N> p_left, const dual<T, N> & p_right);
+
+// Arithmetic operators with a constant
+// The constant is not deduced, integer literals convert to `T`
+template<class T, std::size_t N>
+constexpr dual<T, N> operator+(dual<T, N> p_left, const std::type_identity_t<T> p_right);
+template<class T, std::size_t N>
+constexpr dual<T, N> operator+(const std::type_identity_t<T> p_left, dual<T, N> p_right);
+template<class T, std::size_t N>
+constexpr dual<T, N> operator-(dual<T, N> p_left, const std::type_identity_t<T> p_right);
+template<class T, std::size_t N>
+constexpr dual<T, N> operator-(const std::type_identity_t<T> p_left, const dual<T, N> & p_right);
+template<class T, std::size_t N>
+constexpr dual<T, N> operator*(dual<T, N> p_left, const std::type_identity_t<T> p_right);
+template<class T, std::size_t N>
+constexpr dual<T, N> operator*(const std::type_identity_t<T> p_left, dual<T, N> p_right);
+template<class T, std::size_t N>
+constexpr dual<T, N> operator/(dual<T, N> p_left, const std::type_identity_t<T> p_right);
+template<class T, std::size_t N>
+constexpr dual<T, N> operator/(const std::type_identity_t<T> p_left, const dual<T, N> & p_right);
+
+// Compare the values, the derivatives are ignored
+template<class T, std::size_t N>
+constexpr bool operator==(const dual<T, N> & p_left, const dual<T, N> & p_right);
+template<class T, std::size_t N>
+constexpr bool operator==(const dual<T, N> & p_left, const std::type_identity_t<T> p_right);
+template<class T, std::size_t N>
+constexpr std::partial_ordering operator<=>(const dual<T, N> & p_left, const dual<T, N> & p_right);
+template<class T, std::size_t N>
+constexpr std::partial_ordering operator<=>(const dual<T, N> & p_left, const std::type_identity_t<T> p_right);
+
+
+// Elementary functions
+// Found by argument dependent lookup from generic code
+template<class T, std::size_t N>
+dual<T, N> sqrt(const dual<T, N> & p_value);
+template<class T, std::size_t N>
+dual<T, N> abs(const dual<T, N> & p_value);
+template<class T, std::size_t N>
+dual<T, N> sin(const dual<T, N> & p_value);
+template<class T, std::size_t N>
+dual<T, N> cos(const dual<T, N> & p_value);
+template<class T, std::size_t N>
+dual<T, N> asin(const dual<T, N> & p_value);
+template<class T, std::size_t N>
+dual<T, N> acos(const dual<T, N> & p_value);
+template<class T, std::size_t N>
+dual<T, N> atan2(const dual<T, N> & p_y, const dual<T, N> & p_x);
+template<class T, std::size_t N>
+dual<T, N> exp(const dual<T, N> & p_value);
+template<class T, std::size_t N>
+dual<T, N> log(const dual<T, N> & p_value);
+
+
+// Make an independent variable
+// Its derivative is one with respect to itself and zero for the others
+template<std::size_t N, class T>
+constexpr dual<T, N> make_dual_variable(const T p_value, const std::size_t p_variable);
+
+// Make a vector of independent variables, one per element
+template<class T, std::size_t S>
+constexpr vector<dual<T, S>, S> make_dual_vector(const vector<T, S> & p_values);
+
+// Make a vector of independent variables, one per element
+// Element `i` is the variable `p_first_variable + i` out of `N`, several
+//  inputs can be differentiated together by giving them consecutive variables
+template<std::size_t N, class T, std::size_t S>
+constexpr vector<dual<T, N>, S> make_dual_vector(const vector<T, S> & p_values, const std::size_t p_first_variable);
+
+// Make a matrix of independent variables, one per element
+// Element (row, col) is the variable `row * C + col`
+template<class T, std::size_t R, std::size_t C>
+constexpr matrix<dual<T, R * C>, R, C> make_dual_matrix(const matrix<T, R, C> & p_values);
+
+
+// Get the values of a vector of duals
+template<class T, std::size_t N, std::size_t S>
+constexpr vector<T, S> get_values(const vector<dual<T, N>, S> & p_vector);
+
+// Get the derivatives of a dual as a vector
+template<class T, std::size_t N>
+constexpr vector<T, N> get_gradient(const dual<T, N> & p_value);
+
+// Get the derivatives of a vector of duals
+// Row `i` holds the derivatives of element `i`
+template<class T, std::size_t N, std::size_t S>
+constexpr matrix<T, S, N> get_jacobian(const vector<dual<T, N>, S> & p_vector);
+
+};  // namespace math
+};  // namespace ft
+
+#include "dual.hpp"
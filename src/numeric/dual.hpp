@@ -0,0 +1,506 @@
+#pragma once
+
+// Implements the dual numbers of dual.h
+
+#include "dual.h"
+
+// other headers
+#include "error/ft_assert.h"
+
+// standard headers
+#include <cmath>
+
+namespace ft {
+namespace math {
+namespace details {
+namespace dual_ns {
+
+// Apply a function to a dual given its value and derivative at the value
+// Chain rule: every derivative is scaled by the derivative of the function
+template<class T, std::size_t N>
+constexpr dual<T, N> chain(const dual<T, N> & p_argument, const T p_value, const T p_derivative)
+{
+    const auto & argument = p_argument.get_derivatives();
+
+    typename dual<T, N>::derivatives_type derivatives;
+    for (std::size_t i = 0; i < N; ++i) {
+        derivatives[i] = argument[i] * p_derivative;
+    }
+    return { p_value, derivatives };
+}
+
+};  // namespace dual_ns
+};  // namespace details
+};  // namespace math
+};  // namespace ft
+
+
+// Initialize to a constant, all derivatives are zero
+template<class T, std::size_t N>
+constexpr ft::math::dual<T, N>::dual(const T p_value) :
+    m_value(p_value),
+    m_derivatives{}
+{
+}
+
+
+// Initialize to these values
+template<class T, std::size_t N>
+constexpr ft::math::dual<T, N>::dual(const T p_value, const derivatives_type & p_derivatives) :
+    m_value(p_value),
+    m_derivatives(p_derivatives)
+{
+}
+
+
+// Get the value
+template<class T, std::size_t N>
+constexpr T ft::math::dual<T, N>::get_value() const
+{
+    return m_value;
+}
+
+
+// Get the derivatives with respect to every variable
+template<class T, std::size_t N>
+constexpr const typename ft::math::dual<T, N>::derivatives_type & ft::math::dual<T, N>::get_derivatives() const
+{
+    return m_derivatives;
+}
+
+
+// Get the derivative with respect to one variable
+template<class T, std::size_t N>
+constexpr T ft::math::dual<T, N>::get_derivative(const std::size_t p_variable) const
+{
+    FT_ASSERT(p_variable < N);
+    return m_derivatives[p_variable];
+}
+
+
+// Set the value, the derivatives are unchanged
+template<class T, std::size_t N>
+constexpr void ft::math::dual<T, N>::set_value(const T p_value)
+{
+    m_value = p_value;
+}
+
+
+// Set the derivative with respect to one variable
+template<class T, std::size_t N>
+constexpr void ft::math::dual<T, N>::set_derivative(const std::size_t p_variable, const T p_derivative)
+{
+    FT_ASSERT(p_variable < N);
+    m_derivatives[p_variable] = p_derivative;
+}
+
+
+// Addition
+template<class T, std::size_t N>
+constexpr ft::math::dual<T, N> & ft::math::dual<T, N>::operator+=(const dual & p_other)
+{
+    m_value += p_other.m_value;
+    for (std::size_t i = 0; i < N; ++i) {
+        m_derivatives[i] += p_other.m_derivatives[i];
+    }
+    return *this;
+}
+
+
+// Subtraction
+template<class T, std::size_t N>
+constexpr ft::math::dual<T, N> & ft::math::dual<T, N>::operator-=(const dual & p_other)
+{
+    m_value -= p_other.m_value;
+    for (std::size_t i = 0; i < N; ++i) {
+        m_derivatives[i] -= p_other.m_derivatives[i];
+    }
+    return *this;
+}
+
+
+// Multiplication
+// (a * b)' = a' * b + a * b'
+template<class T, std::size_t N>
+constexpr ft::math::dual<T, N> & ft::math::dual<T, N>::operator*=(const dual & p_other)
+{
+    for (std::size_t i = 0; i < N; ++i) {
+        m_derivatives[i] = m_derivatives[i] * p_other.m_value + m_value * p_other.m_derivatives[i];
+    }
+    m_value *= p_other.m_value;
+    return *this;
+}
+
+
+// Division
+// (a / b)' = (a' - (a / b) * b') / b
+template<class T, std::size_t N>
+constexpr ft::math::dual<T, N> & ft::math::dual<T, N>::operator/=(const dual & p_other)
+{
+    const auto inverse = 1 / p_other.m_value;
+    m_value *= inverse;
+    for (std::size_t i = 0; i < N; ++i) {
+        m_derivatives[i] = (m_derivatives[i] - m_value * p_other.m_derivatives[i]) * inverse;
+    }
+    return *this;
+}
+
+
+// Add a constant
+template<class T, std::size_t N>
+constexpr ft::math::dual<T, N> & ft::math::dual<T, N>::operator+=(const T p_scalar)
+{
+    m_value += p_scalar;
+    return *this;
+}
+
+
+// Subtract a constant
+template<class T, std::size_t N>
+constexpr ft::math::dual<T, N> & ft::math::dual<T, N>::operator-=(const T p_scalar)
+{
+    m_value -= p_scalar;
+    return *this;
+}
+
+
+// Multiply by a constant
+template<class T, std::size_t N>
+constexpr ft::math::dual<T, N> & ft::math::dual<T, N>::operator*=(const T p_scalar)
+{
+    m_value *= p_scalar;
+    for (std::size_t i = 0; i < N; ++i) {
+        m_derivatives[i] *= p_scalar;
+    }
+    return *this;
+}
+
+
+// Divide by a constant
+template<class T, std::size_t N>
+constexpr ft::math::dual<T, N> & ft::math::dual<T, N>::operator/=(const T p_scalar)
+{
+    return *this *= 1 / p_scalar;
+}
+
+
+// Unary minus
+template<class T, std::size_t N>
+constexpr ft::math::dual<T, N> ft::math::operator-(const dual<T, N> & p_value)
+{
+    return p_value * -1;
+}
+
+
+// Addition
+template<class T, std::size_t N>
+constexpr ft::math::dual<T, N> ft::math::operator+(dual<T, N> p_left, const dual<T, N> & p_right)
+{
+    return p_left += p_right;
+}
+
+
+// Subtraction
+template<class T, std::size_t N>
+constexpr ft::math::dual<T, N> ft::math::operator-(dual<T, N> p_left, const dual<T, N> & p_right)
+{
+    return p_left -= p_right;
+}
+
+
+// Multiplication
+template<class T, std::size_t N>
+constexpr ft::math::dual<T, N> ft::math::operator*(dual<T, N> p_left, const dual<T, N> & p_right)
+{
+    return p_left *= p_right;
+}
+
+
+// Division
+template<class T, std::size_t N>
+constexpr ft::math::dual<T, N> ft::math::operator/(dual<T, N> p_left, const dual<T, N> & p_right)
+{
+    return p_left /= p_right;
+}
+
+
+// Add a constant
+template<class T, std::size_t N>
+constexpr ft::math::dual<T, N> ft::math::operator+(dual<T, N> p_left, const std::type_identity_t<T> p_right)
+{
+    return p_left += p_right;
+}
+
+
+// Add a constant
+template<class T, std::size_t N>
+constexpr ft::math::dual<T, N> ft::math::operator+(const std::type_identity_t<T> p_left, dual<T, N> p_right)
+{
+    return p_right += p_left;
+}
+
+
+// Subtract a constant
+template<class T, std::size_t N>
+constexpr ft::math::dual<T, N> ft::math::operator-(dual<T, N> p_left, const std::type_identity_t<T> p_right)
+{
+    return p_left -= p_right;
+}
+
+
+// Subtract from a constant
+template<class T, std::size_t N>
+constexpr ft::math::dual<T, N> ft::math::operator-(const std::type_identity_t<T> p_left, const dual<T, N> & p_right)
+{
+    return -p_right + p_left;
+}
+
+
+// Multiply by a constant
+template<class T, std::size_t N>
+constexpr ft::math::dual<T, N> ft::math::operator*(dual<T, N> p_left, const std::type_identity_t<T> p_right)
+{
+    return p_left *= p_right;
+}
+
+
+// Multiply by a constant
+template<class T, std::size_t N>
+constexpr ft::math::dual<T, N> ft::math::operator*(const std::type_identity_t<T> p_left, dual<T, N> p_right)
+{
+    return p_right *= p_left;
+}
+
+
+// Divide by a constant
+template<class T, std::size_t N>
+constexpr ft::math::dual<T, N> ft::math::operator/(dual<T, N> p_left, const std::type_identity_t<T> p_right)
+{
+    return p_left /= p_right;
+}
+
+
+// Divide a constant
+// (c / b)' = -(c / b) * b' / b
+template<class T, std::size_t N>
+constexpr ft::math::dual<T, N> ft::math::operator/(const std::type_identity_t<T> p_left, const dual<T, N> & p_right)
+{
+    const auto inverse = 1 / p_right.get_value();
+    const auto value = p_left * inverse;
+    return details::dual_ns::chain(p_right, value, -value * inverse);
+}
+
+
+// Compare the values, the derivatives are ignored
+template<class T, std::size_t N>
+constexpr bool ft::math::operator==(const dual<T, N> & p_left, const dual<T, N> & p_right)
+{
+    return p_left.get_value() == p_right.get_value();
+}
+
+
+// Compare the values, the derivatives are ignored
+template<class T, std::size_t N>
+constexpr bool ft::math::operator==(const dual<T, N> & p_left, const std::type_identity_t<T> p_right)
+{
+    return p_left.get_value() == p_right;
+}
+
+
+// Compare the values, the derivatives are ignored
+template<class T, std::size_t N>
+constexpr std::partial_ordering ft::math::operator<=>(const dual<T, N> & p_left, const dual<T, N> & p_right)
+{
+    return p_left.get_value() <=> p_right.get_value();
+}
+
+
+// Compare the values, the derivatives are ignored
+template<class T, std::size_t N>
+constexpr std::partial_ordering ft::math::operator<=>(const dual<T, N> & p_left, const std::type_identity_t<T> p_right)
+{
+    return p_left.get_value() <=> p_right;
+}
+
+
+// Square root
+// The derivative is infinite at zero
+template<class T, std::size_t N>
+ft::math::dual<T, N> ft::math::sqrt(const dual<T, N> & p_value)
+{
+    const auto root = std::sqrt(p_value.get_value());
+    return details::dual_ns::chain(p_value, root, T(0.5) / root);
+}
+
+
+// Absolute value
+// The derivative at zero is taken from the positive side
+template<class T, std::size_t N>
+ft::math::dual<T, N> ft::math::abs(const dual<T, N> & p_value)
+{
+    const auto value = p_value.get_value();
+    return details::dual_ns::chain(p_value, std::abs(value), value < 0 ? T(-1) : T(1));
+}
+
+
+// Sine
+template<class T, std::size_t N>
+ft::math::dual<T, N> ft::math::sin(const dual<T, N> & p_value)
+{
+    const auto value = p_value.get_value();
+    return details::dual_ns::chain(p_value, std::sin(value), std::cos(value));
+}
+
+
+// Cosine
+template<class T, std::size_t N>
+ft::math::dual<T, N> ft::math::cos(const dual<T, N> & p_value)
+{
+    const auto value = p_value.get_value();
+    return details::dual_ns::chain(p_value, std::cos(value), -std::sin(value));
+}
+
+
+// Arc sine
+// The derivative is infinite at -1 and 1
+template<class T, std::size_t N>
+ft::math::dual<T, N> ft::math::asin(const dual<T, N> & p_value)
+{
+    const auto value = p_value.get_value();
+    return details::dual_ns::chain(p_value, std::asin(value), 1 / std::sqrt(1 - value * value));
+}
+
+
+// Arc cosine
+// The derivative is infinite at -1 and 1
+template<class T, std::size_t N>
+ft::math::dual<T, N> ft::math::acos(const dual<T, N> & p_value)
+{
+    const auto value = p_value.get_value();
+    return details::dual_ns::chain(p_value, std::acos(value), -1 / std::sqrt(1 - value * value));
+}
+
+
+// Angle of the point (x, y)
+// atan2(y, x)' = (x * y' - y * x') / (x^2 + y^2)
+template<class T, std::size_t N>
+ft::math::dual<T, N> ft::math::atan2(const dual<T, N> & p_y, const dual<T, N> & p_x)
+{
+    const auto y = p_y.get_value();
+    const auto x = p_x.get_value();
+    const auto inverse = 1 / (x * x + y * y);
+
+    const auto & dy = p_y.get_derivatives();
+    const auto & dx = p_x.get_derivatives();
+
+    typename dual<T, N>::derivatives_type derivatives;
+    for (std::size_t i = 0; i < N; ++i) {
+        derivatives[i] = (x * dy[i] - y * dx[i]) * inverse;
+    }
+    return { std::atan2(y, x), derivatives };
+}
+
+
+// Exponential
+template<class T, std::size_t N>
+ft::math::dual<T, N> ft::math::exp(const dual<T, N> & p_value)
+{
+    const auto value = std::exp(p_value.get_value());
+    return details::dual_ns::chain(p_value, value, value);
+}
+
+
+// Natural logarithm
+template<class T, std::size_t N>
+ft::math::dual<T, N> ft::math::log(const dual<T, N> & p_value)
+{
+    const auto value = p_value.get_value();
+    return details::dual_ns::chain(p_value, std::log(value), 1 / value);
+}
+
+
+// Make an independent variable
+// Its derivative is one with respect to itself and zero for the others
+template<std::size_t N, class T>
+constexpr ft::math::dual<T, N> ft::math::make_dual_variable(const T p_value, const std::size_t p_variable)
+{
+    auto result = dual<T, N>(p_value);
+    result.set_derivative(p_variable, 1);
+    return result;
+}
+
+
+// Make a vector of independent variables, one per element
+template<class T, std::size_t S>
+constexpr ft::math::vector<ft::math::dual<T, S>, S> ft::math::make_dual_vector(const vector<T, S> & p_values)
+{
+    return make_dual_vector<S>(p_values, 0);
+}
+
+
+// Make a vector of independent variables, one per element
+template<std::size_t N, class T, std::size_t S>
+constexpr ft::math::vector<ft::math::dual<T, N>, S> ft::math::make_dual_vector(
+    const vector<T, S> & p_values,
+    const std::size_t p_first_variable)
+{
+    FT_ASSERT(p_first_variable + S <= N);
+
+    vector<dual<T, N>, S> result;
+    for (std::size_t i = 0; i < S; ++i) {
+        result[i] = make_dual_variable<N>(p_values[i], p_first_variable + i);
+    }
+    return result;
+}
+
+
+// Make a matrix of independent variables, one per element
+template<class T, std::size_t R, std::size_t C>
+constexpr ft::math::matrix<ft::math::dual<T, R * C>, R, C> ft::math::make_dual_matrix(const matrix<T, R, C> & p_values)
+{
+    matrix<dual<T, R * C>, R, C> result;
+    for (std::size_t row = 0; row < R; ++row)
+    {
+        for (std::size_t col = 0; col < C; ++col) {
+            result[row][col] = make_dual_variable<R * C>(p_values[row][col], row * C + col);
+        }
+    }
+    return result;
+}
+
+
+// Get the values of a vector of duals
+template<class T, std::size_t N, std::size_t S>
+constexpr ft::math::vector<T, S> ft::math::get_values(const vector<dual<T, N>, S> & p_vector)
+{
+    vector<T, S> result;
+    for (std::size_t i = 0; i < S; ++i) {
+        result[i] = p_vector[i].get_value();
+    }
+    return result;
+}
+
+
+// Get the derivatives of a dual as a vector
+template<class T, std::size_t N>
+constexpr ft::math::vector<T, N> ft::math::get_gradient(const dual<T, N> & p_value)
+{
+    return vector<T, N>(p_value.get_derivatives());
+}
+
+
+// Get the derivatives of a vector of duals
+// Row `i` holds the derivatives of element `i`
+template<class T, std::size_t N, std::size_t S>
+constexpr ft::math::matrix<T, S, N> ft::math::get_jacobian(const vector<dual<T, N>, S> & p_vector)
+{
+    matrix<T, S, N> result;
+    for (std::size_t row = 0; row < S; ++row)
+    {
+        const auto & derivatives = p_vector[row].get_derivatives();
+        for (std::size_t col = 0; col < N; ++col) {
+            result[row][col] = derivatives[col];
+        }
+    }
+    return result;
+}
@@ -0,0 +1,117 @@
+#pragma once
+
+// Polynomial approximations of elementary functions for float and double
+//
+// Every function is branch free: range reduction, polynomial evaluation and
+//  special cases use arithmetic and selects only, so loops calling them over
+//  arrays (the batch functions below) can be vectorized by the compiler,
+//  unlike loops calling the std functions
+// The compiler must be allowed to evaluate both sides of the selects and to
+//  vectorize the square root, which needs -fno-trapping-math and
+//  -fno-math-errno with GCC
+//
+// Two accuracy tiers are available, the error bounds below are the largest
+//  measured against a long double reference, in units in the last place
+//
+//                      float                   double
+//                  fast      precise       fast        precise
+//  sin, cos        77        2             1.3e5       2
+//  asin, acos      106       3             5.6e5       3
+//  atan, atan2     32        3             2.1e4       3
+//  exp             168       2             1.4e6       2
+//  log             7         2             1.1e5       2
+//
+// sin and cos reduce their argument in double with a three part Cody-Waite
+//  splitting of pi / 2, the bounds hold for |x| <= 2^30, larger arguments
+//  give unspecified results
+// Infinities and NaNs give the same results as the std functions
+
+// standard headers
+#include <span>
+
+namespace ft {
+namespace math {
+
+// Accuracy of the approximations
+enum class approximation_tier
+{
+    // Fewer polynomial terms, relative errors around 1e-5 in float
+    //  and 1e-10 in double
+    fast,
+
+    // Within a few units in the last place
+    precise
+};
+
+
+// Compute the sine and cosine of an angle in radians
+template<approximation_tier A = approximation_tier::precise, class T>
+void approx_sincos(const T p_angle, T & p_sine, T & p_cosine);
+
+// Compute the sine of an angle in radians
+template<approximation_tier A = approximation_tier::precise, class T>
+T approx_sin(const T p_angle);
+
+// Compute the cosine of an angle in radians
+template<approximation_tier A = approximation_tier::precise, class T>
+T approx_cos(const T p_angle);
+
+// Compute the arc sine in radians, in [-pi / 2, pi / 2]
+template<approximation_tier A = approximation_tier::precise, class T>
+T approx_asin(const T p_value);
+
+// Compute the arc cosine in radians, in [0, pi]
+template<approximation_tier A = approximation_tier::precise, class T>
+T approx_acos(const T p_value);
+
+// Compute the arc tangent in radians, in [-pi / 2, pi / 2]
+template<approximation_tier A = approximation_tier::precise, class T>
+T approx_atan(const T p_value);
+
+// Compute the angle of the point (x, y) in radians, in [-pi, pi]
+template<approximation_tier A = approximation_tier::precise, class T>
+T approx_atan2(const T p_y, const T p_x);
+
+// Compute e raised to a power
+template<approximation_tier A = approximation_tier::precise, class T>
+T approx_exp(const T p_value);
+
+// Compute the natural logarithm
+template<approximation_tier A = approximation_tier::precise, class T>
+T approx_log(const T p_value);
+
+
+// Compute the sines and cosines of an array of angles in radians
+// `p_sines` and `p_cosines` must be at least as large as `p_angles`
+template<approximation_tier A = approximation_tier::precise, class T>
+void sincos_batch(std::span<const T> p_angles, std::span<T> p_sines, std::span<T> p_cosines);
+
+// Compute the arc sines of an array of values
+// `p_results` must be at least as large as `p_values`
+template<approximation_tier A = approximation_tier::precise, class T>
+void asin_batch(std::span<const T> p_values, std::span<T> p_results);
+
+// Compute the arc cosines of an array of values
+// `p_results` must be at least as large as `p_values`
+template<approximation_tier A = approximation_tier::precise, class T>
+void acos_batch(std::span<const T> p_values, std::span<T> p_results);
+
+// Compute the angles of an array of points
+// `p_x` and `p_results` must be at least as large as `p_y`
+template<approximation_tier A = approximation_tier::precise, class T>
+void atan2_batch(std::span<const T> p_y, std::span<const T> p_x, std::span<T> p_results);
+
+// Compute e raised to an array of powers
+// `p_results` must be at least as large as `p_values`
+template<approximation_tier A = approximation_tier::precise, class T>
+void exp_batch(std::span<const T> p_values, std::span<T> p_results);
+
+// Compute the natural logarithms of an array of values
+// `p_results` must be at least as large as `p_values`
+template<approximation_tier A = approximation_tier::precise, class T>
+void log_batch(std::span<const T> p_values, std::span<T> p_results);
+
+};  // namespace math
+};  // namespace ft
+
+#include "elementary_functions.hpp"
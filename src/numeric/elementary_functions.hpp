@@ -0,0 +1,526 @@
+#pragma once
+
+// Implements the approximations of elementary_functions.h
+// The scalar functions are inline so that the batch loops inline them
+//  whatever the optimizer size limits, a call would prevent vectorization
+
+// project headers
+#include "elementary_functions.h"
+
+// other headers
+#include "error/ft_assert.h"
+
+// standard headers
+#include <array>
+#include <bit>
+#include <cmath>
+#include <cstddef>  // std::size_t
+#include <cstdint>
+#include <limits>
+#include <numbers>
+#include <type_traits>
+
+namespace ft {
+namespace math {
+namespace details {
+namespace elementary_functions_ns {
+
+// Constants depending on the floating point type
+template<class T>
+struct float_constants;
+
+template<>
+struct float_constants<float>
+{
+    using bits_type = std::uint32_t;
+    static constexpr int mantissa_bits = 23;
+    static constexpr int exponent_bias = 127;
+    static constexpr bits_type exponent_mask = 0xFF;
+
+    // Type in which sin and cos reduce their argument
+    // Three float parts of pi / 2 lose too much to cancellation near the
+    //  zeros of large arguments
+    using reduction_type = double;
+
+    // ln(2) split so that n * ln_2_high is exact for |n| < 2^8
+    static constexpr float ln_2_high = 0.693359375f;
+    static constexpr float ln_2_low = -2.12194440e-4f;
+
+    // Inputs of exp whose result is finite or not zero
+    static constexpr float exp_max = 88.7228394f;
+    static constexpr float exp_min = -103.972084f;
+
+    // Scales subnormal inputs of log to normal numbers
+    static constexpr float subnormal_scale = 16777216.0f;
+    static constexpr int subnormal_exponent = 24;
+};
+
+template<>
+struct float_constants<double>
+{
+    using bits_type = std::uint64_t;
+    static constexpr int mantissa_bits = 52;
+    static constexpr int exponent_bias = 1023;
+    static constexpr bits_type exponent_mask = 0x7FF;
+
+    // Type in which sin and cos reduce their argument
+    using reduction_type = double;
+
+    // pi / 2 split so that j * pi_2_1 and j * pi_2_2 are exact for |j| < 2^30
+    static constexpr double pi_2_1 = 1.5707962512969970703e+00;
+    static constexpr double pi_2_2 = 7.5497894158615963534e-08;
+    static constexpr double pi_2_3 = 5.3903028581581189703e-15;
+
+    // ln(2) split so that n * ln_2_high is exact for |n| < 2^11
+    static constexpr double ln_2_high = 6.93147180369123816490e-01;
+    static constexpr double ln_2_low = 1.90821492927058770002e-10;
+
+    // Inputs of exp whose result is finite or not zero
+    static constexpr double exp_max = 709.782712893383973;
+    static constexpr double exp_min = -745.133219101941108;
+
+    // Scales subnormal inputs of log to normal numbers
+    static constexpr double subnormal_scale = 18014398509481984.0;
+    static constexpr int subnormal_exponent = 54;
+};
+
+
+// Largest quadrant index sin and cos convert to an integer
+inline constexpr double max_quadrant = 1073741824.0;
+
+
+// Coefficients of P for the sine
+// sin(r) = r + r * z * P(z), z = r^2, |r| <= pi / 4
+template<class T, approximation_tier A>
+constexpr auto sin_coefficients()
+{
+    if constexpr (std::is_same_v<T, float> && A == approximation_tier::fast) {
+        return std::array<T, 2>{ -1.666573100e-01f, 8.211855507e-03f };
+    }
+    else if constexpr (std::is_same_v<T, float> && A == approximation_tier::precise) {
+        return std::array<T, 3>{ -1.666666466e-01f, 8.332748271e-03f, -1.958789088e-04f };
+    }
+    else if constexpr (std::is_same_v<T, double> && A == approximation_tier::fast) {
+        return std::array<T, 4>{ -1.66666666638552896e-01, 8.33333187471020816e-03, -1.98400867353848464e-04, 2.72499258030597915e-06 };
+    }
+    else if constexpr (std::is_same_v<T, double> && A == approximation_tier::precise) {
+        return std::array<T, 6>{ -1.66666666666666657e-01, 8.33333333333094797e-03, -1.98412698367585736e-04, 2.75573161025524389e-06, -2.50511318450036243e-08, 1.59181292948666079e-10 };
+    }
+}
+
+
+// Coefficients of P for the cosine
+// cos(r) = 1 - z / 2 + z^2 * P(z), z = r^2, |r| <= pi / 4
+template<class T, approximation_tier A>
+constexpr auto cos_coefficients()
+{
+    if constexpr (std::is_same_v<T, float> && A == approximation_tier::fast) {
+        return std::array<T, 2>{ 4.166549508e-02f, -1.373681406e-03f };
+    }
+    else if constexpr (std::is_same_v<T, float> && A == approximation_tier::precise) {
+        return std::array<T, 3>{ 4.166666466e-02f, -1.388830304e-03f, 2.454794209e-05f };
+    }
+    else if constexpr (std::is_same_v<T, double> && A == approximation_tier::fast) {
+        return std::array<T, 4>{ 4.16666666643212003e-02, -1.38888876720167894e-03, 2.48006003771567284e-05, -2.73009592039014691e-07 };
+    }
+    else if constexpr (std::is_same_v<T, double> && A == approximation_tier::precise) {
+        return std::array<T, 6>{ 4.16666666666666644e-02, -1.38888888888873976e-03, 2.48015872987656891e-05, -2.75573172717297931e-07, 2.08761462684031992e-09, -1.13826324255217172e-11 };
+    }
+}
+
+
+// Coefficients of P for the exponential
+// exp(r) = 1 + r + r^2 * P(r), |r| <= ln(2) / 2
+template<class T, approximation_tier A>
+constexpr auto exp_coefficients()
+{
+    if constexpr (std::is_same_v<T, float> && A == approximation_tier::fast) {
+        return std::array<T, 3>{ 5.000000000e-01f, 1.674189867e-01f, 4.179198611e-02f };
+    }
+    else if constexpr (std::is_same_v<T, float> && A == approximation_tier::precise) {
+        return std::array<T, 5>{ 5.000000000e-01f, 1.666657703e-01f, 4.166655466e-02f, 8.363173075e-03f, 1.392617612e-03f };
+    }
+    else if constexpr (std::is_same_v<T, double> && A == approximation_tier::fast) {
+        return std::array<T, 6>{ 5.00000001345772715e-01, 1.66666666816142561e-01, 4.16664650060400502e-02, 8.33331093444886900e-03, 1.39336410319867011e-03, 1.98909808697503266e-04 };
+    }
+    else if constexpr (std::is_same_v<T, double> && A == approximation_tier::precise) {
+        return std::array<T, 10>{ 5.00000000000000111e-01, 1.66666666666666685e-01, 4.16666666666241636e-02, 8.33333333333006500e-03, 1.38888889171967186e-03, 1.98412698630405450e-04, 2.48015213223686919e-05, 2.75572684803100238e-06, 2.76200758799833672e-07, 2.51003758325612340e-08 };
+    }
+}
+
+
+// Coefficients of P for the logarithm
+// log((1 + s) / (1 - s)) = 2 * s + s * z * P(z), z = s^2, |s| <= 3 - 2 * sqrt(2)
+template<class T, approximation_tier A>
+constexpr auto log_coefficients()
+{
+    if constexpr (std::is_same_v<T, float> && A == approximation_tier::fast) {
+        return std::array<T, 2>{ 6.666349945e-01f, 4.085826936e-01f };
+    }
+    else if constexpr (std::is_same_v<T, float> && A == approximation_tier::precise) {
+        return std::array<T, 3>{ 6.666668504e-01f, 3.998878057e-01f, 2.957994939e-01f };
+    }
+    else if constexpr (std::is_same_v<T, double> && A == approximation_tier::fast) {
+        return std::array<T, 4>{ 6.66666665544970893e-01, 4.00001218398061242e-01, 2.85508208159606647e-01, 2.33304672163038351e-01 };
+    }
+    else if constexpr (std::is_same_v<T, double> && A == approximation_tier::precise) {
+        return std::array<T, 7>{ 6.66666666666666963e-01, 3.99999999998995048e-01, 2.85714286259754868e-01, 2.22222111347950807e-01, 1.81828891252617225e-01, 1.53317216005560419e-01, 1.46164496850434061e-01 };
+    }
+}
+
+
+// Coefficients of P for the arc tangent
+// atan(t) = t + t * z * P(z), z = t^2, |t| <= tan(pi / 8)
+template<class T, approximation_tier A>
+constexpr auto atan_coefficients()
+{
+    if constexpr (std::is_same_v<T, float> && A == approximation_tier::fast) {
+        return std::array<T, 3>{ -3.333189656e-01f, 1.984809781e-01f, -1.181944441e-01f };
+    }
+    else if constexpr (std::is_same_v<T, float> && A == approximation_tier::precise) {
+        return std::array<T, 5>{ -3.333333176e-01f, 1.999954048e-01f, -1.426395560e-01f, 1.074373149e-01f, -6.451928208e-02f };
+    }
+    else if constexpr (std::is_same_v<T, double> && A == approximation_tier::fast) {
+        return std::array<T, 7>{ -3.33333333314407287e-01, 1.99999989172885806e-01, -1.42856125113870164e-01, 1.11074951357144736e-01, -9.02898350035046260e-02, 7.13532512233067823e-02, -4.04322482588716087e-02 };
+    }
+    else if constexpr (std::is_same_v<T, double> && A == approximation_tier::precise) {
+        return std::array<T, 11>{ -3.33333333333333315e-01, 1.99999999999955214e-01, -1.42857142846665425e-01, 1.11111110152563614e-01, -9.09090457812390257e-02, 7.69218319082608654e-02, -6.66451144738194751e-02, 5.85814891280221003e-02, -5.08544973794025981e-02, 3.92316582955871893e-02, -1.91768871190622602e-02 };
+    }
+}
+
+
+// Coefficients of P for the arc sine
+// asin(s) = s + s * z * P(z), z = s^2, |s| <= 1 / 2
+template<class T, approximation_tier A>
+constexpr auto asin_coefficients()
+{
+    if constexpr (std::is_same_v<T, float> && A == approximation_tier::fast) {
+        return std::array<T, 3>{ 1.666867211e-01f, 7.357109233e-02f, 5.897563890e-02f };
+    }
+    else if constexpr (std::is_same_v<T, float> && A == approximation_tier::precise) {
+        return std::array<T, 5>{ 1.666667241e-01f, 7.498855073e-02f, 4.500138007e-02f, 2.655454221e-02f, 3.808502356e-02f };
+    }
+    else if constexpr (std::is_same_v<T, double> && A == approximation_tier::fast) {
+        return std::array<T, 7>{ 1.66666666860856433e-01, 7.49999240440183818e-02, 4.46476638881348475e-02, 3.02691387285891830e-02, 2.36118170088917521e-02, 1.05744155169129085e-02, 3.09745403713550735e-02 };
+    }
+    else if constexpr (std::is_same_v<T, double> && A == approximation_tier::precise) {
+        return std::array<T, 13>{ 1.66666666666666685e-01, 7.49999999999843292e-02, 4.46428571463554288e-02, 3.03819441385312465e-02, 2.23721729421498886e-02, 1.73523927208699726e-02, 1.39712129735529329e-02, 1.14791774151849057e-02, 1.03228143501857793e-02, 5.45750671864035815e-03, 1.74008794426940214e-02, -1.48518870712472037e-02, 2.87578513674215663e-02 };
+    }
+}
+
+
+// Evaluate a polynomial with Horner's scheme
+// Coefficients are in increasing order of degree
+template<class T, std::size_t N>
+inline T evaluate_polynomial(const std::array<T, N> & p_coefficients, const T p_x)
+{
+    auto result = p_coefficients[N - 1];
+    for (auto i = N - 1; i-- > 0;) {
+        result = result * p_x + p_coefficients[i];
+    }
+    return result;
+}
+
+
+// Get 2 ^ p_exponent for exponents of normal numbers
+template<class T>
+inline T make_power_of_two(const std::int32_t p_exponent)
+{
+    using constants = float_constants<T>;
+    using bits_type = typename constants::bits_type;
+    return std::bit_cast<T>(static_cast<bits_type>(p_exponent + constants::exponent_bias) << constants::mantissa_bits);
+}
+
+
+// Compute the arc tangent of a value in [-tan(3 * pi / 8), tan(3 * pi / 8)]
+// Values above tan(pi / 8) use atan(t) = pi / 4 + atan((t - 1) / (t + 1))
+template<approximation_tier A, class T>
+inline T atan_reduced(const T p_value)
+{
+    const auto tan_pi_8 = static_cast<T>(0.41421356237309504880);
+    const auto shifted = p_value > tan_pi_8;
+    const auto t = shifted ? (p_value - 1) / (p_value + 1) : p_value;
+    const auto z = t * t;
+    const auto result = t + t * z * evaluate_polynomial(atan_coefficients<T, A>(), z);
+    return shifted ? std::numbers::pi_v<T> / 4 + result : result;
+}
+
+
+// Compute asin(s) for s in [0, 1 / 2]
+// `p_z` is s^2
+template<approximation_tier A, class T>
+inline T asin_reduced(const T p_s, const T p_z)
+{
+    return p_s + p_s * p_z * evaluate_polynomial(asin_coefficients<T, A>(), p_z);
+}
+
+};  // namespace elementary_functions_ns
+};  // namespace details
+};  // namespace math
+};  // namespace ft
+
+
+// Compute the sine and cosine of an angle in radians
+template<ft::math::approximation_tier A, class T>
+inline void ft::math::approx_sincos(const T p_angle, T & p_sine, T & p_cosine)
+{
+    using namespace details::elementary_functions_ns;
+    using constants = float_constants<T>;
+
+    using reduction_type = typename constants::reduction_type;
+    using reduction_constants = float_constants<reduction_type>;
+
+    // angle = r + quadrant * pi / 2 with |r| <= pi / 4
+    const auto x = static_cast<reduction_type>(p_angle);
+    const auto j = std::rint(x * (2 / std::numbers::pi_v<reduction_type>));
+    const auto r = static_cast<T>(((x - j * reduction_constants::pi_2_1) - j * reduction_constants::pi_2_2) - j * reduction_constants::pi_2_3);
+    const auto quadrant = static_cast<std::int32_t>((std::abs(j) < max_quadrant) ? j : 0.0);
+
+    const auto z = r * r;
+    const auto sine = r + r * z * evaluate_polynomial(sin_coefficients<T, A>(), z);
+    const auto cosine = 1 - z / 2 + z * z * evaluate_polynomial(cos_coefficients<T, A>(), z);
+
+    const auto swap = (quadrant & 1) != 0;
+    const auto sine_negative = (quadrant & 2) != 0;
+    const auto cosine_negative = ((quadrant + 1) & 2) != 0;
+    const auto s = swap ? cosine : sine;
+    const auto c = swap ? sine : cosine;
+    p_sine = sine_negative ? -s : s;
+    p_cosine = cosine_negative ? -c : c;
+}
+
+
+// Compute the sine of an angle in radians
+template<ft::math::approximation_tier A, class T>
+inline T ft::math::approx_sin(const T p_angle)
+{
+    T sine;
+    T cosine;
+    approx_sincos<A>(p_angle, sine, cosine);
+    return sine;
+}
+
+
+// Compute the cosine of an angle in radians
+template<ft::math::approximation_tier A, class T>
+inline T ft::math::approx_cos(const T p_angle)
+{
+    T sine;
+    T cosine;
+    approx_sincos<A>(p_angle, sine, cosine);
+    return cosine;
+}
+
+
+// Compute the arc sine in radians
+// Values above 1 / 2 use asin(x) = pi / 2 - 2 * asin(sqrt((1 - x) / 2))
+template<ft::math::approximation_tier A, class T>
+inline T ft::math::approx_asin(const T p_value)
+{
+    using namespace details::elementary_functions_ns;
+
+    const auto a = std::abs(p_value);
+    const auto large = a > static_cast<T>(0.5);
+    const auto z = large ? (1 - a) / 2 : a * a;
+    const auto s = large ? std::sqrt(z) : a;
+    const auto p = asin_reduced<A>(s, z);
+    const auto result = large ? std::numbers::pi_v<T> / 2 - 2 * p : p;
+    return std::copysign(result, p_value);
+}
+
+
+// Compute the arc cosine in radians
+// Values above 1 / 2 in magnitude use acos(x) = 2 * asin(sqrt((1 - x) / 2))
+template<ft::math::approximation_tier A, class T>
+inline T ft::math::approx_acos(const T p_value)
+{
+    using namespace details::elementary_functions_ns;
+
+    const auto a = std::abs(p_value);
+    const auto large = a > static_cast<T>(0.5);
+    const auto z = large ? (1 - a) / 2 : a * a;
+    const auto s = large ? std::sqrt(z) : a;
+    const auto p = asin_reduced<A>(s, z);
+
+    const auto small_result = std::numbers::pi_v<T> / 2 - std::copysign(p, p_value);
+    const auto large_result = (p_value < 0) ? std::numbers::pi_v<T> - 2 * p : 2 * p;
+    return large ? large_result : small_result;
+}
+
+
+// Compute the arc tangent in radians
+// Values above 1 in magnitude use atan(x) = pi / 2 - atan(1 / x)
+template<ft::math::approximation_tier A, class T>
+inline T ft::math::approx_atan(const T p_value)
+{
+    using namespace details::elementary_functions_ns;
+
+    const auto a = std::abs(p_value);
+    const auto inverted = a > 1;
+    const auto result = atan_reduced<A>(inverted ? 1 / a : a);
+    return std::copysign(inverted ? std::numbers::pi_v<T> / 2 - result : result, p_value);
+}
+
+
+// Compute the angle of the point (x, y) in radians
+// The smaller coordinate over the larger one is in [0, 1], its arc tangent
+//  is then moved to the right octant
+template<ft::math::approximation_tier A, class T>
+inline T ft::math::approx_atan2(const T p_y, const T p_x)
+{
+    using namespace details::elementary_functions_ns;
+
+    const auto a_x = std::abs(p_x);
+    const auto a_y = std::abs(p_y);
+    const auto steep = a_y > a_x;
+    const auto high = steep ? a_y : a_x;
+    const auto low = steep ? a_x : a_y;
+
+    // Both zero give 0, both infinite give 1
+    const auto ratio = (high > 0) ? ((low == high) ? static_cast<T>(1) : low / high) : static_cast<T>(0);
+
+    auto result = atan_reduced<A>(ratio);
+    result = steep ? std::numbers::pi_v<T> / 2 - result : result;
+    // Negative zero x gives pi like std::atan2
+    result = (std::copysign(static_cast<T>(1), p_x) < 0) ? std::numbers::pi_v<T> - result : result;
+    result = std::copysign(result, p_y);
+    return (p_x != p_x || p_y != p_y) ? p_x + p_y : result;
+}
+
+
+// Compute e raised to a power
+// exp(x) = 2^n * exp(r) with x = n * ln(2) + r, |r| <= ln(2) / 2
+template<ft::math::approximation_tier A, class T>
+inline T ft::math::approx_exp(const T p_value)
+{
+    using namespace details::elementary_functions_ns;
+    using constants = float_constants<T>;
+
+    // Keep n in range, the special results are selected at the end
+    auto x = (p_value > constants::exp_max) ? constants::exp_max : p_value;
+    x = (x < constants::exp_min) ? constants::exp_min : x;
+    x = (x == x) ? x : static_cast<T>(0);
+
+    const auto n = std::rint(x * std::numbers::log2e_v<T>);
+    const auto r = (x - n * constants::ln_2_high) - n * constants::ln_2_low;
+    const auto p = 1 + r + r * r * evaluate_polynomial(exp_coefficients<T, A>(), r);
+
+    // Scale in two steps so that subnormal results and 2^128 are reachable
+    const auto exponent = static_cast<std::int32_t>(n);
+    const auto half = exponent / 2;
+    auto result = p * make_power_of_two<T>(half) * make_power_of_two<T>(exponent - half);
+
+    result = (p_value > constants::exp_max) ? std::numeric_limits<T>::infinity() : result;
+    result = (p_value < constants::exp_min) ? static_cast<T>(0) : result;
+    return (p_value == p_value) ? result : p_value;
+}
+
+
+// Compute the natural logarithm
+// log(x) = e * ln(2) + log(m) with x = 2^e * m, sqrt(1 / 2) <= m < sqrt(2),
+//  and log(m) = 2 * atanh(s) with s = (m - 1) / (m + 1)
+template<ft::math::approximation_tier A, class T>
+inline T ft::math::approx_log(const T p_value)
+{
+    using namespace details::elementary_functions_ns;
+    using constants = float_constants<T>;
+    using bits_type = typename constants::bits_type;
+
+    const auto subnormal = p_value < std::numeric_limits<T>::min();
+    const auto x = subnormal ? p_value * constants::subnormal_scale : p_value;
+    const auto bits = std::bit_cast<bits_type>(x);
+
+    // Mantissa in [1, 2) then in [sqrt(1 / 2), sqrt(2))
+    auto exponent = static_cast<std::int32_t>((bits >> constants::mantissa_bits) & constants::exponent_mask) - constants::exponent_bias;
+    exponent -= subnormal ? constants::subnormal_exponent : 0;
+    const auto mantissa_mask = (bits_type{ 1 } << constants::mantissa_bits) - 1;
+    auto m = std::bit_cast<T>((bits & mantissa_mask) | (static_cast<bits_type>(constants::exponent_bias) << constants::mantissa_bits));
+    const auto high = m > std::numbers::sqrt2_v<T>;
+    m = high ? m / 2 : m;
+    exponent += high ? 1 : 0;
+
+    const auto s = (m - 1) / (m + 1);
+    const auto z = s * s;
+    const auto log_m = 2 * s + s * z * evaluate_polynomial(log_coefficients<T, A>(), z);
+    const auto e = static_cast<T>(exponent);
+    auto result = e * constants::ln_2_high + (log_m + e * constants::ln_2_low);
+
+    result = (p_value == std::numeric_limits<T>::infinity()) ? p_value : result;
+    result = (p_value == 0) ? -std::numeric_limits<T>::infinity() : result;
+    result = (p_value < 0) ? std::numeric_limits<T>::quiet_NaN() : result;
+    return (p_value == p_value) ? result : p_value;
+}
+
+
+// Compute the sines and cosines of an array of angles in radians
+template<ft::math::approximation_tier A, class T>
+void ft::math::sincos_batch(std::span<const T> p_angles, std::span<T> p_sines, std::span<T> p_cosines)
+{
+    FT_ASSERT(p_sines.size() >= p_angles.size());
+    FT_ASSERT(p_cosines.size() >= p_angles.size());
+
+    for (std::size_t i = 0; i < p_angles.size(); ++i) {
+        approx_sincos<A>(p_angles[i], p_sines[i], p_cosines[i]);
+    }
+}
+
+
+// Compute the arc sines of an array of values
+template<ft::math::approximation_tier A, class T>
+void ft::math::asin_batch(std::span<const T> p_values, std::span<T> p_results)
+{
+    FT_ASSERT(p_results.size() >= p_values.size());
+
+    for (std::size_t i = 0; i < p_values.size(); ++i) {
+        p_results[i] = approx_asin<A>(p_values[i]);
+    }
+}
+
+
+// Compute the arc cosines of an array of values
+template<ft::math::approximation_tier A, class T>
+void ft::math::acos_batch(std::span<const T> p_values, std::span<T> p_results)
+{
+    FT_ASSERT(p_results.size() >= p_values.size());
+
+    for (std::size_t i = 0; i < p_values.size(); ++i) {
+        p_results[i] = approx_acos<A>(p_values[i]);
+    }
+}
+
+
+// Compute the angles of an array of points
+template<ft::math::approximation_tier A, class T>
+void ft::math::atan2_batch(std::span<const T> p_y, std::span<const T> p_x, std::span<T> p_results)
+{
+    FT_ASSERT(p_x.size() >= p_y.size());
+    FT_ASSERT(p_results.size() >= p_y.size());
+
+    for (std::size_t i = 0; i < p_y.size(); ++i) {
+        p_results[i] = approx_atan2<A>(p_y[i], p_x[i]);
+    }
+}
+
+
+// Compute e raised to an array of powers
+template<ft::math::approximation_tier A, class T>
+void ft::math::exp_batch(std::span<const T> p_values, std::span<T> p_results)
+{
+    FT_ASSERT(p_results.size() >= p_values.size());
+
+    for (std::size_t i = 0; i < p_values.size(); ++i) {
+        p_results[i] = approx_exp<A>(p_values[i]);
+    }
+}
+
+
+// Compute the natural logarithms of an array of values
+template<ft::math::approximation_tier A, class T>
+void ft::math::log_batch(std::span<const T> p_values, std::span<T> p_results)
+{
+    FT_ASSERT(p_results.size() >= p_values.size());
+
+    for (std::size_t i = 0; i < p_values.size(); ++i) {
+        p_results[i] = approx_log<A>(p_values[i]);
+    }
+}
@@ -0,0 +1,93 @@
+// project headers
+#include "floating_point_environment.h"
+
+// standard headers
+#if defined(__SSE__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 1)
+#define FT_MATH_HAS_MXCSR
+#include <xmmintrin.h>
+#endif
+
+namespace {
+
+#if defined(FT_MATH_HAS_MXCSR)
+
+// Flush to zero and denormals are zero bits of MXCSR
+constexpr std::uint64_t flush_bits = 0x8040;
+
+// Read MXCSR
+std::uint64_t read_state()
+{
+    return _mm_getcsr();
+}
+
+// Write MXCSR
+void write_state(const std::uint64_t p_state)
+{
+    _mm_setcsr(static_cast<unsigned int>(p_state));
+}
+
+#elif defined(__aarch64__)
+
+// Flush to zero bit of FPCR, also treats denormal operands as zero
+constexpr std::uint64_t flush_bits = std::uint64_t{ 1 } << 24;
+
+// Read FPCR
+std::uint64_t read_state()
+{
+    std::uint64_t result;
+    __asm__ __volatile__("mrs %0, fpcr" : "=r"(result));
+    return result;
+}
+
+// Write FPCR
+void write_state(const std::uint64_t p_state)
+{
+    __asm__ __volatile__("msr fpcr, %0" : : "r"(p_state));
+}
+
+#else
+
+// No control register, nothing is flushed
+constexpr std::uint64_t flush_bits = 0;
+
+std::uint64_t read_state()
+{
+    return 0;
+}
+
+void write_state(const std::uint64_t)
+{
+}
+
+#endif
+
+}   // namespace
+
+
+// Returns true if denormal flushing is supported on this target
+bool ft::math::denormal_flush_supported()
+{
+    return flush_bits != 0;
+}
+
+
+// Returns true if denormal flushing is enabled on the calling thread
+bool ft::math::denormal_flush_enabled()
+{
+    return flush_bits != 0 && (read_state() & flush_bits) == flush_bits;
+}
+
+
+// Save the environment and enable flushing
+ft::math::denormal_flush_scope::denormal_flush_scope() :
+    m_saved_state(read_state())
+{
+    write_state(m_saved_state | flush_bits);
+}
+
+
+// Restore the saved environment
+ft::math::denormal_flush_scope::~denormal_flush_scope()
+{
+    write_state(m_saved_state);
+}
@@ -0,0 +1,51 @@
+#pragma once
+
+// Control of the floating point environment of the calling thread
+//
+// Operations on denormal numbers (magnitudes below the smallest normal
+//  value) take a slow microcode path on most CPUs, 10 to 100 times slower
+//  than on normal numbers
+// Flushing them to zero trades the gradual underflow of IEEE 754 for
+//  constant speed:
+//  - flush to zero (FTZ): denormal results are replaced by zero
+//  - denormals are zero (DAZ): denormal operands are read as zero
+// x86 supports both through the MXCSR register, AArch64 supports both with
+//  the FZ bit of FPCR, other targets are left unchanged
+//
+// The environment belongs to a thread, the workers of a thread pool keep
+//  their own and are not affected by a scope opened on the calling thread
+
+// standard headers
+#include <cstdint>
+
+namespace ft {
+namespace math {
+
+// Returns true if denormal flushing is supported on this target
+bool denormal_flush_supported();
+
+// Returns true if denormal flushing is enabled on the calling thread
+bool denormal_flush_enabled();
+
+
+// Enables denormal flushing on the calling thread for its lifetime
+class denormal_flush_scope
+{
+public:
+    // Save the environment and enable flushing
+    denormal_flush_scope();
+
+    // Restore the saved environment
+    ~denormal_flush_scope();
+
+    denormal_flush_scope(const denormal_flush_scope &) = delete;
+    denormal_flush_scope & operator=(const denormal_flush_scope &) = delete;
+
+private:
+    // Control register value at construction
+    std::uint64_t m_saved_state;
+
+};  // class denormal_flush_scope
+
+};  // namespace math
+};  // namespace ft
@@ -0,0 +1,69 @@
+// project headers
+#include "special_values.h"
+
+// standard headers
+#include <map>
+#include <mutex>
+#include <string_view>
+
+namespace {
+
+// Denormals recorded per operation name
+struct denormal_registry
+{
+    std::mutex mutex;
+    std::map<std::string, ft::math::denormal_report_entry, std::less<>> entries;
+};
+
+
+// Get the registry shared by all threads
+denormal_registry & get_registry()
+{
+    static denormal_registry registry;
+    return registry;
+}
+
+}   // namespace
+
+
+// Record `p_count` denormals produced by one call of `p_operation`
+void ft::math::flag_denormals(const char * p_operation, const std::size_t p_count)
+{
+    if (p_count == 0) {
+        return;
+    }
+
+    auto & registry = get_registry();
+    const std::lock_guard lock(registry.mutex);
+
+    auto found = registry.entries.find(std::string_view(p_operation));
+    if (found == registry.entries.end()) {
+        found = registry.entries.emplace(p_operation, denormal_report_entry{ p_operation }).first;
+    }
+    ++found->second.flagged_calls;
+    found->second.denormal_count += p_count;
+}
+
+
+// Get the operations that produced denormals, sorted by name
+std::vector<ft::math::denormal_report_entry> ft::math::get_denormal_report()
+{
+    auto & registry = get_registry();
+    const std::lock_guard lock(registry.mutex);
+
+    std::vector<denormal_report_entry> result;
+    result.reserve(registry.entries.size());
+    for (const auto & [name, entry] : registry.entries) {
+        result.push_back(entry);
+    }
+    return result;
+}
+
+
+// Forget every recorded denormal
+void ft::math::reset_denormal_report()
+{
+    auto & registry = get_registry();
+    const std::lock_guard lock(registry.mutex);
+    registry.entries.clear();
+}
@@ -0,0 +1,123 @@
+#pragma once
+
+// Detection of denormal, NaN and infinite values in arrays of scalars,
+//  vectors and matrices
+// Values are classified from their bit patterns without branches, so
+//  scanning large arrays is vectorized by the compiler
+//
+// Denormal checks, when `FT_MATH_DENORMAL_CHECKS` is defined, count the
+//  denormals produced by instrumented operations and record them in a
+//  report keyed by operation name, shared by all threads
+// Use `FT_MATH_CHECK_DENORMALS` to instrument an operation, it compiles to
+//  nothing when the checks are disabled and is skipped in constant
+//  evaluation
+// Denormals are only produced when flushing is disabled, see
+//  floating_point_environment.h
+
+// project headers
+#include "matrix/dynamic_matrix.h"
+#include "matrix/matrix.h"
+#include "vector/vector.h"
+#include "vector/vector_soa.h"
+
+// standard headers
+#include <cstddef>  // std::size_t
+#include <span>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+namespace ft {
+namespace math {
+
+// Number of special values found in an array
+struct special_value_counts
+{
+    std::size_t denormal = 0;
+    std::size_t nan = 0;
+    std::size_t infinite = 0;
+
+    // Returns true if any special value was found
+    constexpr bool any() const;
+
+    // Add the counts of another array
+    constexpr special_value_counts & operator+=(const special_value_counts & p_other);
+};
+
+
+// Count the special values of an array of scalars
+template<class T>
+special_value_counts count_special_values(std::span<const T> p_values);
+
+// Count the special values of the components of an array of vectors
+template<class T, std::size_t S>
+special_value_counts count_special_values(std::span<const vector<T, S>> p_vectors);
+
+// Count the special values of the elements of an array of matrices
+template<class T, std::size_t R, std::size_t C>
+special_value_counts count_special_values(std::span<const matrix<T, R, C>> p_matrices);
+
+// Count the special values of the components of an array of vectors
+template<class T, std::size_t S>
+special_value_counts count_special_values(const vector_soa_span<const T, S> & p_vectors);
+
+// Count the special values of the components of a vector
+template<class T, std::size_t S>
+special_value_counts count_special_values(const vector<T, S> & p_vector);
+
+// Count the special values of the elements of a matrix
+template<class T, std::size_t R, std::size_t C>
+special_value_counts count_special_values(const matrix<T, R, C> & p_matrix);
+
+// Count the special values of the elements of a matrix
+template<class T>
+special_value_counts count_special_values(const dynamic_matrix<T> & p_matrix);
+
+
+// Denormals produced by an operation since the last reset
+struct denormal_report_entry
+{
+    // Name given to the instrumented operation
+    std::string operation;
+
+    // Number of calls that produced denormals
+    std::size_t flagged_calls = 0;
+
+    // Total number of denormals produced
+    std::size_t denormal_count = 0;
+};
+
+
+// Record `p_count` denormals produced by one call of `p_operation`
+// Nothing is recorded when `p_count` is zero
+void flag_denormals(const char * p_operation, const std::size_t p_count);
+
+// Count the denormals of `p_values` and record them for `p_operation`
+// `p_values` is anything `count_special_values` accepts
+template<class V>
+void check_denormals(const char * p_operation, const V & p_values);
+
+// Get the operations that produced denormals, sorted by name
+std::vector<denormal_report_entry> get_denormal_report();
+
+// Forget every recorded denormal
+void reset_denormal_report();
+
+};  // namespace math
+};  // namespace ft
+
+
+// Check the result `values` of operation `op` for denormals when the
+//  checks are enabled
+#if defined(FT_MATH_DENORMAL_CHECKS)
+#define FT_MATH_CHECK_DENORMALS(op, values)                     \
+    do {                                                        \
+        if (!std::is_constant_evaluated()) {                    \
+            ::ft::math::check_denormals((op), (values));        \
+        }                                                       \
+    } while (false)
+#else
+#define FT_MATH_CHECK_DENORMALS(op, values) ((void)0)
+#endif
+
+#include "special_values.hpp"
@@ -0,0 +1,163 @@
+#pragma once
+
+// Implements the special value detection of special_values.h
+
+// project headers
+#include "special_values.h"
+
+// standard headers
+#include <bit>
+#include <cmath>
+#include <cstdint>
+#include <limits>
+
+namespace ft {
+namespace math {
+namespace details {
+namespace special_values_ns {
+
+// Unsigned integer with the size of `T` when `T` is float or double
+template<class T>
+using float_bits = std::conditional_t<std::is_same_v<T, double>, std::uint64_t, std::uint32_t>;
+
+// True if `T` is classified from its IEEE 754 bit pattern
+template<class T>
+inline constexpr bool has_float_bits = std::is_same_v<T, float> || std::is_same_v<T, double>;
+
+
+// Add the classification of `p_value` to the counts
+template<class T>
+inline void classify(const T p_value, std::size_t & p_denormal, std::size_t & p_nan, std::size_t & p_infinite)
+{
+    if constexpr (has_float_bits<T>)
+    {
+        using U = float_bits<T>;
+        constexpr auto mantissa_bits = std::numeric_limits<T>::digits - 1;
+        constexpr auto mantissa_mask = (U{ 1 } << mantissa_bits) - 1;
+        constexpr auto exponent_mask = ~mantissa_mask & (~U{ 0 } >> 1);
+
+        const auto bits = std::bit_cast<U>(p_value);
+        const auto exponent = bits & exponent_mask;
+        const auto has_mantissa = (bits & mantissa_mask) != 0;
+        p_denormal += (exponent == 0) & has_mantissa;
+        p_nan += (exponent == exponent_mask) & has_mantissa;
+        p_infinite += (exponent == exponent_mask) & !has_mantissa;
+    }
+    else if constexpr (std::is_floating_point_v<T>)
+    {
+        const auto category = std::fpclassify(p_value);
+        p_denormal += category == FP_SUBNORMAL;
+        p_nan += category == FP_NAN;
+        p_infinite += category == FP_INFINITE;
+    }
+}
+
+
+// Count the special values of `p_size` scalars starting at `p_values`
+template<class T>
+special_value_counts count(const T * p_values, const std::size_t p_size)
+{
+    // Local counters so the compiler can keep them in registers
+    std::size_t denormal = 0;
+    std::size_t nan = 0;
+    std::size_t infinite = 0;
+    for (std::size_t i = 0; i < p_size; ++i) {
+        classify(p_values[i], denormal, nan, infinite);
+    }
+    return { denormal, nan, infinite };
+}
+
+};  // namespace special_values_ns
+};  // namespace details
+};  // namespace math
+};  // namespace ft
+
+
+// Returns true if any special value was found
+constexpr bool ft::math::special_value_counts::any() const
+{
+    return denormal != 0 || nan != 0 || infinite != 0;
+}
+
+
+// Add the counts of another array
+constexpr ft::math::special_value_counts &
+ft::math::special_value_counts::operator+=(const special_value_counts & p_other)
+{
+    denormal += p_other.denormal;
+    nan += p_other.nan;
+    infinite += p_other.infinite;
+    return *this;
+}
+
+
+// Count the special values of an array of scalars
+template<class T>
+ft::math::special_value_counts ft::math::count_special_values(std::span<const T> p_values)
+{
+    return details::special_values_ns::count(p_values.data(), p_values.size());
+}
+
+
+// Count the special values of the components of an array of vectors
+template<class T, std::size_t S>
+ft::math::special_value_counts ft::math::count_special_values(std::span<const vector<T, S>> p_vectors)
+{
+    // Vectors are flat arrays, the whole span is scanned as scalars
+    static_assert(sizeof(vector<T, S>) == S * sizeof(T));
+    return details::special_values_ns::count(p_vectors.empty() ? nullptr : p_vectors.front().data(), p_vectors.size() * S);
+}
+
+
+// Count the special values of the elements of an array of matrices
+template<class T, std::size_t R, std::size_t C>
+ft::math::special_value_counts ft::math::count_special_values(std::span<const matrix<T, R, C>> p_matrices)
+{
+    // Matrices are flat arrays, the whole span is scanned as scalars
+    static_assert(sizeof(matrix<T, R, C>) == R * C * sizeof(T));
+    return details::special_values_ns::count(p_matrices.empty() ? nullptr : p_matrices.front().data(), p_matrices.size() * R * C);
+}
+
+
+// Count the special values of the components of an array of vectors
+template<class T, std::size_t S>
+ft::math::special_value_counts ft::math::count_special_values(const vector_soa_span<const T, S> & p_vectors)
+{
+    special_value_counts result;
+    for (std::size_t i = 0; i < S; ++i) {
+        result += details::special_values_ns::count(p_vectors.component(i), p_vectors.size());
+    }
+    return result;
+}
+
+
+// Count the special values of the components of a vector
+template<class T, std::size_t S>
+ft::math::special_value_counts ft::math::count_special_values(const vector<T, S> & p_vector)
+{
+    return details::special_values_ns::count(p_vector.data(), S);
+}
+
+
+// Count the special values of the elements of a matrix
+template<class T, std::size_t R, std::size_t C>
+ft::math::special_value_counts ft::math::count_special_values(const matrix<T, R, C> & p_matrix)
+{
+    return details::special_values_ns::count(p_matrix.data(), R * C);
+}
+
+
+// Count the special values of the elements of a matrix
+template<class T>
+ft::math::special_value_counts ft::math::count_special_values(const dynamic_matrix<T> & p_matrix)
+{
+    return details::special_values_ns::count(p_matrix.data(), p_matrix.rows() * p_matrix.cols());
+}
+
+
+// Count the denormals of `p_values` and record them for `p_operation`
+template<class V>
+void ft::math::check_denormals(const char * p_operation, const V & p_values)
+{
+    flag_denormals(p_operation, count_special_values(p_values).denormal);
+}
@@ -0,0 +1,58 @@
+#pragma once
+
+// Parallel least significant digit radix sort of unsigned integer keys
+// Sorts a permutation instead of the keys, so any number of attribute arrays
+//  can be reordered alongside with apply_permutation
+// The sort is stable, the result does not depend on the number of threads
+// Digits on which every key agrees are skipped, keys using only their low
+//  bits (Morton codes of a few levels, small ids) cost fewer passes
+
+// project headers
+#include "thread_pool.h"
+#include "vector/vector_soa.h"
+
+// standard headers
+#include <cstddef>  // std::size_t
+#include <cstdint>
+#include <span>
+
+namespace ft {
+namespace math {
+
+// Bits sorted per pass
+inline constexpr std::size_t radix_sort_digit_bits = 8;
+
+
+// Sort keys in increasing order
+// `p_permutation[i]` is set to the index of the `i`th smallest key, equal
+//  keys keeping their order
+// `p_permutation` must be as large as `p_keys`
+template<class K>
+void radix_sort(
+    std::span<const K> p_keys,
+    std::span<std::uint32_t> p_permutation,
+    thread_pool & p_pool = default_thread_pool());
+
+
+// Set `p_destination[i]` to `p_source[p_permutation[i]]`
+// `p_destination` must be at least as large as `p_permutation` and must not overlap `p_source`
+template<class T>
+void apply_permutation(
+    std::span<const T> p_source,
+    std::span<const std::uint32_t> p_permutation,
+    std::span<T> p_destination,
+    thread_pool & p_pool = default_thread_pool());
+
+// Set element `i` of `p_destination` to element `p_permutation[i]` of `p_source`
+// `p_destination` must be at least as large as `p_permutation` and must not overlap `p_source`
+template<class T, std::size_t S>
+void apply_permutation(
+    const vector_soa_span<const T, S> & p_source,
+    std::span<const std::uint32_t> p_permutation,
+    const vector_soa_span<T, S> & p_destination,
+    thread_pool & p_pool = default_thread_pool());
+
+};  // namespace math
+};  // namespace ft
+
+#include "radix_sort.hpp"
@@ -0,0 +1,180 @@
+#pragma once
+
+// Implements the sort of radix_sort.h
+
+// project headers
+#include "radix_sort.h"
+
+// other headers
+#include "error/ft_assert.h"
+
+// standard headers
+#include <algorithm>
+#include <array>
+#include <functional>
+#include <limits>
+#include <numeric>
+#include <type_traits>
+#include <vector>
+
+namespace ft {
+namespace math {
+namespace details {
+namespace radix_sort_ns {
+
+inline constexpr std::size_t digit_count = std::size_t{ 1 } << radix_sort_digit_bits;
+
+// Keys counted or moved per parallel chunk
+inline constexpr std::size_t chunk_size = 65536;
+
+// Elements gathered per parallel chunk
+inline constexpr std::size_t gather_chunk_size = 16384;
+
+
+// Get the digit of a key for a pass
+template<class K>
+constexpr std::size_t get_digit(const K p_key, const std::size_t p_pass)
+{
+    return static_cast<std::size_t>((p_key >> (p_pass * radix_sort_digit_bits)) & static_cast<K>(digit_count - 1));
+}
+
+};  // namespace radix_sort_ns
+};  // namespace details
+};  // namespace math
+};  // namespace ft
+
+
+// Sort keys in increasing order
+template<class K>
+void ft::math::radix_sort(
+    std::span<const K> p_keys,
+    std::span<std::uint32_t> p_permutation,
+    thread_pool & p_pool)
+{
+    using namespace details::radix_sort_ns;
+    static_assert(std::is_unsigned_v<K>, "Keys must be unsigned integers");
+
+    const auto size = p_keys.size();
+    FT_ASSERT(p_permutation.size() >= size);
+    FT_ASSERT(size <= std::numeric_limits<std::uint32_t>::max());
+
+    std::iota(p_permutation.begin(), p_permutation.begin() + size, std::uint32_t{ 0 });
+    if (size < 2) {
+        return;
+    }
+
+    const auto chunks = chunk_count(size, chunk_size);
+
+    // Bits on which some keys differ
+    std::vector<K> differences(chunks, 0);
+    parallel_for_chunks(size, chunk_size, [&](const std::size_t p_chunk, const std::size_t p_begin, const std::size_t p_end)
+    {
+        auto difference = K{ 0 };
+        for (auto i = p_begin; i < p_end; ++i) {
+            difference |= p_keys[i] ^ p_keys[0];
+        }
+        differences[p_chunk] = difference;
+    }, p_pool);
+    const auto difference = std::accumulate(differences.begin(), differences.end(), K{ 0 }, std::bit_or<K>());
+
+    // Keys and indices ping-pong between the caller's permutation and scratch buffers
+    std::vector<K> keys(p_keys.begin(), p_keys.end());
+    std::vector<K> next_keys(size);
+    std::span<std::uint32_t> indices = p_permutation.first(size);
+    std::vector<std::uint32_t> scratch(size);
+    std::span<std::uint32_t> next_indices = scratch;
+
+    std::vector<std::array<std::size_t, digit_count>> offsets(chunks);
+    constexpr auto passes = (sizeof(K) * 8 + radix_sort_digit_bits - 1) / radix_sort_digit_bits;
+    for (std::size_t pass = 0; pass < passes; ++pass)
+    {
+        if (get_digit(difference, pass) == 0) {
+            continue;
+        }
+
+        parallel_for_chunks(size, chunk_size, [&](const std::size_t p_chunk, const std::size_t p_begin, const std::size_t p_end)
+        {
+            auto & counts = offsets[p_chunk];
+            counts.fill(0);
+            for (auto i = p_begin; i < p_end; ++i) {
+                counts[get_digit(keys[i], pass)] += 1;
+            }
+        }, p_pool);
+
+        // Digit major, chunk minor, keeps the sort stable
+        std::size_t total = 0;
+        for (std::size_t d = 0; d < digit_count; ++d)
+        {
+            for (std::size_t c = 0; c < chunks; ++c)
+            {
+                const auto count = offsets[c][d];
+                offsets[c][d] = total;
+                total += count;
+            }
+        }
+
+        parallel_for_chunks(size, chunk_size, [&](const std::size_t p_chunk, const std::size_t p_begin, const std::size_t p_end)
+        {
+            auto & positions = offsets[p_chunk];
+            for (auto i = p_begin; i < p_end; ++i)
+            {
+                const auto position = positions[get_digit(keys[i], pass)]++;
+                next_keys[position] = keys[i];
+                next_indices[position] = indices[i];
+            }
+        }, p_pool);
+
+        keys.swap(next_keys);
+        std::swap(indices, next_indices);
+    }
+
+    if (indices.data() != p_permutation.data()) {
+        std::copy(indices.begin(), indices.end(), p_permutation.begin());
+    }
+}
+
+
+// Set `p_destination[i]` to `p_source[p_permutation[i]]`
+template<class T>
+void ft::math::apply_permutation(
+    std::span<const T> p_source,
+    std::span<const std::uint32_t> p_permutation,
+    std::span<T> p_destination,
+    thread_pool & p_pool)
+{
+    FT_ASSERT(p_destination.size() >= p_permutation.size());
+
+    parallel_for_chunks(p_permutation.size(), details::radix_sort_ns::gather_chunk_size,
+        [&](std::size_t, const std::size_t p_begin, const std::size_t p_end)
+        {
+            for (auto i = p_begin; i < p_end; ++i) {
+                p_destination[i] = p_source[p_permutation[i]];
+            }
+        }, p_pool);
+}
+
+
+// Set element `i` of `p_destination` to element `p_permutation[i]` of `p_source`
+template<class T, std::size_t S>
+void ft::math::apply_permutation(
+    const vector_soa_span<const T, S> & p_source,
+    std::span<const std::uint32_t> p_permutation,
+    const vector_soa_span<T, S> & p_destination,
+    thread_pool & p_pool)
+{
+    FT_ASSERT(p_destination.size() >= p_permutation.size());
+
+    parallel_for_chunks(p_permutation.size(), details::radix_sort_ns::gather_chunk_size,
+        [&](std::size_t, const std::size_t p_begin, const std::size_t p_end)
+        {
+            // One component at a time, each stream is read and written on its own
+            for (std::size_t c = 0; c < S; ++c)
+            {
+                const auto source = p_source.component(c);
+                const auto destination = p_destination.component(c);
+                for (auto i = p_begin; i < p_end; ++i) {
+                    destination[i] = source[p_permutation[i]];
+                }
+            }
+        }, p_pool);
+}
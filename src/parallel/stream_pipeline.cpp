@@ -0,0 +1,205 @@
+// project headers
+#include "stream_pipeline.h"
+
+// other headers
+#include "error/ft_assert.h"
+
+// standard headers
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace {
+
+// Bounded FIFO of chunk indices between two stages
+class chunk_queue
+{
+public:
+    explicit chunk_queue(const std::size_t p_capacity) :
+        m_capacity(p_capacity)
+    {
+    }
+
+
+    // Add a chunk, waiting while the queue is full
+    void push(const std::size_t p_chunk)
+    {
+        std::unique_lock lock(m_mutex);
+        m_not_full.wait(lock, [this]() { return m_chunks.size() < m_capacity; });
+        m_chunks.push_back(p_chunk);
+        lock.unlock();
+        m_not_empty.notify_one();
+    }
+
+
+    // Take the oldest chunk, waiting while the queue is empty
+    // Returns false once the queue is closed and empty
+    bool pop(std::size_t & p_chunk)
+    {
+        std::unique_lock lock(m_mutex);
+        m_not_empty.wait(lock, [this]() { return m_closed || !m_chunks.empty(); });
+        if (m_chunks.empty()) {
+            return false;
+        }
+
+        p_chunk = m_chunks.front();
+        m_chunks.pop_front();
+        lock.unlock();
+        m_not_full.notify_one();
+        return true;
+    }
+
+
+    // Tell the consumer no chunk will be pushed anymore
+    void close()
+    {
+        {
+            std::lock_guard lock(m_mutex);
+            m_closed = true;
+        }
+        m_not_empty.notify_all();
+    }
+
+private:
+    std::mutex m_mutex;
+    std::condition_variable m_not_empty;
+    std::condition_variable m_not_full;
+    std::deque<std::size_t> m_chunks;
+    std::size_t m_capacity;
+    bool m_closed = false;
+};
+
+
+// Buffer of one chunk and the number of elements it holds
+struct chunk_buffer
+{
+    std::vector<std::byte> data;
+    std::size_t count = 0;
+};
+
+}   // namespace
+
+
+// Run the reader, transform and writer stages on elements of `p_element_size` bytes
+ft::math::stream_result ft::math::details::stream_pipeline_ns::run(
+    std::FILE * p_input,
+    std::FILE * p_output,
+    const std::size_t p_element_size,
+    const stream_options & p_options,
+    const std::function<void(std::byte *, std::size_t)> & p_func)
+{
+    FT_ASSERT(p_input != nullptr && p_output != nullptr);
+    FT_ASSERT(p_element_size > 0 && p_options.chunk_size > 0 && p_options.queue_depth > 0);
+
+    // Enough chunks for every queue to be full while each stage holds one
+    const auto chunk_bytes = p_options.chunk_size * p_element_size;
+    std::vector<chunk_buffer> buffers(2 * p_options.queue_depth + 3);
+    for (auto & buffer : buffers) {
+        buffer.data.resize(chunk_bytes);
+    }
+
+    chunk_queue free_chunks(buffers.size());
+    chunk_queue read_chunks(p_options.queue_depth);
+    chunk_queue transformed_chunks(p_options.queue_depth);
+    for (std::size_t i = 0; i < buffers.size(); ++i) {
+        free_chunks.push(i);
+    }
+
+    // Only written by the reader
+    auto read_failed = false;
+    auto partial_element = false;
+
+    // Written by the writer, stops the other stages early
+    std::atomic<bool> write_failed = false;
+    std::size_t written_count = 0;
+
+    std::thread reader([&]()
+    {
+        std::size_t chunk;
+        while (!write_failed.load(std::memory_order_relaxed) && free_chunks.pop(chunk))
+        {
+            auto & buffer = buffers[chunk];
+            const auto bytes = std::fread(buffer.data.data(), 1, chunk_bytes, p_input);
+            buffer.count = bytes / p_element_size;
+
+            if (buffer.count > 0) {
+                read_chunks.push(chunk);
+            }
+            if (bytes < chunk_bytes)
+            {
+                read_failed = std::ferror(p_input) != 0;
+                partial_element = (bytes % p_element_size) != 0;
+                break;
+            }
+        }
+        read_chunks.close();
+    });
+
+    std::thread writer([&]()
+    {
+        std::size_t chunk;
+        while (transformed_chunks.pop(chunk))
+        {
+            const auto & buffer = buffers[chunk];
+            if (!write_failed.load(std::memory_order_relaxed))
+            {
+                if (std::fwrite(buffer.data.data(), p_element_size, buffer.count, p_output) == buffer.count) {
+                    written_count += buffer.count;
+                }
+                else {
+                    write_failed.store(true, std::memory_order_relaxed);
+                }
+            }
+            free_chunks.push(chunk);
+        }
+
+        if (!write_failed.load(std::memory_order_relaxed) && std::fflush(p_output) != 0) {
+            write_failed.store(true, std::memory_order_relaxed);
+        }
+    });
+
+    // The calling thread transforms, the stages are joined even if `p_func` throws
+    try
+    {
+        std::size_t chunk;
+        while (read_chunks.pop(chunk))
+        {
+            auto & buffer = buffers[chunk];
+            if (!write_failed.load(std::memory_order_relaxed)) {
+                p_func(buffer.data.data(), buffer.count);
+            }
+            transformed_chunks.push(chunk);
+        }
+    }
+    catch (...)
+    {
+        write_failed.store(true, std::memory_order_relaxed);
+        transformed_chunks.close();
+        for (std::size_t chunk; read_chunks.pop(chunk);) {
+            free_chunks.push(chunk);
+        }
+        reader.join();
+        writer.join();
+        throw;
+    }
+
+    transformed_chunks.close();
+    reader.join();
+    writer.join();
+
+    stream_result result;
+    result.element_count = written_count;
+    if (read_failed) {
+        result.error = stream_error::read;
+    }
+    else if (write_failed) {
+        result.error = stream_error::write;
+    }
+    else if (partial_element) {
+        result.error = stream_error::partial_element;
+    }
+    return result;
+}
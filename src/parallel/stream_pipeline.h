@@ -0,0 +1,89 @@
+#pragma once
+
+// Chunked streaming of arrays too large to fit in memory
+// A reader thread fills chunks from the input file, the calling thread
+//  transforms them (using the thread pool) and a writer thread writes them
+//  to the output file, the stages being connected by bounded queues
+// While chunk `n` is transformed, chunk `n + 1` is read and chunk `n - 1`
+//  written, so I/O and compute overlap and memory use stays bounded
+//
+// Files hold packed arrays of elements in native byte order
+// Elements are transformed independently, so the output is the same byte
+//  for byte whatever the chunk size and the number of threads
+
+// project headers
+#include "thread_pool.h"
+#include "matrix/matrix.h"
+#include "vector/vector.h"
+
+// standard headers
+#include <cstddef>  // std::size_t
+#include <cstdio>
+#include <span>
+
+namespace ft {
+namespace math {
+
+// Error that stopped a stream
+enum class stream_error
+{
+    none,
+
+    // Reading the input failed
+    read,
+
+    // Writing the output failed
+    write,
+
+    // The input size is not a multiple of the element size
+    // The complete elements were still transformed and written
+    partial_element
+};
+
+
+// Chunking of a stream
+struct stream_options
+{
+    // Elements per chunk
+    std::size_t chunk_size = 1 << 16;
+
+    // Chunks each queue can hold, two double buffers the reads and writes
+    std::size_t queue_depth = 2;
+};
+
+
+// Outcome of a stream
+struct stream_result
+{
+    // Elements transformed and written
+    std::size_t element_count = 0;
+
+    stream_error error = stream_error::none;
+};
+
+
+// Stream the elements of `p_input` to `p_output` through `p_func(chunk)`
+// `p_func` gets a `std::span<E>` of at most `chunk_size` elements to transform
+//  in place, chunks come in file order
+// The files are neither opened, closed nor rewound
+template<class E, class F>
+stream_result stream_transform(
+    std::FILE * p_input,
+    std::FILE * p_output,
+    F && p_func,
+    const stream_options & p_options = {});
+
+// Stream packed `vector<T, 3>` points from `p_input` to `p_output`, transformed by `p_matrix`
+// Each chunk is transformed in parallel on `p_pool`
+template<class T>
+stream_result transform_point_stream(
+    std::FILE * p_input,
+    std::FILE * p_output,
+    const matrix<T, 4, 4> & p_matrix,
+    const stream_options & p_options = {},
+    thread_pool & p_pool = default_thread_pool());
+
+};  // namespace math
+};  // namespace ft
+
+#include "stream_pipeline.hpp"
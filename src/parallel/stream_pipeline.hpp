@@ -0,0 +1,74 @@
+#pragma once
+
+// Implements the templates of stream_pipeline.h
+
+// project headers
+#include "stream_pipeline.h"
+#include "matrix/matrix_vect_interop.h"
+
+// standard headers
+#include <cstddef>  // std::byte
+#include <functional>
+#include <type_traits>
+
+namespace ft {
+namespace math {
+namespace details {
+namespace stream_pipeline_ns {
+
+// Points transformed per parallel task of transform_point_stream
+inline constexpr std::size_t transform_task_size = 4096;
+
+
+// Run the reader, transform and writer stages on elements of `p_element_size` bytes
+// `p_func(data, count)` transforms `count` elements starting at `data`
+stream_result run(
+    std::FILE * p_input,
+    std::FILE * p_output,
+    const std::size_t p_element_size,
+    const stream_options & p_options,
+    const std::function<void(std::byte *, std::size_t)> & p_func);
+
+};  // namespace stream_pipeline_ns
+};  // namespace details
+};  // namespace math
+};  // namespace ft
+
+
+// Stream the elements of `p_input` to `p_output` through `p_func(chunk)`
+template<class E, class F>
+ft::math::stream_result ft::math::stream_transform(
+    std::FILE * p_input,
+    std::FILE * p_output,
+    F && p_func,
+    const stream_options & p_options)
+{
+    static_assert(std::is_trivially_copyable_v<E>, "streamed elements are copied as bytes");
+    static_assert(alignof(E) <= __STDCPP_DEFAULT_NEW_ALIGNMENT__, "chunk buffers use the default alignment");
+
+    return details::stream_pipeline_ns::run(p_input, p_output, sizeof(E), p_options,
+        [&](std::byte * p_data, const std::size_t p_count) {
+            p_func(std::span<E>(reinterpret_cast<E *>(p_data), p_count));
+        });
+}
+
+
+// Stream packed `vector<T, 3>` points from `p_input` to `p_output`, transformed by `p_matrix`
+template<class T>
+ft::math::stream_result ft::math::transform_point_stream(
+    std::FILE * p_input,
+    std::FILE * p_output,
+    const matrix<T, 4, 4> & p_matrix,
+    const stream_options & p_options,
+    thread_pool & p_pool)
+{
+    return stream_transform<vector<T, 3>>(p_input, p_output, [&](const std::span<vector<T, 3>> p_chunk)
+    {
+        parallel_for_chunks(p_chunk.size(), details::stream_pipeline_ns::transform_task_size,
+            [&](const std::size_t, const std::size_t p_begin, const std::size_t p_end)
+            {
+                const auto points = p_chunk.subspan(p_begin, p_end - p_begin);
+                transform_points_batch<T>(p_matrix, points, points);
+            }, p_pool);
+    }, p_options);
+}
@@ -0,0 +1,160 @@
+// project headers
+#include "thread_pool.h"
+
+// standard headers
+#include <algorithm>
+#include <utility>
+
+namespace {
+
+// Set on threads currently running loop iterations
+thread_local bool t_in_parallel_loop = false;
+
+
+// Marks the current thread as running loop iterations while in scope
+class parallel_loop_scope
+{
+public:
+    parallel_loop_scope() { t_in_parallel_loop = true; }
+    ~parallel_loop_scope() { t_in_parallel_loop = false; }
+
+    parallel_loop_scope(const parallel_loop_scope &) = delete;
+    parallel_loop_scope & operator=(const parallel_loop_scope &) = delete;
+};
+
+}   // namespace
+
+
+// Start `p_thread_count - 1` workers, the caller being the last thread
+ft::math::thread_pool::thread_pool(const std::size_t p_thread_count)
+{
+    auto count = p_thread_count;
+    if (count == 0) {
+        count = std::max<std::size_t>(1, std::thread::hardware_concurrency());
+    }
+
+    m_workers.reserve(count - 1);
+    for (std::size_t i = 1; i < count; ++i) {
+        m_workers.emplace_back([this]() { worker_main(); });
+    }
+}
+
+
+// Stops and joins the workers
+ft::math::thread_pool::~thread_pool()
+{
+    {
+        std::lock_guard lock(m_mutex);
+        m_stop = true;
+    }
+    m_start.notify_all();
+
+    for (auto & worker : m_workers) {
+        worker.join();
+    }
+}
+
+
+// Get the number of threads working on a loop, including the caller
+std::size_t ft::math::thread_pool::thread_count() const
+{
+    return m_workers.size() + 1;
+}
+
+
+// Call `p_func(i)` for each `i` in [0, p_count), spread over the threads
+void ft::math::thread_pool::run(const std::size_t p_count, const std::function<void(std::size_t)> & p_func)
+{
+    // Nested loops and pools without workers run on the calling thread
+    if (t_in_parallel_loop || m_workers.empty() || p_count < 2)
+    {
+        for (std::size_t i = 0; i < p_count; ++i) {
+            p_func(i);
+        }
+        return;
+    }
+
+    std::lock_guard run_lock(m_run_mutex);
+
+    {
+        std::lock_guard lock(m_mutex);
+        m_func = &p_func;
+        m_count = p_count;
+        m_next = 0;
+        m_busy = m_workers.size();
+        m_generation += 1;
+    }
+    m_start.notify_all();
+
+    // The caller works too
+    work();
+
+    // Wait for the workers to let go of the loop, even when a call threw
+    std::exception_ptr exception;
+    {
+        std::unique_lock lock(m_mutex);
+        m_done.wait(lock, [this]() { return m_busy == 0; });
+        m_func = nullptr;
+        std::swap(exception, m_exception);
+    }
+
+    if (exception) {
+        std::rethrow_exception(exception);
+    }
+}
+
+
+// Take and run indices of the current loop until there are none left
+void ft::math::thread_pool::work()
+{
+    const parallel_loop_scope scope;
+    try
+    {
+        for (auto i = m_next.fetch_add(1); i < m_count; i = m_next.fetch_add(1)) {
+            (*m_func)(i);
+        }
+    }
+    catch (...)
+    {
+        // Keep the first exception for `run` and stop handing out indices
+        std::lock_guard lock(m_mutex);
+        if (!m_exception) {
+            m_exception = std::current_exception();
+        }
+        m_next = m_count;
+    }
+}
+
+
+// Worker thread main function
+void ft::math::thread_pool::worker_main()
+{
+    std::size_t generation = 0;
+    while (true)
+    {
+        {
+            std::unique_lock lock(m_mutex);
+            m_start.wait(lock, [&]() { return m_stop || m_generation != generation; });
+            if (m_stop) {
+                return;
+            }
+            generation = m_generation;
+        }
+
+        work();
+
+        {
+            std::lock_guard lock(m_mutex);
+            m_busy -= 1;
+        }
+        m_done.notify_one();
+    }
+}
+
+
+// Get the pool shared by the library
+ft::math::thread_pool & ft::math::default_thread_pool()
+{
+    static thread_pool pool;
+    return pool;
+}
@@ -0,0 +1,101 @@
+#pragma once
+
+// A fixed set of worker threads used by the parallel kernels of the library
+// The calling thread takes part in the work and waits for it to finish
+// Work is split in chunks whose boundaries only depend on the problem size,
+//  never on the number of threads, so kernels that combine per chunk results
+//  in chunk order are deterministic
+// A call made from inside a parallel loop runs serially on the calling thread
+
+// standard headers
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>  // std::size_t
+#include <exception>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace ft {
+namespace math {
+
+class thread_pool
+{
+public:
+    // Start `p_thread_count - 1` workers, the caller being the last thread
+    // Zero uses one thread per hardware thread
+    explicit thread_pool(const std::size_t p_thread_count = 0);
+
+    // Stops and joins the workers
+    ~thread_pool();
+
+    thread_pool(const thread_pool &) = delete;
+    thread_pool & operator=(const thread_pool &) = delete;
+
+
+    // Get the number of threads working on a loop, including the caller
+    std::size_t thread_count() const;
+
+
+    // Call `p_func(i)` for each `i` in [0, p_count), spread over the threads
+    // Returns when every call has returned
+    // If a call throws, the indices not started yet are skipped and the first
+    //  exception is rethrown once every thread has left the loop
+    void run(const std::size_t p_count, const std::function<void(std::size_t)> & p_func);
+
+private:
+    // Take and run indices of the current loop until there are none left
+    void work();
+
+    // Worker thread main function
+    void worker_main();
+
+private:
+    // Worker threads
+    std::vector<std::thread> m_workers;
+
+    // Serializes loops started from different threads
+    std::mutex m_run_mutex;
+
+    // Protects the loop state below
+    std::mutex m_mutex;
+    std::condition_variable m_start;
+    std::condition_variable m_done;
+
+    // Current loop
+    const std::function<void(std::size_t)> * m_func = nullptr;
+    std::size_t m_count = 0;
+    std::atomic<std::size_t> m_next = 0;
+    std::size_t m_generation = 0;
+    std::size_t m_busy = 0;
+    bool m_stop = false;
+
+    // First exception thrown by the current loop
+    std::exception_ptr m_exception;
+
+};  // class thread_pool
+
+
+// Get the pool shared by the library
+// Created on first use with one thread per hardware thread
+thread_pool & default_thread_pool();
+
+
+// Split [0, p_size) in chunks of `p_chunk_size` elements and call
+//  `p_func(p_chunk_index, p_begin, p_end)` for each, in parallel
+// The last chunk may be smaller
+template<class F>
+void parallel_for_chunks(
+    const std::size_t p_size,
+    const std::size_t p_chunk_size,
+    F && p_func,
+    thread_pool & p_pool = default_thread_pool());
+
+// Get the number of chunks `parallel_for_chunks` splits `p_size` elements in
+constexpr std::size_t chunk_count(const std::size_t p_size, const std::size_t p_chunk_size);
+
+};  // namespace math
+};  // namespace ft
+
+#include "thread_pool.hpp"
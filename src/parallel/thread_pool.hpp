@@ -0,0 +1,46 @@
+#pragma once
+
+// Implements the templates of thread_pool.h
+
+// project headers
+#include "thread_pool.h"
+
+// other headers
+#include "error/ft_assert.h"
+
+// Get the number of chunks `parallel_for_chunks` splits `p_size` elements in
+constexpr std::size_t ft::math::chunk_count(const std::size_t p_size, const std::size_t p_chunk_size)
+{
+    return (p_size + p_chunk_size - 1) / p_chunk_size;
+}
+
+
+// Split [0, p_size) in chunks of `p_chunk_size` elements and process them in parallel
+template<class F>
+void ft::math::parallel_for_chunks(
+    const std::size_t p_size,
+    const std::size_t p_chunk_size,
+    F && p_func,
+    thread_pool & p_pool)
+{
+    FT_ASSERT(p_chunk_size > 0);
+
+    const auto count = chunk_count(p_size, p_chunk_size);
+    if (count == 0) {
+        return;
+    }
+
+    // Not worth waking the workers
+    if (count == 1)
+    {
+        p_func(std::size_t{ 0 }, std::size_t{ 0 }, p_size);
+        return;
+    }
+
+    p_pool.run(count, [&](const std::size_t p_chunk)
+    {
+        const auto begin = p_chunk * p_chunk_size;
+        const auto end = (p_size - begin < p_chunk_size) ? p_size : begin + p_chunk_size;
+        p_func(p_chunk, begin, end);
+    });
+}
@@ -0,0 +1,130 @@
+#pragma once
+
+// Parallel reductions over arrays of vectors
+// Arrays are split in chunks of `reduce_chunk_size` vectors reduced in
+//  parallel, then the chunk results are combined in a fixed tree
+// Inside a chunk, consecutive vectors go to `reduce_lane_count` independent
+//  accumulators so the loop can be vectorized and pipelined
+// The order of every addition only depends on the array size, results are
+//  the same bit for bit whatever the number of threads
+//
+// Sums take a summation method, from the cheapest to the most accurate:
+//  - naive: error grows linearly with the size, fine for doubles
+//  - pairwise: error grows with the logarithm of the size, at almost no cost
+//  - kahan: compensated summation, error independent of the size, about
+//    four times the additions
+// Compensated summation is undone by compilers allowed to reassociate
+//  floating point operations (-ffast-math, -fassociative-math)
+
+// project headers
+#include "thread_pool.h"
+#include "vector/vector.h"
+
+// standard headers
+#include <cstddef>  // std::size_t
+#include <span>
+
+namespace ft {
+namespace math {
+
+// Summation methods of the sums
+enum class summation
+{
+    naive,
+    pairwise,
+    kahan
+};
+
+// Vectors reduced per parallel chunk
+inline constexpr std::size_t reduce_chunk_size = 16384;
+
+// Independent accumulators inside a chunk
+inline constexpr std::size_t reduce_lane_count = 8;
+
+// Vectors summed directly by the pairwise method, larger ranges are split in two
+inline constexpr std::size_t reduce_pairwise_block_size = 1024;
+
+
+// Smallest and largest components of an array of vectors
+template<class T, std::size_t S>
+struct vector_minmax_result
+{
+    vector<T, S> min;
+    vector<T, S> max;
+};
+
+
+// Sum an array of vectors
+template<summation M = summation::pairwise, class T, std::size_t S>
+vector<T, S> vector_sum(
+    std::span<const vector<T, S>> p_vectors,
+    thread_pool & p_pool = default_thread_pool());
+
+// Sum an array of vectors scaled by weights
+// `p_weights` must be at least as large as `p_vectors`
+template<summation M = summation::pairwise, class T, std::size_t S>
+vector<T, S> vector_weighted_sum(
+    std::span<const vector<T, S>> p_vectors,
+    std::span<const T> p_weights,
+    thread_pool & p_pool = default_thread_pool());
+
+// Sum the squared lengths of an array of vectors
+template<summation M = summation::pairwise, class T, std::size_t S>
+T vector_length2_sum(
+    std::span<const vector<T, S>> p_vectors,
+    thread_pool & p_pool = default_thread_pool());
+
+
+// Get the mean of a non empty array of vectors
+template<summation M = summation::pairwise, class T, std::size_t S>
+vector<T, S> vector_centroid(
+    std::span<const vector<T, S>> p_vectors,
+    thread_pool & p_pool = default_thread_pool());
+
+// Get the weighted mean of an array of vectors
+// `p_weights` must be at least as large as `p_vectors` and have a non zero sum
+template<summation M = summation::pairwise, class T, std::size_t S>
+vector<T, S> vector_weighted_mean(
+    std::span<const vector<T, S>> p_vectors,
+    std::span<const T> p_weights,
+    thread_pool & p_pool = default_thread_pool());
+
+
+// Reduce an array of vectors with a custom accumulator
+// Each chunk copies `p_initial` and calls `p_add(accumulator, vector)` on its
+//  vectors in order, then `p_merge(accumulator, other)` combines the chunk
+//  accumulators in chunk order, starting from `p_initial`
+// `p_initial` must be an identity of `p_merge`
+template<class A, class T, std::size_t S, class F, class G>
+A vector_accumulate(
+    std::span<const vector<T, S>> p_vectors,
+    const A & p_initial,
+    F && p_add,
+    G && p_merge,
+    thread_pool & p_pool = default_thread_pool());
+
+
+// Get the smallest value of each component
+// An empty array gives the largest value of T
+template<class T, std::size_t S>
+vector<T, S> vector_min(
+    std::span<const vector<T, S>> p_vectors,
+    thread_pool & p_pool = default_thread_pool());
+
+// Get the largest value of each component
+// An empty array gives the lowest value of T
+template<class T, std::size_t S>
+vector<T, S> vector_max(
+    std::span<const vector<T, S>> p_vectors,
+    thread_pool & p_pool = default_thread_pool());
+
+// Get the smallest and largest values of each component in one pass
+template<class T, std::size_t S>
+vector_minmax_result<T, S> vector_minmax(
+    std::span<const vector<T, S>> p_vectors,
+    thread_pool & p_pool = default_thread_pool());
+
+};  // namespace math
+};  // namespace ft
+
+#include "vector_reduce.hpp"
@@ -0,0 +1,356 @@
+#pragma once
+
+// Implements the reductions of vector_reduce.h
+
+// project headers
+#include "vector_reduce.h"
+
+// other headers
+#include "error/ft_assert.h"
+
+// standard headers
+#include <algorithm>
+#include <array>
+#include <limits>
+#include <vector>
+
+namespace ft {
+namespace math {
+namespace details {
+namespace vector_reduce_ns {
+
+// Sum of a range with its compensation
+// The exact sum is `sum - compensation`, the compensation is only
+//  used by the kahan method
+template<class T, std::size_t S>
+struct partial_sum
+{
+    vector<T, S> sum = make_zero_vector<T, S>();
+    vector<T, S> compensation = make_zero_vector<T, S>();
+};
+
+
+// Add `p_value` to a compensated sum
+template<class T, std::size_t S>
+void kahan_add(partial_sum<T, S> & p_partial, const vector<T, S> & p_value)
+{
+    for (std::size_t a = 0; a < S; ++a)
+    {
+        const auto y = p_value[a] - p_partial.compensation[a];
+        const auto t = p_partial.sum[a] + y;
+        p_partial.compensation[a] = (t - p_partial.sum[a]) - y;
+        p_partial.sum[a] = t;
+    }
+}
+
+
+// Combine two partial sums
+template<summation M, class T, std::size_t S>
+partial_sum<T, S> combine(const partial_sum<T, S> & p_left, const partial_sum<T, S> & p_right)
+{
+    if constexpr (M == summation::kahan)
+    {
+        auto result = p_left;
+        kahan_add(result, p_right.sum);
+        kahan_add(result, -p_right.compensation);
+        return result;
+    }
+    else {
+        partial_sum<T, S> result;
+        result.sum = p_left.sum + p_right.sum;
+        return result;
+    }
+}
+
+
+// Combine partial sums in order as a balanced tree
+template<summation M, class T, std::size_t S>
+partial_sum<T, S> combine_all(std::span<partial_sum<T, S>> p_partials)
+{
+    if (p_partials.empty()) {
+        return {};
+    }
+
+    for (std::size_t step = 1; step < p_partials.size(); step *= 2)
+    {
+        for (std::size_t i = 0; i + step < p_partials.size(); i += 2 * step) {
+            p_partials[i] = combine<M>(p_partials[i], p_partials[i + step]);
+        }
+    }
+    return p_partials[0];
+}
+
+
+// Sum `p_value(i)` for i in [p_begin, p_end) with one accumulator per lane
+// Vector `i` goes to lane `(i - p_begin) % reduce_lane_count`
+template<summation M, class T, std::size_t S, class F>
+partial_sum<T, S> sum_lanes(const std::size_t p_begin, const std::size_t p_end, F & p_value)
+{
+    if constexpr (M == summation::kahan)
+    {
+        std::array<partial_sum<T, S>, reduce_lane_count> lanes;
+        for (auto i = p_begin; i < p_end; ++i) {
+            kahan_add(lanes[(i - p_begin) % reduce_lane_count], p_value(i));
+        }
+        return combine_all<M, T, S>(lanes);
+    }
+    else
+    {
+        std::array<vector<T, S>, reduce_lane_count> lanes;
+        lanes.fill(make_zero_vector<T, S>());
+
+        auto i = p_begin;
+        for (; i + reduce_lane_count <= p_end; i += reduce_lane_count)
+        {
+            for (std::size_t l = 0; l < reduce_lane_count; ++l) {
+                lanes[l] += p_value(i + l);
+            }
+        }
+        for (std::size_t l = 0; i < p_end; ++i, ++l) {
+            lanes[l] += p_value(i);
+        }
+
+        for (std::size_t step = 1; step < reduce_lane_count; step *= 2)
+        {
+            for (std::size_t l = 0; l + step < reduce_lane_count; l += 2 * step) {
+                lanes[l] += lanes[l + step];
+            }
+        }
+
+        partial_sum<T, S> result;
+        result.sum = lanes[0];
+        return result;
+    }
+}
+
+
+// Sum `p_value(i)` for i in [p_begin, p_end) with method `M`
+template<summation M, class T, std::size_t S, class F>
+partial_sum<T, S> sum_range(const std::size_t p_begin, const std::size_t p_end, F & p_value)
+{
+    if constexpr (M == summation::pairwise)
+    {
+        if (p_end - p_begin > reduce_pairwise_block_size)
+        {
+            // Split on a block boundary so the leaves are full blocks
+            const auto blocks = (p_end - p_begin + reduce_pairwise_block_size - 1) / reduce_pairwise_block_size;
+            const auto middle = p_begin + (blocks / 2) * reduce_pairwise_block_size;
+            return combine<M>(sum_range<M, T, S>(p_begin, middle, p_value), sum_range<M, T, S>(middle, p_end, p_value));
+        }
+    }
+    return sum_lanes<M, T, S>(p_begin, p_end, p_value);
+}
+
+
+// Sum `p_value(i)` for i in [0, p_size) in parallel chunks
+template<summation M, class T, std::size_t S, class F>
+vector<T, S> parallel_sum(const std::size_t p_size, F && p_value, thread_pool & p_pool)
+{
+    std::vector<partial_sum<T, S>> partials(chunk_count(p_size, reduce_chunk_size));
+    parallel_for_chunks(p_size, reduce_chunk_size, [&](const std::size_t p_chunk, const std::size_t p_begin, const std::size_t p_end) {
+        partials[p_chunk] = sum_range<M, T, S>(p_begin, p_end, p_value);
+    }, p_pool);
+
+    const auto result = combine_all<M, T, S>(partials);
+    return result.sum - result.compensation;
+}
+
+
+// Fill a vector with one value
+template<class T, std::size_t S>
+vector<T, S> make_filled(const T p_value)
+{
+    vector<T, S> result;
+    for (std::size_t a = 0; a < S; ++a) {
+        result[a] = p_value;
+    }
+    return result;
+}
+
+
+// Lower each component of `p_min` to the one of `p_value`
+template<class T, std::size_t S>
+void lower(vector<T, S> & p_min, const vector<T, S> & p_value)
+{
+    for (std::size_t a = 0; a < S; ++a) {
+        p_min[a] = (p_value[a] < p_min[a]) ? p_value[a] : p_min[a];
+    }
+}
+
+
+// Raise each component of `p_max` to the one of `p_value`
+template<class T, std::size_t S>
+void raise(vector<T, S> & p_max, const vector<T, S> & p_value)
+{
+    for (std::size_t a = 0; a < S; ++a) {
+        p_max[a] = (p_value[a] > p_max[a]) ? p_value[a] : p_max[a];
+    }
+}
+
+};  // namespace vector_reduce_ns
+};  // namespace details
+};  // namespace math
+};  // namespace ft
+
+
+// Sum an array of vectors
+template<ft::math::summation M, class T, std::size_t S>
+ft::math::vector<T, S> ft::math::vector_sum(
+    std::span<const vector<T, S>> p_vectors,
+    thread_pool & p_pool)
+{
+    return details::vector_reduce_ns::parallel_sum<M, T, S>(p_vectors.size(), [&](const std::size_t p_index) -> const vector<T, S> & {
+        return p_vectors[p_index];
+    }, p_pool);
+}
+
+
+// Sum an array of vectors scaled by weights
+template<ft::math::summation M, class T, std::size_t S>
+ft::math::vector<T, S> ft::math::vector_weighted_sum(
+    std::span<const vector<T, S>> p_vectors,
+    std::span<const T> p_weights,
+    thread_pool & p_pool)
+{
+    FT_ASSERT(p_weights.size() >= p_vectors.size());
+
+    return details::vector_reduce_ns::parallel_sum<M, T, S>(p_vectors.size(), [&](const std::size_t p_index) {
+        return p_vectors[p_index] * p_weights[p_index];
+    }, p_pool);
+}
+
+
+// Sum the squared lengths of an array of vectors
+template<ft::math::summation M, class T, std::size_t S>
+T ft::math::vector_length2_sum(
+    std::span<const vector<T, S>> p_vectors,
+    thread_pool & p_pool)
+{
+    return details::vector_reduce_ns::parallel_sum<M, T, 1>(p_vectors.size(), [&](const std::size_t p_index) {
+        return vector<T, 1>{ length2(p_vectors[p_index]) };
+    }, p_pool)[0];
+}
+
+
+// Get the mean of a non empty array of vectors
+template<ft::math::summation M, class T, std::size_t S>
+ft::math::vector<T, S> ft::math::vector_centroid(
+    std::span<const vector<T, S>> p_vectors,
+    thread_pool & p_pool)
+{
+    FT_ASSERT(!p_vectors.empty());
+    return vector_sum<M>(p_vectors, p_pool) / static_cast<T>(p_vectors.size());
+}
+
+
+// Get the weighted mean of an array of vectors
+template<ft::math::summation M, class T, std::size_t S>
+ft::math::vector<T, S> ft::math::vector_weighted_mean(
+    std::span<const vector<T, S>> p_vectors,
+    std::span<const T> p_weights,
+    thread_pool & p_pool)
+{
+    FT_ASSERT(p_weights.size() >= p_vectors.size());
+
+    // Sum the weights alongside the weighted vectors, in the same pass
+    const auto sum = details::vector_reduce_ns::parallel_sum<M, T, S + 1>(p_vectors.size(), [&](const std::size_t p_index) {
+        const auto weight = p_weights[p_index];
+        vector<T, S + 1> result;
+        for (std::size_t a = 0; a < S; ++a) {
+            result[a] = p_vectors[p_index][a] * weight;
+        }
+        result[S] = weight;
+        return result;
+    }, p_pool);
+
+    FT_ASSERT(sum[S] != 0);
+    vector<T, S> result;
+    for (std::size_t a = 0; a < S; ++a) {
+        result[a] = sum[a] / sum[S];
+    }
+    return result;
+}
+
+
+// Reduce an array of vectors with a custom accumulator
+template<class A, class T, std::size_t S, class F, class G>
+A ft::math::vector_accumulate(
+    std::span<const vector<T, S>> p_vectors,
+    const A & p_initial,
+    F && p_add,
+    G && p_merge,
+    thread_pool & p_pool)
+{
+    std::vector<A> partials(chunk_count(p_vectors.size(), reduce_chunk_size), p_initial);
+    parallel_for_chunks(p_vectors.size(), reduce_chunk_size, [&](const std::size_t p_chunk, const std::size_t p_begin, const std::size_t p_end)
+    {
+        auto accumulator = p_initial;
+        for (auto i = p_begin; i < p_end; ++i) {
+            p_add(accumulator, p_vectors[i]);
+        }
+        partials[p_chunk] = accumulator;
+    }, p_pool);
+
+    auto result = p_initial;
+    for (const auto & partial : partials) {
+        p_merge(result, partial);
+    }
+    return result;
+}
+
+
+// Get the smallest value of each component
+template<class T, std::size_t S>
+ft::math::vector<T, S> ft::math::vector_min(
+    std::span<const vector<T, S>> p_vectors,
+    thread_pool & p_pool)
+{
+    using namespace details::vector_reduce_ns;
+
+    return vector_accumulate(p_vectors, make_filled<T, S>(std::numeric_limits<T>::max()),
+        [](auto & p_min, const auto & p_value) { lower(p_min, p_value); },
+        [](auto & p_min, const auto & p_other) { lower(p_min, p_other); },
+        p_pool);
+}
+
+
+// Get the largest value of each component
+template<class T, std::size_t S>
+ft::math::vector<T, S> ft::math::vector_max(
+    std::span<const vector<T, S>> p_vectors,
+    thread_pool & p_pool)
+{
+    using namespace details::vector_reduce_ns;
+
+    return vector_accumulate(p_vectors, make_filled<T, S>(std::numeric_limits<T>::lowest()),
+        [](auto & p_max, const auto & p_value) { raise(p_max, p_value); },
+        [](auto & p_max, const auto & p_other) { raise(p_max, p_other); },
+        p_pool);
+}
+
+
+// Get the smallest and largest values of each component in one pass
+template<class T, std::size_t S>
+ft::math::vector_minmax_result<T, S> ft::math::vector_minmax(
+    std::span<const vector<T, S>> p_vectors,
+    thread_pool & p_pool)
+{
+    using namespace details::vector_reduce_ns;
+
+    const auto initial = vector_minmax_result<T, S>{
+        make_filled<T, S>(std::numeric_limits<T>::max()),
+        make_filled<T, S>(std::numeric_limits<T>::lowest())
+    };
+    return vector_accumulate(p_vectors, initial,
+        [](auto & p_result, const auto & p_value)
+        {
+            lower(p_result.min, p_value);
+            raise(p_result.max, p_value);
+        },
+        [](auto & p_result, const auto & p_other)
+        {
+            lower(p_result.min, p_other.min);
+            raise(p_result.max, p_other.max);
+        },
+        p_pool);
+}
@@ -1,11 +1,10 @@
 #pragma once
 
 // project headers
-#include "matrix/matrix.h"
+#include "numeric/dual.h"
 #include "vector/vector.h"
 
 // standard headers
-#include <complex>
 #include <type_traits>
 
 // i, j, k are the imaginary components
@@ -16,6 +15,7 @@
 //  float
 //  double
 //  long double
+//  a dual number of one of those, to differentiate quaternion expressions
 
 namespace ft {
 namespace math {
@@ -24,10 +24,8 @@ template<class T>
 class quaternion
 {
     static_assert(
-        std::is_same_v<T, float> ||
-        std::is_same_v<T, double> ||
-        std::is_same_v<T, long double>,
-        "Uses std::complex internally, only float, double or long double are supported");
+        std::is_floating_point_v<T> || is_dual_v<T>,
+        "Only float, double, long double or dual numbers of those are supported");
 
 public:
     // Default constructor
@@ -86,20 +84,13 @@ public:
     quaternion & operator*=(const quaternion & p_other);
 
 private:
-    // Get a component from the matrix representation
-    T get_r() const;
-    T get_i() const;
-    T get_j() const;
-    T get_k() const;
-
-private:
-    // Use matrix representation
-    // https://en.wikipedia.org/wiki/Quaternion#Matrix_representations
-    matrix<std::complex<T>, 2, 2> m_matrix;
+    // Components in (r, i, j, k) order
+    vector<T, 4> m_components;
 
 };  // class quaternion
 
 };  // namespace math
 };  // namespace ft
 
+#include "quaternion.hpp"
 #include "quaternion_operators.h"
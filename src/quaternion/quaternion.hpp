@@ -1,15 +1,12 @@
-// project heaers
-#include "matrix/matrix_operators.h"
-#include "quaternion.h"
+#pragma once
 
-// standard headers
-#include <cmath>
+#include "quaternion.h"
 
 // Initialize to these values
 template<class T>
 ft::math::quaternion<T>::quaternion(const T p_r, const T p_i, const T p_j, const T p_k)
 {
-    set(p_r, p_i, p_j, p_j);
+    set(p_r, p_i, p_j, p_k);
 }
 
 
@@ -25,10 +22,7 @@ ft::math::quaternion<T>::quaternion(const T p_r, const vector<T, 3> & p_v)
 template<class T>
 void ft::math::quaternion<T>::set(const T p_r, const T p_i, const T p_j, const T p_k)
 {
-    m_matrix[0][0] = { p_r, p_i };
-    m_matrix[0][1] = { p_j, p_k };
-    m_matrix[1][0] = { -p_j, p_k };
-    m_matrix[1][1] = { p_r, -p_i };
+    m_components = { p_r, p_i, p_j, p_k };
 }
 
 
@@ -60,7 +54,7 @@ void ft::math::quaternion<T>::set(const vector<T, 4> & p_values)
 template<class T>
 ft::math::vector<T, 3> ft::math::quaternion<T>::get_imaginary() const
 {
-    return { get_i(), get_j(), get_k() };
+    return { m_components[1], m_components[2], m_components[3] };
 }
 
 
@@ -68,7 +62,7 @@ ft::math::vector<T, 3> ft::math::quaternion<T>::get_imaginary() const
 template<class T>
 T ft::math::quaternion<T>::get_real() const
 {
-    return get_r();
+    return m_components[0];
 }
 
 
@@ -77,7 +71,7 @@ T ft::math::quaternion<T>::get_real() const
 template<class T>
 ft::math::vector<T, 4> ft::math::quaternion<T>::get_components() const
 {
-    return { get_r(), get_i(), get_j(), get_k() };
+    return m_components;
 }
 
 
@@ -85,7 +79,7 @@ ft::math::vector<T, 4> ft::math::quaternion<T>::get_components() const
 template<class T>
 ft::math::quaternion<T> & ft::math::quaternion<T>::operator+=(const quaternion & p_other)
 {
-    m_matrix += p_other.m_matrix;
+    m_components += p_other.m_components;
     return *this;
 }
 
@@ -94,7 +88,7 @@ ft::math::quaternion<T> & ft::math::quaternion<T>::operator+=(const quaternion &
 template<class T>
 ft::math::quaternion<T> & ft::math::quaternion<T>::operator-=(const quaternion & p_other)
 {
-    m_matrix -= p_other.m_matrix;
+    m_components -= p_other.m_components;
     return *this;
 }
 
@@ -103,7 +97,7 @@ ft::math::quaternion<T> & ft::math::quaternion<T>::operator-=(const quaternion &
 template<class T>
 ft::math::quaternion<T> & ft::math::quaternion<T>::operator*=(const T p_scalar)
 {
-    m_matrix *= p_scalar;
+    m_components *= p_scalar;
     return *this;
 }
 
@@ -112,52 +106,24 @@ ft::math::quaternion<T> & ft::math::quaternion<T>::operator*=(const T p_scalar)
 template<class T>
 ft::math::quaternion<T> & ft::math::quaternion<T>::operator/=(const T p_scalar)
 {
-    m_matrix /= p_scalar;
+    m_components /= p_scalar;
     return *this;
 }
 
 
 // Quaternion multiplication
+// Hamilton product
 template<class T>
 ft::math::quaternion<T> & ft::math::quaternion<T>::operator*=(const quaternion & p_other)
 {
-    m_matrix *= p_other.m_matrix;
-    return *this;
-}
-
-
-// Get a component from the matrix representation
-template<class T>
-T ft::math::quaternion<T>::get_r() const
-{
-    return m_matrix[0][0].real();
-}
-
-
-// Get a component from the matrix representation
-template<class T>
-T ft::math::quaternion<T>::get_i() const
-{
-    return m_matrix[0][0].imag();
-}
-
-
-// Get a component from the matrix representation
-template<class T>
-T ft::math::quaternion<T>::get_j() const
-{
-    return m_matrix[0][1].real();
-}
-
+    const auto [ar, ai, aj, ak] = m_components;
+    const auto [br, bi, bj, bk] = p_other.m_components;
 
-// Get a component from the matrix representation
-template<class T>
-T ft::math::quaternion<T>::get_k() const
-{
-    return m_matrix[0][1].imag();
+    m_components = {
+        ar * br - ai * bi - aj * bj - ak * bk,
+        ar * bi + ai * br + aj * bk - ak * bj,
+        ar * bj - ai * bk + aj * br + ak * bi,
+        ar * bk + ai * bj - aj * bi + ak * br
+    };
+    return *this;
 }
-
-// Explicit specialization
-template class ft::math::quaternion<float>;
-template class ft::math::quaternion<double>;
-template class ft::math::quaternion<long double>;
@@ -0,0 +1,74 @@
+#pragma once
+
+// Compact fixed size encodings of unit quaternions
+//
+// The smallest three encoding drops the component of largest magnitude,
+//  which is recovered from the unit length, after flipping the sign of the
+//  quaternion to make it positive (q and -q are the same rotation)
+// The other three components lie in [-1 / sqrt(2), 1 / sqrt(2)] and are
+//  quantized with `(B - 2) / 3` bits each, the 2 bits above them store the index
+//  of the dropped component
+// Worst case rotation angle between a unit quaternion and its decoded value,
+//  measured over dense samples of the rotations:
+//  - 32 bits: 4.3e-3 rad (0.25 degrees)
+//  - 48 bits: 1.3e-4 rad (0.0075 degrees)
+//  - 64 bits: 4.1e-6 rad (0.00024 degrees), 4.3e-6 rad with floats
+// The batches taking a `std::span<std::byte>` store the codes packed as
+//  described in vector_encoding.h, a 48 bit code takes 6 bytes
+//
+// Batches are written without branches so the compiler can vectorize them
+
+// project headers
+#include "quaternion.h"
+#include "vector/vector_encoding.h"
+#include "vector/vector_soa.h"
+
+// standard headers
+#include <cstddef>  // std::size_t
+#include <span>
+
+namespace ft {
+namespace math {
+
+// Encode a unit quaternion in `B` bits, `B` being 32, 48 or 64
+template<std::size_t B, class T>
+quantized_code<B> encode_smallest_three(const quaternion<T> & p_quaternion);
+
+// Decode a unit quaternion encoded in `B` bits
+// The real part of the result may have the opposite sign of the encoded one
+template<std::size_t B, class T>
+quaternion<T> decode_smallest_three(const quantized_code<B> p_code);
+
+
+// Encode an array of (r, i, j, k) unit quaternion components in `B` bits each
+// `p_codes` must be at least as large as `p_quaternions`
+template<std::size_t B, class T>
+void encode_smallest_three_batch(
+    const vector_soa_span<const T, 4> & p_quaternions,
+    std::span<quantized_code<B>> p_codes);
+
+// Decode an array of unit quaternions encoded in `B` bits each to (r, i, j, k) components
+// `p_results` must be at least as large as `p_codes`
+template<std::size_t B, class T>
+void decode_smallest_three_batch(
+    std::span<const quantized_code<B>> p_codes,
+    const vector_soa_span<T, 4> & p_results);
+
+// Encode an array of (r, i, j, k) unit quaternion components to a stream of packed `B` bit codes
+// `p_bytes` must hold at least `packed_code_size<B>` bytes per quaternion
+template<std::size_t B, class T>
+void encode_smallest_three_batch(
+    const vector_soa_span<const T, 4> & p_quaternions,
+    std::span<std::byte> p_bytes);
+
+// Decode a stream of packed `B` bit codes to an array of (r, i, j, k) unit quaternion components
+// `p_bytes` holds whole codes, `p_results` must have one quaternion per code
+template<std::size_t B, class T>
+void decode_smallest_three_batch(
+    std::span<const std::byte> p_bytes,
+    const vector_soa_span<T, 4> & p_results);
+
+};  // namespace math
+};  // namespace ft
+
+#include "quaternion_encoding.hpp"
@@ -0,0 +1,182 @@
+#pragma once
+
+// Implements the encodings of quaternion_encoding.h
+
+// project headers
+#include "quaternion_encoding.h"
+
+// other headers
+#include "error/ft_assert.h"
+
+// standard headers
+#include <algorithm>
+#include <cmath>
+#include <numbers>
+
+namespace ft {
+namespace math {
+namespace details {
+namespace quaternion_encoding_ns {
+
+// Bits of each stored component of a `B` bit code
+template<std::size_t B>
+inline constexpr std::size_t component_bits = (B - 2) / 3;
+
+
+// Encode (r, i, j, k) unit quaternion components in `B` bits
+template<std::size_t B, class T>
+inline quantized_code<B> encode(const T p_r, const T p_i, const T p_j, const T p_k)
+{
+    static_assert(B == 32 || B == 48 || B == 64, "smallest three codes are 32, 48 or 64 bits");
+    constexpr auto N = component_bits<B>;
+    using U = quantized_code<B>;
+
+    // Find the component of largest magnitude
+    const auto ar = std::abs(p_r);
+    const auto ai = std::abs(p_i);
+    const auto aj = std::abs(p_j);
+    const auto ak = std::abs(p_k);
+    const auto rj = ar >= aj ? 0 : 2;
+    const auto ik = ai >= ak ? 1 : 3;
+    const auto largest = std::max(ar, aj) >= std::max(ai, ak) ? rj : ik;
+    const auto largest_value = (largest == 0) ? p_r : (largest == 1) ? p_i : (largest == 2) ? p_j : p_k;
+
+    // The other components in order
+    const auto a = (largest == 0) ? p_i : p_r;
+    const auto b = (largest <= 1) ? p_j : p_i;
+    const auto c = (largest <= 2) ? p_k : p_j;
+
+    // Flip the quaternion so the dropped component is positive, and map
+    //  the others from [-1 / sqrt(2), 1 / sqrt(2)] to [0, 1]
+    const auto half = static_cast<T>(0.5);
+    const auto scale = std::copysign(std::numbers::sqrt2_v<T> * half, largest_value);
+
+    return static_cast<U>(
+        (static_cast<U>(largest) << (3 * N)) |
+        (vector_encoding_ns::quantize_unit<N, U>(a * scale + half) << (2 * N)) |
+        (vector_encoding_ns::quantize_unit<N, U>(b * scale + half) << N) |
+        vector_encoding_ns::quantize_unit<N, U>(c * scale + half));
+}
+
+
+// Decode (r, i, j, k) unit quaternion components encoded in `B` bits
+template<std::size_t B, class T>
+inline void decode(const quantized_code<B> p_code, T & p_r, T & p_i, T & p_j, T & p_k)
+{
+    static_assert(B == 32 || B == 48 || B == 64, "smallest three codes are 32, 48 or 64 bits");
+    constexpr auto N = component_bits<B>;
+    constexpr auto mask = vector_encoding_ns::max_code<N>;
+    constexpr auto scale = std::numbers::sqrt2_v<T> / 2;
+
+    const auto largest = p_code >> (3 * N);
+    const auto a = (vector_encoding_ns::dequantize_unit<N, T>((p_code >> (2 * N)) & mask) * 2 - 1) * scale;
+    const auto b = (vector_encoding_ns::dequantize_unit<N, T>((p_code >> N) & mask) * 2 - 1) * scale;
+    const auto c = (vector_encoding_ns::dequantize_unit<N, T>(p_code & mask) * 2 - 1) * scale;
+
+    const auto remainder = 1 - a * a - b * b - c * c;
+    const auto largest_value = std::sqrt((remainder > 0) ? remainder : static_cast<T>(0));
+
+    p_r = (largest == 0) ? largest_value : a;
+    p_i = (largest == 0) ? a : (largest == 1) ? largest_value : b;
+    p_j = (largest <= 1) ? b : (largest == 2) ? largest_value : c;
+    p_k = (largest <= 2) ? c : largest_value;
+}
+
+};  // namespace quaternion_encoding_ns
+};  // namespace details
+};  // namespace math
+};  // namespace ft
+
+
+// Encode a unit quaternion in `B` bits
+template<std::size_t B, class T>
+ft::math::quantized_code<B> ft::math::encode_smallest_three(const quaternion<T> & p_quaternion)
+{
+    const auto q = p_quaternion.get_components();
+    return details::quaternion_encoding_ns::encode<B>(q[0], q[1], q[2], q[3]);
+}
+
+
+// Decode a unit quaternion encoded in `B` bits
+template<std::size_t B, class T>
+ft::math::quaternion<T> ft::math::decode_smallest_three(const quantized_code<B> p_code)
+{
+    vector<T, 4> q;
+    details::quaternion_encoding_ns::decode<B>(p_code, q[0], q[1], q[2], q[3]);
+    return quaternion<T>(q);
+}
+
+
+// Encode an array of (r, i, j, k) unit quaternion components in `B` bits each
+template<std::size_t B, class T>
+void ft::math::encode_smallest_three_batch(
+    const vector_soa_span<const T, 4> & p_quaternions,
+    std::span<quantized_code<B>> p_codes)
+{
+    FT_ASSERT(p_codes.size() >= p_quaternions.size());
+
+    const auto r = p_quaternions.component(0);
+    const auto i = p_quaternions.component(1);
+    const auto j = p_quaternions.component(2);
+    const auto k = p_quaternions.component(3);
+    for (std::size_t n = 0; n < p_quaternions.size(); ++n) {
+        p_codes[n] = details::quaternion_encoding_ns::encode<B>(r[n], i[n], j[n], k[n]);
+    }
+}
+
+
+// Decode an array of unit quaternions encoded in `B` bits each to (r, i, j, k) components
+template<std::size_t B, class T>
+void ft::math::decode_smallest_three_batch(
+    std::span<const quantized_code<B>> p_codes,
+    const vector_soa_span<T, 4> & p_results)
+{
+    FT_ASSERT(p_results.size() >= p_codes.size());
+
+    const auto r = p_results.component(0);
+    const auto i = p_results.component(1);
+    const auto j = p_results.component(2);
+    const auto k = p_results.component(3);
+    for (std::size_t n = 0; n < p_codes.size(); ++n) {
+        details::quaternion_encoding_ns::decode<B>(p_codes[n], r[n], i[n], j[n], k[n]);
+    }
+}
+
+
+// Encode an array of (r, i, j, k) unit quaternion components to a stream of packed `B` bit codes
+template<std::size_t B, class T>
+void ft::math::encode_smallest_three_batch(
+    const vector_soa_span<const T, 4> & p_quaternions,
+    std::span<std::byte> p_bytes)
+{
+    FT_ASSERT(p_bytes.size() >= p_quaternions.size() * packed_code_size<B>);
+
+    const auto r = p_quaternions.component(0);
+    const auto i = p_quaternions.component(1);
+    const auto j = p_quaternions.component(2);
+    const auto k = p_quaternions.component(3);
+    for (std::size_t n = 0; n < p_quaternions.size(); ++n) {
+        store_packed_code<B>(details::quaternion_encoding_ns::encode<B>(r[n], i[n], j[n], k[n]), p_bytes.data() + n * packed_code_size<B>);
+    }
+}
+
+
+// Decode a stream of packed `B` bit codes to an array of (r, i, j, k) unit quaternion components
+template<std::size_t B, class T>
+void ft::math::decode_smallest_three_batch(
+    std::span<const std::byte> p_bytes,
+    const vector_soa_span<T, 4> & p_results)
+{
+    FT_ASSERT(p_bytes.size() % packed_code_size<B> == 0);
+
+    const auto count = p_bytes.size() / packed_code_size<B>;
+    FT_ASSERT(p_results.size() >= count);
+
+    const auto r = p_results.component(0);
+    const auto i = p_results.component(1);
+    const auto j = p_results.component(2);
+    const auto k = p_results.component(3);
+    for (std::size_t n = 0; n < count; ++n) {
+        details::quaternion_encoding_ns::decode<B>(load_packed_code<B>(p_bytes.data() + n * packed_code_size<B>), r[n], i[n], j[n], k[n]);
+    }
+}
@@ -0,0 +1,54 @@
+#pragma once
+
+// Integration of orientations with a constant angular velocity over a time step
+// Angular velocities are in world space, in radians per unit of time, so that
+//  dq / dt = (0, omega) * q / 2
+//
+// The exact step multiplies by the rotation of angle |omega| * dt around omega,
+//  q' = exp((0, omega * dt / 2)) * q, and keeps unit quaternions unit
+// The first order step is q' = q + (0, omega) * q * dt / 2 renormalized, it
+//  saves the sine and cosine but its angle error grows as (|omega| * dt)^3
+
+// project headers
+#include "numeric/elementary_functions.h"
+#include "quaternion.h"
+#include "vector/vector.h"
+#include "vector/vector_soa.h"
+
+namespace ft {
+namespace math {
+
+// Integrate a unit quaternion over a time step
+template<class T>
+quaternion<T> integrate(const quaternion<T> & p_orientation, const vector<T, 3> & p_angular_velocity, const T p_time_step);
+
+// Integrate a unit quaternion over a time step with a first order step
+template<class T>
+quaternion<T> integrate_first_order(const quaternion<T> & p_orientation, const vector<T, 3> & p_angular_velocity, const T p_time_step);
+
+
+// Integrate an array of (r, i, j, k) unit quaternion components over a time step
+// `p_angular_velocities` and `p_results` must be at least as large as `p_orientations`
+// `p_results` may alias `p_orientations`
+template<approximation_tier A = approximation_tier::precise, class T>
+void integrate_batch(
+    const vector_soa_span<const T, 4> & p_orientations,
+    const vector_soa_span<const T, 3> & p_angular_velocities,
+    const T p_time_step,
+    const vector_soa_span<T, 4> & p_results);
+
+// Integrate an array of (r, i, j, k) unit quaternion components over a time step
+//  with first order steps
+// `p_angular_velocities` and `p_results` must be at least as large as `p_orientations`
+// `p_results` may alias `p_orientations`
+template<class T>
+void integrate_first_order_batch(
+    const vector_soa_span<const T, 4> & p_orientations,
+    const vector_soa_span<const T, 3> & p_angular_velocities,
+    const T p_time_step,
+    const vector_soa_span<T, 4> & p_results);
+
+};  // namespace math
+};  // namespace ft
+
+#include "quaternion_integration.hpp"
@@ -0,0 +1,134 @@
+#pragma once
+
+// Implements the integration steps of quaternion_integration.h
+
+// project headers
+#include "quaternion_integration.h"
+#include "quaternion_rotation.h"
+#include "quaternion_utility.h"
+
+// other headers
+#include "error/ft_assert.h"
+
+// standard headers
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <span>
+
+namespace ft {
+namespace math {
+namespace details {
+namespace quaternion_integration_ns {
+
+// Exact step of the unit quaternion (r, i, j, k)
+// `p_half_omega` is the angular velocity times half the time step, `p_angle`
+//  its norm and `p_sine`, `p_cosine` the sine and cosine of the norm
+template<class T>
+vector<T, 4> integrate_components(const vector<T, 4> & p_q, const vector<T, 3> & p_half_omega, const T p_angle, const T p_sine, const T p_cosine)
+{
+    const auto delta = quaternion_utility_ns::exp_imaginary_components(
+        vector<T, 4>{ static_cast<T>(0), p_half_omega[0], p_half_omega[1], p_half_omega[2] },
+        p_angle, p_sine, p_cosine);
+    return quaternion_rotation_ns::multiply_components(delta, p_q);
+}
+
+
+// First order step of the unit quaternion (r, i, j, k)
+template<class T>
+vector<T, 4> integrate_first_order_components(const vector<T, 4> & p_q, const vector<T, 3> & p_omega, const T p_time_step)
+{
+    const auto half_step = p_time_step / 2;
+    const auto derivative = quaternion_rotation_ns::multiply_components(
+        vector<T, 4>{ static_cast<T>(0), p_omega[0], p_omega[1], p_omega[2] },
+        p_q);
+
+    auto result = p_q + derivative * half_step;
+    result *= static_cast<T>(1 / std::sqrt(length2(result)));
+    return result;
+}
+
+};  // namespace quaternion_integration_ns
+};  // namespace details
+};  // namespace math
+};  // namespace ft
+
+
+// Integrate a unit quaternion over a time step
+template<class T>
+ft::math::quaternion<T> ft::math::integrate(const quaternion<T> & p_orientation, const vector<T, 3> & p_angular_velocity, const T p_time_step)
+{
+    const auto half_omega = p_angular_velocity * (p_time_step / 2);
+    const auto angle = length(half_omega);
+    return quaternion<T>(details::quaternion_integration_ns::integrate_components(
+        p_orientation.get_components(), half_omega, angle, static_cast<T>(std::sin(angle)), static_cast<T>(std::cos(angle))));
+}
+
+
+// Integrate a unit quaternion over a time step with a first order step
+template<class T>
+ft::math::quaternion<T> ft::math::integrate_first_order(const quaternion<T> & p_orientation, const vector<T, 3> & p_angular_velocity, const T p_time_step)
+{
+    return quaternion<T>(details::quaternion_integration_ns::integrate_first_order_components(
+        p_orientation.get_components(), p_angular_velocity, p_time_step));
+}
+
+
+// Integrate an array of (r, i, j, k) unit quaternion components over a time step
+template<ft::math::approximation_tier A, class T>
+void ft::math::integrate_batch(
+    const vector_soa_span<const T, 4> & p_orientations,
+    const vector_soa_span<const T, 3> & p_angular_velocities,
+    const T p_time_step,
+    const vector_soa_span<T, 4> & p_results)
+{
+    using details::quaternion_rotation_ns::batch_block_size;
+
+    FT_ASSERT(p_angular_velocities.size() >= p_orientations.size());
+    FT_ASSERT(p_results.size() >= p_orientations.size());
+
+    const auto half_step = p_time_step / 2;
+    std::array<T, batch_block_size> angles;
+    std::array<T, batch_block_size> sines;
+    std::array<T, batch_block_size> cosines;
+
+    for (std::size_t begin = 0; begin < p_orientations.size(); begin += batch_block_size)
+    {
+        const auto count = std::min(batch_block_size, p_orientations.size() - begin);
+
+        for (std::size_t i = 0; i < count; ++i) {
+            angles[i] = length(p_angular_velocities.get(begin + i) * half_step);
+        }
+        sincos_batch<A, T>(
+            std::span<const T>(angles.data(), count),
+            std::span<T>(sines.data(), count),
+            std::span<T>(cosines.data(), count));
+
+        for (std::size_t i = 0; i < count; ++i)
+        {
+            const auto index = begin + i;
+            p_results.set(index, details::quaternion_integration_ns::integrate_components(
+                p_orientations.get(index), p_angular_velocities.get(index) * half_step, angles[i], sines[i], cosines[i]));
+        }
+    }
+}
+
+
+// Integrate an array of (r, i, j, k) unit quaternion components over a time step
+//  with first order steps
+template<class T>
+void ft::math::integrate_first_order_batch(
+    const vector_soa_span<const T, 4> & p_orientations,
+    const vector_soa_span<const T, 3> & p_angular_velocities,
+    const T p_time_step,
+    const vector_soa_span<T, 4> & p_results)
+{
+    FT_ASSERT(p_angular_velocities.size() >= p_orientations.size());
+    FT_ASSERT(p_results.size() >= p_orientations.size());
+
+    for (std::size_t i = 0; i < p_orientations.size(); ++i)
+    {
+        p_results.set(i, details::quaternion_integration_ns::integrate_first_order_components(
+            p_orientations.get(i), p_angular_velocities.get(i), p_time_step));
+    }
+}
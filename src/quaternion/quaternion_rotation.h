@@ -0,0 +1,75 @@
+#pragma once
+
+// Conversions between unit quaternions and rotations
+
+// project headers
+#include "matrix/matrix.h"
+#include "numeric/elementary_functions.h"
+#include "quaternion.h"
+#include "vector/vector.h"
+#include "vector/vector_soa.h"
+
+// standard headers
+#include <span>
+
+namespace ft {
+namespace math {
+
+// Rotation of `angle` radians around a unit `axis`
+template<class T>
+struct axis_angle
+{
+    vector<T, 3> axis;
+    T angle;
+};
+
+
+// Make the rotation matrix of a unit quaternion
+template<class T>
+matrix<T, 3, 3> make_rotation_matrix(const quaternion<T> & p_quaternion);
+
+// Make the unit quaternion of a rotation matrix
+// The real part of the result is never negative
+template<class T>
+quaternion<T> make_rotation_quaternion(const matrix<T, 3, 3> & p_matrix);
+
+
+// Make the unit quaternion of a rotation of `p_angle` radians around a unit axis
+template<class T>
+quaternion<T> make_rotation_quaternion(const vector<T, 3> & p_axis, const T p_angle);
+
+// Make the unit quaternion of a rotation around a unit axis
+template<class T>
+quaternion<T> make_rotation_quaternion(const axis_angle<T> & p_axis_angle);
+
+// Get the axis and angle of the rotation of a unit quaternion
+// The angle is in [0, pi], the identity gives the +x axis
+template<class T>
+axis_angle<T> make_axis_angle(const quaternion<T> & p_quaternion);
+
+
+// Rotate a vector by a unit quaternion
+template<class T>
+vector<T, 3> rotate(const quaternion<T> & p_quaternion, const vector<T, 3> & p_vector);
+
+
+// Make the (r, i, j, k) unit quaternion components of an array of axis angle rotations
+// `p_angles` and `p_results` must be at least as large as `p_axes`
+template<approximation_tier A = approximation_tier::precise, class T>
+void make_rotation_quaternion_batch(
+    const vector_soa_span<const T, 3> & p_axes,
+    std::span<const T> p_angles,
+    const vector_soa_span<T, 4> & p_results);
+
+// Get the axes and angles of an array of (r, i, j, k) unit quaternion components
+// `p_axes` and `p_angles` must be at least as large as `p_quaternions`
+template<approximation_tier A = approximation_tier::precise, class T>
+void make_axis_angle_batch(
+    const vector_soa_span<const T, 4> & p_quaternions,
+    const vector_soa_span<T, 3> & p_axes,
+    std::span<T> p_angles);
+
+};  // namespace math
+};  // namespace ft
+
+#include "quaternion_rotation.hpp"
@@ -0,0 +1,296 @@
+#pragma once
+
+// Implements the conversions of quaternion_rotation.h
+// The kernels work on raw (r, i, j, k) components so that batched
+//  code can use them without going through the quaternion class
+
+// project headers
+#include "quaternion_rotation.h"
+#include "quaternion_utility.h"
+#include "vector/vector_functions.h"
+
+// other headers
+#include "error/ft_assert.h"
+
+// standard headers
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <limits>
+
+namespace ft {
+namespace math {
+namespace details {
+namespace quaternion_rotation_ns {
+
+// Hamilton product of two quaternions given as (r, i, j, k) components
+template<class T>
+constexpr vector<T, 4> multiply_components(const vector<T, 4> & p_a, const vector<T, 4> & p_b)
+{
+    return {
+        p_a[0] * p_b[0] - p_a[1] * p_b[1] - p_a[2] * p_b[2] - p_a[3] * p_b[3],
+        p_a[0] * p_b[1] + p_a[1] * p_b[0] + p_a[2] * p_b[3] - p_a[3] * p_b[2],
+        p_a[0] * p_b[2] - p_a[1] * p_b[3] + p_a[2] * p_b[0] + p_a[3] * p_b[1],
+        p_a[0] * p_b[3] + p_a[1] * p_b[2] - p_a[2] * p_b[1] + p_a[3] * p_b[0]
+    };
+}
+
+
+// Conjugate of a quaternion given as (r, i, j, k) components
+template<class T>
+constexpr vector<T, 4> conjugate_components(const vector<T, 4> & p_q)
+{
+    return { p_q[0], -p_q[1], -p_q[2], -p_q[3] };
+}
+
+
+// Make the rotation matrix of the unit quaternion (r, i, j, k)
+template<class T>
+constexpr matrix<T, 3, 3> components_to_matrix(const vector<T, 4> & p_q)
+{
+    const auto [r, i, j, k] = p_q;
+
+    const auto ii = i * i;
+    const auto jj = j * j;
+    const auto kk = k * k;
+    const auto ij = i * j;
+    const auto ik = i * k;
+    const auto jk = j * k;
+    const auto ri = r * i;
+    const auto rj = r * j;
+    const auto rk = r * k;
+
+    return matrix<T, 3, 3>{
+        1 - 2 * (jj + kk), 2 * (ij - rk), 2 * (ik + rj),
+        2 * (ij + rk), 1 - 2 * (ii + kk), 2 * (jk - ri),
+        2 * (ik - rj), 2 * (jk + ri), 1 - 2 * (ii + jj)
+    };
+}
+
+
+// Make the (r, i, j, k) components of the unit quaternion of a rotation matrix
+// Builds the candidate solved from each of the four diagonal combinations and
+//  selects the best conditioned one, which is stable for every angle and
+//  uses selects instead of branches
+template<class T>
+inline vector<T, 4> matrix_to_components(const matrix<T, 3, 3> & p_m)
+{
+    const auto m00 = p_m[0][0];
+    const auto m11 = p_m[1][1];
+    const auto m22 = p_m[2][2];
+
+    // 4 * r^2, 4 * i^2, 4 * j^2, 4 * k^2
+    const auto t_r = 1 + m00 + m11 + m22;
+    const auto t_i = 1 + m00 - m11 - m22;
+    const auto t_j = 1 - m00 + m11 - m22;
+    const auto t_k = 1 - m00 - m11 + m22;
+
+    const auto d_i = p_m[2][1] - p_m[1][2];
+    const auto d_j = p_m[0][2] - p_m[2][0];
+    const auto d_k = p_m[1][0] - p_m[0][1];
+    const auto s_ij = p_m[0][1] + p_m[1][0];
+    const auto s_ik = p_m[0][2] + p_m[2][0];
+    const auto s_jk = p_m[1][2] + p_m[2][1];
+
+    // Pick the largest square
+    const auto use_r = (t_r >= t_i) && (t_r >= t_j) && (t_r >= t_k);
+    const auto use_i = !use_r && (t_i >= t_j) && (t_i >= t_k);
+    const auto use_j = !use_r && !use_i && (t_j >= t_k);
+
+    const auto select = [&](const T p_r, const T p_i, const T p_j, const T p_k) {
+        return use_r ? p_r : (use_i ? p_i : (use_j ? p_j : p_k));
+    };
+
+    const auto t = select(t_r, t_i, t_j, t_k);
+    const auto scale = static_cast<T>(0.5) / static_cast<T>(std::sqrt(t));
+
+    vector<T, 4> result{
+        select(t_r, d_i, d_j, d_k) * scale,
+        select(d_i, t_i, s_ij, s_ik) * scale,
+        select(d_j, s_ij, t_j, s_jk) * scale,
+        select(d_k, s_ik, s_jk, t_k) * scale
+    };
+
+    // Both signs are the same rotation, keep the real part positive
+    const auto sign = (result[0] < 0) ? static_cast<T>(-1) : static_cast<T>(1);
+    result *= sign;
+
+    return result;
+}
+
+
+// Rotate a vector by the unit quaternion (r, i, j, k)
+template<class T>
+vector<T, 3> rotate_components(const vector<T, 4> & p_q, const vector<T, 3> & p_vector)
+{
+    // v' = v + 2 * r * (u x v) + 2 * u x (u x v)
+    const auto u = vector<T, 3>{ p_q[1], p_q[2], p_q[3] };
+    const auto t = vector_cross(u, p_vector) * static_cast<T>(2);
+    return p_vector + t * p_q[0] + vector_cross(u, t);
+}
+
+// Angles processed together by the batch functions
+// The sines, cosines and arc tangents of a block go through the
+//  vectorized batch functions of numeric/elementary_functions.h
+inline constexpr std::size_t batch_block_size = 256;
+
+
+// Make the (r, i, j, k) components of a rotation around a unit axis
+// `p_sine` and `p_cosine` are those of half the rotation angle
+template<class T>
+vector<T, 4> axis_angle_to_components(const vector<T, 3> & p_axis, const T p_sine, const T p_cosine)
+{
+    return { p_cosine, p_axis[0] * p_sine, p_axis[1] * p_sine, p_axis[2] * p_sine };
+}
+
+
+// Get the rotation axis of the unit quaternion (r, i, j, k)
+// `p_length` is the norm of the imaginary part
+// The rotation angle is 2 * atan2(p_length, |r|)
+template<class T>
+vector<T, 3> components_to_axis(const vector<T, 4> & p_q, const T p_length)
+{
+    // Both signs are the same rotation, the positive real part gives the smaller angle
+    const auto sign = (p_q[0] < 0) ? static_cast<T>(-1) : static_cast<T>(1);
+    const auto valid = p_length > std::numeric_limits<T>::min();
+    const auto inverse = sign / (valid ? p_length : static_cast<T>(1));
+    return {
+        valid ? p_q[1] * inverse : static_cast<T>(1),
+        valid ? p_q[2] * inverse : static_cast<T>(0),
+        valid ? p_q[3] * inverse : static_cast<T>(0)
+    };
+}
+
+};  // namespace quaternion_rotation_ns
+};  // namespace details
+};  // namespace math
+};  // namespace ft
+
+
+// Make the rotation matrix of a unit quaternion
+template<class T>
+ft::math::matrix<T, 3, 3> ft::math::make_rotation_matrix(const quaternion<T> & p_quaternion)
+{
+    return details::quaternion_rotation_ns::components_to_matrix(p_quaternion.get_components());
+}
+
+
+// Make the unit quaternion of a rotation matrix
+template<class T>
+ft::math::quaternion<T> ft::math::make_rotation_quaternion(const matrix<T, 3, 3> & p_matrix)
+{
+    return quaternion<T>(details::quaternion_rotation_ns::matrix_to_components(p_matrix));
+}
+
+
+// Make the unit quaternion of a rotation of `p_angle` radians around a unit axis
+template<class T>
+ft::math::quaternion<T> ft::math::make_rotation_quaternion(const vector<T, 3> & p_axis, const T p_angle)
+{
+    const auto half_angle = p_angle / 2;
+    return quaternion<T>(details::quaternion_rotation_ns::axis_angle_to_components(
+        p_axis, static_cast<T>(std::sin(half_angle)), static_cast<T>(std::cos(half_angle))));
+}
+
+
+// Make the unit quaternion of a rotation around a unit axis
+template<class T>
+ft::math::quaternion<T> ft::math::make_rotation_quaternion(const axis_angle<T> & p_axis_angle)
+{
+    return make_rotation_quaternion(p_axis_angle.axis, p_axis_angle.angle);
+}
+
+
+// Get the axis and angle of the rotation of a unit quaternion
+template<class T>
+ft::math::axis_angle<T> ft::math::make_axis_angle(const quaternion<T> & p_quaternion)
+{
+    const auto components = p_quaternion.get_components();
+    const auto length = details::quaternion_utility_ns::imaginary_length(components);
+    return {
+        details::quaternion_rotation_ns::components_to_axis(components, length),
+        2 * static_cast<T>(std::atan2(length, std::abs(components[0])))
+    };
+}
+
+
+// Rotate a vector by a unit quaternion
+template<class T>
+ft::math::vector<T, 3> ft::math::rotate(const quaternion<T> & p_quaternion, const vector<T, 3> & p_vector)
+{
+    return details::quaternion_rotation_ns::rotate_components(p_quaternion.get_components(), p_vector);
+}
+
+
+// Make the (r, i, j, k) unit quaternion components of an array of axis angle rotations
+template<ft::math::approximation_tier A, class T>
+void ft::math::make_rotation_quaternion_batch(
+    const vector_soa_span<const T, 3> & p_axes,
+    std::span<const T> p_angles,
+    const vector_soa_span<T, 4> & p_results)
+{
+    using details::quaternion_rotation_ns::batch_block_size;
+
+    FT_ASSERT(p_angles.size() >= p_axes.size());
+    FT_ASSERT(p_results.size() >= p_axes.size());
+
+    std::array<T, batch_block_size> half_angles;
+    std::array<T, batch_block_size> sines;
+    std::array<T, batch_block_size> cosines;
+
+    for (std::size_t begin = 0; begin < p_axes.size(); begin += batch_block_size)
+    {
+        const auto count = std::min(batch_block_size, p_axes.size() - begin);
+
+        for (std::size_t i = 0; i < count; ++i) {
+            half_angles[i] = p_angles[begin + i] / 2;
+        }
+        sincos_batch<A, T>(
+            std::span<const T>(half_angles.data(), count),
+            std::span<T>(sines.data(), count),
+            std::span<T>(cosines.data(), count));
+
+        for (std::size_t i = 0; i < count; ++i) {
+            p_results.set(begin + i, details::quaternion_rotation_ns::axis_angle_to_components(p_axes.get(begin + i), sines[i], cosines[i]));
+        }
+    }
+}
+
+
+// Get the axes and angles of an array of (r, i, j, k) unit quaternion components
+template<ft::math::approximation_tier A, class T>
+void ft::math::make_axis_angle_batch(
+    const vector_soa_span<const T, 4> & p_quaternions,
+    const vector_soa_span<T, 3> & p_axes,
+    std::span<T> p_angles)
+{
+    using details::quaternion_rotation_ns::batch_block_size;
+
+    FT_ASSERT(p_axes.size() >= p_quaternions.size());
+    FT_ASSERT(p_angles.size() >= p_quaternions.size());
+
+    std::array<T, batch_block_size> lengths;
+    std::array<T, batch_block_size> reals;
+
+    for (std::size_t begin = 0; begin < p_quaternions.size(); begin += batch_block_size)
+    {
+        const auto count = std::min(batch_block_size, p_quaternions.size() - begin);
+
+        for (std::size_t i = 0; i < count; ++i)
+        {
+            const auto q = p_quaternions.get(begin + i);
+            lengths[i] = details::quaternion_utility_ns::imaginary_length(q);
+            reals[i] = std::abs(q[0]);
+            p_axes.set(begin + i, details::quaternion_rotation_ns::components_to_axis(q, lengths[i]));
+        }
+
+        const auto angles = p_angles.subspan(begin, count);
+        atan2_batch<A, T>(
+            std::span<const T>(lengths.data(), count),
+            std::span<const T>(reals.data(), count),
+            angles);
+        for (auto & angle : angles) {
+            angle *= 2;
+        }
+    }
+}
@@ -1,6 +1,11 @@
 #pragma once
 
+// project headers
 #include "quaternion.h"
+#include "vector/vector_soa.h"
+
+// standard headers
+#include <cstddef>  // std::size_t
 
 namespace ft {
 namespace math {
@@ -35,6 +40,40 @@ void normalize(quaternion<T> & p_quaternion);
 template<class T>
 quaternion<T> normalized(quaternion<T> p_quaternion);
 
+
+// Normalize the given quaternion if its squared norm is further than
+//  `p_tolerance` from 1
+// Returns true if the quaternion was normalized
+template<class T>
+bool normalize_if_drifted(quaternion<T> & p_quaternion, const T p_tolerance);
+
+
+// Normalize the (r, i, j, k) quaternion components of an array whose squared
+//  norm is further than `p_tolerance` from 1
+// Runs in one branch free pass, every quaternion is written back
+// Returns the number of quaternions normalized
+template<class T>
+std::size_t normalize_if_drifted_batch(const vector_soa_span<T, 4> & p_quaternions, const T p_tolerance);
+
+
+// Get the exponential of this quaternion
+// exp(r, v) = exp(r) * (cos |v|, sin |v| * v / |v|)
+template<class T>
+quaternion<T> exp(const quaternion<T> & p_quaternion);
+
+
+// Get the natural logarithm of this quaternion
+// log(q) = (log |q|, acos(r / |q|) * v / |v|)
+// Negative real quaternions have no unique logarithm, their imaginary part is zero
+template<class T>
+quaternion<T> log(const quaternion<T> & p_quaternion);
+
+
+// Raise this quaternion to a real power
+// pow(q, t) = exp(t * log(q)), for unit quaternions it scales the rotation angle by t
+template<class T>
+quaternion<T> pow(const quaternion<T> & p_quaternion, const T p_exponent);
+
 };  // namespace math
 };  // namespace ft
 
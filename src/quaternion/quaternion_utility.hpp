@@ -6,6 +6,58 @@
 
 // standard headers
 #include <cmath>
+#include <limits>
+
+namespace ft {
+namespace math {
+namespace details {
+namespace quaternion_utility_ns {
+
+// Norm of the imaginary part of the quaternion (r, i, j, k)
+template<class T>
+T imaginary_length(const vector<T, 4> & p_q)
+{
+    using std::sqrt;
+    return static_cast<T>(sqrt(p_q[1] * p_q[1] + p_q[2] * p_q[2] + p_q[3] * p_q[3]));
+}
+
+
+// Exponential of the quaternion (r, i, j, k) without the exp(r) factor
+// `p_angle` is the norm of the imaginary part, `p_sine` and `p_cosine` its sine and cosine
+template<class T>
+vector<T, 4> exp_imaginary_components(const vector<T, 4> & p_q, const T p_angle, const T p_sine, const T p_cosine)
+{
+    // sin(x) / x tends to 1 at 0
+    const auto valid = p_angle > std::numeric_limits<T>::min();
+    const auto scale = valid ? p_sine / (valid ? p_angle : static_cast<T>(1)) : static_cast<T>(1);
+    return { p_cosine, p_q[1] * scale, p_q[2] * scale, p_q[3] * scale };
+}
+
+
+// Natural logarithm of the quaternion (r, i, j, k)
+template<class T>
+vector<T, 4> log_components(const vector<T, 4> & p_q)
+{
+    using std::atan2;
+    using std::log;
+    using std::sqrt;
+
+    const auto v = imaginary_length(p_q);
+    const auto norm = static_cast<T>(sqrt(v * v + p_q[0] * p_q[0]));
+
+    // atan2 keeps the angle accurate near 0 and pi, unlike acos(r / |q|)
+    // The angle over |v| tends to 1 / |q| when v vanishes
+    const auto angle = static_cast<T>(atan2(v, p_q[0]));
+    const auto valid = v > std::numeric_limits<T>::min();
+    const auto scale = valid ? angle / (valid ? v : static_cast<T>(1)) : static_cast<T>(1) / norm;
+    return { static_cast<T>(log(norm)), p_q[1] * scale, p_q[2] * scale, p_q[3] * scale };
+}
+
+};  // namespace quaternion_utility_ns
+};  // namespace details
+};  // namespace math
+};  // namespace ft
+
 
 // Get the quaternion's conjugate
 template<class T>
@@ -27,7 +79,8 @@ T ft::math::length2(const quaternion<T> & p_quaternion)
 template<class T>
 T ft::math::length(const quaternion<T> & p_quaternion)
 {
-    return std::sqrt(length2(p_quaternion));
+    using std::sqrt;
+    return sqrt(length2(p_quaternion));
 }
 
 
@@ -56,3 +109,78 @@ ft::math::quaternion<T> ft::math::normalized(quaternion<T> p_quaternion)
     normalize(p_quaternion);
     return p_quaternion;
 }
+
+
+// Normalize the given quaternion if its squared norm is further than
+//  `p_tolerance` from 1
+template<class T>
+bool ft::math::normalize_if_drifted(quaternion<T> & p_quaternion, const T p_tolerance)
+{
+    using std::abs;
+    using std::sqrt;
+
+    const auto l2 = length2(p_quaternion);
+    if (abs(l2 - 1) <= p_tolerance) {
+        return false;
+    }
+
+    FT_ASSERT(l2 > 0);
+    p_quaternion /= static_cast<T>(sqrt(l2));
+    return true;
+}
+
+
+// Normalize the (r, i, j, k) quaternion components of an array whose squared
+//  norm is further than `p_tolerance` from 1
+template<class T>
+std::size_t ft::math::normalize_if_drifted_batch(const vector_soa_span<T, 4> & p_quaternions, const T p_tolerance)
+{
+    using std::abs;
+    using std::sqrt;
+
+    std::size_t count = 0;
+    for (std::size_t i = 0; i < p_quaternions.size(); ++i)
+    {
+        const auto q = p_quaternions.get(i);
+        const auto l2 = length2(q);
+        const auto drifted = abs(l2 - 1) > p_tolerance;
+
+        // Quaternions within the tolerance are scaled by one
+        const auto scale = drifted ? 1 / static_cast<T>(sqrt(l2)) : static_cast<T>(1);
+        p_quaternions.set(i, q * scale);
+        count += drifted;
+    }
+    return count;
+}
+
+
+// Get the exponential of this quaternion
+template<class T>
+ft::math::quaternion<T> ft::math::exp(const quaternion<T> & p_quaternion)
+{
+    using namespace details::quaternion_utility_ns;
+    using std::cos;
+    using std::exp;
+    using std::sin;
+
+    const auto components = p_quaternion.get_components();
+    const auto angle = imaginary_length(components);
+    const auto result = exp_imaginary_components(components, angle, static_cast<T>(sin(angle)), static_cast<T>(cos(angle)));
+    return quaternion<T>(result * static_cast<T>(exp(components[0])));
+}
+
+
+// Get the natural logarithm of this quaternion
+template<class T>
+ft::math::quaternion<T> ft::math::log(const quaternion<T> & p_quaternion)
+{
+    return quaternion<T>(details::quaternion_utility_ns::log_components(p_quaternion.get_components()));
+}
+
+
+// Raise this quaternion to a real power
+template<class T>
+ft::math::quaternion<T> ft::math::pow(const quaternion<T> & p_quaternion, const T p_exponent)
+{
+    return exp(log(p_quaternion) * p_exponent);
+}
@@ -0,0 +1,55 @@
+#pragma once
+
+// Philox4x32-10 counter based random number generator
+// (Salmon et al., "Parallel random numbers: as easy as 1, 2, 3")
+//
+// A generator holds no state that changes: block `n` of a stream is a fixed
+//  function of the seed, the stream and `n`, so any element of a sequence
+//  can be computed directly, in any order and on any thread
+// Streams split the 2^64 blocks of a seed further, each stream gives
+//  2^64 blocks of four 32 bit words independent of the other streams
+
+// standard headers
+#include <array>
+#include <cstddef>  // std::size_t
+#include <cstdint>
+
+namespace ft {
+namespace math {
+
+class philox4x32
+{
+public:
+    using block_type = std::array<std::uint32_t, 4>;
+
+    // Number of 32 bit words per block
+    static constexpr std::size_t block_words = 4;
+
+public:
+    // Construct the generator of a seed and stream
+    constexpr explicit philox4x32(const std::uint64_t p_seed = 0, const std::uint64_t p_stream = 0);
+
+
+    // Get the seed
+    constexpr std::uint64_t get_seed() const;
+
+    // Get the stream
+    constexpr std::uint64_t get_stream() const;
+
+    // Get a generator of the same seed on another stream
+    constexpr philox4x32 make_stream(const std::uint64_t p_stream) const;
+
+
+    // Get block `p_counter` of the stream
+    constexpr block_type generate(const std::uint64_t p_counter) const;
+
+private:
+    std::uint64_t m_seed;
+    std::uint64_t m_stream;
+
+};  // class philox4x32
+
+};  // namespace math
+};  // namespace ft
+
+#include "philox.hpp"
@@ -0,0 +1,84 @@
+#pragma once
+
+// Implements the philox4x32 class of philox.h
+
+// project headers
+#include "philox.h"
+
+namespace ft {
+namespace math {
+namespace details {
+namespace philox_ns {
+
+inline constexpr std::uint32_t multiplier_0 = 0xD2511F53;
+inline constexpr std::uint32_t multiplier_1 = 0xCD9E8D57;
+inline constexpr std::uint32_t key_increment_0 = 0x9E3779B9;
+inline constexpr std::uint32_t key_increment_1 = 0xBB67AE85;
+inline constexpr std::size_t rounds = 10;
+
+};  // namespace philox_ns
+};  // namespace details
+
+
+// Construct the generator of a seed and stream
+constexpr philox4x32::philox4x32(const std::uint64_t p_seed, const std::uint64_t p_stream) :
+    m_seed(p_seed),
+    m_stream(p_stream)
+{
+}
+
+
+// Get the seed
+constexpr std::uint64_t philox4x32::get_seed() const
+{
+    return m_seed;
+}
+
+
+// Get the stream
+constexpr std::uint64_t philox4x32::get_stream() const
+{
+    return m_stream;
+}
+
+
+// Get a generator of the same seed on another stream
+constexpr philox4x32 philox4x32::make_stream(const std::uint64_t p_stream) const
+{
+    return philox4x32(m_seed, p_stream);
+}
+
+
+// Get block `p_counter` of the stream
+// The 128 bit counter is the block index followed by the stream
+constexpr philox4x32::block_type philox4x32::generate(const std::uint64_t p_counter) const
+{
+    using namespace details::philox_ns;
+
+    auto c_0 = static_cast<std::uint32_t>(p_counter);
+    auto c_1 = static_cast<std::uint32_t>(p_counter >> 32);
+    auto c_2 = static_cast<std::uint32_t>(m_stream);
+    auto c_3 = static_cast<std::uint32_t>(m_stream >> 32);
+    auto k_0 = static_cast<std::uint32_t>(m_seed);
+    auto k_1 = static_cast<std::uint32_t>(m_seed >> 32);
+
+    for (std::size_t round = 0; round < rounds; ++round)
+    {
+        const auto product_0 = static_cast<std::uint64_t>(multiplier_0) * c_0;
+        const auto product_1 = static_cast<std::uint64_t>(multiplier_1) * c_2;
+        const auto high_0 = static_cast<std::uint32_t>(product_0 >> 32);
+        const auto high_1 = static_cast<std::uint32_t>(product_1 >> 32);
+
+        c_0 = high_1 ^ c_1 ^ k_0;
+        c_1 = static_cast<std::uint32_t>(product_1);
+        c_2 = high_0 ^ c_3 ^ k_1;
+        c_3 = static_cast<std::uint32_t>(product_0);
+
+        k_0 += key_increment_0;
+        k_1 += key_increment_1;
+    }
+    return { c_0, c_1, c_2, c_3 };
+}
+
+};  // namespace math
+};  // namespace ft
@@ -0,0 +1,120 @@
+#pragma once
+
+// Fill arrays with random vectors and rotations
+//
+// Element `i` of a fill is made from the blocks of the generator starting at
+//  `p_counter + i * blocks`, where `blocks` is the number of blocks a sample
+//  uses; the result does not depend on how the work is split over threads
+// Each fill returns the counter following the last block it used, to chain
+//  fills on one stream; give each independent producer its own stream with
+//  philox4x32::make_stream
+//
+// Floats take 24 random bits from one word, doubles 53 bits from two words,
+//  uniform values are in [0, 1)
+// Words are generated for many samples at once in a loop the compiler can
+//  vectorize, then turned into samples
+
+// project headers
+#include "philox.h"
+#include "parallel/thread_pool.h"
+#include "quaternion/quaternion.h"
+#include "spatial/aabb.h"
+#include "vector/vector.h"
+#include "vector/vector_soa.h"
+
+// standard headers
+#include <cstddef>  // std::size_t
+#include <cstdint>
+#include <span>
+
+namespace ft {
+namespace math {
+
+// Fill with points uniformly distributed in a box
+template<class T, std::size_t S>
+std::uint64_t fill_random_in_box(
+    const philox4x32 & p_generator,
+    const std::uint64_t p_counter,
+    const aabb<T, S> & p_box,
+    std::span<vector<T, S>> p_result,
+    thread_pool & p_pool = default_thread_pool());
+
+template<class T, std::size_t S>
+std::uint64_t fill_random_in_box(
+    const philox4x32 & p_generator,
+    const std::uint64_t p_counter,
+    const aabb<T, S> & p_box,
+    const vector_soa_span<T, S> & p_result,
+    thread_pool & p_pool = default_thread_pool());
+
+
+// Fill with unit vectors uniformly distributed on the circle (S = 2) or the sphere (S = 3)
+template<class T, std::size_t S>
+std::uint64_t fill_random_unit_vectors(
+    const philox4x32 & p_generator,
+    const std::uint64_t p_counter,
+    std::span<vector<T, S>> p_result,
+    thread_pool & p_pool = default_thread_pool());
+
+template<class T, std::size_t S>
+std::uint64_t fill_random_unit_vectors(
+    const philox4x32 & p_generator,
+    const std::uint64_t p_counter,
+    const vector_soa_span<T, S> & p_result,
+    thread_pool & p_pool = default_thread_pool());
+
+
+// Fill with points uniformly distributed in the unit disc (S = 2) or ball (S = 3)
+template<class T, std::size_t S>
+std::uint64_t fill_random_in_ball(
+    const philox4x32 & p_generator,
+    const std::uint64_t p_counter,
+    std::span<vector<T, S>> p_result,
+    thread_pool & p_pool = default_thread_pool());
+
+template<class T, std::size_t S>
+std::uint64_t fill_random_in_ball(
+    const philox4x32 & p_generator,
+    const std::uint64_t p_counter,
+    const vector_soa_span<T, S> & p_result,
+    thread_pool & p_pool = default_thread_pool());
+
+
+// Fill with rotations uniformly distributed over SO(3) (Shoemake's method)
+// Unit quaternions with a non negative real part
+template<class T>
+std::uint64_t fill_random_rotations(
+    const philox4x32 & p_generator,
+    const std::uint64_t p_counter,
+    std::span<quaternion<T>> p_result,
+    thread_pool & p_pool = default_thread_pool());
+
+// Fill with rotations written as (r, i, j, k) unit quaternion components
+template<class T>
+std::uint64_t fill_random_rotations(
+    const philox4x32 & p_generator,
+    const std::uint64_t p_counter,
+    const vector_soa_span<T, 4> & p_result,
+    thread_pool & p_pool = default_thread_pool());
+
+
+// Fill with directions of the hemisphere around +z with a density proportional
+//  to the cosine of their angle with +z
+template<class T>
+std::uint64_t fill_random_cosine_hemisphere(
+    const philox4x32 & p_generator,
+    const std::uint64_t p_counter,
+    std::span<vector<T, 3>> p_result,
+    thread_pool & p_pool = default_thread_pool());
+
+template<class T>
+std::uint64_t fill_random_cosine_hemisphere(
+    const philox4x32 & p_generator,
+    const std::uint64_t p_counter,
+    const vector_soa_span<T, 3> & p_result,
+    thread_pool & p_pool = default_thread_pool());
+
+};  // namespace math
+};  // namespace ft
+
+#include "random_fill.hpp"
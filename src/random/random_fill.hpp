@@ -0,0 +1,355 @@
+#pragma once
+
+// Implements the fills of random_fill.h
+
+// project headers
+#include "numeric/elementary_functions.h"
+#include "random_fill.h"
+
+// standard headers
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <numbers>
+
+namespace ft {
+namespace math {
+namespace details {
+namespace random_fill_ns {
+
+// Samples per parallel chunk
+inline constexpr std::size_t chunk_size = 4096;
+
+// Samples whose words are generated together
+inline constexpr std::size_t batch_size = 64;
+
+// Words used by a uniform value
+template<class T>
+inline constexpr std::size_t value_words = (sizeof(T) <= sizeof(std::uint32_t)) ? 1 : 2;
+
+// Blocks used by a sample of `V` uniform values
+template<class T, std::size_t V>
+inline constexpr std::size_t sample_blocks = (V * value_words<T> + philox4x32::block_words - 1) / philox4x32::block_words;
+
+
+// Turn random words into a uniform value in [0, 1)
+template<class T>
+T to_unit(const std::uint32_t * p_words)
+{
+    if constexpr (value_words<T> == 1) {
+        return static_cast<T>(p_words[0] >> 8) * static_cast<T>(0x1.0p-24);
+    }
+    else
+    {
+        const auto bits = (static_cast<std::uint64_t>(p_words[0]) << 21) | (p_words[1] >> 11);
+        return static_cast<T>(bits) * static_cast<T>(0x1.0p-53);
+    }
+}
+
+
+// Turn the words of a sample into `V` uniform values in [0, 1)
+template<class T, std::size_t V>
+std::array<T, V> to_units(const std::uint32_t * p_words)
+{
+    std::array<T, V> result;
+    for (std::size_t v = 0; v < V; ++v) {
+        result[v] = to_unit<T>(p_words + v * value_words<T>);
+    }
+    return result;
+}
+
+
+// Make `p_count` samples of `V` uniform values each
+// Sample `i` is `p_make(values)`, written with `p_store(i, sample)`
+// Returns the counter following the last block used
+template<class T, std::size_t V, class F, class G>
+std::uint64_t fill(
+    const philox4x32 & p_generator,
+    const std::uint64_t p_counter,
+    const std::size_t p_count,
+    F && p_make,
+    G && p_store,
+    thread_pool & p_pool)
+{
+    constexpr auto blocks = sample_blocks<T, V>;
+    constexpr auto sample_words = blocks * philox4x32::block_words;
+
+    parallel_for_chunks(p_count, chunk_size, [&](std::size_t, const std::size_t p_begin, const std::size_t p_end)
+    {
+        std::array<std::uint32_t, batch_size * sample_words> words;
+        for (auto first = p_begin; first < p_end; first += batch_size)
+        {
+            const auto count = std::min(batch_size, p_end - first);
+            const auto counter = p_counter + first * blocks;
+
+            // Independent blocks, vectorizable
+            for (std::size_t b = 0; b < count * blocks; ++b)
+            {
+                const auto block = p_generator.generate(counter + b);
+                for (std::size_t w = 0; w < philox4x32::block_words; ++w) {
+                    words[b * philox4x32::block_words + w] = block[w];
+                }
+            }
+
+            for (std::size_t s = 0; s < count; ++s) {
+                p_store(first + s, p_make(to_units<T, V>(words.data() + s * sample_words)));
+            }
+        }
+    }, p_pool);
+
+    return p_counter + p_count * blocks;
+}
+
+
+// Map uniform values to a point of a box
+template<class T, std::size_t S>
+vector<T, S> make_in_box(const std::array<T, S> & p_units, const aabb<T, S> & p_box)
+{
+    vector<T, S> result;
+    for (std::size_t a = 0; a < S; ++a) {
+        result[a] = p_box.get_min()[a] + p_units[a] * (p_box.get_max()[a] - p_box.get_min()[a]);
+    }
+    return result;
+}
+
+
+// Map uniform values to a unit vector
+// The circle takes one value, the sphere two (Archimedes' cylinder projection)
+template<class T, std::size_t S>
+vector<T, S> make_unit_vector(const T * p_units)
+{
+    static_assert(S == 2 || S == 3, "Unit vectors are 2D or 3D");
+
+    T sine;
+    T cosine;
+    approx_sincos(2 * std::numbers::pi_v<T> * p_units[0], sine, cosine);
+    if constexpr (S == 2) {
+        return { cosine, sine };
+    }
+    else
+    {
+        const auto z = 1 - 2 * p_units[1];
+        const auto r2 = 1 - z * z;
+        const auto r = static_cast<T>(std::sqrt((r2 > 0) ? r2 : static_cast<T>(0)));
+        return { r * cosine, r * sine, z };
+    }
+}
+
+
+// Map uniform values to a point of the unit disc or ball
+// The last value picks the radius, the density grows as r ^ (S - 1)
+template<class T, std::size_t S>
+vector<T, S> make_in_ball(const std::array<T, S> & p_units)
+{
+    auto result = make_unit_vector<T, S>(p_units.data());
+    const auto radius = (S == 2) ? static_cast<T>(std::sqrt(p_units[S - 1])) : static_cast<T>(std::cbrt(p_units[S - 1]));
+    for (std::size_t a = 0; a < S; ++a) {
+        result[a] *= radius;
+    }
+    return result;
+}
+
+
+// Map uniform values to (r, i, j, k) unit quaternion components
+// Shoemake, "Uniform random rotations", Graphics Gems III
+template<class T>
+vector<T, 4> make_rotation(const std::array<T, 3> & p_units)
+{
+    const auto r_1 = static_cast<T>(std::sqrt(1 - p_units[0]));
+    const auto r_2 = static_cast<T>(std::sqrt(p_units[0]));
+    T sine_1;
+    T cosine_1;
+    T sine_2;
+    T cosine_2;
+    approx_sincos(2 * std::numbers::pi_v<T> * p_units[1], sine_1, cosine_1);
+    approx_sincos(2 * std::numbers::pi_v<T> * p_units[2], sine_2, cosine_2);
+
+    const auto r = r_2 * cosine_2;
+    const auto sign = (r < 0) ? static_cast<T>(-1) : static_cast<T>(1);
+    return {
+        sign * r,
+        sign * r_1 * sine_1,
+        sign * r_1 * cosine_1,
+        sign * r_2 * sine_2
+    };
+}
+
+
+// Map uniform values to a cosine distributed direction around +z (Malley's method)
+template<class T>
+vector<T, 3> make_cosine_hemisphere(const std::array<T, 2> & p_units)
+{
+    const auto r = static_cast<T>(std::sqrt(p_units[1]));
+    T sine;
+    T cosine;
+    approx_sincos(2 * std::numbers::pi_v<T> * p_units[0], sine, cosine);
+    const auto z2 = 1 - p_units[1];
+    return {
+        r * cosine,
+        r * sine,
+        static_cast<T>(std::sqrt((z2 > 0) ? z2 : static_cast<T>(0)))
+    };
+}
+
+};  // namespace random_fill_ns
+};  // namespace details
+};  // namespace math
+};  // namespace ft
+
+
+// Fill with points uniformly distributed in a box
+template<class T, std::size_t S>
+std::uint64_t ft::math::fill_random_in_box(
+    const philox4x32 & p_generator,
+    const std::uint64_t p_counter,
+    const aabb<T, S> & p_box,
+    std::span<vector<T, S>> p_result,
+    thread_pool & p_pool)
+{
+    using namespace details::random_fill_ns;
+    return fill<T, S>(p_generator, p_counter, p_result.size(),
+        [&](const std::array<T, S> & p_units) { return make_in_box(p_units, p_box); },
+        [&](const std::size_t p_index, const vector<T, S> & p_value) { p_result[p_index] = p_value; },
+        p_pool);
+}
+
+
+template<class T, std::size_t S>
+std::uint64_t ft::math::fill_random_in_box(
+    const philox4x32 & p_generator,
+    const std::uint64_t p_counter,
+    const aabb<T, S> & p_box,
+    const vector_soa_span<T, S> & p_result,
+    thread_pool & p_pool)
+{
+    using namespace details::random_fill_ns;
+    return fill<T, S>(p_generator, p_counter, p_result.size(),
+        [&](const std::array<T, S> & p_units) { return make_in_box(p_units, p_box); },
+        [&](const std::size_t p_index, const vector<T, S> & p_value) { p_result.set(p_index, p_value); },
+        p_pool);
+}
+
+
+// Fill with unit vectors uniformly distributed on the circle or the sphere
+template<class T, std::size_t S>
+std::uint64_t ft::math::fill_random_unit_vectors(
+    const philox4x32 & p_generator,
+    const std::uint64_t p_counter,
+    std::span<vector<T, S>> p_result,
+    thread_pool & p_pool)
+{
+    using namespace details::random_fill_ns;
+    return fill<T, S - 1>(p_generator, p_counter, p_result.size(),
+        [](const std::array<T, S - 1> & p_units) { return make_unit_vector<T, S>(p_units.data()); },
+        [&](const std::size_t p_index, const vector<T, S> & p_value) { p_result[p_index] = p_value; },
+        p_pool);
+}
+
+
+template<class T, std::size_t S>
+std::uint64_t ft::math::fill_random_unit_vectors(
+    const philox4x32 & p_generator,
+    const std::uint64_t p_counter,
+    const vector_soa_span<T, S> & p_result,
+    thread_pool & p_pool)
+{
+    using namespace details::random_fill_ns;
+    return fill<T, S - 1>(p_generator, p_counter, p_result.size(),
+        [](const std::array<T, S - 1> & p_units) { return make_unit_vector<T, S>(p_units.data()); },
+        [&](const std::size_t p_index, const vector<T, S> & p_value) { p_result.set(p_index, p_value); },
+        p_pool);
+}
+
+
+// Fill with points uniformly distributed in the unit disc or ball
+template<class T, std::size_t S>
+std::uint64_t ft::math::fill_random_in_ball(
+    const philox4x32 & p_generator,
+    const std::uint64_t p_counter,
+    std::span<vector<T, S>> p_result,
+    thread_pool & p_pool)
+{
+    using namespace details::random_fill_ns;
+    return fill<T, S>(p_generator, p_counter, p_result.size(),
+        [](const std::array<T, S> & p_units) { return make_in_ball<T, S>(p_units); },
+        [&](const std::size_t p_index, const vector<T, S> & p_value) { p_result[p_index] = p_value; },
+        p_pool);
+}
+
+
+template<class T, std::size_t S>
+std::uint64_t ft::math::fill_random_in_ball(
+    const philox4x32 & p_generator,
+    const std::uint64_t p_counter,
+    const vector_soa_span<T, S> & p_result,
+    thread_pool & p_pool)
+{
+    using namespace details::random_fill_ns;
+    return fill<T, S>(p_generator, p_counter, p_result.size(),
+        [](const std::array<T, S> & p_units) { return make_in_ball<T, S>(p_units); },
+        [&](const std::size_t p_index, const vector<T, S> & p_value) { p_result.set(p_index, p_value); },
+        p_pool);
+}
+
+
+// Fill with rotations uniformly distributed over SO(3)
+template<class T>
+std::uint64_t ft::math::fill_random_rotations(
+    const philox4x32 & p_generator,
+    const std::uint64_t p_counter,
+    std::span<quaternion<T>> p_result,
+    thread_pool & p_pool)
+{
+    using namespace details::random_fill_ns;
+    return fill<T, 3>(p_generator, p_counter, p_result.size(),
+        [](const std::array<T, 3> & p_units) { return make_rotation<T>(p_units); },
+        [&](const std::size_t p_index, const vector<T, 4> & p_value) { p_result[p_index].set(p_value); },
+        p_pool);
+}
+
+
+// Fill with rotations written as (r, i, j, k) unit quaternion components
+template<class T>
+std::uint64_t ft::math::fill_random_rotations(
+    const philox4x32 & p_generator,
+    const std::uint64_t p_counter,
+    const vector_soa_span<T, 4> & p_result,
+    thread_pool & p_pool)
+{
+    using namespace details::random_fill_ns;
+    return fill<T, 3>(p_generator, p_counter, p_result.size(),
+        [](const std::array<T, 3> & p_units) { return make_rotation<T>(p_units); },
+        [&](const std::size_t p_index, const vector<T, 4> & p_value) { p_result.set(p_index, p_value); },
+        p_pool);
+}
+
+
+// Fill with cosine distributed directions of the hemisphere around +z
+template<class T>
+std::uint64_t ft::math::fill_random_cosine_hemisphere(
+    const philox4x32 & p_generator,
+    const std::uint64_t p_counter,
+    std::span<vector<T, 3>> p_result,
+    thread_pool & p_pool)
+{
+    using namespace details::random_fill_ns;
+    return fill<T, 2>(p_generator, p_counter, p_result.size(),
+        [](const std::array<T, 2> & p_units) { return make_cosine_hemisphere<T>(p_units); },
+        [&](const std::size_t p_index, const vector<T, 3> & p_value) { p_result[p_index] = p_value; },
+        p_pool);
+}
+
+
+template<class T>
+std::uint64_t ft::math::fill_random_cosine_hemisphere(
+    const philox4x32 & p_generator,
+    const std::uint64_t p_counter,
+    const vector_soa_span<T, 3> & p_result,
+    thread_pool & p_pool)
+{
+    using namespace details::random_fill_ns;
+    return fill<T, 2>(p_generator, p_counter, p_result.size(),
+        [](const std::array<T, 2> & p_units) { return make_cosine_hemisphere<T>(p_units); },
+        [&](const std::size_t p_index, const vector<T, 3> & p_value) { p_result.set(p_index, p_value); },
+        p_pool);
+}
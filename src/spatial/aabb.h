@@ -0,0 +1,128 @@
+#pragma once
+
+// Axis aligned bounding box in `S` dimensions
+// An empty box has its minimum above its maximum on every axis, it contains
+//  nothing, overlaps nothing, and merging anything into it gives that thing
+
+// project headers
+#include "vector/vector.h"
+
+// standard headers
+#include <cstddef>  // std::size_t
+#include <span>
+
+namespace ft {
+namespace math {
+
+template<class T, std::size_t S>
+class aabb
+{
+public:
+    using value_type = T;
+    static constexpr auto dimensions = S;
+
+public:
+    // Default constructor
+    // Constructs an empty box
+    constexpr aabb();
+
+    // Construct from the minimum and maximum corners
+    constexpr aabb(const vector<T, S> & p_min, const vector<T, S> & p_max);
+
+
+    // Get the minimum corner
+    constexpr const vector<T, S> & get_min() const;
+
+    // Get the maximum corner
+    constexpr const vector<T, S> & get_max() const;
+
+    // Set the minimum corner
+    constexpr void set_min(const vector<T, S> & p_min);
+
+    // Set the maximum corner
+    constexpr void set_max(const vector<T, S> & p_max);
+
+
+    // Returns true if the box contains no point
+    constexpr bool is_empty() const;
+
+    // Get the center of the box
+    constexpr vector<T, S> get_center() const;
+
+    // Get the size of the box along each axis
+    constexpr vector<T, S> get_extent() const;
+
+    // Get half the measure of the boundary of the box
+    // Half the surface area in 3D, half the perimeter in 2D
+    // Zero for an empty box
+    constexpr T get_half_surface_area() const;
+
+
+    // Grow the box to contain a point
+    constexpr aabb & expand(const vector<T, S> & p_point);
+
+    // Grow the box to contain another box
+    constexpr aabb & expand(const aabb & p_other);
+
+
+    // Returns true if the point is inside the box or on its boundary
+    constexpr bool contains(const vector<T, S> & p_point) const;
+
+    // Returns true if the other box is inside this box
+    constexpr bool contains(const aabb & p_other) const;
+
+    // Returns true if the boxes share at least one point
+    constexpr bool overlaps(const aabb & p_other) const;
+
+
+    // Get the point of the box nearest to `p_point`
+    constexpr vector<T, S> closest_point(const vector<T, S> & p_point) const;
+
+    // Get the squared distance between the box and a point
+    // Zero for points inside the box
+    constexpr T distance2(const vector<T, S> & p_point) const;
+
+
+    // Compare operators
+    constexpr bool operator==(const aabb & p_other) const;
+    constexpr bool operator!=(const aabb & p_other) const;
+
+private:
+    vector<T, S> m_min;
+    vector<T, S> m_max;
+
+};  // class aabb
+
+
+// Get the smallest box containing both boxes
+template<class T, std::size_t S>
+constexpr aabb<T, S> make_union(const aabb<T, S> & p_a, const aabb<T, S> & p_b);
+
+// Get the box shared by both boxes
+// Empty if they do not overlap
+template<class T, std::size_t S>
+constexpr aabb<T, S> make_intersection(const aabb<T, S> & p_a, const aabb<T, S> & p_b);
+
+// Get the smallest box containing a set of points
+// Empty if there are no points
+template<class T, std::size_t S>
+aabb<T, S> make_bounding_box(std::span<const vector<T, S>> p_points);
+
+
+// Intersect a ray with a box using the slab test
+// `p_inverse_direction` holds the inverse of each component of the direction,
+//  infinite for zero components
+// Returns true and narrows [p_t_min, p_t_max] to the part of the ray inside
+//  the box if they intersect
+template<class T, std::size_t S>
+constexpr bool intersect_ray(
+    const aabb<T, S> & p_box,
+    const vector<T, S> & p_origin,
+    const vector<T, S> & p_inverse_direction,
+    T & p_t_min,
+    T & p_t_max);
+
+};  // namespace math
+};  // namespace ft
+
+#include "aabb.hpp"
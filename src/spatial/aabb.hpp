@@ -0,0 +1,304 @@
+#pragma once
+
+// Implements the aabb class of aabb.h
+
+// project headers
+#include "aabb.h"
+
+// standard headers
+#include <limits>
+
+namespace ft {
+namespace math {
+
+// Constructs an empty box
+template<class T, std::size_t S>
+constexpr aabb<T, S>::aabb()
+{
+    for (std::size_t i = 0; i < S; ++i)
+    {
+        m_min[i] = std::numeric_limits<T>::max();
+        m_max[i] = std::numeric_limits<T>::lowest();
+    }
+}
+
+
+// Construct from the minimum and maximum corners
+template<class T, std::size_t S>
+constexpr aabb<T, S>::aabb(const vector<T, S> & p_min, const vector<T, S> & p_max) :
+    m_min(p_min),
+    m_max(p_max)
+{
+}
+
+
+// Get the minimum corner
+template<class T, std::size_t S>
+constexpr const vector<T, S> & aabb<T, S>::get_min() const
+{
+    return m_min;
+}
+
+
+// Get the maximum corner
+template<class T, std::size_t S>
+constexpr const vector<T, S> & aabb<T, S>::get_max() const
+{
+    return m_max;
+}
+
+
+// Set the minimum corner
+template<class T, std::size_t S>
+constexpr void aabb<T, S>::set_min(const vector<T, S> & p_min)
+{
+    m_min = p_min;
+}
+
+
+// Set the maximum corner
+template<class T, std::size_t S>
+constexpr void aabb<T, S>::set_max(const vector<T, S> & p_max)
+{
+    m_max = p_max;
+}
+
+
+// Returns true if the box contains no point
+template<class T, std::size_t S>
+constexpr bool aabb<T, S>::is_empty() const
+{
+    auto result = false;
+    for (std::size_t i = 0; i < S; ++i) {
+        result |= m_min[i] > m_max[i];
+    }
+    return result;
+}
+
+
+// Get the center of the box
+template<class T, std::size_t S>
+constexpr vector<T, S> aabb<T, S>::get_center() const
+{
+    vector<T, S> result;
+    for (std::size_t i = 0; i < S; ++i) {
+        result[i] = (m_min[i] + m_max[i]) / 2;
+    }
+    return result;
+}
+
+
+// Get the size of the box along each axis
+template<class T, std::size_t S>
+constexpr vector<T, S> aabb<T, S>::get_extent() const
+{
+    vector<T, S> result;
+    for (std::size_t i = 0; i < S; ++i) {
+        result[i] = m_max[i] - m_min[i];
+    }
+    return result;
+}
+
+
+// Get half the measure of the boundary of the box
+template<class T, std::size_t S>
+constexpr T aabb<T, S>::get_half_surface_area() const
+{
+    if (is_empty()) {
+        return static_cast<T>(0);
+    }
+
+    // Sum of the measures of the faces orthogonal to each axis
+    const auto extent = get_extent();
+    auto result = static_cast<T>(0);
+    for (std::size_t i = 0; i < S; ++i)
+    {
+        auto face = static_cast<T>(1);
+        for (std::size_t j = 0; j < S; ++j) {
+            face *= (i == j) ? static_cast<T>(1) : extent[j];
+        }
+        result += face;
+    }
+    return result;
+}
+
+
+// Grow the box to contain a point
+template<class T, std::size_t S>
+constexpr aabb<T, S> & aabb<T, S>::expand(const vector<T, S> & p_point)
+{
+    for (std::size_t i = 0; i < S; ++i)
+    {
+        m_min[i] = (p_point[i] < m_min[i]) ? p_point[i] : m_min[i];
+        m_max[i] = (p_point[i] > m_max[i]) ? p_point[i] : m_max[i];
+    }
+    return *this;
+}
+
+
+// Grow the box to contain another box
+template<class T, std::size_t S>
+constexpr aabb<T, S> & aabb<T, S>::expand(const aabb & p_other)
+{
+    for (std::size_t i = 0; i < S; ++i)
+    {
+        m_min[i] = (p_other.m_min[i] < m_min[i]) ? p_other.m_min[i] : m_min[i];
+        m_max[i] = (p_other.m_max[i] > m_max[i]) ? p_other.m_max[i] : m_max[i];
+    }
+    return *this;
+}
+
+
+// Returns true if the point is inside the box or on its boundary
+template<class T, std::size_t S>
+constexpr bool aabb<T, S>::contains(const vector<T, S> & p_point) const
+{
+    auto result = true;
+    for (std::size_t i = 0; i < S; ++i) {
+        result &= (p_point[i] >= m_min[i]) & (p_point[i] <= m_max[i]);
+    }
+    return result;
+}
+
+
+// Returns true if the other box is inside this box
+template<class T, std::size_t S>
+constexpr bool aabb<T, S>::contains(const aabb & p_other) const
+{
+    auto result = true;
+    for (std::size_t i = 0; i < S; ++i) {
+        result &= (p_other.m_min[i] >= m_min[i]) & (p_other.m_max[i] <= m_max[i]);
+    }
+    return result;
+}
+
+
+// Returns true if the boxes share at least one point
+template<class T, std::size_t S>
+constexpr bool aabb<T, S>::overlaps(const aabb & p_other) const
+{
+    auto result = true;
+    for (std::size_t i = 0; i < S; ++i) {
+        result &= (p_other.m_min[i] <= m_max[i]) & (p_other.m_max[i] >= m_min[i]);
+    }
+    return result;
+}
+
+
+// Get the point of the box nearest to `p_point`
+template<class T, std::size_t S>
+constexpr vector<T, S> aabb<T, S>::closest_point(const vector<T, S> & p_point) const
+{
+    vector<T, S> result;
+    for (std::size_t i = 0; i < S; ++i)
+    {
+        const auto low = (p_point[i] < m_min[i]) ? m_min[i] : p_point[i];
+        result[i] = (low > m_max[i]) ? m_max[i] : low;
+    }
+    return result;
+}
+
+
+// Get the squared distance between the box and a point
+template<class T, std::size_t S>
+constexpr T aabb<T, S>::distance2(const vector<T, S> & p_point) const
+{
+    auto result = static_cast<T>(0);
+    for (std::size_t i = 0; i < S; ++i)
+    {
+        const auto below = m_min[i] - p_point[i];
+        const auto above = p_point[i] - m_max[i];
+        const auto outside = (below > above) ? below : above;
+        const auto delta = (outside > 0) ? outside : static_cast<T>(0);
+        result += delta * delta;
+    }
+    return result;
+}
+
+
+// Compare operators
+template<class T, std::size_t S>
+constexpr bool aabb<T, S>::operator==(const aabb & p_other) const
+{
+    return m_min == p_other.m_min && m_max == p_other.m_max;
+}
+
+
+template<class T, std::size_t S>
+constexpr bool aabb<T, S>::operator!=(const aabb & p_other) const
+{
+    return !(*this == p_other);
+}
+
+};  // namespace math
+};  // namespace ft
+
+
+// Get the smallest box containing both boxes
+template<class T, std::size_t S>
+constexpr ft::math::aabb<T, S> ft::math::make_union(const aabb<T, S> & p_a, const aabb<T, S> & p_b)
+{
+    auto result = p_a;
+    result.expand(p_b);
+    return result;
+}
+
+
+// Get the box shared by both boxes
+template<class T, std::size_t S>
+constexpr ft::math::aabb<T, S> ft::math::make_intersection(const aabb<T, S> & p_a, const aabb<T, S> & p_b)
+{
+    vector<T, S> min;
+    vector<T, S> max;
+    for (std::size_t i = 0; i < S; ++i)
+    {
+        min[i] = (p_a.get_min()[i] > p_b.get_min()[i]) ? p_a.get_min()[i] : p_b.get_min()[i];
+        max[i] = (p_a.get_max()[i] < p_b.get_max()[i]) ? p_a.get_max()[i] : p_b.get_max()[i];
+    }
+    return { min, max };
+}
+
+
+// Get the smallest box containing a set of points
+template<class T, std::size_t S>
+ft::math::aabb<T, S> ft::math::make_bounding_box(std::span<const vector<T, S>> p_points)
+{
+    aabb<T, S> result;
+    for (const auto & point : p_points) {
+        result.expand(point);
+    }
+    return result;
+}
+
+
+// Intersect a ray with a box using the slab test
+template<class T, std::size_t S>
+constexpr bool ft::math::intersect_ray(
+    const aabb<T, S> & p_box,
+    const vector<T, S> & p_origin,
+    const vector<T, S> & p_inverse_direction,
+    T & p_t_min,
+    T & p_t_max)
+{
+    auto t_min = p_t_min;
+    auto t_max = p_t_max;
+    for (std::size_t i = 0; i < S; ++i)
+    {
+        const auto t_0 = (p_box.get_min()[i] - p_origin[i]) * p_inverse_direction[i];
+        const auto t_1 = (p_box.get_max()[i] - p_origin[i]) * p_inverse_direction[i];
+        const auto t_near = (t_0 < t_1) ? t_0 : t_1;
+        const auto t_far = (t_0 < t_1) ? t_1 : t_0;
+
+        // Written so that a NaN slab (origin on a plane of a zero direction axis) is ignored
+        t_min = (t_near > t_min) ? t_near : t_min;
+        t_max = (t_far < t_max) ? t_far : t_max;
+    }
+
+    if (t_min > t_max) {
+        return false;
+    }
+
+    p_t_min = t_min;
+    p_t_max = t_max;
+    return true;
+}
@@ -0,0 +1,162 @@
+#pragma once
+
+// Bounding volume hierarchy over the bounds of a set of primitives
+//
+// Built top-down with a binned surface area heuristic, the subtrees below the
+//  first few splits are built in parallel on a thread_pool
+// The split decisions do not depend on the number of threads, the same input
+//  always gives the same tree
+// The binary tree is then collapsed into nodes of `W` children (4 or 8) whose
+//  bounds are stored as structure of arrays, so a query tests all the
+//  children of a node with one loop the compiler can vectorize
+//
+// Primitives are only known through their bounds, queries call back into the
+//  caller for exact tests (ray hits, distances)
+// refit() updates the bounds after the primitives moved, without changing
+//  the tree layout; the tree gets slower to query as the motion grows
+
+// project headers
+#include "aabb.h"
+#include "parallel/thread_pool.h"
+#include "vector/vector.h"
+
+// standard headers
+#include <array>
+#include <cstddef>  // std::size_t
+#include <cstdint>
+#include <limits>
+#include <span>
+#include <vector>
+
+namespace ft {
+namespace math {
+
+// Number of bins per axis tested when looking for a split
+inline constexpr std::size_t bvh_bin_count = 16;
+
+// Ranges of up to this many primitives may become leaves
+inline constexpr std::size_t bvh_max_leaf_size = 8;
+
+// Below this depth the builder stops looking for the best split and splits
+//  at the median, keeping the tree depth bounded for degenerate inputs
+inline constexpr std::size_t bvh_max_sah_depth = 32;
+
+
+// Result of a ray or closest primitive query
+template<class T>
+struct bvh_hit
+{
+    // Index of the primitive, `bvh<T>::npos` if nothing was found
+    std::uint32_t primitive;
+
+    // Distance along the ray, or squared distance to the point
+    T distance;
+};
+
+
+template<class T, std::size_t S = 3, std::size_t W = 4>
+class bvh
+{
+    static_assert(W >= 2 && W <= 8, "Nodes have between 2 and 8 children");
+
+public:
+    using value_type = T;
+    static constexpr auto dimensions = S;
+    static constexpr auto width = W;
+
+    // Marks missing children and primitives
+    static constexpr auto npos = std::numeric_limits<std::uint32_t>::max();
+
+public:
+    // Default constructor
+    // Constructs an empty hierarchy
+    bvh() = default;
+
+    // Build over the bounds of a set of primitives
+    explicit bvh(std::span<const aabb<T, S>> p_bounds, thread_pool & p_pool = default_thread_pool());
+
+
+    // Build over the bounds of a set of primitives
+    // Primitive `i` of the queries is `p_bounds[i]`
+    void build(std::span<const aabb<T, S>> p_bounds, thread_pool & p_pool = default_thread_pool());
+
+    // Update the bounds of the primitives without changing the tree layout
+    // `p_bounds` must have as many elements as the one the tree was built with
+    void refit(std::span<const aabb<T, S>> p_bounds);
+
+
+    // Returns true if the hierarchy has no primitive
+    bool is_empty() const;
+
+    // Get the number of primitives
+    std::size_t primitive_count() const;
+
+    // Get the number of nodes
+    std::size_t node_count() const;
+
+    // Get the bounds of all the primitives
+    const aabb<T, S> & get_bounds() const;
+
+
+    // Call `p_callback(i)` for each primitive `i` whose bounds overlap `p_box`
+    template<class F>
+    void query_overlap(const aabb<T, S> & p_box, F && p_callback) const;
+
+    // Find the nearest primitive hit by a ray in [0, p_t_max)
+    // `p_intersect(i, t_max)` returns the distance along the ray to primitive `i`
+    //  or any value not smaller than `t_max` if it is missed
+    // The direction does not need to be normalized, distances are in units of it
+    template<class F>
+    bvh_hit<T> query_ray(
+        const vector<T, S> & p_origin,
+        const vector<T, S> & p_direction,
+        const T p_t_max,
+        F && p_intersect) const;
+
+    // Find the primitive nearest to a point, closer than `sqrt(p_max_distance2)`
+    // `p_distance2(i)` returns the squared distance from the point to primitive `i`
+    template<class F>
+    bvh_hit<T> query_closest(
+        const vector<T, S> & p_point,
+        F && p_distance2,
+        const T p_max_distance2 = std::numeric_limits<T>::infinity()) const;
+
+private:
+    // `W` children with their bounds stored per axis
+    struct node
+    {
+        std::array<std::array<T, W>, S> min;
+        std::array<std::array<T, W>, S> max;
+
+        // Node index of inner children, first primitive of leaves, npos when unused
+        std::array<std::uint32_t, W> child;
+
+        // Number of primitives of leaves, zero for inner children
+        std::array<std::uint32_t, W> count;
+    };
+
+    // Set the bounds of a child
+    static void set_child_bounds(node & p_node, const std::size_t p_slot, const aabb<T, S> & p_bounds);
+
+    // Get the union of the bounds of the children of a node
+    static aabb<T, S> get_node_bounds(const node & p_node);
+
+private:
+    // Nodes, parents before children, the root first
+    std::vector<node> m_nodes;
+
+    // Primitive index for each leaf slot, leaves reference ranges of it
+    std::vector<std::uint32_t> m_primitives;
+
+    // Primitive bounds in the order of `m_primitives`
+    std::vector<aabb<T, S>> m_primitive_bounds;
+
+    // Bounds of everything
+    aabb<T, S> m_bounds;
+
+};  // class bvh
+
+};  // namespace math
+};  // namespace ft
+
+#include "bvh.hpp"
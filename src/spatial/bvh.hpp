@@ -0,0 +1,844 @@
+#pragma once
+
+// Implements the bvh class of bvh.h
+
+// project headers
+#include "bvh.h"
+
+// other headers
+#include "error/ft_assert.h"
+
+// standard headers
+#include <algorithm>
+#include <numeric>
+
+namespace ft {
+namespace math {
+namespace details {
+namespace bvh_ns {
+
+inline constexpr auto invalid_index = std::numeric_limits<std::uint32_t>::max();
+
+// Ranges smaller than this are never split into parallel tasks
+inline constexpr std::size_t min_task_size = 4096;
+
+// Number of tasks per thread the builder aims for, to balance uneven subtrees
+inline constexpr std::size_t tasks_per_thread = 8;
+
+// Centroids computed per parallel chunk
+inline constexpr std::size_t centroid_chunk_size = 16384;
+
+// Stack entries needed by a traversal
+// The binary tree is at most `bvh_max_sah_depth` levels of heuristic splits
+//  followed by median splits, each level pushes at most W - 1 children
+template<std::size_t W>
+inline constexpr std::size_t stack_size = (bvh_max_sah_depth + 34) * W;
+
+
+// Node of the binary tree built before collapsing
+template<class T, std::size_t S>
+struct build_node
+{
+    aabb<T, S> bounds;
+    std::uint32_t left = invalid_index;
+    std::uint32_t right = invalid_index;
+
+    // Range of primitives of a leaf, a zero count marks an inner node
+    std::uint32_t first = 0;
+    std::uint32_t count = 0;
+};
+
+
+// Range of primitives whose subtree is built as a separate task
+struct build_task
+{
+    std::uint32_t node;
+    std::uint32_t first;
+    std::uint32_t count;
+    std::size_t depth;
+};
+
+
+// Data shared by every step of a build
+template<class T, std::size_t S>
+struct build_context
+{
+    std::span<const aabb<T, S>> bounds;
+    std::span<const vector<T, S>> centroids;
+    std::span<std::uint32_t> indices;
+
+    // Pool used to scan large ranges, null inside parallel tasks
+    thread_pool * pool;
+};
+
+
+// Bounds of the primitives of a range and of their centroids
+template<class T, std::size_t S>
+struct range_bounds
+{
+    aabb<T, S> bounds;
+    aabb<T, S> centroid_bounds;
+
+    void merge(const range_bounds & p_other)
+    {
+        bounds.expand(p_other.bounds);
+        centroid_bounds.expand(p_other.centroid_bounds);
+    }
+};
+
+
+// Primitive bounds and counts of the bins of every axis
+template<class T, std::size_t S>
+struct range_bins
+{
+    std::array<std::array<aabb<T, S>, bvh_bin_count>, S> bounds;
+    std::array<std::array<std::uint32_t, bvh_bin_count>, S> counts = {};
+
+    void merge(const range_bins & p_other)
+    {
+        for (std::size_t a = 0; a < S; ++a)
+        {
+            for (std::size_t b = 0; b < bvh_bin_count; ++b)
+            {
+                bounds[a][b].expand(p_other.bounds[a][b]);
+                counts[a][b] += p_other.counts[a][b];
+            }
+        }
+    }
+};
+
+
+// Accumulate `p_func(accumulator, primitive)` over the primitives of a range
+// Large ranges are split in chunks accumulated in parallel then merged in order
+template<class A, class T, std::size_t S, class F>
+A accumulate_range(const build_context<T, S> & p_context, const std::uint32_t p_first, const std::uint32_t p_count, F && p_func)
+{
+    if (p_context.pool == nullptr || p_count <= min_task_size)
+    {
+        A result;
+        for (auto i = p_first; i < p_first + p_count; ++i) {
+            p_func(result, p_context.indices[i]);
+        }
+        return result;
+    }
+
+    std::vector<A> partials(chunk_count(p_count, min_task_size));
+    parallel_for_chunks(p_count, min_task_size, [&](const std::size_t p_chunk, const std::size_t p_begin, const std::size_t p_end)
+    {
+        for (auto i = p_begin; i < p_end; ++i) {
+            p_func(partials[p_chunk], p_context.indices[p_first + i]);
+        }
+    }, *p_context.pool);
+
+    for (std::size_t c = 1; c < partials.size(); ++c) {
+        partials[0].merge(partials[c]);
+    }
+    return partials[0];
+}
+
+
+// Partition the primitives in [p_first, p_first + p_count) in two
+// Returns the start of the second part, or `p_first` if the range should be a leaf
+template<class T, std::size_t S>
+std::uint32_t split_range(
+    const build_context<T, S> & p_context,
+    const std::uint32_t p_first,
+    const std::uint32_t p_count,
+    const std::size_t p_depth,
+    const aabb<T, S> & p_bounds,
+    const aabb<T, S> & p_centroid_bounds)
+{
+    if (p_count <= 1) {
+        return p_first;
+    }
+
+    const auto begin = p_context.indices.begin() + p_first;
+    const auto end = begin + p_count;
+    const auto median = p_first + p_count / 2;
+    const auto & centroids = p_context.centroids;
+    const auto centroid_min = p_centroid_bounds.get_min();
+    const auto extent = p_centroid_bounds.get_extent();
+
+    std::size_t widest = 0;
+    for (std::size_t a = 1; a < S; ++a) {
+        widest = (extent[a] > extent[widest]) ? a : widest;
+    }
+
+    // Every centroid is at the same place, no plane can separate them
+    if (!(extent[widest] > 0)) {
+        return (p_count <= bvh_max_leaf_size) ? p_first : median;
+    }
+
+    if (p_depth >= bvh_max_sah_depth)
+    {
+        std::nth_element(begin, begin + p_count / 2, end, [&](const auto p_a, const auto p_b) {
+            return centroids[p_a][widest] < centroids[p_b][widest];
+        });
+        return median;
+    }
+
+    auto best_cost = std::numeric_limits<T>::infinity();
+    std::size_t best_axis = 0;
+    std::size_t best_bin = 0;
+
+    // Flat axes put everything in the first bin and are skipped below
+    vector<T, S> scales;
+    for (std::size_t a = 0; a < S; ++a) {
+        scales[a] = (extent[a] > 0) ? static_cast<T>(bvh_bin_count) / extent[a] : static_cast<T>(0);
+    }
+    const auto get_bin = [&](const std::uint32_t p_index, const std::size_t p_axis) {
+        return std::min(bvh_bin_count - 1, static_cast<std::size_t>((centroids[p_index][p_axis] - centroid_min[p_axis]) * scales[p_axis]));
+    };
+
+    const auto bins = accumulate_range<range_bins<T, S>>(p_context, p_first, p_count, [&](auto & p_bins, const std::uint32_t p_index)
+    {
+        for (std::size_t a = 0; a < S; ++a)
+        {
+            const auto bin = get_bin(p_index, a);
+            p_bins.bounds[a][bin].expand(p_context.bounds[p_index]);
+            p_bins.counts[a][bin] += 1;
+        }
+    });
+
+    for (std::size_t a = 0; a < S; ++a)
+    {
+        if (!(extent[a] > 0)) {
+            continue;
+        }
+
+        const auto & bin_bounds = bins.bounds[a];
+        const auto & bin_counts = bins.counts[a];
+
+        // Cost of the primitives right of each plane
+        std::array<T, bvh_bin_count> right_costs;
+        aabb<T, S> accumulated;
+        std::uint32_t count = 0;
+        for (auto b = bvh_bin_count - 1; b > 0; --b)
+        {
+            accumulated.expand(bin_bounds[b]);
+            count += bin_counts[b];
+            right_costs[b] = accumulated.get_half_surface_area() * static_cast<T>(count);
+        }
+
+        accumulated = {};
+        count = 0;
+        for (std::size_t b = 0; b + 1 < bvh_bin_count; ++b)
+        {
+            accumulated.expand(bin_bounds[b]);
+            count += bin_counts[b];
+            if (count == 0 || count == p_count) {
+                continue;
+            }
+
+            const auto cost = accumulated.get_half_surface_area() * static_cast<T>(count) + right_costs[b + 1];
+            if (cost < best_cost)
+            {
+                best_cost = cost;
+                best_axis = a;
+                best_bin = b + 1;
+            }
+        }
+    }
+
+    // Binning could not separate the centroids
+    if (best_cost == std::numeric_limits<T>::infinity()) {
+        return (p_count <= bvh_max_leaf_size) ? p_first : median;
+    }
+
+    // Costs relative to intersecting one primitive, a traversal step costing as much
+    const auto area = p_bounds.get_half_surface_area();
+    const auto split_cost = 1 + ((area > 0) ? best_cost / area : static_cast<T>(0));
+    if (p_count <= bvh_max_leaf_size && split_cost >= static_cast<T>(p_count)) {
+        return p_first;
+    }
+
+    const auto middle = std::partition(begin, end, [&](const auto p_index) {
+        return get_bin(p_index, best_axis) < best_bin;
+    });
+    return p_first + static_cast<std::uint32_t>(middle - begin);
+}
+
+
+// Build the binary tree of the primitives in [p_first, p_first + p_count)
+// Ranges of at most `p_task_size` primitives are not built but appended to
+//  `p_tasks` when it is not null, their node is left as a placeholder
+// Returns the index of the root of the range
+template<class T, std::size_t S>
+std::uint32_t build_range(
+    const build_context<T, S> & p_context,
+    std::vector<build_node<T, S>> & p_nodes,
+    const std::uint32_t p_first,
+    const std::uint32_t p_count,
+    const std::size_t p_depth,
+    std::vector<build_task> * p_tasks,
+    const std::size_t p_task_size)
+{
+    const auto index = static_cast<std::uint32_t>(p_nodes.size());
+    p_nodes.emplace_back();
+
+    const auto [bounds, centroid_bounds] = accumulate_range<range_bounds<T, S>>(p_context, p_first, p_count,
+        [&](auto & p_bounds, const std::uint32_t p_index)
+        {
+            p_bounds.bounds.expand(p_context.bounds[p_index]);
+            p_bounds.centroid_bounds.expand(p_context.centroids[p_index]);
+        });
+    p_nodes[index].bounds = bounds;
+
+    if (p_tasks != nullptr && p_count <= p_task_size)
+    {
+        p_tasks->push_back({ index, p_first, p_count, p_depth });
+        return index;
+    }
+
+    const auto middle = split_range(p_context, p_first, p_count, p_depth, bounds, centroid_bounds);
+    if (middle == p_first)
+    {
+        p_nodes[index].first = p_first;
+        p_nodes[index].count = p_count;
+        return index;
+    }
+
+    const auto left = build_range(p_context, p_nodes, p_first, middle - p_first, p_depth + 1, p_tasks, p_task_size);
+    const auto right = build_range(p_context, p_nodes, middle, p_first + p_count - middle, p_depth + 1, p_tasks, p_task_size);
+    p_nodes[index].left = left;
+    p_nodes[index].right = right;
+    return index;
+}
+
+
+// Replace the placeholder nodes of the tasks by the subtrees they built
+// The root of each subtree takes the place of its placeholder
+template<class T, std::size_t S>
+void attach_subtrees(
+    std::vector<build_node<T, S>> & p_nodes,
+    std::span<const build_task> p_tasks,
+    std::span<const std::vector<build_node<T, S>>> p_subtrees)
+{
+    for (std::size_t t = 0; t < p_tasks.size(); ++t)
+    {
+        const auto & subtree = p_subtrees[t];
+
+        // Local node k > 0 lands at offset + k
+        const auto offset = static_cast<std::uint32_t>(p_nodes.size() - 1);
+        const auto relocate = [&](build_node<T, S> p_node)
+        {
+            if (p_node.count == 0)
+            {
+                p_node.left += offset;
+                p_node.right += offset;
+            }
+            return p_node;
+        };
+
+        p_nodes[p_tasks[t].node] = relocate(subtree[0]);
+        for (std::size_t k = 1; k < subtree.size(); ++k) {
+            p_nodes.push_back(relocate(subtree[k]));
+        }
+    }
+}
+
+
+// Collapse the binary subtree at `p_index` into nodes of `W` children appended to `p_wide`
+// Inner children with the largest surface area are opened first
+// Returns the index of the wide node
+template<std::size_t W, class N, class T, std::size_t S>
+std::uint32_t collapse(const std::vector<build_node<T, S>> & p_nodes, const std::uint32_t p_index, std::vector<N> & p_wide)
+{
+    const auto index = static_cast<std::uint32_t>(p_wide.size());
+    p_wide.emplace_back();
+
+    std::array<std::uint32_t, W> children;
+    std::size_t count = 0;
+    if (p_nodes[p_index].count > 0) {
+        children[count++] = p_index;
+    }
+    else
+    {
+        children[count++] = p_nodes[p_index].left;
+        children[count++] = p_nodes[p_index].right;
+    }
+
+    while (count < W)
+    {
+        auto largest = W;
+        auto largest_area = static_cast<T>(-1);
+        for (std::size_t c = 0; c < count; ++c)
+        {
+            const auto & child = p_nodes[children[c]];
+            const auto area = child.bounds.get_half_surface_area();
+            if (child.count == 0 && area > largest_area)
+            {
+                largest = c;
+                largest_area = area;
+            }
+        }
+        if (largest == W) {
+            break;
+        }
+
+        const auto & opened = p_nodes[children[largest]];
+        children[largest] = opened.left;
+        children[count++] = opened.right;
+    }
+
+    for (std::size_t c = 0; c < W; ++c)
+    {
+        aabb<T, S> bounds;
+        auto child = invalid_index;
+        std::uint32_t primitives = 0;
+        if (c < count)
+        {
+            const auto & source = p_nodes[children[c]];
+            bounds = source.bounds;
+            child = (source.count > 0) ? source.first : collapse<W>(p_nodes, children[c], p_wide);
+            primitives = source.count;
+        }
+
+        auto & node = p_wide[index];
+        for (std::size_t a = 0; a < S; ++a)
+        {
+            node.min[a][c] = bounds.get_min()[a];
+            node.max[a][c] = bounds.get_max()[a];
+        }
+        node.child[c] = child;
+        node.count[c] = primitives;
+    }
+    return index;
+}
+
+
+// Sort the first `p_count` slots by increasing key
+// Insertion sort, there are at most 8 of them
+template<class T, std::size_t W>
+void sort_slots(std::array<std::uint8_t, W> & p_slots, const std::size_t p_count, const std::array<T, W> & p_keys)
+{
+    for (std::size_t i = 1; i < p_count; ++i)
+    {
+        const auto slot = p_slots[i];
+        auto j = i;
+        for (; j > 0 && p_keys[p_slots[j - 1]] > p_keys[slot]; --j) {
+            p_slots[j] = p_slots[j - 1];
+        }
+        p_slots[j] = slot;
+    }
+}
+
+};  // namespace bvh_ns
+};  // namespace details
+
+
+// Build over the bounds of a set of primitives
+template<class T, std::size_t S, std::size_t W>
+bvh<T, S, W>::bvh(std::span<const aabb<T, S>> p_bounds, thread_pool & p_pool)
+{
+    build(p_bounds, p_pool);
+}
+
+
+// Build over the bounds of a set of primitives
+template<class T, std::size_t S, std::size_t W>
+void bvh<T, S, W>::build(std::span<const aabb<T, S>> p_bounds, thread_pool & p_pool)
+{
+    using namespace details::bvh_ns;
+
+    FT_ASSERT(p_bounds.size() < npos);
+
+    const auto size = p_bounds.size();
+    m_nodes.clear();
+    m_primitives.resize(size);
+    m_primitive_bounds.resize(size);
+    m_bounds = {};
+    if (size == 0) {
+        return;
+    }
+
+    std::iota(m_primitives.begin(), m_primitives.end(), std::uint32_t{ 0 });
+
+    std::vector<vector<T, S>> centroids(size);
+    parallel_for_chunks(size, centroid_chunk_size, [&](std::size_t, const std::size_t p_begin, const std::size_t p_end)
+    {
+        for (auto i = p_begin; i < p_end; ++i) {
+            centroids[i] = p_bounds[i].get_center();
+        }
+    }, p_pool);
+
+    const build_context<T, S> context{ p_bounds, centroids, m_primitives, &p_pool };
+    const build_context<T, S> task_context{ p_bounds, centroids, m_primitives, nullptr };
+
+    // The top of the tree is built serially, the ranges below it in parallel
+    std::vector<build_node<T, S>> nodes;
+    nodes.reserve(2 * size / bvh_max_leaf_size + 1);
+    std::vector<build_task> tasks;
+    const auto task_size = std::max(min_task_size, size / (p_pool.thread_count() * tasks_per_thread));
+    const auto parallel = p_pool.thread_count() > 1 && size > task_size;
+    build_range(context, nodes, 0, static_cast<std::uint32_t>(size), 0, parallel ? &tasks : nullptr, task_size);
+
+    if (!tasks.empty())
+    {
+        std::vector<std::vector<build_node<T, S>>> subtrees(tasks.size());
+        parallel_for_chunks(tasks.size(), 1, [&](const std::size_t p_task, std::size_t, std::size_t)
+        {
+            const auto & task = tasks[p_task];
+            subtrees[p_task].reserve(2 * task.count / bvh_max_leaf_size + 1);
+            build_range(task_context, subtrees[p_task], task.first, task.count, task.depth, nullptr, 0);
+        }, p_pool);
+
+        attach_subtrees<T, S>(nodes, tasks, subtrees);
+    }
+
+    m_nodes.reserve(nodes.size() / 2 + 1);
+    collapse<W>(nodes, 0, m_nodes);
+
+    for (std::size_t i = 0; i < size; ++i) {
+        m_primitive_bounds[i] = p_bounds[m_primitives[i]];
+    }
+    m_bounds = nodes[0].bounds;
+}
+
+
+// Update the bounds of the primitives without changing the tree layout
+template<class T, std::size_t S, std::size_t W>
+void bvh<T, S, W>::refit(std::span<const aabb<T, S>> p_bounds)
+{
+    FT_ASSERT(p_bounds.size() == m_primitives.size());
+
+    for (std::size_t i = 0; i < m_primitives.size(); ++i) {
+        m_primitive_bounds[i] = p_bounds[m_primitives[i]];
+    }
+
+    // Children are stored after their parent
+    for (auto n = m_nodes.size(); n-- > 0;)
+    {
+        auto & node = m_nodes[n];
+        for (std::size_t c = 0; c < W; ++c)
+        {
+            if (node.count[c] > 0)
+            {
+                aabb<T, S> bounds;
+                for (auto i = node.child[c]; i < node.child[c] + node.count[c]; ++i) {
+                    bounds.expand(m_primitive_bounds[i]);
+                }
+                set_child_bounds(node, c, bounds);
+            }
+            else if (node.child[c] != npos) {
+                set_child_bounds(node, c, get_node_bounds(m_nodes[node.child[c]]));
+            }
+        }
+    }
+
+    m_bounds = m_nodes.empty() ? aabb<T, S>{} : get_node_bounds(m_nodes[0]);
+}
+
+
+// Returns true if the hierarchy has no primitive
+template<class T, std::size_t S, std::size_t W>
+bool bvh<T, S, W>::is_empty() const
+{
+    return m_primitives.empty();
+}
+
+
+// Get the number of primitives
+template<class T, std::size_t S, std::size_t W>
+std::size_t bvh<T, S, W>::primitive_count() const
+{
+    return m_primitives.size();
+}
+
+
+// Get the number of nodes
+template<class T, std::size_t S, std::size_t W>
+std::size_t bvh<T, S, W>::node_count() const
+{
+    return m_nodes.size();
+}
+
+
+// Get the bounds of all the primitives
+template<class T, std::size_t S, std::size_t W>
+const aabb<T, S> & bvh<T, S, W>::get_bounds() const
+{
+    return m_bounds;
+}
+
+
+// Call `p_callback(i)` for each primitive `i` whose bounds overlap `p_box`
+template<class T, std::size_t S, std::size_t W>
+template<class F>
+void bvh<T, S, W>::query_overlap(const aabb<T, S> & p_box, F && p_callback) const
+{
+    if (m_nodes.empty()) {
+        return;
+    }
+
+    std::array<std::uint32_t, details::bvh_ns::stack_size<W>> stack;
+    std::size_t stack_size = 0;
+    stack[stack_size++] = 0;
+
+    while (stack_size > 0)
+    {
+        const auto & node = m_nodes[stack[--stack_size]];
+
+        // Test every child at once
+        std::array<bool, W> hits;
+        for (std::size_t c = 0; c < W; ++c) {
+            hits[c] = node.child[c] != npos;
+        }
+        for (std::size_t a = 0; a < S; ++a)
+        {
+            const auto min = p_box.get_min()[a];
+            const auto max = p_box.get_max()[a];
+            for (std::size_t c = 0; c < W; ++c) {
+                hits[c] &= (node.min[a][c] <= max) & (node.max[a][c] >= min);
+            }
+        }
+
+        for (std::size_t c = 0; c < W; ++c)
+        {
+            if (!hits[c]) {
+                continue;
+            }
+
+            if (node.count[c] == 0)
+            {
+                stack[stack_size++] = node.child[c];
+                continue;
+            }
+
+            for (auto i = node.child[c]; i < node.child[c] + node.count[c]; ++i)
+            {
+                if (m_primitive_bounds[i].overlaps(p_box)) {
+                    p_callback(m_primitives[i]);
+                }
+            }
+        }
+    }
+}
+
+
+// Find the nearest primitive hit by a ray in [0, p_t_max)
+template<class T, std::size_t S, std::size_t W>
+template<class F>
+bvh_hit<T> bvh<T, S, W>::query_ray(
+    const vector<T, S> & p_origin,
+    const vector<T, S> & p_direction,
+    const T p_t_max,
+    F && p_intersect) const
+{
+    auto result = bvh_hit<T>{ npos, p_t_max };
+    if (m_nodes.empty()) {
+        return result;
+    }
+
+    vector<T, S> inverse_direction;
+    for (std::size_t a = 0; a < S; ++a) {
+        inverse_direction[a] = 1 / p_direction[a];
+    }
+
+    // Nodes are pushed with the distance at which the ray enters them
+    std::array<std::uint32_t, details::bvh_ns::stack_size<W>> stack;
+    std::array<T, details::bvh_ns::stack_size<W>> stack_entries;
+    std::size_t stack_size = 0;
+    stack[stack_size] = 0;
+    stack_entries[stack_size++] = 0;
+
+    while (stack_size > 0)
+    {
+        --stack_size;
+        if (stack_entries[stack_size] >= result.distance) {
+            continue;
+        }
+        const auto & node = m_nodes[stack[stack_size]];
+
+        // Slab test of every child at once
+        std::array<T, W> entries;
+        std::array<T, W> exits;
+        entries.fill(static_cast<T>(0));
+        exits.fill(result.distance);
+        for (std::size_t a = 0; a < S; ++a)
+        {
+            const auto origin = p_origin[a];
+            const auto inverse = inverse_direction[a];
+            for (std::size_t c = 0; c < W; ++c)
+            {
+                const auto t_0 = (node.min[a][c] - origin) * inverse;
+                const auto t_1 = (node.max[a][c] - origin) * inverse;
+                const auto t_near = (t_0 < t_1) ? t_0 : t_1;
+                const auto t_far = (t_0 < t_1) ? t_1 : t_0;
+                entries[c] = (t_near > entries[c]) ? t_near : entries[c];
+                exits[c] = (t_far < exits[c]) ? t_far : exits[c];
+            }
+        }
+
+        std::array<std::uint8_t, W> slots;
+        std::size_t hit_count = 0;
+        for (std::size_t c = 0; c < W; ++c)
+        {
+            if (node.child[c] != npos && entries[c] <= exits[c]) {
+                slots[hit_count++] = static_cast<std::uint8_t>(c);
+            }
+        }
+        details::bvh_ns::sort_slots(slots, hit_count, entries);
+
+        // Leaves front to back, then inner children pushed so the nearest is popped first
+        for (std::size_t s = 0; s < hit_count; ++s)
+        {
+            const auto c = slots[s];
+            if (node.count[c] == 0 || entries[c] >= result.distance) {
+                continue;
+            }
+
+            for (auto i = node.child[c]; i < node.child[c] + node.count[c]; ++i)
+            {
+                auto t_min = static_cast<T>(0);
+                auto t_max = result.distance;
+                if (!intersect_ray(m_primitive_bounds[i], p_origin, inverse_direction, t_min, t_max)) {
+                    continue;
+                }
+
+                const T t = p_intersect(m_primitives[i], result.distance);
+                if (t >= 0 && t < result.distance) {
+                    result = { m_primitives[i], t };
+                }
+            }
+        }
+
+        for (auto s = hit_count; s-- > 0;)
+        {
+            const auto c = slots[s];
+            if (node.count[c] == 0)
+            {
+                stack[stack_size] = node.child[c];
+                stack_entries[stack_size++] = entries[c];
+            }
+        }
+    }
+    return result;
+}
+
+
+// Find the primitive nearest to a point
+template<class T, std::size_t S, std::size_t W>
+template<class F>
+bvh_hit<T> bvh<T, S, W>::query_closest(
+    const vector<T, S> & p_point,
+    F && p_distance2,
+    const T p_max_distance2) const
+{
+    auto result = bvh_hit<T>{ npos, p_max_distance2 };
+    if (m_nodes.empty()) {
+        return result;
+    }
+
+    // Nodes are pushed with their squared distance to the point
+    std::array<std::uint32_t, details::bvh_ns::stack_size<W>> stack;
+    std::array<T, details::bvh_ns::stack_size<W>> stack_distances;
+    std::size_t stack_size = 0;
+    stack[stack_size] = 0;
+    stack_distances[stack_size++] = 0;
+
+    while (stack_size > 0)
+    {
+        --stack_size;
+        if (stack_distances[stack_size] >= result.distance) {
+            continue;
+        }
+        const auto & node = m_nodes[stack[stack_size]];
+
+        // Distance to every child at once
+        std::array<T, W> distances;
+        distances.fill(static_cast<T>(0));
+        for (std::size_t a = 0; a < S; ++a)
+        {
+            const auto value = p_point[a];
+            for (std::size_t c = 0; c < W; ++c)
+            {
+                const auto below = node.min[a][c] - value;
+                const auto above = value - node.max[a][c];
+                const auto outside = (below > above) ? below : above;
+                const auto delta = (outside > 0) ? outside : static_cast<T>(0);
+                distances[c] += delta * delta;
+            }
+        }
+
+        std::array<std::uint8_t, W> slots;
+        std::size_t hit_count = 0;
+        for (std::size_t c = 0; c < W; ++c)
+        {
+            if (node.child[c] != npos && distances[c] < result.distance) {
+                slots[hit_count++] = static_cast<std::uint8_t>(c);
+            }
+        }
+        details::bvh_ns::sort_slots(slots, hit_count, distances);
+
+        for (std::size_t s = 0; s < hit_count; ++s)
+        {
+            const auto c = slots[s];
+            if (node.count[c] == 0 || distances[c] >= result.distance) {
+                continue;
+            }
+
+            for (auto i = node.child[c]; i < node.child[c] + node.count[c]; ++i)
+            {
+                if (m_primitive_bounds[i].distance2(p_point) >= result.distance) {
+                    continue;
+                }
+
+                const T distance2 = p_distance2(m_primitives[i]);
+                if (distance2 < result.distance) {
+                    result = { m_primitives[i], distance2 };
+                }
+            }
+        }
+
+        for (auto s = hit_count; s-- > 0;)
+        {
+            const auto c = slots[s];
+            if (node.count[c] == 0)
+            {
+                stack[stack_size] = node.child[c];
+                stack_distances[stack_size++] = distances[c];
+            }
+        }
+    }
+    return result;
+}
+
+
+// Set the bounds of a child
+template<class T, std::size_t S, std::size_t W>
+void bvh<T, S, W>::set_child_bounds(node & p_node, const std::size_t p_slot, const aabb<T, S> & p_bounds)
+{
+    for (std::size_t a = 0; a < S; ++a)
+    {
+        p_node.min[a][p_slot] = p_bounds.get_min()[a];
+        p_node.max[a][p_slot] = p_bounds.get_max()[a];
+    }
+}
+
+
+// Get the union of the bounds of the children of a node
+template<class T, std::size_t S, std::size_t W>
+aabb<T, S> bvh<T, S, W>::get_node_bounds(const node & p_node)
+{
+    aabb<T, S> result;
+    for (std::size_t c = 0; c < W; ++c)
+    {
+        if (p_node.child[c] == npos) {
+            continue;
+        }
+
+        vector<T, S> min;
+        vector<T, S> max;
+        for (std::size_t a = 0; a < S; ++a)
+        {
+            min[a] = p_node.min[a][c];
+            max[a] = p_node.max[a][c];
+        }
+        result.expand(aabb<T, S>{ min, max });
+    }
+    return result;
+}
+
+};  // namespace math
+};  // namespace ft
@@ -0,0 +1,112 @@
+#pragma once
+
+// Single pass mean and covariance of point clouds
+// Points are accumulated with Welford's update, which stays accurate for
+//  clouds far from the origin where summing x and x * xt is not
+// Accumulators of separate chunks can be merged (Chan et al.), so large
+//  clouds are accumulated in parallel and the results combined in order
+//
+// Only the lower triangle of the scatter matrix is updated per point, the
+//  full matrix is built when read
+
+// project headers
+#include "matrix/matrix.h"
+#include "parallel/thread_pool.h"
+#include "vector/vector.h"
+
+// standard headers
+#include <cstddef>  // std::size_t
+#include <span>
+
+namespace ft {
+namespace math {
+
+template<class T, std::size_t S>
+class covariance_accumulator
+{
+public:
+    using value_type = T;
+    static constexpr auto dimensions = S;
+
+public:
+    // Default constructor
+    // Constructs an accumulator holding no point
+    constexpr covariance_accumulator();
+
+
+    // Add a point
+    constexpr void add(const vector<T, S> & p_point);
+
+    // Add the points of another accumulator
+    constexpr void merge(const covariance_accumulator & p_other);
+
+
+    // Get the number of points added
+    constexpr std::size_t get_count() const;
+
+    // Get the mean of the points
+    // Zero if there are no points
+    constexpr const vector<T, S> & get_mean() const;
+
+    // Get the sum of the outer products of the deviations from the mean
+    constexpr matrix<T, S, S> get_scatter() const;
+
+    // Get the population covariance, the scatter divided by the count
+    // Zero if there are no points
+    constexpr matrix<T, S, S> get_covariance() const;
+
+    // Get the sample covariance, the scatter divided by the count minus one
+    // Zero if there are less than two points
+    constexpr matrix<T, S, S> get_sample_covariance() const;
+
+private:
+    std::size_t m_count;
+    vector<T, S> m_mean;
+
+    // Only the lower triangle is up to date
+    matrix<T, S, S> m_scatter;
+
+};  // class covariance_accumulator
+
+
+// Principal axes of a point cloud
+template<class T, std::size_t S>
+struct principal_components
+{
+    // Mean of the points
+    vector<T, S> mean;
+
+    // Variance along each axis in decreasing order
+    vector<T, S> variances;
+
+    // Axis `i` is column `i`, matching `variances[i]`
+    // The axes are orthonormal, in 2D and 3D they form a rotation
+    matrix<T, S, S> axes;
+};
+
+
+// Accumulate the mean and covariance of an array of points
+// The points are accumulated in parallel chunks merged in order, the
+//  result does not depend on the number of threads
+template<class T, std::size_t S>
+covariance_accumulator<T, S> accumulate_covariance(
+    std::span<const vector<T, S>> p_points,
+    thread_pool & p_pool = default_thread_pool());
+
+
+// Get the principal axes of accumulated points
+// The population covariance is decomposed, the first axis is the direction
+//  of largest variance
+template<class T, std::size_t S>
+principal_components<T, S> principal_axes(const covariance_accumulator<T, S> & p_accumulator);
+
+// Get the principal axes of an array of points
+template<class T, std::size_t S>
+principal_components<T, S> principal_axes(
+    std::span<const vector<T, S>> p_points,
+    thread_pool & p_pool = default_thread_pool());
+
+};  // namespace math
+};  // namespace ft
+
+#include "covariance.hpp"
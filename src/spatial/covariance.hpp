@@ -0,0 +1,211 @@
+#pragma once
+
+// Implements the covariance accumulation of covariance.h
+
+// project headers
+#include "covariance.h"
+#include "matrix/matrix_eigen.h"
+#include "parallel/vector_reduce.h"
+
+namespace ft {
+namespace math {
+namespace details {
+namespace covariance_ns {
+
+// Get the determinant of the axes of a 2D or 3D cloud
+template<class T, std::size_t S>
+T axes_determinant(const matrix<T, S, S> & p_axes)
+{
+    if constexpr (S == 2) {
+        return p_axes[0][0] * p_axes[1][1] - p_axes[0][1] * p_axes[1][0];
+    }
+    else
+    {
+        return
+            p_axes[0][0] * (p_axes[1][1] * p_axes[2][2] - p_axes[1][2] * p_axes[2][1]) -
+            p_axes[0][1] * (p_axes[1][0] * p_axes[2][2] - p_axes[1][2] * p_axes[2][0]) +
+            p_axes[0][2] * (p_axes[1][0] * p_axes[2][1] - p_axes[1][1] * p_axes[2][0]);
+    }
+}
+
+};  // namespace covariance_ns
+};  // namespace details
+
+
+// Constructs an accumulator holding no point
+template<class T, std::size_t S>
+constexpr covariance_accumulator<T, S>::covariance_accumulator() :
+    m_count(0),
+    m_mean(make_zero_vector<T, S>())
+{
+    m_scatter.fill(0);
+}
+
+
+// Add a point
+template<class T, std::size_t S>
+constexpr void covariance_accumulator<T, S>::add(const vector<T, S> & p_point)
+{
+    m_count += 1;
+    const auto inverse_count = static_cast<T>(1) / static_cast<T>(m_count);
+
+    // Deviations from the old and the new mean
+    vector<T, S> before;
+    vector<T, S> after;
+    for (std::size_t a = 0; a < S; ++a)
+    {
+        before[a] = p_point[a] - m_mean[a];
+        m_mean[a] += before[a] * inverse_count;
+        after[a] = p_point[a] - m_mean[a];
+    }
+
+    for (std::size_t y = 0; y < S; ++y) {
+        for (std::size_t x = 0; x <= y; ++x) {
+            m_scatter[y][x] += before[y] * after[x];
+        }
+    }
+}
+
+
+// Add the points of another accumulator
+template<class T, std::size_t S>
+constexpr void covariance_accumulator<T, S>::merge(const covariance_accumulator & p_other)
+{
+    if (p_other.m_count == 0) {
+        return;
+    }
+    if (m_count == 0)
+    {
+        *this = p_other;
+        return;
+    }
+
+    const auto count = m_count + p_other.m_count;
+    const auto other_weight = static_cast<T>(p_other.m_count) / static_cast<T>(count);
+    const auto cross_weight = static_cast<T>(m_count) * other_weight;
+
+    const auto delta = p_other.m_mean - m_mean;
+    for (std::size_t y = 0; y < S; ++y) {
+        for (std::size_t x = 0; x <= y; ++x) {
+            m_scatter[y][x] += p_other.m_scatter[y][x] + delta[y] * delta[x] * cross_weight;
+        }
+    }
+    for (std::size_t a = 0; a < S; ++a) {
+        m_mean[a] += delta[a] * other_weight;
+    }
+    m_count = count;
+}
+
+
+// Get the number of points added
+template<class T, std::size_t S>
+constexpr std::size_t covariance_accumulator<T, S>::get_count() const
+{
+    return m_count;
+}
+
+
+// Get the mean of the points
+template<class T, std::size_t S>
+constexpr const vector<T, S> & covariance_accumulator<T, S>::get_mean() const
+{
+    return m_mean;
+}
+
+
+// Get the sum of the outer products of the deviations from the mean
+template<class T, std::size_t S>
+constexpr matrix<T, S, S> covariance_accumulator<T, S>::get_scatter() const
+{
+    auto result = m_scatter;
+    for (std::size_t y = 0; y < S; ++y) {
+        for (std::size_t x = y + 1; x < S; ++x) {
+            result[y][x] = result[x][y];
+        }
+    }
+    return result;
+}
+
+
+// Get the population covariance, the scatter divided by the count
+template<class T, std::size_t S>
+constexpr matrix<T, S, S> covariance_accumulator<T, S>::get_covariance() const
+{
+    auto result = get_scatter();
+    if (m_count > 0) {
+        result /= static_cast<T>(m_count);
+    }
+    return result;
+}
+
+
+// Get the sample covariance, the scatter divided by the count minus one
+template<class T, std::size_t S>
+constexpr matrix<T, S, S> covariance_accumulator<T, S>::get_sample_covariance() const
+{
+    auto result = get_scatter();
+    if (m_count > 1) {
+        result /= static_cast<T>(m_count - 1);
+    }
+    else {
+        result.fill(0);
+    }
+    return result;
+}
+
+};  // namespace math
+};  // namespace ft
+
+
+// Accumulate the mean and covariance of an array of points
+template<class T, std::size_t S>
+ft::math::covariance_accumulator<T, S> ft::math::accumulate_covariance(
+    std::span<const vector<T, S>> p_points,
+    thread_pool & p_pool)
+{
+    return vector_accumulate(p_points, covariance_accumulator<T, S>(),
+        [](auto & p_accumulator, const auto & p_point) { p_accumulator.add(p_point); },
+        [](auto & p_accumulator, const auto & p_other) { p_accumulator.merge(p_other); },
+        p_pool);
+}
+
+
+// Get the principal axes of accumulated points
+template<class T, std::size_t S>
+ft::math::principal_components<T, S> ft::math::principal_axes(const covariance_accumulator<T, S> & p_accumulator)
+{
+    const auto decomposition = symmetric_eigen_decompose(p_accumulator.get_covariance());
+
+    // Eigenvalues come in increasing order, reverse them
+    principal_components<T, S> result;
+    result.mean = p_accumulator.get_mean();
+    for (std::size_t i = 0; i < S; ++i)
+    {
+        result.variances[i] = decomposition.eigenvalues[S - 1 - i];
+        for (std::size_t r = 0; r < S; ++r) {
+            result.axes[r][i] = decomposition.eigenvectors[r][S - 1 - i];
+        }
+    }
+
+    // Flip the last axis of reflections
+    if constexpr (S == 2 || S == 3)
+    {
+        if (details::covariance_ns::axes_determinant(result.axes) < 0)
+        {
+            for (std::size_t r = 0; r < S; ++r) {
+                result.axes[r][S - 1] = -result.axes[r][S - 1];
+            }
+        }
+    }
+    return result;
+}
+
+
+// Get the principal axes of an array of points
+template<class T, std::size_t S>
+ft::math::principal_components<T, S> ft::math::principal_axes(
+    std::span<const vector<T, S>> p_points,
+    thread_pool & p_pool)
+{
+    return principal_axes(accumulate_covariance(p_points, p_pool));
+}
@@ -0,0 +1,140 @@
+#pragma once
+
+// k-d tree over an array of points for nearest neighbour and radius queries
+//
+// The tree is implicit: points are reordered so that the median of each range
+//  is its node, its left subtree the elements before it and its right subtree
+//  the elements after it, down to small leaf ranges scanned linearly
+// There are no child pointers, a node only stores its split axis, and every
+//  subtree is a contiguous block of points
+// Each range is split on the axis along which its points spread the most
+//
+// The subtrees below the first few splits are built in parallel on a
+//  thread_pool, the layout does not depend on the number of threads
+// Query results reference points by their index in the array the tree was
+//  built from
+
+// project headers
+#include "parallel/thread_pool.h"
+#include "vector/vector.h"
+
+// standard headers
+#include <cstddef>  // std::size_t
+#include <cstdint>
+#include <limits>
+#include <span>
+#include <vector>
+
+namespace ft {
+namespace math {
+
+// Ranges of up to this many points are leaves
+inline constexpr std::size_t kd_tree_leaf_size = 8;
+
+
+// A point found by a query
+template<class T>
+struct kd_tree_neighbour
+{
+    // Index of the point, `kd_tree<T, S>::npos` if nothing was found
+    std::uint32_t index;
+
+    // Squared distance to the query point
+    T distance2;
+};
+
+
+template<class T, std::size_t S>
+class kd_tree
+{
+public:
+    using value_type = T;
+    static constexpr auto dimensions = S;
+
+    // Marks a missing point
+    static constexpr auto npos = std::numeric_limits<std::uint32_t>::max();
+
+public:
+    // Default constructor
+    // Constructs an empty tree
+    kd_tree() = default;
+
+    // Build over an array of points
+    explicit kd_tree(std::span<const vector<T, S>> p_points, thread_pool & p_pool = default_thread_pool());
+
+
+    // Build over an array of points
+    // The points are copied, the array does not need to outlive the tree
+    void build(std::span<const vector<T, S>> p_points, thread_pool & p_pool = default_thread_pool());
+
+
+    // Returns true if the tree has no point
+    bool is_empty() const;
+
+    // Get the number of points
+    std::size_t size() const;
+
+
+    // Find the point nearest to `p_point`, no farther than `sqrt(p_max_distance2)`
+    kd_tree_neighbour<T> query_nearest(
+        const vector<T, S> & p_point,
+        const T p_max_distance2 = std::numeric_limits<T>::infinity()) const;
+
+    // Find the `p_neighbours.size()` points nearest to `p_point`, no farther than `sqrt(p_max_distance2)`
+    // They are written in increasing order of distance, ties by increasing index
+    // Returns how many were found
+    std::size_t query_knn(
+        const vector<T, S> & p_point,
+        std::span<kd_tree_neighbour<T>> p_neighbours,
+        const T p_max_distance2 = std::numeric_limits<T>::infinity()) const;
+
+    // Call `p_callback(index, distance2)` for each point within `p_radius` of `p_point`
+    // Points are visited in tree order
+    template<class F>
+    void query_radius(const vector<T, S> & p_point, const T p_radius, F && p_callback) const;
+
+
+    // Find the `p_k` points nearest to each query point
+    // The neighbours of query `q` are written to `p_neighbours[q * p_k]` and
+    //  after in increasing order of distance, their number to `p_counts[q]`
+    void query_knn_batch(
+        std::span<const vector<T, S>> p_points,
+        const std::size_t p_k,
+        std::span<kd_tree_neighbour<T>> p_neighbours,
+        std::span<std::uint32_t> p_counts,
+        thread_pool & p_pool = default_thread_pool()) const;
+
+    // Find the points within `p_radius` of each query point
+    // The neighbours of query `q` are `p_neighbours[p_offsets[q]]` up to
+    //  `p_neighbours[p_offsets[q + 1]]`, in tree order
+    // Both vectors are overwritten, `p_offsets` gets one more element than `p_points`
+    void query_radius_batch(
+        std::span<const vector<T, S>> p_points,
+        const T p_radius,
+        std::vector<kd_tree_neighbour<T>> & p_neighbours,
+        std::vector<std::size_t> & p_offsets,
+        thread_pool & p_pool = default_thread_pool()) const;
+
+private:
+    // Visit the points whose distance to `p_point` is below the bound of the visitor
+    // The visitor has `bound()` returning the current squared distance bound and
+    //  `visit(position, distance2)` called for each point within it
+    template<class V>
+    void search(const vector<T, S> & p_point, V & p_visitor) const;
+
+private:
+    // Points in tree order
+    std::vector<vector<T, S>> m_points;
+
+    // Index in the original array of each point
+    std::vector<std::uint32_t> m_indices;
+
+    // Split axis of each node, unused for leaves
+    std::vector<std::uint8_t> m_axes;
+
+};  // class kd_tree
+
+};  // namespace math
+};  // namespace ft
+
+#include "kd_tree.hpp"
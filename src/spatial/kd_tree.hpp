@@ -0,0 +1,411 @@
+#pragma once
+
+// Implements the kd_tree class of kd_tree.h
+
+// project headers
+#include "kd_tree.h"
+
+// other headers
+#include "error/ft_assert.h"
+
+// standard headers
+#include <algorithm>
+#include <array>
+#include <numeric>
+
+namespace ft {
+namespace math {
+namespace details {
+namespace kd_tree_ns {
+
+// Ranges smaller than this are never split into parallel tasks
+inline constexpr std::size_t min_task_size = 4096;
+
+// Number of tasks per thread the builder aims for
+inline constexpr std::size_t tasks_per_thread = 8;
+
+// Points copied per parallel chunk
+inline constexpr std::size_t copy_chunk_size = 16384;
+
+// Query points per parallel chunk of the batches
+inline constexpr std::size_t query_chunk_size = 64;
+
+// Stack entries needed by a search, one per level plus the one being split
+inline constexpr std::size_t stack_size = 64;
+
+
+// Range of points whose subtree is built as a separate task
+struct build_task
+{
+    std::uint32_t begin;
+    std::uint32_t end;
+};
+
+
+// Arrange the indices in [p_begin, p_end) as an implicit subtree
+// Ranges of at most `p_task_size` points are not arranged but appended to
+//  `p_tasks` when it is not null
+template<class T, std::size_t S>
+void build_range(
+    std::span<const vector<T, S>> p_points,
+    std::span<std::uint32_t> p_indices,
+    std::span<std::uint8_t> p_axes,
+    const std::uint32_t p_begin,
+    const std::uint32_t p_end,
+    std::vector<build_task> * p_tasks,
+    const std::size_t p_task_size)
+{
+    const auto count = p_end - p_begin;
+    if (count <= kd_tree_leaf_size) {
+        return;
+    }
+
+    if (p_tasks != nullptr && count <= p_task_size)
+    {
+        p_tasks->push_back({ p_begin, p_end });
+        return;
+    }
+
+    auto low = p_points[p_indices[p_begin]];
+    auto high = low;
+    for (auto i = p_begin + 1; i < p_end; ++i)
+    {
+        const auto & point = p_points[p_indices[i]];
+        for (std::size_t a = 0; a < S; ++a)
+        {
+            low[a] = (point[a] < low[a]) ? point[a] : low[a];
+            high[a] = (point[a] > high[a]) ? point[a] : high[a];
+        }
+    }
+
+    std::size_t axis = 0;
+    for (std::size_t a = 1; a < S; ++a) {
+        axis = (high[a] - low[a] > high[axis] - low[axis]) ? a : axis;
+    }
+
+    const auto median = p_begin + count / 2;
+    std::nth_element(p_indices.begin() + p_begin, p_indices.begin() + median, p_indices.begin() + p_end,
+        [&](const std::uint32_t p_a, const std::uint32_t p_b) {
+            return p_points[p_a][axis] < p_points[p_b][axis];
+        });
+    p_axes[median] = static_cast<std::uint8_t>(axis);
+
+    build_range(p_points, p_indices, p_axes, p_begin, median, p_tasks, p_task_size);
+    build_range(p_points, p_indices, p_axes, median + 1, p_end, p_tasks, p_task_size);
+}
+
+
+// Orders neighbours by distance then index
+template<class T>
+bool is_nearer(const kd_tree_neighbour<T> & p_a, const kd_tree_neighbour<T> & p_b)
+{
+    return p_a.distance2 < p_b.distance2 || (p_a.distance2 == p_b.distance2 && p_a.index < p_b.index);
+}
+
+
+// Keeps the nearest points seen in a max heap
+template<class T>
+class knn_visitor
+{
+public:
+    knn_visitor(std::span<kd_tree_neighbour<T>> p_heap, std::span<const std::uint32_t> p_indices, const T p_max_distance2) :
+        m_heap(p_heap),
+        m_indices(p_indices),
+        m_max_distance2(p_max_distance2)
+    {
+    }
+
+    T bound() const
+    {
+        return (m_count < m_heap.size()) ? m_max_distance2 : m_heap[0].distance2;
+    }
+
+    void visit(const std::size_t p_position, const T p_distance2)
+    {
+        const auto neighbour = kd_tree_neighbour<T>{ m_indices[p_position], p_distance2 };
+        if (m_count < m_heap.size())
+        {
+            m_heap[m_count++] = neighbour;
+            std::push_heap(m_heap.begin(), m_heap.begin() + m_count, is_nearer<T>);
+        }
+        else if (is_nearer(neighbour, m_heap[0]))
+        {
+            std::pop_heap(m_heap.begin(), m_heap.end(), is_nearer<T>);
+            m_heap.back() = neighbour;
+            std::push_heap(m_heap.begin(), m_heap.end(), is_nearer<T>);
+        }
+    }
+
+    // Sort the neighbours found and get their number
+    std::size_t finish()
+    {
+        std::sort_heap(m_heap.begin(), m_heap.begin() + m_count, is_nearer<T>);
+        return m_count;
+    }
+
+private:
+    std::span<kd_tree_neighbour<T>> m_heap;
+    std::span<const std::uint32_t> m_indices;
+    T m_max_distance2;
+    std::size_t m_count = 0;
+};
+
+
+// Reports every point within a fixed distance
+template<class T, class F>
+class radius_visitor
+{
+public:
+    radius_visitor(std::span<const std::uint32_t> p_indices, const T p_radius2, F & p_callback) :
+        m_indices(p_indices),
+        m_radius2(p_radius2),
+        m_callback(p_callback)
+    {
+    }
+
+    T bound() const
+    {
+        return m_radius2;
+    }
+
+    void visit(const std::size_t p_position, const T p_distance2)
+    {
+        m_callback(m_indices[p_position], p_distance2);
+    }
+
+private:
+    std::span<const std::uint32_t> m_indices;
+    T m_radius2;
+    F & m_callback;
+};
+
+};  // namespace kd_tree_ns
+};  // namespace details
+
+
+// Build over an array of points
+template<class T, std::size_t S>
+kd_tree<T, S>::kd_tree(std::span<const vector<T, S>> p_points, thread_pool & p_pool)
+{
+    build(p_points, p_pool);
+}
+
+
+// Build over an array of points
+template<class T, std::size_t S>
+void kd_tree<T, S>::build(std::span<const vector<T, S>> p_points, thread_pool & p_pool)
+{
+    using namespace details::kd_tree_ns;
+
+    FT_ASSERT(p_points.size() < npos);
+
+    const auto size = p_points.size();
+    m_points.resize(size);
+    m_indices.resize(size);
+    m_axes.assign(size, 0);
+    std::iota(m_indices.begin(), m_indices.end(), std::uint32_t{ 0 });
+
+    // The top of the tree is arranged serially, the ranges below it in parallel
+    std::vector<build_task> tasks;
+    const auto task_size = std::max(min_task_size, size / (p_pool.thread_count() * tasks_per_thread));
+    const auto parallel = p_pool.thread_count() > 1 && size > task_size;
+    build_range<T, S>(p_points, m_indices, m_axes, 0, static_cast<std::uint32_t>(size), parallel ? &tasks : nullptr, task_size);
+
+    parallel_for_chunks(tasks.size(), 1, [&](const std::size_t p_task, std::size_t, std::size_t) {
+        build_range<T, S>(p_points, m_indices, m_axes, tasks[p_task].begin, tasks[p_task].end, nullptr, 0);
+    }, p_pool);
+
+    parallel_for_chunks(size, copy_chunk_size, [&](std::size_t, const std::size_t p_begin, const std::size_t p_end)
+    {
+        for (auto i = p_begin; i < p_end; ++i) {
+            m_points[i] = p_points[m_indices[i]];
+        }
+    }, p_pool);
+}
+
+
+// Returns true if the tree has no point
+template<class T, std::size_t S>
+bool kd_tree<T, S>::is_empty() const
+{
+    return m_points.empty();
+}
+
+
+// Get the number of points
+template<class T, std::size_t S>
+std::size_t kd_tree<T, S>::size() const
+{
+    return m_points.size();
+}
+
+
+// Find the point nearest to `p_point`
+template<class T, std::size_t S>
+kd_tree_neighbour<T> kd_tree<T, S>::query_nearest(const vector<T, S> & p_point, const T p_max_distance2) const
+{
+    auto result = kd_tree_neighbour<T>{ npos, p_max_distance2 };
+    query_knn(p_point, std::span(&result, 1), p_max_distance2);
+    return result;
+}
+
+
+// Find the `p_neighbours.size()` points nearest to `p_point`
+template<class T, std::size_t S>
+std::size_t kd_tree<T, S>::query_knn(
+    const vector<T, S> & p_point,
+    std::span<kd_tree_neighbour<T>> p_neighbours,
+    const T p_max_distance2) const
+{
+    if (p_neighbours.empty()) {
+        return 0;
+    }
+
+    details::kd_tree_ns::knn_visitor<T> visitor(p_neighbours, m_indices, p_max_distance2);
+    search(p_point, visitor);
+    return visitor.finish();
+}
+
+
+// Call `p_callback(index, distance2)` for each point within `p_radius` of `p_point`
+template<class T, std::size_t S>
+template<class F>
+void kd_tree<T, S>::query_radius(const vector<T, S> & p_point, const T p_radius, F && p_callback) const
+{
+    details::kd_tree_ns::radius_visitor<T, F> visitor(m_indices, p_radius * p_radius, p_callback);
+    search(p_point, visitor);
+}
+
+
+// Find the `p_k` points nearest to each query point
+template<class T, std::size_t S>
+void kd_tree<T, S>::query_knn_batch(
+    std::span<const vector<T, S>> p_points,
+    const std::size_t p_k,
+    std::span<kd_tree_neighbour<T>> p_neighbours,
+    std::span<std::uint32_t> p_counts,
+    thread_pool & p_pool) const
+{
+    FT_ASSERT(p_neighbours.size() >= p_points.size() * p_k);
+    FT_ASSERT(p_counts.size() >= p_points.size());
+
+    parallel_for_chunks(p_points.size(), details::kd_tree_ns::query_chunk_size,
+        [&](std::size_t, const std::size_t p_begin, const std::size_t p_end)
+        {
+            for (auto q = p_begin; q < p_end; ++q) {
+                p_counts[q] = static_cast<std::uint32_t>(query_knn(p_points[q], p_neighbours.subspan(q * p_k, p_k)));
+            }
+        }, p_pool);
+}
+
+
+// Find the points within `p_radius` of each query point
+template<class T, std::size_t S>
+void kd_tree<T, S>::query_radius_batch(
+    std::span<const vector<T, S>> p_points,
+    const T p_radius,
+    std::vector<kd_tree_neighbour<T>> & p_neighbours,
+    std::vector<std::size_t> & p_offsets,
+    thread_pool & p_pool) const
+{
+    using namespace details::kd_tree_ns;
+
+    const auto size = p_points.size();
+    p_offsets.assign(size + 1, 0);
+
+    // Each chunk collects its own results, they are concatenated in chunk order
+    std::vector<std::vector<kd_tree_neighbour<T>>> found(chunk_count(size, query_chunk_size));
+    parallel_for_chunks(size, query_chunk_size, [&](const std::size_t p_chunk, const std::size_t p_begin, const std::size_t p_end)
+    {
+        auto & neighbours = found[p_chunk];
+        for (auto q = p_begin; q < p_end; ++q)
+        {
+            const auto before = neighbours.size();
+            query_radius(p_points[q], p_radius, [&](const std::uint32_t p_index, const T p_distance2) {
+                neighbours.push_back({ p_index, p_distance2 });
+            });
+            p_offsets[q + 1] = neighbours.size() - before;
+        }
+    }, p_pool);
+
+    std::partial_sum(p_offsets.begin(), p_offsets.end(), p_offsets.begin());
+    p_neighbours.resize(p_offsets[size]);
+
+    parallel_for_chunks(size, query_chunk_size, [&](const std::size_t p_chunk, const std::size_t p_begin, std::size_t) {
+        std::copy(found[p_chunk].begin(), found[p_chunk].end(), p_neighbours.begin() + p_offsets[p_begin]);
+    }, p_pool);
+}
+
+
+// Visit the points whose distance to `p_point` is below the bound of the visitor
+template<class T, std::size_t S>
+template<class V>
+void kd_tree<T, S>::search(const vector<T, S> & p_point, V & p_visitor) const
+{
+    if (m_points.empty()) {
+        return;
+    }
+
+    // Ranges left to search with a lower bound of their squared distance
+    struct range
+    {
+        std::uint32_t begin;
+        std::uint32_t end;
+        T distance2;
+    };
+    std::array<range, details::kd_tree_ns::stack_size> stack;
+    std::size_t stack_size = 0;
+    stack[stack_size++] = { 0, static_cast<std::uint32_t>(m_points.size()), static_cast<T>(0) };
+
+    while (stack_size > 0)
+    {
+        const auto current = stack[--stack_size];
+        if (current.distance2 > p_visitor.bound()) {
+            continue;
+        }
+
+        const auto count = current.end - current.begin;
+        if (count <= kd_tree_leaf_size)
+        {
+            // Leaves are contiguous, distances are computed in one pass
+            std::array<T, kd_tree_leaf_size> distances;
+            for (std::uint32_t i = 0; i < count; ++i) {
+                distances[i] = distance2(p_point, m_points[current.begin + i]);
+            }
+            for (std::uint32_t i = 0; i < count; ++i)
+            {
+                if (distances[i] <= p_visitor.bound()) {
+                    p_visitor.visit(current.begin + i, distances[i]);
+                }
+            }
+            continue;
+        }
+
+        const auto median = current.begin + count / 2;
+        const auto distance = distance2(p_point, m_points[median]);
+        if (distance <= p_visitor.bound()) {
+            p_visitor.visit(median, distance);
+        }
+
+        // Search the side of the point first, the other side is at least as far as the plane
+        const auto axis = m_axes[median];
+        const auto offset = p_point[axis] - m_points[median][axis];
+        const auto plane2 = offset * offset;
+        const auto far2 = (plane2 > current.distance2) ? plane2 : current.distance2;
+        const auto left = range{ current.begin, median, current.distance2 };
+        const auto right = range{ median + 1, current.end, current.distance2 };
+        if (offset < 0)
+        {
+            stack[stack_size++] = { right.begin, right.end, far2 };
+            stack[stack_size++] = left;
+        }
+        else
+        {
+            stack[stack_size++] = { left.begin, left.end, far2 };
+            stack[stack_size++] = right;
+        }
+    }
+}
+
+};  // namespace math
+};  // namespace ft
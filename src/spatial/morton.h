@@ -0,0 +1,72 @@
+#pragma once
+
+// Morton (Z-order) codes of 2D and 3D cells
+// The bits of the cell coordinates are interleaved, x in the lowest bit,
+//  so sorting points by code lays them out along a space filling curve and
+//  points close in space tend to be close in memory
+//
+// Uses the BMI2 pdep and pext instructions when the compiler targets them
+//  (__BMI2__), and a sequence of shifts and masks otherwise; both give the
+//  same codes
+
+// project headers
+#include "aabb.h"
+#include "parallel/thread_pool.h"
+#include "vector/vector.h"
+
+// standard headers
+#include <cstddef>  // std::size_t
+#include <cstdint>
+#include <span>
+
+namespace ft {
+namespace math {
+
+// Bits of each coordinate kept in a 64 bit code
+template<std::size_t S>
+inline constexpr std::size_t morton_bits = 64 / S;
+
+
+// Interleave the bits of a 2D or 3D cell
+// Only the low `morton_bits<S>` bits of each coordinate are used
+template<std::size_t S>
+constexpr std::uint64_t morton_encode(const vector<std::uint32_t, S> & p_cell);
+
+// Get the cell of a 2D or 3D Morton code
+template<std::size_t S>
+constexpr vector<std::uint32_t, S> morton_decode(const std::uint64_t p_code);
+
+
+// Get the cell holding a point in a grid of 2 ^ morton_bits<S> cells per axis spanning `p_bounds`
+// Points outside the bounds are clamped to the border cells
+template<class T, std::size_t S>
+vector<std::uint32_t, S> make_morton_cell(const vector<T, S> & p_point, const aabb<T, S> & p_bounds);
+
+// Get the Morton code of the cell holding a point
+template<class T, std::size_t S>
+std::uint64_t morton_encode(const vector<T, S> & p_point, const aabb<T, S> & p_bounds);
+
+
+// Compute the Morton code of each point
+// `p_codes` must be at least as large as `p_points`
+template<class T, std::size_t S>
+void morton_encode_batch(
+    std::span<const vector<T, S>> p_points,
+    const aabb<T, S> & p_bounds,
+    std::span<std::uint64_t> p_codes,
+    thread_pool & p_pool = default_thread_pool());
+
+// Get the order of the points along the Morton curve of their bounding box
+// `p_permutation[i]` is set to the index of the `i`th point along the curve,
+//  use apply_permutation to reorder the points and their attributes
+// `p_permutation` must be at least as large as `p_points`
+template<class T, std::size_t S>
+void morton_sort(
+    std::span<const vector<T, S>> p_points,
+    std::span<std::uint32_t> p_permutation,
+    thread_pool & p_pool = default_thread_pool());
+
+};  // namespace math
+};  // namespace ft
+
+#include "morton.hpp"
@@ -0,0 +1,215 @@
+#pragma once
+
+// Implements the codes of morton.h
+
+// project headers
+#include "morton.h"
+#include "parallel/radix_sort.h"
+
+// other headers
+#include "error/ft_assert.h"
+
+// standard headers
+#include <algorithm>
+#include <type_traits>
+#include <vector>
+
+#if defined(__BMI2__)
+#include <immintrin.h>
+#endif
+
+namespace ft {
+namespace math {
+namespace details {
+namespace morton_ns {
+
+// Points whose code is computed per parallel chunk
+inline constexpr std::size_t chunk_size = 16384;
+
+// Bits of the code holding the first coordinate
+template<std::size_t S>
+inline constexpr std::uint64_t axis_mask = (S == 2) ? 0x5555555555555555ull : 0x1249249249249249ull;
+
+
+// Spread the low bits of a coordinate to every `S`th bit
+template<std::size_t S>
+constexpr std::uint64_t spread_bits(const std::uint64_t p_value)
+{
+    static_assert(S == 2 || S == 3, "Morton codes are 2D or 3D");
+
+    auto x = p_value & ((std::uint64_t{ 1 } << morton_bits<S>) - 1);
+    if constexpr (S == 2)
+    {
+        x = (x | (x << 16)) & 0x0000FFFF0000FFFFull;
+        x = (x | (x << 8)) & 0x00FF00FF00FF00FFull;
+        x = (x | (x << 4)) & 0x0F0F0F0F0F0F0F0Full;
+        x = (x | (x << 2)) & 0x3333333333333333ull;
+        x = (x | (x << 1)) & 0x5555555555555555ull;
+    }
+    else
+    {
+        x = (x | (x << 32)) & 0x001F00000000FFFFull;
+        x = (x | (x << 16)) & 0x001F0000FF0000FFull;
+        x = (x | (x << 8)) & 0x100F00F00F00F00Full;
+        x = (x | (x << 4)) & 0x10C30C30C30C30C3ull;
+        x = (x | (x << 2)) & 0x1249249249249249ull;
+    }
+    return x;
+}
+
+
+// Gather every `S`th bit to the low bits
+template<std::size_t S>
+constexpr std::uint64_t compact_bits(const std::uint64_t p_value)
+{
+    static_assert(S == 2 || S == 3, "Morton codes are 2D or 3D");
+
+    auto x = p_value & axis_mask<S>;
+    if constexpr (S == 2)
+    {
+        x = (x | (x >> 1)) & 0x3333333333333333ull;
+        x = (x | (x >> 2)) & 0x0F0F0F0F0F0F0F0Full;
+        x = (x | (x >> 4)) & 0x00FF00FF00FF00FFull;
+        x = (x | (x >> 8)) & 0x0000FFFF0000FFFFull;
+        x = (x | (x >> 16)) & 0x00000000FFFFFFFFull;
+    }
+    else
+    {
+        x = (x | (x >> 2)) & 0x10C30C30C30C30C3ull;
+        x = (x | (x >> 4)) & 0x100F00F00F00F00Full;
+        x = (x | (x >> 8)) & 0x001F0000FF0000FFull;
+        x = (x | (x >> 16)) & 0x001F00000000FFFFull;
+        x = (x | (x >> 32)) & 0x00000000001FFFFFull;
+    }
+    return x;
+}
+
+};  // namespace morton_ns
+};  // namespace details
+};  // namespace math
+};  // namespace ft
+
+
+// Interleave the bits of a 2D or 3D cell
+template<std::size_t S>
+constexpr std::uint64_t ft::math::morton_encode(const vector<std::uint32_t, S> & p_cell)
+{
+    using namespace details::morton_ns;
+
+#if defined(__BMI2__)
+    if (!std::is_constant_evaluated())
+    {
+        auto result = std::uint64_t{ 0 };
+        for (std::size_t a = 0; a < S; ++a) {
+            result |= _pdep_u64(p_cell[a], axis_mask<S> << a);
+        }
+        return result;
+    }
+#endif
+
+    auto result = std::uint64_t{ 0 };
+    for (std::size_t a = 0; a < S; ++a) {
+        result |= spread_bits<S>(p_cell[a]) << a;
+    }
+    return result;
+}
+
+
+// Get the cell of a 2D or 3D Morton code
+template<std::size_t S>
+constexpr ft::math::vector<std::uint32_t, S> ft::math::morton_decode(const std::uint64_t p_code)
+{
+    using namespace details::morton_ns;
+
+    vector<std::uint32_t, S> result;
+
+#if defined(__BMI2__)
+    if (!std::is_constant_evaluated())
+    {
+        for (std::size_t a = 0; a < S; ++a) {
+            result[a] = static_cast<std::uint32_t>(_pext_u64(p_code, axis_mask<S> << a));
+        }
+        return result;
+    }
+#endif
+
+    for (std::size_t a = 0; a < S; ++a) {
+        result[a] = static_cast<std::uint32_t>(compact_bits<S>(p_code >> a));
+    }
+    return result;
+}
+
+
+// Get the cell holding a point in a grid spanning `p_bounds`
+template<class T, std::size_t S>
+ft::math::vector<std::uint32_t, S> ft::math::make_morton_cell(const vector<T, S> & p_point, const aabb<T, S> & p_bounds)
+{
+    constexpr auto cells = std::uint64_t{ 1 } << morton_bits<S>;
+    const auto extent = p_bounds.get_extent();
+
+    vector<std::uint32_t, S> result;
+    for (std::size_t a = 0; a < S; ++a)
+    {
+        const auto scale = (extent[a] > 0) ? static_cast<T>(cells) / extent[a] : static_cast<T>(0);
+        auto position = (p_point[a] - p_bounds.get_min()[a]) * scale;
+        position = (position > 0) ? position : static_cast<T>(0);
+        position = (position < static_cast<T>(cells)) ? position : static_cast<T>(cells);
+        result[a] = static_cast<std::uint32_t>(std::min(static_cast<std::uint64_t>(position), cells - 1));
+    }
+    return result;
+}
+
+
+// Get the Morton code of the cell holding a point
+template<class T, std::size_t S>
+std::uint64_t ft::math::morton_encode(const vector<T, S> & p_point, const aabb<T, S> & p_bounds)
+{
+    return morton_encode(make_morton_cell(p_point, p_bounds));
+}
+
+
+// Compute the Morton code of each point
+template<class T, std::size_t S>
+void ft::math::morton_encode_batch(
+    std::span<const vector<T, S>> p_points,
+    const aabb<T, S> & p_bounds,
+    std::span<std::uint64_t> p_codes,
+    thread_pool & p_pool)
+{
+    FT_ASSERT(p_codes.size() >= p_points.size());
+
+    parallel_for_chunks(p_points.size(), details::morton_ns::chunk_size,
+        [&](std::size_t, const std::size_t p_begin, const std::size_t p_end)
+        {
+            for (auto i = p_begin; i < p_end; ++i) {
+                p_codes[i] = morton_encode(p_points[i], p_bounds);
+            }
+        }, p_pool);
+}
+
+
+// Get the order of the points along the Morton curve of their bounding box
+template<class T, std::size_t S>
+void ft::math::morton_sort(
+    std::span<const vector<T, S>> p_points,
+    std::span<std::uint32_t> p_permutation,
+    thread_pool & p_pool)
+{
+    using namespace details::morton_ns;
+
+    FT_ASSERT(p_permutation.size() >= p_points.size());
+
+    std::vector<aabb<T, S>> chunk_bounds(chunk_count(p_points.size(), chunk_size));
+    parallel_for_chunks(p_points.size(), chunk_size, [&](const std::size_t p_chunk, const std::size_t p_begin, const std::size_t p_end) {
+        chunk_bounds[p_chunk] = make_bounding_box(p_points.subspan(p_begin, p_end - p_begin));
+    }, p_pool);
+
+    aabb<T, S> bounds;
+    for (const auto & box : chunk_bounds) {
+        bounds.expand(box);
+    }
+
+    std::vector<std::uint64_t> codes(p_points.size());
+    morton_encode_batch(p_points, bounds, std::span(codes), p_pool);
+    radix_sort(std::span<const std::uint64_t>(codes), p_permutation, p_pool);
+}
@@ -0,0 +1,211 @@
+#pragma once
+
+// Uniform grid spatial hash over an array of points for radius queries
+//
+// Space is divided in cubic cells of a fixed size, each cell is hashed to one
+//  of a power of two number of buckets, at least one per point, so the grid
+//  has no bounds and costs memory proportional to the number of points
+// Points are stored sorted by bucket, every bucket is a contiguous block of
+//  points and a table gives the start of each block
+// The hash is linear along the first axis: a row of neighbouring cells maps
+//  to consecutive buckets, a contiguous block of points
+// A query of radius up to the cell size visits 3 rows of 3 cells in 3D, points
+//  of other cells sharing a bucket are rejected by distance
+//
+// Building is a parallel counting sort in two passes with no atomics: a
+//  stable scatter on the high bits of the bucket, then a counting sort of
+//  each of the resulting 256 groups on its own
+// Rebuilding every step is intended, the buffers are kept between builds,
+//  which allocate nothing once they have grown
+// The batch queries can do the same with caller owned `spatial_hash_query_buffers`
+// Points of a bucket stay in their original order, the layout does not
+//  depend on the number of threads
+// Query results reference points by their index in the array the hash was
+//  built from, `get_indices` gives the permutation to sort point attributes
+//  in bucket order with `apply_permutation`
+
+// project headers
+#include "parallel/thread_pool.h"
+#include "vector/vector.h"
+
+// standard headers
+#include <cstddef>  // std::size_t
+#include <cstdint>
+#include <span>
+#include <type_traits>
+#include <vector>
+
+namespace ft {
+namespace math {
+
+// A point found by a query
+template<class T>
+struct spatial_hash_neighbour
+{
+    // Index of the point
+    std::uint32_t index;
+
+    // Squared distance to the query point
+    T distance2;
+};
+
+
+// Scratch buffers of the batch queries
+// Passing the same buffers to successive queries avoids their allocations,
+//  the buffers keep their largest size until destroyed
+// A query uses its buffers from several threads, queries running at the
+//  same time need their own buffers
+template<class T>
+struct spatial_hash_query_buffers
+{
+    // Results of each parallel chunk
+    std::vector<std::vector<spatial_hash_neighbour<T>>> found;
+};
+
+
+template<class T, std::size_t S>
+class spatial_hash
+{
+    static_assert(std::is_floating_point_v<T>, "Points have floating point coordinates");
+    static_assert(S == 2 || S == 3, "Spatial hashes are 2D or 3D");
+
+public:
+    using value_type = T;
+    static constexpr auto dimensions = S;
+
+public:
+    // Default constructor
+    // Constructs an empty hash
+    spatial_hash() = default;
+
+    // Build over an array of points with cells of size `p_cell_size`
+    spatial_hash(
+        std::span<const vector<T, S>> p_points,
+        const T p_cell_size,
+        thread_pool & p_pool = default_thread_pool());
+
+
+    // Build over an array of points with cells of size `p_cell_size`
+    // The points are copied, the array does not need to outlive the hash
+    // The cell size should be the largest query radius
+    void build(std::span<const vector<T, S>> p_points, const T p_cell_size, thread_pool & p_pool = default_thread_pool());
+
+
+    // Returns true if the hash has no point
+    bool is_empty() const;
+
+    // Get the number of points
+    std::size_t size() const;
+
+    // Get the size of the cells
+    T get_cell_size() const;
+
+    // Get the points in bucket order
+    std::span<const vector<T, S>> get_points() const;
+
+    // Get the index in the original array of each point in bucket order
+    std::span<const std::uint32_t> get_indices() const;
+
+
+    // Call `p_callback(index, distance2)` for each point within `p_radius` of `p_point`
+    // `p_radius` must not be larger than the cell size
+    // Points are visited in bucket order
+    template<class F>
+    void query_radius(const vector<T, S> & p_point, const T p_radius, F && p_callback) const;
+
+
+    // Find the points within `p_radius` of each query point
+    // The neighbours of query `q` are `p_neighbours[p_offsets[q]]` up to
+    //  `p_neighbours[p_offsets[q + 1]]`, in bucket order
+    // Both vectors are overwritten, `p_offsets` gets one more element than `p_points`
+    void query_radius_batch(
+        std::span<const vector<T, S>> p_points,
+        const T p_radius,
+        std::vector<spatial_hash_neighbour<T>> & p_neighbours,
+        std::vector<std::size_t> & p_offsets,
+        thread_pool & p_pool = default_thread_pool()) const;
+
+    // Find the points within `p_radius` of each query point
+    // Reuses `p_buffers` instead of allocating scratch buffers
+    void query_radius_batch(
+        std::span<const vector<T, S>> p_points,
+        const T p_radius,
+        std::vector<spatial_hash_neighbour<T>> & p_neighbours,
+        std::vector<std::size_t> & p_offsets,
+        spatial_hash_query_buffers<T> & p_buffers,
+        thread_pool & p_pool = default_thread_pool()) const;
+
+    // Find the points within `p_radius` of each point of the hash, itself included
+    // Same layout as `query_radius_batch`, query `i` is the point of index `i`
+    //  in the array the hash was built from
+    // Faster than querying the same points with `query_radius_batch`, points
+    //  are queried in bucket order so neighbouring queries share buckets
+    void build_neighbour_lists(
+        const T p_radius,
+        std::vector<spatial_hash_neighbour<T>> & p_neighbours,
+        std::vector<std::size_t> & p_offsets,
+        thread_pool & p_pool = default_thread_pool()) const;
+
+    // Find the points within `p_radius` of each point of the hash, itself included
+    // Reuses `p_buffers` instead of allocating scratch buffers
+    void build_neighbour_lists(
+        const T p_radius,
+        std::vector<spatial_hash_neighbour<T>> & p_neighbours,
+        std::vector<std::size_t> & p_offsets,
+        spatial_hash_query_buffers<T> & p_buffers,
+        thread_pool & p_pool = default_thread_pool()) const;
+
+private:
+    // Call `p_visitor(begin, end)` for each block of points that may be within
+    //  `p_radius` of `p_point`, every point is in at most one block
+    template<class V>
+    void visit_blocks(const vector<T, S> & p_point, const T p_radius, V && p_visitor) const;
+
+    // Append the points within `p_radius` of `p_point` to `p_neighbours`
+    //  starting at `p_count`, `p_neighbours` grows as needed and may end
+    //  with unused elements
+    // Returns the number of used elements
+    std::size_t collect_radius(
+        const vector<T, S> & p_point,
+        const T p_radius,
+        std::vector<spatial_hash_neighbour<T>> & p_neighbours,
+        std::size_t p_count) const;
+
+    // Get the bucket of a cell
+    std::uint32_t get_bucket(const vector<std::int32_t, S> & p_cell) const;
+
+    // Get the cell holding a point
+    vector<std::int32_t, S> get_cell(const vector<T, S> & p_point) const;
+
+private:
+    // Points in bucket order
+    std::vector<vector<T, S>> m_points;
+
+    // Index in the original array of each point
+    std::vector<std::uint32_t> m_indices;
+
+    // First point of each bucket, followed by the number of points
+    std::vector<std::uint32_t> m_bucket_starts;
+
+    // Bucket of each point and scratch buffers of the sort, kept between builds
+    std::vector<std::uint32_t> m_buckets;
+    std::vector<std::uint32_t> m_sorted_buckets;
+    std::vector<std::uint32_t> m_sorted_indices;
+    std::vector<vector<T, S>> m_sorted_points;
+
+    // Per group counts then offsets of each chunk of the build, group minor
+    std::vector<std::uint32_t> m_chunk_offsets;
+
+    // Size of the cells and its inverse
+    T m_cell_size = 1;
+    T m_inverse_cell_size = 1;
+
+    // Number of buckets minus one, a power of two minus one
+    std::uint32_t m_bucket_mask = 0;
+
+};  // class spatial_hash
+
+};  // namespace math
+};  // namespace ft
+
+#include "spatial_hash.hpp"
@@ -0,0 +1,499 @@
+#pragma once
+
+// Implements the spatial_hash class of spatial_hash.h
+
+// project headers
+#include "spatial_hash.h"
+
+// other headers
+#include "error/ft_assert.h"
+
+// standard headers
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <cmath>
+#include <limits>
+#include <numeric>
+
+namespace ft {
+namespace math {
+namespace details {
+namespace spatial_hash_ns {
+
+// Bits of the bucket index sorted by the first pass
+inline constexpr std::uint32_t group_bits = 8;
+inline constexpr std::size_t group_count = std::size_t{ 1 } << group_bits;
+
+// Points hashed or moved per parallel chunk
+inline constexpr std::size_t chunk_size = 65536;
+
+// Query points per parallel chunk of the batches
+inline constexpr std::size_t query_chunk_size = 256;
+
+// Make sure the batch query buffers have a result buffer for `p_chunks` chunks
+// Buffers are only added, the ones of earlier queries keep their capacity
+template<class T>
+void reserve_found(spatial_hash_query_buffers<T> & p_buffers, const std::size_t p_chunks)
+{
+    if (p_buffers.found.size() < p_chunks) {
+        p_buffers.found.resize(p_chunks);
+    }
+}
+
+// Per axis factors of the cell hash
+// The first is one, consecutive cells along the first axis are consecutive
+//  buckets, a row of cells is a contiguous block of points
+inline constexpr std::array<std::uint32_t, 3> hash_factors = { 1u, 73856093u, 19349663u };
+
+// Largest number of rows of cells along the first axis a query visits
+// A radius up to the cell size covers 3 cells per axis, 4 when rounding
+//  pushes the bounds of the query over a cell boundary
+template<std::size_t S>
+inline constexpr std::size_t max_query_rows = (S == 2) ? 4 : 16;
+
+
+// Consecutive buckets of a row of cells
+struct bucket_row
+{
+    std::uint32_t first;
+    std::uint32_t count;
+};
+
+};  // namespace spatial_hash_ns
+};  // namespace details
+
+
+// Build over an array of points with cells of size `p_cell_size`
+template<class T, std::size_t S>
+spatial_hash<T, S>::spatial_hash(std::span<const vector<T, S>> p_points, const T p_cell_size, thread_pool & p_pool)
+{
+    build(p_points, p_cell_size, p_pool);
+}
+
+
+// Build over an array of points with cells of size `p_cell_size`
+template<class T, std::size_t S>
+void spatial_hash<T, S>::build(std::span<const vector<T, S>> p_points, const T p_cell_size, thread_pool & p_pool)
+{
+    using namespace details::spatial_hash_ns;
+
+    FT_ASSERT(p_cell_size > 0);
+    FT_ASSERT(p_points.size() < std::numeric_limits<std::uint32_t>::max());
+
+    const auto size = p_points.size();
+    m_cell_size = p_cell_size;
+    m_inverse_cell_size = 1 / p_cell_size;
+
+    // At least one bucket per point, and enough for the groups of the first pass
+    const auto bucket_bits = std::max<std::uint32_t>(group_bits, static_cast<std::uint32_t>(std::bit_width(size)));
+    const auto bucket_count = std::size_t{ 1 } << bucket_bits;
+    const auto group_shift = bucket_bits - group_bits;
+    m_bucket_mask = static_cast<std::uint32_t>(bucket_count - 1);
+
+    m_points.resize(size);
+    m_indices.resize(size);
+    m_buckets.resize(size);
+    m_sorted_buckets.resize(size);
+    m_sorted_indices.resize(size);
+    m_sorted_points.resize(size);
+    m_bucket_starts.assign(bucket_count + 1, 0);
+    if (size == 0) {
+        return;
+    }
+
+    // Hash the points and count them per group in each chunk
+    const auto chunks = chunk_count(size, chunk_size);
+    m_chunk_offsets.resize(chunks * group_count);
+    parallel_for_chunks(size, chunk_size, [&](const std::size_t p_chunk, const std::size_t p_begin, const std::size_t p_end)
+    {
+        const auto counts = m_chunk_offsets.data() + p_chunk * group_count;
+        std::fill_n(counts, group_count, 0);
+        for (auto i = p_begin; i < p_end; ++i)
+        {
+            const auto bucket = get_bucket(get_cell(p_points[i]));
+            m_buckets[i] = bucket;
+            counts[bucket >> group_shift] += 1;
+        }
+    }, p_pool);
+
+    // Group major, chunk minor, keeps the sort stable
+    std::array<std::uint32_t, group_count + 1> group_starts;
+    std::uint32_t total = 0;
+    for (std::size_t g = 0; g < group_count; ++g)
+    {
+        group_starts[g] = total;
+        for (std::size_t c = 0; c < chunks; ++c)
+        {
+            auto & offset = m_chunk_offsets[c * group_count + g];
+            const auto count = offset;
+            offset = total;
+            total += count;
+        }
+    }
+    group_starts[group_count] = total;
+
+    // First pass, move the points to their group
+    // Moving the points now keeps the reads of the second pass sequential
+    parallel_for_chunks(size, chunk_size, [&](const std::size_t p_chunk, const std::size_t p_begin, const std::size_t p_end)
+    {
+        const auto positions = m_chunk_offsets.data() + p_chunk * group_count;
+        for (auto i = p_begin; i < p_end; ++i)
+        {
+            const auto bucket = m_buckets[i];
+            const auto position = positions[bucket >> group_shift]++;
+            m_sorted_buckets[position] = bucket;
+            m_sorted_indices[position] = static_cast<std::uint32_t>(i);
+            m_sorted_points[position] = p_points[i];
+        }
+    }, p_pool);
+
+    // Second pass, sort each group by bucket, the groups own disjoint ranges
+    //  of points and of bucket starts
+    parallel_for_chunks(group_count, 1, [&](const std::size_t p_group, std::size_t, std::size_t)
+    {
+        const auto begin = group_starts[p_group];
+        const auto end = group_starts[p_group + 1];
+        const auto first_bucket = p_group << group_shift;
+        const auto last_bucket = (p_group + 1) << group_shift;
+        const auto starts = m_bucket_starts.begin();
+
+        for (auto i = begin; i < end; ++i) {
+            starts[m_sorted_buckets[i]] += 1;
+        }
+
+        auto position = begin;
+        for (auto b = first_bucket; b < last_bucket; ++b)
+        {
+            const auto count = starts[b];
+            starts[b] = position;
+            position += count;
+        }
+
+        // Each start is advanced to the start of the next bucket
+        for (auto i = begin; i < end; ++i)
+        {
+            const auto destination = starts[m_sorted_buckets[i]]++;
+            m_indices[destination] = m_sorted_indices[i];
+            m_points[destination] = m_sorted_points[i];
+        }
+
+        for (auto b = last_bucket - 1; b > first_bucket; --b) {
+            starts[b] = starts[b - 1];
+        }
+        starts[first_bucket] = begin;
+    }, p_pool);
+
+    m_bucket_starts[bucket_count] = static_cast<std::uint32_t>(size);
+}
+
+
+// Returns true if the hash has no point
+template<class T, std::size_t S>
+bool spatial_hash<T, S>::is_empty() const
+{
+    return m_points.empty();
+}
+
+
+// Get the number of points
+template<class T, std::size_t S>
+std::size_t spatial_hash<T, S>::size() const
+{
+    return m_points.size();
+}
+
+
+// Get the size of the cells
+template<class T, std::size_t S>
+T spatial_hash<T, S>::get_cell_size() const
+{
+    return m_cell_size;
+}
+
+
+// Get the points in bucket order
+template<class T, std::size_t S>
+std::span<const vector<T, S>> spatial_hash<T, S>::get_points() const
+{
+    return m_points;
+}
+
+
+// Get the index in the original array of each point in bucket order
+template<class T, std::size_t S>
+std::span<const std::uint32_t> spatial_hash<T, S>::get_indices() const
+{
+    return m_indices;
+}
+
+
+// Call `p_callback(index, distance2)` for each point within `p_radius` of `p_point`
+template<class T, std::size_t S>
+template<class F>
+void spatial_hash<T, S>::query_radius(const vector<T, S> & p_point, const T p_radius, F && p_callback) const
+{
+    const auto radius2 = p_radius * p_radius;
+    visit_blocks(p_point, p_radius, [&](const std::uint32_t p_begin, const std::uint32_t p_end)
+    {
+        for (auto i = p_begin; i < p_end; ++i)
+        {
+            const auto d2 = distance2(m_points[i], p_point);
+            if (d2 <= radius2) {
+                p_callback(m_indices[i], d2);
+            }
+        }
+    });
+}
+
+
+// Find the points within `p_radius` of each query point
+template<class T, std::size_t S>
+void spatial_hash<T, S>::query_radius_batch(
+    std::span<const vector<T, S>> p_points,
+    const T p_radius,
+    std::vector<spatial_hash_neighbour<T>> & p_neighbours,
+    std::vector<std::size_t> & p_offsets,
+    thread_pool & p_pool) const
+{
+    spatial_hash_query_buffers<T> buffers;
+    query_radius_batch(p_points, p_radius, p_neighbours, p_offsets, buffers, p_pool);
+}
+
+
+// Find the points within `p_radius` of each query point
+template<class T, std::size_t S>
+void spatial_hash<T, S>::query_radius_batch(
+    std::span<const vector<T, S>> p_points,
+    const T p_radius,
+    std::vector<spatial_hash_neighbour<T>> & p_neighbours,
+    std::vector<std::size_t> & p_offsets,
+    spatial_hash_query_buffers<T> & p_buffers,
+    thread_pool & p_pool) const
+{
+    using namespace details::spatial_hash_ns;
+
+    const auto size = p_points.size();
+    p_offsets.assign(size + 1, 0);
+
+    // Each chunk collects its own results, they are concatenated in chunk order
+    reserve_found(p_buffers, chunk_count(size, query_chunk_size));
+    parallel_for_chunks(size, query_chunk_size, [&](const std::size_t p_chunk, const std::size_t p_begin, const std::size_t p_end)
+    {
+        auto & neighbours = p_buffers.found[p_chunk];
+        std::size_t count = 0;
+        for (auto q = p_begin; q < p_end; ++q)
+        {
+            const auto before = count;
+            count = collect_radius(p_points[q], p_radius, neighbours, count);
+            p_offsets[q + 1] = count - before;
+        }
+    }, p_pool);
+
+    std::partial_sum(p_offsets.begin(), p_offsets.end(), p_offsets.begin());
+    p_neighbours.resize(p_offsets[size]);
+
+    parallel_for_chunks(size, query_chunk_size, [&](const std::size_t p_chunk, const std::size_t p_begin, const std::size_t p_end) {
+        std::copy_n(p_buffers.found[p_chunk].begin(), p_offsets[p_end] - p_offsets[p_begin], p_neighbours.begin() + p_offsets[p_begin]);
+    }, p_pool);
+}
+
+
+// Find the points within `p_radius` of each point of the hash
+template<class T, std::size_t S>
+void spatial_hash<T, S>::build_neighbour_lists(
+    const T p_radius,
+    std::vector<spatial_hash_neighbour<T>> & p_neighbours,
+    std::vector<std::size_t> & p_offsets,
+    thread_pool & p_pool) const
+{
+    spatial_hash_query_buffers<T> buffers;
+    build_neighbour_lists(p_radius, p_neighbours, p_offsets, buffers, p_pool);
+}
+
+
+// Find the points within `p_radius` of each point of the hash
+template<class T, std::size_t S>
+void spatial_hash<T, S>::build_neighbour_lists(
+    const T p_radius,
+    std::vector<spatial_hash_neighbour<T>> & p_neighbours,
+    std::vector<std::size_t> & p_offsets,
+    spatial_hash_query_buffers<T> & p_buffers,
+    thread_pool & p_pool) const
+{
+    using namespace details::spatial_hash_ns;
+
+    const auto size = m_points.size();
+    p_offsets.assign(size + 1, 0);
+
+    // Queries run in bucket order, the counts are stored by original index
+    reserve_found(p_buffers, chunk_count(size, query_chunk_size));
+    parallel_for_chunks(size, query_chunk_size, [&](const std::size_t p_chunk, const std::size_t p_begin, const std::size_t p_end)
+    {
+        auto & neighbours = p_buffers.found[p_chunk];
+        std::size_t count = 0;
+        for (auto i = p_begin; i < p_end; ++i)
+        {
+            const auto before = count;
+            count = collect_radius(m_points[i], p_radius, neighbours, count);
+            p_offsets[m_indices[i] + 1] = count - before;
+        }
+    }, p_pool);
+
+    std::partial_sum(p_offsets.begin(), p_offsets.end(), p_offsets.begin());
+    p_neighbours.resize(p_offsets[size]);
+
+    // Scatter the list of each query to the place of its original index
+    parallel_for_chunks(size, query_chunk_size, [&](const std::size_t p_chunk, const std::size_t p_begin, const std::size_t p_end)
+    {
+        auto source = p_buffers.found[p_chunk].begin();
+        for (auto i = p_begin; i < p_end; ++i)
+        {
+            const auto index = m_indices[i];
+            const auto count = p_offsets[index + 1] - p_offsets[index];
+            std::copy_n(source, count, p_neighbours.begin() + p_offsets[index]);
+            source += count;
+        }
+    }, p_pool);
+}
+
+
+// Call `p_visitor(begin, end)` for each block of points that may be within
+//  `p_radius` of `p_point`
+template<class T, std::size_t S>
+template<class V>
+void spatial_hash<T, S>::visit_blocks(const vector<T, S> & p_point, const T p_radius, V && p_visitor) const
+{
+    FT_ASSERT(p_radius <= m_cell_size);
+
+    if (m_points.empty()) {
+        return;
+    }
+
+    auto low = p_point;
+    auto high = p_point;
+    for (std::size_t a = 0; a < S; ++a)
+    {
+        low[a] -= p_radius;
+        high[a] += p_radius;
+    }
+    const auto low_cell = get_cell(low);
+    const auto high_cell = get_cell(high);
+
+    // Rows of cells already visited, rows sharing a bucket must not report
+    //  its points twice
+    std::array<details::spatial_hash_ns::bucket_row, details::spatial_hash_ns::max_query_rows<S>> rows;
+    std::size_t row_count = 0;
+    const auto row_length = static_cast<std::uint32_t>(high_cell[0] - low_cell[0] + 1);
+
+    auto cell = low_cell;
+    while (true)
+    {
+        const auto first = get_bucket(cell);
+
+        // Distance from an earlier row to this one, the rows overlap when it
+        //  is shorter than a row
+        bool overlaps = first + row_length > m_bucket_mask + 1;
+        for (std::size_t r = 0; r < row_count; ++r)
+        {
+            overlaps |= ((first - rows[r].first) & m_bucket_mask) < row_length;
+            overlaps |= ((rows[r].first - first) & m_bucket_mask) < row_length;
+        }
+
+        if (!overlaps)
+        {
+            // Usual case, the row is one block of points
+            p_visitor(m_bucket_starts[first], m_bucket_starts[first + row_length]);
+        }
+        else
+        {
+            // Rows sharing a bucket or wrapping around the table, visit the
+            //  buckets one at a time and skip those already visited
+            for (std::uint32_t c = 0; c < row_length; ++c)
+            {
+                const auto bucket = (first + c) & m_bucket_mask;
+
+                bool visited = false;
+                for (std::size_t r = 0; r < row_count; ++r) {
+                    visited |= ((bucket - rows[r].first) & m_bucket_mask) < rows[r].count;
+                }
+                if (!visited) {
+                    p_visitor(m_bucket_starts[bucket], m_bucket_starts[bucket + 1]);
+                }
+            }
+        }
+        rows[row_count++] = { first, row_length };
+
+        // Next row of the box
+        std::size_t axis = 1;
+        while (axis < S && cell[axis] == high_cell[axis])
+        {
+            cell[axis] = low_cell[axis];
+            axis += 1;
+        }
+        if (axis == S) {
+            break;
+        }
+        cell[axis] += 1;
+    }
+}
+
+
+// Append the points within `p_radius` of `p_point` to `p_neighbours`
+template<class T, std::size_t S>
+std::size_t spatial_hash<T, S>::collect_radius(
+    const vector<T, S> & p_point,
+    const T p_radius,
+    std::vector<spatial_hash_neighbour<T>> & p_neighbours,
+    std::size_t p_count) const
+{
+    const auto radius2 = p_radius * p_radius;
+    visit_blocks(p_point, p_radius, [&](const std::uint32_t p_begin, const std::uint32_t p_end)
+    {
+        const auto needed = p_count + (p_end - p_begin);
+        if (p_neighbours.size() < needed) {
+            p_neighbours.resize(std::max(p_neighbours.size() * 2, needed));
+        }
+
+        // Every point is written and only those within the radius are kept,
+        //  a branch on the distance is mispredicted too often
+        auto * neighbours = p_neighbours.data();
+        for (auto i = p_begin; i < p_end; ++i)
+        {
+            const auto d2 = distance2(m_points[i], p_point);
+            neighbours[p_count] = { m_indices[i], d2 };
+            p_count += d2 <= radius2;
+        }
+    });
+    return p_count;
+}
+
+
+// Get the bucket of a cell
+template<class T, std::size_t S>
+std::uint32_t spatial_hash<T, S>::get_bucket(const vector<std::int32_t, S> & p_cell) const
+{
+    using namespace details::spatial_hash_ns;
+
+    std::uint32_t hash = 0;
+    for (std::size_t a = 0; a < S; ++a) {
+        hash += static_cast<std::uint32_t>(p_cell[a]) * hash_factors[a];
+    }
+    return hash & m_bucket_mask;
+}
+
+
+// Get the cell holding a point
+// The coordinates divided by the cell size must fit in 32 bit integers
+template<class T, std::size_t S>
+vector<std::int32_t, S> spatial_hash<T, S>::get_cell(const vector<T, S> & p_point) const
+{
+    vector<std::int32_t, S> result;
+    for (std::size_t a = 0; a < S; ++a) {
+        result[a] = static_cast<std::int32_t>(std::floor(p_point[a] * m_inverse_cell_size));
+    }
+    return result;
+}
+
+};  // namespace math
+};  // namespace ft
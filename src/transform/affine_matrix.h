@@ -0,0 +1,169 @@
+#pragma once
+
+// Represents an affine transform (linear part followed by translation) in
+//  `D` = 2 or 3 dimensions
+// Stored as the top `D` rows of the homogeneous matrix, a `D` by `D + 1`
+//  matrix whose last column is the translation: 12 scalars instead of the 16
+//  of a `matrix<T, 4, 4>` (6 instead of 9 in 2D), the constant last row is
+//  neither stored nor multiplied
+// Composing costs 36 multiplications in 3D instead of 64 for the 4x4 product
+//
+// Prefer `rigid_transform` or `similarity_transform` when the linear part is
+//  known to be a rotation, affine matrices also hold shears and non uniform
+//  scales
+
+// project headers
+#include "matrix/matrix.h"
+#include "rigid_transform.h"
+#include "vector/vector.h"
+#include "vector/vector_soa.h"
+
+// standard headers
+#include <cstddef>  // std::size_t
+#include <span>
+
+namespace ft {
+namespace math {
+
+template<class T, std::size_t D>
+class affine_matrix
+{
+    static_assert(D == 2 || D == 3, "Affine matrices are 2D or 3D");
+
+public:
+    using value_type = T;
+    static constexpr auto dimensions = D;
+
+    // The stored rows of the homogeneous matrix
+    using matrix_type = matrix<T, D, D + 1>;
+
+public:
+    // Default constructor
+    // Values are uninitialized
+    constexpr affine_matrix() = default;
+
+    // Construct from the top `D` rows of a homogeneous matrix
+    constexpr explicit affine_matrix(const matrix_type & p_matrix);
+
+    // Construct from a linear part and a translation
+    constexpr affine_matrix(const matrix<T, D, D> & p_linear, const vector<T, D> & p_translation);
+
+
+    // Get the top `D` rows of the homogeneous matrix
+    constexpr const matrix_type & get_matrix() const;
+
+    // Get the linear part
+    constexpr matrix<T, D, D> get_linear() const;
+
+    // Get the translation
+    constexpr vector<T, D> get_translation() const;
+
+
+    // Set the linear part
+    constexpr void set_linear(const matrix<T, D, D> & p_linear);
+
+    // Set the translation
+    constexpr void set_translation(const vector<T, D> & p_translation);
+
+
+    // Compose with another transform
+    // The result applies `p_other` first, then this transform
+    constexpr affine_matrix & operator*=(const affine_matrix & p_other);
+
+private:
+    // Linear part in the first `D` columns, translation in the last one
+    matrix_type m_matrix;
+
+};  // class affine_matrix
+
+
+// Returns the identity transform
+template<class T, std::size_t D>
+constexpr affine_matrix<T, D> make_identity_affine_matrix();
+
+// Make an affine transform from a 3x3 or 4x4 homogeneous matrix
+// The last row of the matrix is ignored, it must be (0, ..., 0, 1)
+template<class T, std::size_t S>
+constexpr affine_matrix<T, S - 1> make_affine_matrix(const matrix<T, S, S> & p_matrix);
+
+// Make an affine transform from a rigid transform
+template<class T>
+constexpr affine_matrix<T, 3> make_affine_matrix(const rigid_transform<T> & p_transform);
+
+// Make the 3x3 or 4x4 homogeneous matrix of an affine transform
+template<class T, std::size_t D>
+constexpr matrix<T, D + 1, D + 1> make_transform_matrix(const affine_matrix<T, D> & p_transform);
+
+// Make a rigid transform from an affine transform
+// The linear part must be a rotation
+template<class T>
+rigid_transform<T> make_rigid_transform(const affine_matrix<T, 3> & p_transform);
+
+
+// Compose two transforms
+// The result applies `p_right` first, then `p_left`
+template<class T, std::size_t D>
+constexpr affine_matrix<T, D> operator*(affine_matrix<T, D> p_left, const affine_matrix<T, D> & p_right);
+
+// Get the inverse of a transform
+// The linear part must be invertible
+template<class T, std::size_t D>
+constexpr affine_matrix<T, D> inverse(const affine_matrix<T, D> & p_transform);
+
+
+// Transform a point (linear part and translation)
+template<class T, std::size_t D>
+constexpr vector<T, D> transform_point(const affine_matrix<T, D> & p_transform, const vector<T, D> & p_point);
+
+// Transform a direction (linear part only)
+// Normals must be transformed by the inverse transposed linear part instead
+template<class T, std::size_t D>
+constexpr vector<T, D> transform_direction(const affine_matrix<T, D> & p_transform, const vector<T, D> & p_direction);
+
+
+// Compose arrays of transforms element by element
+// `p_result[i] = p_left[i] * p_right[i]`, `p_result` may alias either input
+template<class T, std::size_t D>
+void compose_batch(
+    std::span<const affine_matrix<T, D>> p_left,
+    std::span<const affine_matrix<T, D>> p_right,
+    std::span<affine_matrix<T, D>> p_result);
+
+// Compose arrays of transforms stored as structures of arrays element by element
+// Each array holds one element of the `D` by `D + 1` stored matrices
+// `p_result[i] = p_left[i] * p_right[i]`, `p_result` may alias either input
+template<class T, std::size_t D>
+void compose_batch(
+    const matrix_soa_span<const T, D, D + 1> & p_left,
+    const matrix_soa_span<const T, D, D + 1> & p_right,
+    const matrix_soa_span<T, D, D + 1> & p_result);
+
+// Compute world transforms from local transforms in a hierarchy
+// `p_parents[i]` is the index of the parent of transform `i`, which must be
+//  smaller than `i`, or `no_parent_transform` for roots
+template<class T, std::size_t D>
+void compose_hierarchy(
+    std::span<const affine_matrix<T, D>> p_local,
+    std::span<const std::size_t> p_parents,
+    std::span<affine_matrix<T, D>> p_world);
+
+// Transform an array of points by one transform
+// `p_result` may alias `p_points`
+template<class T, std::size_t D>
+void transform_points_batch(
+    const affine_matrix<T, D> & p_transform,
+    std::span<const vector<T, D>> p_points,
+    std::span<vector<T, D>> p_result);
+
+// Transform an array of points stored as a structure of arrays by one transform
+// `p_result` may alias `p_points`
+template<class T, std::size_t D>
+void transform_points_batch(
+    const affine_matrix<T, D> & p_transform,
+    const vector_soa_span<const T, D> & p_points,
+    const vector_soa_span<T, D> & p_result);
+
+};  // namespace math
+};  // namespace ft
+
+#include "affine_matrix.hpp"
@@ -0,0 +1,447 @@
+#pragma once
+
+// Implementation for the affine_matrix class
+
+// project headers
+#include "affine_matrix.h"
+#include "matrix/matrix_unroll.h"
+#include "quaternion/quaternion_rotation.h"
+
+// other headers
+#include "error/ft_assert.h"
+
+// standard headers
+#include <algorithm>
+#include <array>
+#include <type_traits>
+
+namespace ft {
+namespace math {
+namespace details {
+namespace affine_matrix_ns {
+
+// Matrices composed per block by the structure of arrays batch
+inline constexpr std::size_t compose_block_size = 64;
+
+
+// Compose two stored `D` by `D + 1` matrices, `p_left * p_right`
+// Fully unrolled so batches keep every element in registers
+template<class T, std::size_t D>
+constexpr matrix<T, D, D + 1> compose(const matrix<T, D, D + 1> & p_left, const matrix<T, D, D + 1> & p_right)
+{
+    constexpr auto dimensions = std::integral_constant<std::size_t, D>{};
+    constexpr auto columns = std::integral_constant<std::size_t, D + 1>{};
+
+    matrix<T, D, D + 1> result;
+    for_range(zero_index, dimensions, [&](auto row)
+    {
+        for_range(zero_index, columns, [&](auto col)
+        {
+            // The implicit last row (0, ..., 0, 1) of the right matrix adds
+            //  the left translation to the last column
+            T value = (col == D) ? p_left[row][D] : static_cast<T>(0);
+            for_range(zero_index, dimensions, [&](auto k) {
+                value += p_left[row][k] * p_right[k][col];
+            });
+            result[row][col] = value;
+        });
+    });
+    return result;
+}
+
+
+// Transform a point, or a direction if `p_translate` is false
+template<class T, std::size_t D>
+constexpr vector<T, D> transform(const matrix<T, D, D + 1> & p_matrix, const vector<T, D> & p_vector, const bool p_translate)
+{
+    vector<T, D> result;
+    for_range(zero_index, std::integral_constant<std::size_t, D>{}, [&](auto row)
+    {
+        T value = p_translate ? p_matrix[row][D] : static_cast<T>(0);
+        for_range(zero_index, std::integral_constant<std::size_t, D>{}, [&](auto k) {
+            value += p_matrix[row][k] * p_vector[k];
+        });
+        result[row] = value;
+    });
+    return result;
+}
+
+
+// Invert the linear part of a stored matrix from its adjugate
+template<class T, std::size_t D>
+constexpr matrix<T, D, D> invert_linear(const matrix<T, D, D + 1> & p_matrix)
+{
+    const auto & m = p_matrix;
+
+    matrix<T, D, D> result;
+    if constexpr (D == 2)
+    {
+        const auto determinant = m[0][0] * m[1][1] - m[0][1] * m[1][0];
+        FT_ASSERT(determinant != 0);
+        const auto inverse = 1 / determinant;
+
+        result[0][0] = m[1][1] * inverse;
+        result[0][1] = -m[0][1] * inverse;
+        result[1][0] = -m[1][0] * inverse;
+        result[1][1] = m[0][0] * inverse;
+    }
+    else
+    {
+        // Cofactors of the first column give the determinant
+        const auto c00 = m[1][1] * m[2][2] - m[1][2] * m[2][1];
+        const auto c10 = m[1][2] * m[2][0] - m[1][0] * m[2][2];
+        const auto c20 = m[1][0] * m[2][1] - m[1][1] * m[2][0];
+        const auto determinant = m[0][0] * c00 + m[0][1] * c10 + m[0][2] * c20;
+        FT_ASSERT(determinant != 0);
+        const auto inverse = 1 / determinant;
+
+        result[0][0] = c00 * inverse;
+        result[0][1] = (m[0][2] * m[2][1] - m[0][1] * m[2][2]) * inverse;
+        result[0][2] = (m[0][1] * m[1][2] - m[0][2] * m[1][1]) * inverse;
+        result[1][0] = c10 * inverse;
+        result[1][1] = (m[0][0] * m[2][2] - m[0][2] * m[2][0]) * inverse;
+        result[1][2] = (m[0][2] * m[1][0] - m[0][0] * m[1][2]) * inverse;
+        result[2][0] = c20 * inverse;
+        result[2][1] = (m[0][1] * m[2][0] - m[0][0] * m[2][1]) * inverse;
+        result[2][2] = (m[0][0] * m[1][1] - m[0][1] * m[1][0]) * inverse;
+    }
+    return result;
+}
+
+};  // namespace affine_matrix_ns
+};  // namespace details
+
+
+// Construct from the top `D` rows of a homogeneous matrix
+template<class T, std::size_t D>
+constexpr affine_matrix<T, D>::affine_matrix(const matrix_type & p_matrix) :
+    m_matrix(p_matrix)
+{ }
+
+
+// Construct from a linear part and a translation
+template<class T, std::size_t D>
+constexpr affine_matrix<T, D>::affine_matrix(const matrix<T, D, D> & p_linear, const vector<T, D> & p_translation)
+{
+    set_linear(p_linear);
+    set_translation(p_translation);
+}
+
+
+// Get the top `D` rows of the homogeneous matrix
+template<class T, std::size_t D>
+constexpr const typename affine_matrix<T, D>::matrix_type & affine_matrix<T, D>::get_matrix() const
+{
+    return m_matrix;
+}
+
+
+// Get the linear part
+template<class T, std::size_t D>
+constexpr matrix<T, D, D> affine_matrix<T, D>::get_linear() const
+{
+    matrix<T, D, D> result;
+    for (std::size_t y = 0; y < D; ++y) {
+        for (std::size_t x = 0; x < D; ++x) {
+            result[y][x] = m_matrix[y][x];
+        }
+    }
+    return result;
+}
+
+
+// Get the translation
+template<class T, std::size_t D>
+constexpr vector<T, D> affine_matrix<T, D>::get_translation() const
+{
+    vector<T, D> result;
+    for (std::size_t y = 0; y < D; ++y) {
+        result[y] = m_matrix[y][D];
+    }
+    return result;
+}
+
+
+// Set the linear part
+template<class T, std::size_t D>
+constexpr void affine_matrix<T, D>::set_linear(const matrix<T, D, D> & p_linear)
+{
+    for (std::size_t y = 0; y < D; ++y) {
+        for (std::size_t x = 0; x < D; ++x) {
+            m_matrix[y][x] = p_linear[y][x];
+        }
+    }
+}
+
+
+// Set the translation
+template<class T, std::size_t D>
+constexpr void affine_matrix<T, D>::set_translation(const vector<T, D> & p_translation)
+{
+    for (std::size_t y = 0; y < D; ++y) {
+        m_matrix[y][D] = p_translation[y];
+    }
+}
+
+
+// Compose with another transform
+// The result applies `p_other` first, then this transform
+template<class T, std::size_t D>
+constexpr affine_matrix<T, D> & affine_matrix<T, D>::operator*=(const affine_matrix & p_other)
+{
+    // (A1, t1) * (A2, t2) = (A1 * A2, A1 * t2 + t1)
+    m_matrix = details::affine_matrix_ns::compose(m_matrix, p_other.m_matrix);
+    return *this;
+}
+
+};  // namespace math
+};  // namespace ft
+
+
+// Returns the identity transform
+template<class T, std::size_t D>
+constexpr ft::math::affine_matrix<T, D> ft::math::make_identity_affine_matrix()
+{
+    matrix<T, D, D + 1> result;
+    for (std::size_t y = 0; y < D; ++y) {
+        for (std::size_t x = 0; x <= D; ++x) {
+            result[y][x] = (x == y) ? static_cast<T>(1) : static_cast<T>(0);
+        }
+    }
+    return affine_matrix<T, D>(result);
+}
+
+
+// Make an affine transform from a 3x3 or 4x4 homogeneous matrix
+template<class T, std::size_t S>
+constexpr ft::math::affine_matrix<T, S - 1> ft::math::make_affine_matrix(const matrix<T, S, S> & p_matrix)
+{
+    // The stored rows are the first rows of the homogeneous matrix
+    return affine_matrix<T, S - 1>(matrix<T, S - 1, S>(p_matrix.data()));
+}
+
+
+// Make an affine transform from a rigid transform
+template<class T>
+constexpr ft::math::affine_matrix<T, 3> ft::math::make_affine_matrix(const rigid_transform<T> & p_transform)
+{
+    return affine_matrix<T, 3>(
+        details::quaternion_rotation_ns::components_to_matrix(p_transform.get_rotation_components()),
+        p_transform.get_translation());
+}
+
+
+// Make the 3x3 or 4x4 homogeneous matrix of an affine transform
+template<class T, std::size_t D>
+constexpr ft::math::matrix<T, D + 1, D + 1> ft::math::make_transform_matrix(const affine_matrix<T, D> & p_transform)
+{
+    const auto & stored = p_transform.get_matrix();
+
+    matrix<T, D + 1, D + 1> result;
+    for (std::size_t y = 0; y < D; ++y) {
+        for (std::size_t x = 0; x <= D; ++x) {
+            result[y][x] = stored[y][x];
+        }
+    }
+    for (std::size_t x = 0; x < D; ++x) {
+        result[D][x] = 0;
+    }
+    result[D][D] = 1;
+    return result;
+}
+
+
+// Make a rigid transform from an affine transform
+template<class T>
+ft::math::rigid_transform<T> ft::math::make_rigid_transform(const affine_matrix<T, 3> & p_transform)
+{
+    return rigid_transform<T>(
+        details::quaternion_rotation_ns::matrix_to_components(p_transform.get_linear()),
+        p_transform.get_translation());
+}
+
+
+// Compose two transforms
+template<class T, std::size_t D>
+constexpr ft::math::affine_matrix<T, D> ft::math::operator*(affine_matrix<T, D> p_left, const affine_matrix<T, D> & p_right)
+{
+    p_left *= p_right;
+    return p_left;
+}
+
+
+// Get the inverse of a transform
+template<class T, std::size_t D>
+constexpr ft::math::affine_matrix<T, D> ft::math::inverse(const affine_matrix<T, D> & p_transform)
+{
+    // (A, t)^-1 = (A^-1, -(A^-1 * t))
+    const auto linear = details::affine_matrix_ns::invert_linear(p_transform.get_matrix());
+    const auto translation = p_transform.get_translation();
+
+    vector<T, D> inverse_translation;
+    for (std::size_t y = 0; y < D; ++y)
+    {
+        T value = 0;
+        for (std::size_t x = 0; x < D; ++x) {
+            value -= linear[y][x] * translation[x];
+        }
+        inverse_translation[y] = value;
+    }
+    return affine_matrix<T, D>(linear, inverse_translation);
+}
+
+
+// Transform a point (linear part and translation)
+template<class T, std::size_t D>
+constexpr ft::math::vector<T, D> ft::math::transform_point(const affine_matrix<T, D> & p_transform, const vector<T, D> & p_point)
+{
+    return details::affine_matrix_ns::transform(p_transform.get_matrix(), p_point, true);
+}
+
+
+// Transform a direction (linear part only)
+template<class T, std::size_t D>
+constexpr ft::math::vector<T, D> ft::math::transform_direction(const affine_matrix<T, D> & p_transform, const vector<T, D> & p_direction)
+{
+    return details::affine_matrix_ns::transform(p_transform.get_matrix(), p_direction, false);
+}
+
+
+// Compose arrays of transforms element by element
+template<class T, std::size_t D>
+void ft::math::compose_batch(
+    std::span<const affine_matrix<T, D>> p_left,
+    std::span<const affine_matrix<T, D>> p_right,
+    std::span<affine_matrix<T, D>> p_result)
+{
+    FT_ASSERT(p_left.size() == p_right.size());
+    FT_ASSERT(p_result.size() >= p_left.size());
+
+    for (std::size_t i = 0; i < p_left.size(); ++i) {
+        p_result[i] = p_left[i] * p_right[i];
+    }
+}
+
+
+// Compose arrays of transforms stored as structures of arrays element by element
+template<class T, std::size_t D>
+void ft::math::compose_batch(
+    const matrix_soa_span<const T, D, D + 1> & p_left,
+    const matrix_soa_span<const T, D, D + 1> & p_right,
+    const matrix_soa_span<T, D, D + 1> & p_result)
+{
+    FT_ASSERT(p_left.size() == p_right.size());
+    FT_ASSERT(p_result.size() >= p_left.size());
+
+    using namespace details::affine_matrix_ns;
+    constexpr auto elements = D * (D + 1);
+    constexpr auto element_count = std::integral_constant<std::size_t, elements>{};
+
+    std::array<const T *, elements> left;
+    std::array<const T *, elements> right;
+    std::array<T *, elements> result;
+    for (std::size_t e = 0; e < elements; ++e)
+    {
+        left[e] = p_left.component(e);
+        right[e] = p_right.component(e);
+        result[e] = p_result.component(e);
+    }
+
+    // Blocks are composed to a local buffer that can't alias the inputs, so
+    //  the compiler vectorizes across matrices, then copied to the result,
+    //  which may alias an input
+    T block[elements][compose_block_size];
+    for (std::size_t begin = 0; begin < p_left.size(); begin += compose_block_size)
+    {
+        const auto count = std::min(compose_block_size, p_left.size() - begin);
+        for (std::size_t i = 0; i < count; ++i)
+        {
+            matrix<T, D, D + 1> l;
+            matrix<T, D, D + 1> r;
+            for_range(zero_index, element_count, [&](auto e)
+            {
+                l.data()[e] = left[e][begin + i];
+                r.data()[e] = right[e][begin + i];
+            });
+
+            const auto composed = compose(l, r);
+            for_range(zero_index, element_count, [&](auto e) {
+                block[e][i] = composed.data()[e];
+            });
+        }
+
+        for (std::size_t e = 0; e < elements; ++e) {
+            std::copy_n(block[e], count, result[e] + begin);
+        }
+    }
+}
+
+
+// Compute world transforms from local transforms in a hierarchy
+template<class T, std::size_t D>
+void ft::math::compose_hierarchy(
+    std::span<const affine_matrix<T, D>> p_local,
+    std::span<const std::size_t> p_parents,
+    std::span<affine_matrix<T, D>> p_world)
+{
+    FT_ASSERT(p_parents.size() == p_local.size());
+    FT_ASSERT(p_world.size() >= p_local.size());
+
+    // Parents come first so their world transform is always ready
+    for (std::size_t i = 0; i < p_local.size(); ++i)
+    {
+        const auto parent = p_parents[i];
+        if (parent == no_parent_transform)
+        {
+            p_world[i] = p_local[i];
+        }
+        else
+        {
+            FT_ASSERT(parent < i);
+            p_world[i] = p_world[parent] * p_local[i];
+        }
+    }
+}
+
+
+// Transform an array of points by one transform
+template<class T, std::size_t D>
+void ft::math::transform_points_batch(
+    const affine_matrix<T, D> & p_transform,
+    std::span<const vector<T, D>> p_points,
+    std::span<vector<T, D>> p_result)
+{
+    FT_ASSERT(p_result.size() >= p_points.size());
+
+    const auto m = p_transform.get_matrix();
+    for (std::size_t i = 0; i < p_points.size(); ++i) {
+        p_result[i] = details::affine_matrix_ns::transform(m, p_points[i], true);
+    }
+}
+
+
+// Transform an array of points stored as a structure of arrays by one transform
+template<class T, std::size_t D>
+void ft::math::transform_points_batch(
+    const affine_matrix<T, D> & p_transform,
+    const vector_soa_span<const T, D> & p_points,
+    const vector_soa_span<T, D> & p_result)
+{
+    FT_ASSERT(p_result.size() >= p_points.size());
+
+    constexpr auto dimensions = std::integral_constant<std::size_t, D>{};
+    const auto m = p_transform.get_matrix();
+
+    for (std::size_t i = 0; i < p_points.size(); ++i)
+    {
+        vector<T, D> point;
+        for_range(zero_index, dimensions, [&](auto k) {
+            point[k] = p_points.component(k)[i];
+        });
+
+        const auto transformed = details::affine_matrix_ns::transform(m, point, true);
+        for_range(zero_index, dimensions, [&](auto k) {
+            p_result.component(k)[i] = transformed[k];
+        });
+    }
+}
@@ -0,0 +1,168 @@
+#pragma once
+
+// Represents a dual quaternion real + epsilon * dual
+// Unit dual quaternions represent rigid transforms and blend linearly
+//  without the shrinking artifacts of blended matrices, which makes them
+//  the basis of dual quaternion skinning
+// Both parts are stored as (r, i, j, k) components, 8 scalars
+
+// project headers
+#include "matrix/matrix.h"
+#include "quaternion/quaternion.h"
+#include "rigid_transform.h"
+#include "vector/vector.h"
+#include "vector/vector_soa.h"
+
+// standard headers
+#include <cstddef>  // std::size_t
+#include <cstdint>
+#include <span>
+
+namespace ft {
+namespace math {
+
+template<class T>
+class dual_quaternion
+{
+public:
+    using value_type = T;
+
+public:
+    // Default constructor
+    // Values are uninitialized
+    dual_quaternion() = default;
+
+    // Construct from the (r, i, j, k) components of the real and dual parts
+    constexpr dual_quaternion(const vector<T, 4> & p_real, const vector<T, 4> & p_dual);
+
+    // Construct from the real and dual parts
+    dual_quaternion(const quaternion<T> & p_real, const quaternion<T> & p_dual);
+
+
+    // Get the real part as (r, i, j, k) components
+    constexpr const vector<T, 4> & get_real() const;
+
+    // Get the dual part as (r, i, j, k) components
+    constexpr const vector<T, 4> & get_dual() const;
+
+    // Set the real part from (r, i, j, k) components
+    constexpr void set_real(const vector<T, 4> & p_real);
+
+    // Set the dual part from (r, i, j, k) components
+    constexpr void set_dual(const vector<T, 4> & p_dual);
+
+
+    // Addition
+    constexpr dual_quaternion & operator+=(const dual_quaternion & p_other);
+
+    // Subtraction
+    constexpr dual_quaternion & operator-=(const dual_quaternion & p_other);
+
+    // Scalar product
+    constexpr dual_quaternion & operator*=(const T p_scalar);
+
+    // Dual quaternion multiplication
+    // For unit dual quaternions the result applies `p_other` first
+    constexpr dual_quaternion & operator*=(const dual_quaternion & p_other);
+
+private:
+    // Rotation part
+    vector<T, 4> m_real;
+
+    // Translation part
+    vector<T, 4> m_dual;
+
+};  // class dual_quaternion
+
+
+// Returns the identity dual quaternion
+template<class T>
+constexpr dual_quaternion<T> make_identity_dual_quaternion();
+
+// Make the unit dual quaternion of a rigid transform
+template<class T>
+dual_quaternion<T> make_dual_quaternion(const rigid_transform<T> & p_transform);
+
+// Make the unit dual quaternion of a 4x4 matrix
+// The matrix must only contain a rotation and a translation
+template<class T>
+dual_quaternion<T> make_dual_quaternion(const matrix<T, 4, 4> & p_matrix);
+
+// Make the rigid transform of a unit dual quaternion
+template<class T>
+rigid_transform<T> make_rigid_transform(const dual_quaternion<T> & p_dual_quaternion);
+
+// Make the 4x4 matrix of a unit dual quaternion
+template<class T>
+matrix<T, 4, 4> make_transform_matrix(const dual_quaternion<T> & p_dual_quaternion);
+
+
+// Addition
+template<class T>
+constexpr dual_quaternion<T> operator+(dual_quaternion<T> p_left, const dual_quaternion<T> & p_right);
+
+// Subtraction
+template<class T>
+constexpr dual_quaternion<T> operator-(dual_quaternion<T> p_left, const dual_quaternion<T> & p_right);
+
+// Scalar product
+template<class T>
+constexpr dual_quaternion<T> operator*(dual_quaternion<T> p_left, const T p_right);
+template<class T>
+constexpr dual_quaternion<T> operator*(const T p_left, dual_quaternion<T> p_right);
+
+// Dual quaternion multiplication
+template<class T>
+constexpr dual_quaternion<T> operator*(dual_quaternion<T> p_left, const dual_quaternion<T> & p_right);
+
+
+// Get the quaternion conjugate of both parts
+// This is the inverse of a unit dual quaternion
+template<class T>
+constexpr dual_quaternion<T> conjugate(const dual_quaternion<T> & p_dual_quaternion);
+
+// Normalize the given dual quaternion
+// The real part gets a unit length and the dual part is made orthogonal to it
+template<class T>
+void normalize(dual_quaternion<T> & p_dual_quaternion);
+
+// Return a copy of the given dual quaternion but normalized
+template<class T>
+dual_quaternion<T> normalized(dual_quaternion<T> p_dual_quaternion);
+
+
+// Transform a point by a unit dual quaternion
+template<class T>
+vector<T, 3> transform_point(const dual_quaternion<T> & p_dual_quaternion, const vector<T, 3> & p_point);
+
+// Transform a direction by a unit dual quaternion (rotation only)
+template<class T>
+vector<T, 3> transform_direction(const dual_quaternion<T> & p_dual_quaternion, const vector<T, 3> & p_direction);
+
+
+// Convert an array of rigid transforms (usually a skeleton pose) to dual quaternions
+template<class T>
+void make_dual_quaternion_batch(
+    std::span<const rigid_transform<T>> p_transforms,
+    std::span<dual_quaternion<T>> p_result);
+
+// Dual quaternion skinning of a vertex stream with `B` influences per vertex
+// For each vertex the bone dual quaternions are blended by weight, with the
+//  sign of each bone picked to match the first one so that blends take the
+//  shortest path, normalized and applied to the position and normal
+// The streams are structures of arrays, an unused influence must have a zero weight
+// The loop body has no branch so it can be vectorized over vertices
+template<class T, std::size_t B>
+void dual_quaternion_skinning(
+    std::span<const dual_quaternion<T>> p_bones,
+    const vector_soa_span<const std::uint32_t, B> & p_bone_indices,
+    const vector_soa_span<const T, B> & p_bone_weights,
+    const vector_soa_span<const T, 3> & p_positions,
+    const vector_soa_span<const T, 3> & p_normals,
+    const vector_soa_span<T, 3> & p_out_positions,
+    const vector_soa_span<T, 3> & p_out_normals);
+
+};  // namespace math
+};  // namespace ft
+
+#include "dual_quaternion.hpp"
@@ -0,0 +1,407 @@
+#pragma once
+
+// Implementation for the dual_quaternion class
+
+// project headers
+#include "dual_quaternion.h"
+#include "quaternion/quaternion_rotation.h"
+#include "vector/vector_functions.h"
+
+// other headers
+#include "error/ft_assert.h"
+
+// standard headers
+#include <array>
+#include <cmath>
+
+namespace ft {
+namespace math {
+namespace details {
+namespace dual_quaternion_ns {
+
+// Get the translation of a unit dual quaternion
+// t = 2 * (dual * conjugate(real)), computed without the real part of the product
+template<class T>
+constexpr vector<T, 3> get_translation(const vector<T, 4> & p_real, const vector<T, 4> & p_dual)
+{
+    const auto [rw, rx, ry, rz] = p_real;
+    const auto [dw, dx, dy, dz] = p_dual;
+    return {
+        2 * (rw * dx - dw * rx + ry * dz - rz * dy),
+        2 * (rw * dy - dw * ry + rz * dx - rx * dz),
+        2 * (rw * dz - dw * rz + rx * dy - ry * dx)
+    };
+}
+
+};  // namespace dual_quaternion_ns
+};  // namespace details
+
+
+// Construct from the (r, i, j, k) components of the real and dual parts
+template<class T>
+constexpr dual_quaternion<T>::dual_quaternion(const vector<T, 4> & p_real, const vector<T, 4> & p_dual) :
+    m_real(p_real),
+    m_dual(p_dual)
+{ }
+
+
+// Construct from the real and dual parts
+template<class T>
+dual_quaternion<T>::dual_quaternion(const quaternion<T> & p_real, const quaternion<T> & p_dual) :
+    m_real(p_real.get_components()),
+    m_dual(p_dual.get_components())
+{ }
+
+
+// Get the real part as (r, i, j, k) components
+template<class T>
+constexpr const vector<T, 4> & dual_quaternion<T>::get_real() const
+{
+    return m_real;
+}
+
+
+// Get the dual part as (r, i, j, k) components
+template<class T>
+constexpr const vector<T, 4> & dual_quaternion<T>::get_dual() const
+{
+    return m_dual;
+}
+
+
+// Set the real part from (r, i, j, k) components
+template<class T>
+constexpr void dual_quaternion<T>::set_real(const vector<T, 4> & p_real)
+{
+    m_real = p_real;
+}
+
+
+// Set the dual part from (r, i, j, k) components
+template<class T>
+constexpr void dual_quaternion<T>::set_dual(const vector<T, 4> & p_dual)
+{
+    m_dual = p_dual;
+}
+
+
+// Addition
+template<class T>
+constexpr dual_quaternion<T> & dual_quaternion<T>::operator+=(const dual_quaternion & p_other)
+{
+    m_real += p_other.m_real;
+    m_dual += p_other.m_dual;
+    return *this;
+}
+
+
+// Subtraction
+template<class T>
+constexpr dual_quaternion<T> & dual_quaternion<T>::operator-=(const dual_quaternion & p_other)
+{
+    m_real -= p_other.m_real;
+    m_dual -= p_other.m_dual;
+    return *this;
+}
+
+
+// Scalar product
+template<class T>
+constexpr dual_quaternion<T> & dual_quaternion<T>::operator*=(const T p_scalar)
+{
+    m_real *= p_scalar;
+    m_dual *= p_scalar;
+    return *this;
+}
+
+
+// Dual quaternion multiplication
+template<class T>
+constexpr dual_quaternion<T> & dual_quaternion<T>::operator*=(const dual_quaternion & p_other)
+{
+    // (a + e * b) * (c + e * d) = a * c + e * (a * d + b * c)
+    using details::quaternion_rotation_ns::multiply_components;
+    m_dual = multiply_components(m_real, p_other.m_dual) + multiply_components(m_dual, p_other.m_real);
+    m_real = multiply_components(m_real, p_other.m_real);
+    return *this;
+}
+
+};  // namespace math
+};  // namespace ft
+
+
+// Returns the identity dual quaternion
+template<class T>
+constexpr ft::math::dual_quaternion<T> ft::math::make_identity_dual_quaternion()
+{
+    return dual_quaternion<T>(vector<T, 4>{ 1, 0, 0, 0 }, vector<T, 4>{ 0, 0, 0, 0 });
+}
+
+
+// Make the unit dual quaternion of a rigid transform
+template<class T>
+ft::math::dual_quaternion<T> ft::math::make_dual_quaternion(const rigid_transform<T> & p_transform)
+{
+    // dual = 0.5 * (0, t) * real
+    const auto & real = p_transform.get_rotation_components();
+    const auto & t = p_transform.get_translation();
+    const auto translation = vector<T, 4>{ 0, t[0], t[1], t[2] };
+    auto dual = details::quaternion_rotation_ns::multiply_components(translation, real);
+    dual *= static_cast<T>(0.5);
+    return dual_quaternion<T>(real, dual);
+}
+
+
+// Make the unit dual quaternion of a 4x4 matrix
+template<class T>
+ft::math::dual_quaternion<T> ft::math::make_dual_quaternion(const matrix<T, 4, 4> & p_matrix)
+{
+    return make_dual_quaternion(make_rigid_transform(p_matrix));
+}
+
+
+// Make the rigid transform of a unit dual quaternion
+template<class T>
+ft::math::rigid_transform<T> ft::math::make_rigid_transform(const dual_quaternion<T> & p_dual_quaternion)
+{
+    const auto & real = p_dual_quaternion.get_real();
+    return rigid_transform<T>(real, details::dual_quaternion_ns::get_translation(real, p_dual_quaternion.get_dual()));
+}
+
+
+// Make the 4x4 matrix of a unit dual quaternion
+template<class T>
+ft::math::matrix<T, 4, 4> ft::math::make_transform_matrix(const dual_quaternion<T> & p_dual_quaternion)
+{
+    return make_transform_matrix(make_rigid_transform(p_dual_quaternion));
+}
+
+
+// Addition
+template<class T>
+constexpr ft::math::dual_quaternion<T> ft::math::operator+(dual_quaternion<T> p_left, const dual_quaternion<T> & p_right)
+{
+    p_left += p_right;
+    return p_left;
+}
+
+
+// Subtraction
+template<class T>
+constexpr ft::math::dual_quaternion<T> ft::math::operator-(dual_quaternion<T> p_left, const dual_quaternion<T> & p_right)
+{
+    p_left -= p_right;
+    return p_left;
+}
+
+
+// Scalar product
+template<class T>
+constexpr ft::math::dual_quaternion<T> ft::math::operator*(dual_quaternion<T> p_left, const T p_right)
+{
+    p_left *= p_right;
+    return p_left;
+}
+
+
+// Scalar product
+template<class T>
+constexpr ft::math::dual_quaternion<T> ft::math::operator*(const T p_left, dual_quaternion<T> p_right)
+{
+    p_right *= p_left;
+    return p_right;
+}
+
+
+// Dual quaternion multiplication
+template<class T>
+constexpr ft::math::dual_quaternion<T> ft::math::operator*(dual_quaternion<T> p_left, const dual_quaternion<T> & p_right)
+{
+    p_left *= p_right;
+    return p_left;
+}
+
+
+// Get the quaternion conjugate of both parts
+template<class T>
+constexpr ft::math::dual_quaternion<T> ft::math::conjugate(const dual_quaternion<T> & p_dual_quaternion)
+{
+    return dual_quaternion<T>(
+        details::quaternion_rotation_ns::conjugate_components(p_dual_quaternion.get_real()),
+        details::quaternion_rotation_ns::conjugate_components(p_dual_quaternion.get_dual()));
+}
+
+
+// Normalize the given dual quaternion
+template<class T>
+void ft::math::normalize(dual_quaternion<T> & p_dual_quaternion)
+{
+    auto real = p_dual_quaternion.get_real();
+    auto dual = p_dual_quaternion.get_dual();
+
+    const auto l = length(real);
+    FT_ASSERT(l > 0);
+    real /= l;
+    dual /= l;
+
+    // Remove the part of the dual that is not orthogonal to the real part
+    dual -= real * vector_dot(real, dual);
+
+    p_dual_quaternion.set_real(real);
+    p_dual_quaternion.set_dual(dual);
+}
+
+
+// Return a copy of the given dual quaternion but normalized
+template<class T>
+ft::math::dual_quaternion<T> ft::math::normalized(dual_quaternion<T> p_dual_quaternion)
+{
+    normalize(p_dual_quaternion);
+    return p_dual_quaternion;
+}
+
+
+// Transform a point by a unit dual quaternion
+template<class T>
+ft::math::vector<T, 3> ft::math::transform_point(const dual_quaternion<T> & p_dual_quaternion, const vector<T, 3> & p_point)
+{
+    const auto & real = p_dual_quaternion.get_real();
+    return details::quaternion_rotation_ns::rotate_components(real, p_point) +
+        details::dual_quaternion_ns::get_translation(real, p_dual_quaternion.get_dual());
+}
+
+
+// Transform a direction by a unit dual quaternion (rotation only)
+template<class T>
+ft::math::vector<T, 3> ft::math::transform_direction(const dual_quaternion<T> & p_dual_quaternion, const vector<T, 3> & p_direction)
+{
+    return details::quaternion_rotation_ns::rotate_components(p_dual_quaternion.get_real(), p_direction);
+}
+
+
+// Convert an array of rigid transforms (usually a skeleton pose) to dual quaternions
+template<class T>
+void ft::math::make_dual_quaternion_batch(
+    std::span<const rigid_transform<T>> p_transforms,
+    std::span<dual_quaternion<T>> p_result)
+{
+    FT_ASSERT(p_result.size() >= p_transforms.size());
+
+    for (std::size_t i = 0; i < p_transforms.size(); ++i) {
+        p_result[i] = make_dual_quaternion(p_transforms[i]);
+    }
+}
+
+
+// Dual quaternion skinning of a vertex stream with `B` influences per vertex
+template<class T, std::size_t B>
+void ft::math::dual_quaternion_skinning(
+    std::span<const dual_quaternion<T>> p_bones,
+    const vector_soa_span<const std::uint32_t, B> & p_bone_indices,
+    const vector_soa_span<const T, B> & p_bone_weights,
+    const vector_soa_span<const T, 3> & p_positions,
+    const vector_soa_span<const T, 3> & p_normals,
+    const vector_soa_span<T, 3> & p_out_positions,
+    const vector_soa_span<T, 3> & p_out_normals)
+{
+    static_assert(B > 0);
+
+    const auto count = p_positions.size();
+    FT_ASSERT(p_bone_indices.size() >= count);
+    FT_ASSERT(p_bone_weights.size() >= count);
+    FT_ASSERT(p_normals.size() >= count);
+    FT_ASSERT(p_out_positions.size() >= count);
+    FT_ASSERT(p_out_normals.size() >= count);
+
+    // Hoist the stream pointers out of the loop
+    const auto bones = p_bones.data();
+    std::array<const std::uint32_t *, B> indices;
+    std::array<const T *, B> weights;
+    for (std::size_t b = 0; b < B; ++b)
+    {
+        indices[b] = p_bone_indices.component(b);
+        weights[b] = p_bone_weights.component(b);
+    }
+    const auto in_px = p_positions.component(0);
+    const auto in_py = p_positions.component(1);
+    const auto in_pz = p_positions.component(2);
+    const auto in_nx = p_normals.component(0);
+    const auto in_ny = p_normals.component(1);
+    const auto in_nz = p_normals.component(2);
+    const auto out_px = p_out_positions.component(0);
+    const auto out_py = p_out_positions.component(1);
+    const auto out_pz = p_out_positions.component(2);
+    const auto out_nx = p_out_normals.component(0);
+    const auto out_ny = p_out_normals.component(1);
+    const auto out_nz = p_out_normals.component(2);
+
+    for (std::size_t v = 0; v < count; ++v)
+    {
+        // Blend the bones
+        const auto & first = bones[indices[0][v]].get_real();
+
+        T r0 = 0, r1 = 0, r2 = 0, r3 = 0;
+        T d0 = 0, d1 = 0, d2 = 0, d3 = 0;
+        for (std::size_t b = 0; b < B; ++b)
+        {
+            const auto index = indices[b][v];
+            FT_ASSERT(index < p_bones.size());
+
+            const auto & real = bones[index].get_real();
+            const auto & dual = bones[index].get_dual();
+
+            // q and -q are the same transform, blend along the shortest path
+            const auto dot = first[0] * real[0] + first[1] * real[1] + first[2] * real[2] + first[3] * real[3];
+            const auto weight = weights[b][v];
+            const auto w = (dot < 0) ? -weight : weight;
+
+            r0 += w * real[0];
+            r1 += w * real[1];
+            r2 += w * real[2];
+            r3 += w * real[3];
+            d0 += w * dual[0];
+            d1 += w * dual[1];
+            d2 += w * dual[2];
+            d3 += w * dual[3];
+        }
+
+        // Normalize, the dual part only needs the same scale for the translation
+        const auto inverse = static_cast<T>(1 / std::sqrt(r0 * r0 + r1 * r1 + r2 * r2 + r3 * r3));
+        r0 *= inverse;
+        r1 *= inverse;
+        r2 *= inverse;
+        r3 *= inverse;
+        d0 *= inverse;
+        d1 *= inverse;
+        d2 *= inverse;
+        d3 *= inverse;
+
+        // Translation, t = 2 * (r0 * d - d0 * r + r x d)
+        const auto tx = 2 * (r0 * d1 - d0 * r1 + r2 * d3 - r3 * d2);
+        const auto ty = 2 * (r0 * d2 - d0 * r2 + r3 * d1 - r1 * d3);
+        const auto tz = 2 * (r0 * d3 - d0 * r3 + r1 * d2 - r2 * d1);
+
+        // Rotate a vector, v' = v + r0 * u + r x u with u = 2 * (r x v)
+        const auto rotate = [&](const T p_x, const T p_y, const T p_z, T & p_out_x, T & p_out_y, T & p_out_z)
+        {
+            const auto ux = 2 * (r2 * p_z - r3 * p_y);
+            const auto uy = 2 * (r3 * p_x - r1 * p_z);
+            const auto uz = 2 * (r1 * p_y - r2 * p_x);
+            p_out_x = p_x + r0 * ux + (r2 * uz - r3 * uy);
+            p_out_y = p_y + r0 * uy + (r3 * ux - r1 * uz);
+            p_out_z = p_z + r0 * uz + (r1 * uy - r2 * ux);
+        };
+
+        T px, py, pz;
+        rotate(in_px[v], in_py[v], in_pz[v], px, py, pz);
+        out_px[v] = px + tx;
+        out_py[v] = py + ty;
+        out_pz[v] = pz + tz;
+
+        T nx, ny, nz;
+        rotate(in_nx[v], in_ny[v], in_nz[v], nx, ny, nz);
+        out_nx[v] = nx;
+        out_ny[v] = ny;
+        out_nz[v] = nz;
+    }
+}
@@ -0,0 +1,160 @@
+#pragma once
+
+// Represents a rigid transform (rotation followed by translation)
+// Stored as the 4 components of a unit quaternion and a translation, 7 scalars
+//  instead of the 16 of a `matrix<T, 4, 4>`
+// Composing costs a quaternion product and a rotation, and the inverse is
+//  a conjugate and a rotation instead of a general matrix inverse
+// Transforming an array by one transform first converts its rotation to a
+//  matrix, 9 multiply-adds per element are cheaper than rotating by the
+//  quaternion once the conversion is amortized over the array
+
+// project headers
+#include "matrix/matrix.h"
+#include "quaternion/quaternion.h"
+#include "vector/vector.h"
+#include "vector/vector_soa.h"
+
+// standard headers
+#include <cstddef>  // std::size_t
+#include <limits>
+#include <span>
+
+namespace ft {
+namespace math {
+
+template<class T>
+class rigid_transform
+{
+public:
+    using value_type = T;
+
+public:
+    // Default constructor
+    // Values are uninitialized
+    rigid_transform() = default;
+
+    // Construct from a unit quaternion rotation and a translation
+    rigid_transform(const quaternion<T> & p_rotation, const vector<T, 3> & p_translation);
+
+    // Construct from unit quaternion (r, i, j, k) components and a translation
+    constexpr rigid_transform(const vector<T, 4> & p_rotation, const vector<T, 3> & p_translation);
+
+
+    // Get the rotation
+    quaternion<T> get_rotation() const;
+
+    // Get the rotation as unit quaternion (r, i, j, k) components
+    constexpr const vector<T, 4> & get_rotation_components() const;
+
+    // Get the translation
+    constexpr const vector<T, 3> & get_translation() const;
+
+
+    // Set the rotation
+    // Must be a unit quaternion
+    void set_rotation(const quaternion<T> & p_rotation);
+
+    // Set the rotation from unit quaternion (r, i, j, k) components
+    constexpr void set_rotation_components(const vector<T, 4> & p_rotation);
+
+    // Set the translation
+    constexpr void set_translation(const vector<T, 3> & p_translation);
+
+
+    // Compose with another transform
+    // The result applies `p_other` first, then this transform
+    rigid_transform & operator*=(const rigid_transform & p_other);
+
+private:
+    // Unit quaternion (r, i, j, k)
+    vector<T, 4> m_rotation;
+
+    // Applied after the rotation
+    vector<T, 3> m_translation;
+
+};  // class rigid_transform
+
+
+// Marks a root in a transform hierarchy
+inline constexpr std::size_t no_parent_transform = std::numeric_limits<std::size_t>::max();
+
+
+// Returns the identity transform
+template<class T>
+constexpr rigid_transform<T> make_identity_rigid_transform();
+
+// Make a rigid transform from a 4x4 matrix
+// The matrix must only contain a rotation and a translation
+template<class T>
+rigid_transform<T> make_rigid_transform(const matrix<T, 4, 4> & p_matrix);
+
+// Make the 4x4 matrix of a rigid transform
+template<class T>
+matrix<T, 4, 4> make_transform_matrix(const rigid_transform<T> & p_transform);
+
+
+// Compose two transforms
+// The result applies `p_right` first, then `p_left`
+template<class T>
+rigid_transform<T> operator*(rigid_transform<T> p_left, const rigid_transform<T> & p_right);
+
+// Get the inverse of a transform
+template<class T>
+rigid_transform<T> inverse(const rigid_transform<T> & p_transform);
+
+
+// Transform a point (rotation and translation)
+template<class T>
+vector<T, 3> transform_point(const rigid_transform<T> & p_transform, const vector<T, 3> & p_point);
+
+// Transform a direction (rotation only)
+template<class T>
+vector<T, 3> transform_direction(const rigid_transform<T> & p_transform, const vector<T, 3> & p_direction);
+
+
+// Compose arrays of transforms element by element
+// `p_result[i] = p_left[i] * p_right[i]`, `p_result` may alias either input
+template<class T>
+void compose_batch(
+    std::span<const rigid_transform<T>> p_left,
+    std::span<const rigid_transform<T>> p_right,
+    std::span<rigid_transform<T>> p_result);
+
+// Compute world transforms from local transforms in a hierarchy
+// `p_parents[i]` is the index of the parent of transform `i`, which must be
+//  smaller than `i`, or `no_parent_transform` for roots
+template<class T>
+void compose_hierarchy(
+    std::span<const rigid_transform<T>> p_local,
+    std::span<const std::size_t> p_parents,
+    std::span<rigid_transform<T>> p_world);
+
+// Transform an array of points by one transform
+// `p_result` may alias `p_points`
+template<class T>
+void transform_points_batch(
+    const rigid_transform<T> & p_transform,
+    std::span<const vector<T, 3>> p_points,
+    std::span<vector<T, 3>> p_result);
+
+// Transform an array of points stored as a structure of arrays by one transform
+// `p_result` may alias `p_points`
+template<class T>
+void transform_points_batch(
+    const rigid_transform<T> & p_transform,
+    const vector_soa_span<const T, 3> & p_points,
+    const vector_soa_span<T, 3> & p_result);
+
+// Transform an array of directions by one transform
+// `p_result` may alias `p_directions`
+template<class T>
+void transform_directions_batch(
+    const rigid_transform<T> & p_transform,
+    std::span<const vector<T, 3>> p_directions,
+    std::span<vector<T, 3>> p_result);
+
+};  // namespace math
+};  // namespace ft
+
+#include "rigid_transform.hpp"
@@ -0,0 +1,297 @@
+#pragma once
+
+// Implementation for the rigid_transform class
+
+// project headers
+#include "rigid_transform.h"
+#include "quaternion/quaternion_rotation.h"
+#include "vector/vector_functions.h"
+
+// other headers
+#include "error/ft_assert.h"
+
+namespace ft {
+namespace math {
+
+// Construct from a unit quaternion rotation and a translation
+template<class T>
+rigid_transform<T>::rigid_transform(const quaternion<T> & p_rotation, const vector<T, 3> & p_translation) :
+    m_rotation(p_rotation.get_components()),
+    m_translation(p_translation)
+{ }
+
+
+// Construct from unit quaternion (r, i, j, k) components and a translation
+template<class T>
+constexpr rigid_transform<T>::rigid_transform(const vector<T, 4> & p_rotation, const vector<T, 3> & p_translation) :
+    m_rotation(p_rotation),
+    m_translation(p_translation)
+{ }
+
+
+// Get the rotation
+template<class T>
+quaternion<T> rigid_transform<T>::get_rotation() const
+{
+    return quaternion<T>(m_rotation);
+}
+
+
+// Get the rotation as unit quaternion (r, i, j, k) components
+template<class T>
+constexpr const vector<T, 4> & rigid_transform<T>::get_rotation_components() const
+{
+    return m_rotation;
+}
+
+
+// Get the translation
+template<class T>
+constexpr const vector<T, 3> & rigid_transform<T>::get_translation() const
+{
+    return m_translation;
+}
+
+
+// Set the rotation
+template<class T>
+void rigid_transform<T>::set_rotation(const quaternion<T> & p_rotation)
+{
+    m_rotation = p_rotation.get_components();
+}
+
+
+// Set the rotation from unit quaternion (r, i, j, k) components
+template<class T>
+constexpr void rigid_transform<T>::set_rotation_components(const vector<T, 4> & p_rotation)
+{
+    m_rotation = p_rotation;
+}
+
+
+// Set the translation
+template<class T>
+constexpr void rigid_transform<T>::set_translation(const vector<T, 3> & p_translation)
+{
+    m_translation = p_translation;
+}
+
+
+// Compose with another transform
+// The result applies `p_other` first, then this transform
+template<class T>
+rigid_transform<T> & rigid_transform<T>::operator*=(const rigid_transform & p_other)
+{
+    // (R1, t1) * (R2, t2) = (R1 * R2, R1 * t2 + t1)
+    m_translation += details::quaternion_rotation_ns::rotate_components(m_rotation, p_other.m_translation);
+    m_rotation = details::quaternion_rotation_ns::multiply_components(m_rotation, p_other.m_rotation);
+    return *this;
+}
+
+};  // namespace math
+};  // namespace ft
+
+
+// Returns the identity transform
+template<class T>
+constexpr ft::math::rigid_transform<T> ft::math::make_identity_rigid_transform()
+{
+    return rigid_transform<T>(vector<T, 4>{ 1, 0, 0, 0 }, vector<T, 3>{ 0, 0, 0 });
+}
+
+
+// Make a rigid transform from a 4x4 matrix
+template<class T>
+ft::math::rigid_transform<T> ft::math::make_rigid_transform(const matrix<T, 4, 4> & p_matrix)
+{
+    matrix<T, 3, 3> rotation;
+    for (std::size_t y = 0; y < 3; ++y) {
+        for (std::size_t x = 0; x < 3; ++x) {
+            rotation[y][x] = p_matrix[y][x];
+        }
+    }
+
+    return rigid_transform<T>(
+        details::quaternion_rotation_ns::matrix_to_components(rotation),
+        vector<T, 3>{ p_matrix[0][3], p_matrix[1][3], p_matrix[2][3] });
+}
+
+
+// Make the 4x4 matrix of a rigid transform
+template<class T>
+ft::math::matrix<T, 4, 4> ft::math::make_transform_matrix(const rigid_transform<T> & p_transform)
+{
+    const auto rotation = details::quaternion_rotation_ns::components_to_matrix(p_transform.get_rotation_components());
+    const auto & translation = p_transform.get_translation();
+
+    matrix<T, 4, 4> result;
+    for (std::size_t y = 0; y < 3; ++y)
+    {
+        for (std::size_t x = 0; x < 3; ++x) {
+            result[y][x] = rotation[y][x];
+        }
+        result[y][3] = translation[y];
+    }
+    result[3][0] = 0;
+    result[3][1] = 0;
+    result[3][2] = 0;
+    result[3][3] = 1;
+    return result;
+}
+
+
+// Compose two transforms
+template<class T>
+ft::math::rigid_transform<T> ft::math::operator*(rigid_transform<T> p_left, const rigid_transform<T> & p_right)
+{
+    p_left *= p_right;
+    return p_left;
+}
+
+
+// Get the inverse of a transform
+template<class T>
+ft::math::rigid_transform<T> ft::math::inverse(const rigid_transform<T> & p_transform)
+{
+    // (R, t)^-1 = (R^-1, -(R^-1 * t))
+    const auto rotation = details::quaternion_rotation_ns::conjugate_components(p_transform.get_rotation_components());
+    const auto translation = details::quaternion_rotation_ns::rotate_components(rotation, p_transform.get_translation());
+    return rigid_transform<T>(rotation, -translation);
+}
+
+
+// Transform a point (rotation and translation)
+template<class T>
+ft::math::vector<T, 3> ft::math::transform_point(const rigid_transform<T> & p_transform, const vector<T, 3> & p_point)
+{
+    return transform_direction(p_transform, p_point) + p_transform.get_translation();
+}
+
+
+// Transform a direction (rotation only)
+template<class T>
+ft::math::vector<T, 3> ft::math::transform_direction(const rigid_transform<T> & p_transform, const vector<T, 3> & p_direction)
+{
+    return details::quaternion_rotation_ns::rotate_components(p_transform.get_rotation_components(), p_direction);
+}
+
+
+// Compose arrays of transforms element by element
+template<class T>
+void ft::math::compose_batch(
+    std::span<const rigid_transform<T>> p_left,
+    std::span<const rigid_transform<T>> p_right,
+    std::span<rigid_transform<T>> p_result)
+{
+    FT_ASSERT(p_left.size() == p_right.size());
+    FT_ASSERT(p_result.size() >= p_left.size());
+
+    for (std::size_t i = 0; i < p_left.size(); ++i) {
+        p_result[i] = p_left[i] * p_right[i];
+    }
+}
+
+
+// Compute world transforms from local transforms in a hierarchy
+template<class T>
+void ft::math::compose_hierarchy(
+    std::span<const rigid_transform<T>> p_local,
+    std::span<const std::size_t> p_parents,
+    std::span<rigid_transform<T>> p_world)
+{
+    FT_ASSERT(p_parents.size() == p_local.size());
+    FT_ASSERT(p_world.size() >= p_local.size());
+
+    // Parents come first so their world transform is always ready
+    for (std::size_t i = 0; i < p_local.size(); ++i)
+    {
+        const auto parent = p_parents[i];
+        if (parent == no_parent_transform)
+        {
+            p_world[i] = p_local[i];
+        }
+        else
+        {
+            FT_ASSERT(parent < i);
+            p_world[i] = p_world[parent] * p_local[i];
+        }
+    }
+}
+
+
+// Transform an array of points by one transform
+template<class T>
+void ft::math::transform_points_batch(
+    const rigid_transform<T> & p_transform,
+    std::span<const vector<T, 3>> p_points,
+    std::span<vector<T, 3>> p_result)
+{
+    FT_ASSERT(p_result.size() >= p_points.size());
+
+    const auto m = details::quaternion_rotation_ns::components_to_matrix(p_transform.get_rotation_components());
+    const auto & t = p_transform.get_translation();
+
+    for (std::size_t i = 0; i < p_points.size(); ++i)
+    {
+        const auto p = p_points[i];
+        p_result[i] = vector<T, 3>{
+            m[0][0] * p[0] + m[0][1] * p[1] + m[0][2] * p[2] + t[0],
+            m[1][0] * p[0] + m[1][1] * p[1] + m[1][2] * p[2] + t[1],
+            m[2][0] * p[0] + m[2][1] * p[1] + m[2][2] * p[2] + t[2]
+        };
+    }
+}
+
+
+// Transform an array of points stored as a structure of arrays by one transform
+template<class T>
+void ft::math::transform_points_batch(
+    const rigid_transform<T> & p_transform,
+    const vector_soa_span<const T, 3> & p_points,
+    const vector_soa_span<T, 3> & p_result)
+{
+    FT_ASSERT(p_result.size() >= p_points.size());
+
+    const auto m = details::quaternion_rotation_ns::components_to_matrix(p_transform.get_rotation_components());
+    const auto & t = p_transform.get_translation();
+
+    const auto in_x = p_points.component(0);
+    const auto in_y = p_points.component(1);
+    const auto in_z = p_points.component(2);
+    const auto out_x = p_result.component(0);
+    const auto out_y = p_result.component(1);
+    const auto out_z = p_result.component(2);
+
+    for (std::size_t i = 0; i < p_points.size(); ++i)
+    {
+        const auto x = in_x[i];
+        const auto y = in_y[i];
+        const auto z = in_z[i];
+        out_x[i] = m[0][0] * x + m[0][1] * y + m[0][2] * z + t[0];
+        out_y[i] = m[1][0] * x + m[1][1] * y + m[1][2] * z + t[1];
+        out_z[i] = m[2][0] * x + m[2][1] * y + m[2][2] * z + t[2];
+    }
+}
+
+
+// Transform an array of directions by one transform
+template<class T>
+void ft::math::transform_directions_batch(
+    const rigid_transform<T> & p_transform,
+    std::span<const vector<T, 3>> p_directions,
+    std::span<vector<T, 3>> p_result)
+{
+    FT_ASSERT(p_result.size() >= p_directions.size());
+
+    const auto m = details::quaternion_rotation_ns::components_to_matrix(p_transform.get_rotation_components());
+
+    for (std::size_t i = 0; i < p_directions.size(); ++i)
+    {
+        const auto d = p_directions[i];
+        p_result[i] = vector<T, 3>{
+            m[0][0] * d[0] + m[0][1] * d[1] + m[0][2] * d[2],
+            m[1][0] * d[0] + m[1][1] * d[1] + m[1][2] * d[2],
+            m[2][0] * d[0] + m[2][1] * d[1] + m[2][2] * d[2]
+        };
+    }
+}
@@ -0,0 +1,155 @@
+#pragma once
+
+// Represents a similarity transform (uniform scale, then rotation, then translation)
+// Stored as the 4 components of a unit quaternion, a translation and a scale,
+//  8 scalars instead of the 16 of a `matrix<T, 4, 4>`
+
+// project headers
+#include "matrix/matrix.h"
+#include "quaternion/quaternion.h"
+#include "rigid_transform.h"
+#include "vector/vector.h"
+#include "vector/vector_soa.h"
+
+// standard headers
+#include <cstddef>  // std::size_t
+#include <span>
+
+namespace ft {
+namespace math {
+
+template<class T>
+class similarity_transform
+{
+public:
+    using value_type = T;
+
+public:
+    // Default constructor
+    // Values are uninitialized
+    similarity_transform() = default;
+
+    // Construct from a unit quaternion rotation, a translation and a uniform scale
+    similarity_transform(const quaternion<T> & p_rotation, const vector<T, 3> & p_translation, const T p_scale);
+
+    // Construct from unit quaternion (r, i, j, k) components, a translation and a uniform scale
+    constexpr similarity_transform(const vector<T, 4> & p_rotation, const vector<T, 3> & p_translation, const T p_scale);
+
+    // Construct from a rigid transform, with a scale of 1
+    constexpr similarity_transform(const rigid_transform<T> & p_transform);
+
+
+    // Get the rotation
+    quaternion<T> get_rotation() const;
+
+    // Get the rotation as unit quaternion (r, i, j, k) components
+    constexpr const vector<T, 4> & get_rotation_components() const;
+
+    // Get the translation
+    constexpr const vector<T, 3> & get_translation() const;
+
+    // Get the uniform scale
+    constexpr T get_scale() const;
+
+
+    // Set the rotation
+    // Must be a unit quaternion
+    void set_rotation(const quaternion<T> & p_rotation);
+
+    // Set the rotation from unit quaternion (r, i, j, k) components
+    constexpr void set_rotation_components(const vector<T, 4> & p_rotation);
+
+    // Set the translation
+    constexpr void set_translation(const vector<T, 3> & p_translation);
+
+    // Set the uniform scale
+    // Must not be zero
+    constexpr void set_scale(const T p_scale);
+
+
+    // Compose with another transform
+    // The result applies `p_other` first, then this transform
+    similarity_transform & operator*=(const similarity_transform & p_other);
+
+private:
+    // Unit quaternion (r, i, j, k)
+    vector<T, 4> m_rotation;
+
+    // Applied after the rotation
+    vector<T, 3> m_translation;
+
+    // Applied before the rotation
+    T m_scale;
+
+};  // class similarity_transform
+
+
+// Returns the identity transform
+template<class T>
+constexpr similarity_transform<T> make_identity_similarity_transform();
+
+// Make the 4x4 matrix of a similarity transform
+template<class T>
+matrix<T, 4, 4> make_transform_matrix(const similarity_transform<T> & p_transform);
+
+// Drop the scale of a similarity transform
+template<class T>
+constexpr rigid_transform<T> make_rigid_transform(const similarity_transform<T> & p_transform);
+
+
+// Compose two transforms
+// The result applies `p_right` first, then `p_left`
+template<class T>
+similarity_transform<T> operator*(similarity_transform<T> p_left, const similarity_transform<T> & p_right);
+
+// Get the inverse of a transform
+template<class T>
+similarity_transform<T> inverse(const similarity_transform<T> & p_transform);
+
+
+// Transform a point (scale, rotation and translation)
+template<class T>
+vector<T, 3> transform_point(const similarity_transform<T> & p_transform, const vector<T, 3> & p_point);
+
+// Transform a direction (rotation only, the length is preserved)
+template<class T>
+vector<T, 3> transform_direction(const similarity_transform<T> & p_transform, const vector<T, 3> & p_direction);
+
+
+// Compose arrays of transforms element by element
+// `p_result[i] = p_left[i] * p_right[i]`, `p_result` may alias either input
+template<class T>
+void compose_batch(
+    std::span<const similarity_transform<T>> p_left,
+    std::span<const similarity_transform<T>> p_right,
+    std::span<similarity_transform<T>> p_result);
+
+// Compute world transforms from local transforms in a hierarchy
+// `p_parents[i]` is the index of the parent of transform `i`, which must be
+//  smaller than `i`, or `no_parent_transform` for roots
+template<class T>
+void compose_hierarchy(
+    std::span<const similarity_transform<T>> p_local,
+    std::span<const std::size_t> p_parents,
+    std::span<similarity_transform<T>> p_world);
+
+// Transform an array of points by one transform
+// `p_result` may alias `p_points`
+template<class T>
+void transform_points_batch(
+    const similarity_transform<T> & p_transform,
+    std::span<const vector<T, 3>> p_points,
+    std::span<vector<T, 3>> p_result);
+
+// Transform an array of points stored as a structure of arrays by one transform
+// `p_result` may alias `p_points`
+template<class T>
+void transform_points_batch(
+    const similarity_transform<T> & p_transform,
+    const vector_soa_span<const T, 3> & p_points,
+    const vector_soa_span<T, 3> & p_result);
+
+};  // namespace math
+};  // namespace ft
+
+#include "similarity_transform.hpp"
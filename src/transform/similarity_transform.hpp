@@ -0,0 +1,291 @@
+#pragma once
+
+// Implementation for the similarity_transform class
+
+// project headers
+#include "similarity_transform.h"
+#include "quaternion/quaternion_rotation.h"
+#include "vector/vector_functions.h"
+
+// other headers
+#include "error/ft_assert.h"
+
+namespace ft {
+namespace math {
+
+// Construct from a unit quaternion rotation, a translation and a uniform scale
+template<class T>
+similarity_transform<T>::similarity_transform(const quaternion<T> & p_rotation, const vector<T, 3> & p_translation, const T p_scale) :
+    m_rotation(p_rotation.get_components()),
+    m_translation(p_translation),
+    m_scale(p_scale)
+{ }
+
+
+// Construct from unit quaternion (r, i, j, k) components, a translation and a uniform scale
+template<class T>
+constexpr similarity_transform<T>::similarity_transform(const vector<T, 4> & p_rotation, const vector<T, 3> & p_translation, const T p_scale) :
+    m_rotation(p_rotation),
+    m_translation(p_translation),
+    m_scale(p_scale)
+{ }
+
+
+// Construct from a rigid transform, with a scale of 1
+template<class T>
+constexpr similarity_transform<T>::similarity_transform(const rigid_transform<T> & p_transform) :
+    m_rotation(p_transform.get_rotation_components()),
+    m_translation(p_transform.get_translation()),
+    m_scale(1)
+{ }
+
+
+// Get the rotation
+template<class T>
+quaternion<T> similarity_transform<T>::get_rotation() const
+{
+    return quaternion<T>(m_rotation);
+}
+
+
+// Get the rotation as unit quaternion (r, i, j, k) components
+template<class T>
+constexpr const vector<T, 4> & similarity_transform<T>::get_rotation_components() const
+{
+    return m_rotation;
+}
+
+
+// Get the translation
+template<class T>
+constexpr const vector<T, 3> & similarity_transform<T>::get_translation() const
+{
+    return m_translation;
+}
+
+
+// Get the uniform scale
+template<class T>
+constexpr T similarity_transform<T>::get_scale() const
+{
+    return m_scale;
+}
+
+
+// Set the rotation
+template<class T>
+void similarity_transform<T>::set_rotation(const quaternion<T> & p_rotation)
+{
+    m_rotation = p_rotation.get_components();
+}
+
+
+// Set the rotation from unit quaternion (r, i, j, k) components
+template<class T>
+constexpr void similarity_transform<T>::set_rotation_components(const vector<T, 4> & p_rotation)
+{
+    m_rotation = p_rotation;
+}
+
+
+// Set the translation
+template<class T>
+constexpr void similarity_transform<T>::set_translation(const vector<T, 3> & p_translation)
+{
+    m_translation = p_translation;
+}
+
+
+// Set the uniform scale
+template<class T>
+constexpr void similarity_transform<T>::set_scale(const T p_scale)
+{
+    FT_ASSERT(p_scale != 0);
+    m_scale = p_scale;
+}
+
+
+// Compose with another transform
+// The result applies `p_other` first, then this transform
+template<class T>
+similarity_transform<T> & similarity_transform<T>::operator*=(const similarity_transform & p_other)
+{
+    // (s1, R1, t1) * (s2, R2, t2) = (s1 * s2, R1 * R2, s1 * R1 * t2 + t1)
+    m_translation += details::quaternion_rotation_ns::rotate_components(m_rotation, p_other.m_translation) * m_scale;
+    m_rotation = details::quaternion_rotation_ns::multiply_components(m_rotation, p_other.m_rotation);
+    m_scale *= p_other.m_scale;
+    return *this;
+}
+
+};  // namespace math
+};  // namespace ft
+
+
+// Returns the identity transform
+template<class T>
+constexpr ft::math::similarity_transform<T> ft::math::make_identity_similarity_transform()
+{
+    return similarity_transform<T>(vector<T, 4>{ 1, 0, 0, 0 }, vector<T, 3>{ 0, 0, 0 }, 1);
+}
+
+
+// Make the 4x4 matrix of a similarity transform
+template<class T>
+ft::math::matrix<T, 4, 4> ft::math::make_transform_matrix(const similarity_transform<T> & p_transform)
+{
+    auto result = make_transform_matrix(make_rigid_transform(p_transform));
+    const auto scale = p_transform.get_scale();
+    for (std::size_t y = 0; y < 3; ++y) {
+        for (std::size_t x = 0; x < 3; ++x) {
+            result[y][x] *= scale;
+        }
+    }
+    return result;
+}
+
+
+// Drop the scale of a similarity transform
+template<class T>
+constexpr ft::math::rigid_transform<T> ft::math::make_rigid_transform(const similarity_transform<T> & p_transform)
+{
+    return rigid_transform<T>(p_transform.get_rotation_components(), p_transform.get_translation());
+}
+
+
+// Compose two transforms
+template<class T>
+ft::math::similarity_transform<T> ft::math::operator*(similarity_transform<T> p_left, const similarity_transform<T> & p_right)
+{
+    p_left *= p_right;
+    return p_left;
+}
+
+
+// Get the inverse of a transform
+template<class T>
+ft::math::similarity_transform<T> ft::math::inverse(const similarity_transform<T> & p_transform)
+{
+    // (s, R, t)^-1 = (1 / s, R^-1, -(R^-1 * t) / s)
+    const auto scale = static_cast<T>(1) / p_transform.get_scale();
+    const auto rotation = details::quaternion_rotation_ns::conjugate_components(p_transform.get_rotation_components());
+    const auto translation = details::quaternion_rotation_ns::rotate_components(rotation, p_transform.get_translation());
+    return similarity_transform<T>(rotation, translation * -scale, scale);
+}
+
+
+// Transform a point (scale, rotation and translation)
+template<class T>
+ft::math::vector<T, 3> ft::math::transform_point(const similarity_transform<T> & p_transform, const vector<T, 3> & p_point)
+{
+    return transform_direction(p_transform, p_point) * p_transform.get_scale() + p_transform.get_translation();
+}
+
+
+// Transform a direction (rotation only, the length is preserved)
+template<class T>
+ft::math::vector<T, 3> ft::math::transform_direction(const similarity_transform<T> & p_transform, const vector<T, 3> & p_direction)
+{
+    return details::quaternion_rotation_ns::rotate_components(p_transform.get_rotation_components(), p_direction);
+}
+
+
+// Compose arrays of transforms element by element
+template<class T>
+void ft::math::compose_batch(
+    std::span<const similarity_transform<T>> p_left,
+    std::span<const similarity_transform<T>> p_right,
+    std::span<similarity_transform<T>> p_result)
+{
+    FT_ASSERT(p_left.size() == p_right.size());
+    FT_ASSERT(p_result.size() >= p_left.size());
+
+    for (std::size_t i = 0; i < p_left.size(); ++i) {
+        p_result[i] = p_left[i] * p_right[i];
+    }
+}
+
+
+// Compute world transforms from local transforms in a hierarchy
+template<class T>
+void ft::math::compose_hierarchy(
+    std::span<const similarity_transform<T>> p_local,
+    std::span<const std::size_t> p_parents,
+    std::span<similarity_transform<T>> p_world)
+{
+    FT_ASSERT(p_parents.size() == p_local.size());
+    FT_ASSERT(p_world.size() >= p_local.size());
+
+    // Parents come first so their world transform is always ready
+    for (std::size_t i = 0; i < p_local.size(); ++i)
+    {
+        const auto parent = p_parents[i];
+        if (parent == no_parent_transform)
+        {
+            p_world[i] = p_local[i];
+        }
+        else
+        {
+            FT_ASSERT(parent < i);
+            p_world[i] = p_world[parent] * p_local[i];
+        }
+    }
+}
+
+
+// Transform an array of points by one transform
+template<class T>
+void ft::math::transform_points_batch(
+    const similarity_transform<T> & p_transform,
+    std::span<const vector<T, 3>> p_points,
+    std::span<vector<T, 3>> p_result)
+{
+    FT_ASSERT(p_result.size() >= p_points.size());
+
+    // Fold the scale into a rotation matrix once for the whole array
+    auto m = details::quaternion_rotation_ns::components_to_matrix(p_transform.get_rotation_components());
+    m *= p_transform.get_scale();
+    const auto & t = p_transform.get_translation();
+
+    for (std::size_t i = 0; i < p_points.size(); ++i)
+    {
+        const auto p = p_points[i];
+        p_result[i] = vector<T, 3>{
+            m[0][0] * p[0] + m[0][1] * p[1] + m[0][2] * p[2] + t[0],
+            m[1][0] * p[0] + m[1][1] * p[1] + m[1][2] * p[2] + t[1],
+            m[2][0] * p[0] + m[2][1] * p[1] + m[2][2] * p[2] + t[2]
+        };
+    }
+}
+
+
+// Transform an array of points stored as a structure of arrays by one transform
+template<class T>
+void ft::math::transform_points_batch(
+    const similarity_transform<T> & p_transform,
+    const vector_soa_span<const T, 3> & p_points,
+    const vector_soa_span<T, 3> & p_result)
+{
+    FT_ASSERT(p_result.size() >= p_points.size());
+
+    // Fold the scale into a rotation matrix once for the whole array
+    auto m = details::quaternion_rotation_ns::components_to_matrix(p_transform.get_rotation_components());
+    m *= p_transform.get_scale();
+    const auto & t = p_transform.get_translation();
+
+    const auto in_x = p_points.component(0);
+    const auto in_y = p_points.component(1);
+    const auto in_z = p_points.component(2);
+    const auto out_x = p_result.component(0);
+    const auto out_y = p_result.component(1);
+    const auto out_z = p_result.component(2);
+
+    for (std::size_t i = 0; i < p_points.size(); ++i)
+    {
+        const auto x = in_x[i];
+        const auto y = in_y[i];
+        const auto z = in_z[i];
+        out_x[i] = m[0][0] * x + m[0][1] * y + m[0][2] * z + t[0];
+        out_y[i] = m[1][0] * x + m[1][1] * y + m[1][2] * z + t[1];
+        out_z[i] = m[2][0] * x + m[2][1] * y + m[2][2] * z + t[2];
+    }
+}
@@ -0,0 +1,128 @@
+#pragma once
+
+// Compact fixed size encodings of unit vectors and positions
+//
+// Unit vectors use the octahedral mapping: the sphere is projected on the
+//  octahedron |x| + |y| + |z| = 1, whose lower half is folded over the upper
+//  half to fill a square quantized with `B / 2` bits per axis
+// Worst case angle between a unit vector and its decoded value, measured
+//  over dense samples of the sphere:
+//  - 16 bits: 0.017 rad (0.95 degrees)
+//  - 24 bits: 1.0e-3 rad (0.059 degrees)
+//  - 32 bits: 6.5e-5 rad (0.0037 degrees)
+//
+// Positions are quantized on a regular grid spanning a bounding box with
+//  `B` bits per axis, the worst case error on an axis is half a cell,
+//  `extent / (2 ^ B - 1) / 2`, points outside the box are clamped to it
+//
+// Codes are held in the smallest unsigned integer fitting them, a 24 bit
+//  code in 32 bits and a 48 bit code in 64 bits
+// Byte streams store codes packed in `B / 8` bytes each, little endian and
+//  without padding, the batches taking a `std::span<std::byte>` read and
+//  write these so 24 and 48 bit codes take 3 and 6 bytes
+//
+// Batches are written without branches so the compiler can vectorize them
+
+// project headers
+#include "vector.h"
+#include "vector_soa.h"
+#include "spatial/aabb.h"
+
+// standard headers
+#include <cstddef>  // std::size_t
+#include <cstdint>
+#include <span>
+#include <type_traits>
+
+namespace ft {
+namespace math {
+
+// Smallest unsigned integer holding a `B` bit code
+template<std::size_t B>
+using quantized_code = std::conditional_t<(B <= 8), std::uint8_t,
+    std::conditional_t<(B <= 16), std::uint16_t,
+    std::conditional_t<(B <= 32), std::uint32_t, std::uint64_t>>>;
+
+// Bytes taken by a packed `B` bit code
+template<std::size_t B>
+inline constexpr std::size_t packed_code_size = B / 8;
+
+
+// Write a `B` bit code to the first `packed_code_size<B>` bytes of `p_bytes`
+template<std::size_t B>
+void store_packed_code(const quantized_code<B> p_code, std::byte * p_bytes);
+
+// Read a `B` bit code from the first `packed_code_size<B>` bytes of `p_bytes`
+template<std::size_t B>
+quantized_code<B> load_packed_code(const std::byte * p_bytes);
+
+
+// Encode a unit vector in `B` bits, `B` being 16, 24 or 32
+template<std::size_t B, class T>
+quantized_code<B> encode_octahedral(const vector<T, 3> & p_vector);
+
+// Decode a unit vector encoded in `B` bits
+// The result is normalized
+template<std::size_t B, class T>
+vector<T, 3> decode_octahedral(const quantized_code<B> p_code);
+
+
+// Encode an array of unit vectors in `B` bits each
+// `p_codes` must be at least as large as `p_vectors`
+template<std::size_t B, class T>
+void encode_octahedral_batch(
+    const vector_soa_span<const T, 3> & p_vectors,
+    std::span<quantized_code<B>> p_codes);
+
+// Decode an array of unit vectors encoded in `B` bits each
+// `p_results` must be at least as large as `p_codes`
+template<std::size_t B, class T>
+void decode_octahedral_batch(
+    std::span<const quantized_code<B>> p_codes,
+    const vector_soa_span<T, 3> & p_results);
+
+// Encode an array of unit vectors to a stream of packed `B` bit codes
+// `p_bytes` must hold at least `packed_code_size<B>` bytes per vector
+template<std::size_t B, class T>
+void encode_octahedral_batch(
+    const vector_soa_span<const T, 3> & p_vectors,
+    std::span<std::byte> p_bytes);
+
+// Decode a stream of packed `B` bit codes to an array of unit vectors
+// `p_bytes` holds whole codes, `p_results` must have one vector per code
+template<std::size_t B, class T>
+void decode_octahedral_batch(
+    std::span<const std::byte> p_bytes,
+    const vector_soa_span<T, 3> & p_results);
+
+
+// Quantize a position in `p_bounds` with `B` bits per axis, `B` being at most 32
+// `p_bounds` must not be empty
+template<std::size_t B, class T, std::size_t S>
+vector<quantized_code<B>, S> quantize_position(const vector<T, S> & p_position, const aabb<T, S> & p_bounds);
+
+// Get the position of quantized coordinates in `p_bounds`
+template<std::size_t B, class T, std::size_t S>
+vector<T, S> dequantize_position(const vector<quantized_code<B>, S> & p_coordinates, const aabb<T, S> & p_bounds);
+
+
+// Quantize an array of positions in `p_bounds` with `B` bits per axis
+// `p_results` must be at least as large as `p_positions`
+template<std::size_t B, class T, std::size_t S>
+void quantize_positions_batch(
+    std::span<const vector<T, S>> p_positions,
+    const aabb<T, S> & p_bounds,
+    std::span<vector<quantized_code<B>, S>> p_results);
+
+// Get the positions of an array of quantized coordinates in `p_bounds`
+// `p_results` must be at least as large as `p_coordinates`
+template<std::size_t B, class T, std::size_t S>
+void dequantize_positions_batch(
+    std::span<const vector<quantized_code<B>, S>> p_coordinates,
+    const aabb<T, S> & p_bounds,
+    std::span<vector<T, S>> p_results);
+
+};  // namespace math
+};  // namespace ft
+
+#include "vector_encoding.hpp"
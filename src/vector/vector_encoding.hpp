@@ -0,0 +1,324 @@
+#pragma once
+
+// Implements the encodings of vector_encoding.h
+
+// project headers
+#include "vector_encoding.h"
+#include "vector_functions.h"
+
+// other headers
+#include "error/ft_assert.h"
+
+// standard headers
+#include <cmath>
+#include <limits>
+
+namespace ft {
+namespace math {
+namespace details {
+namespace vector_encoding_ns {
+
+// Largest value of a `N` bit code
+template<std::size_t N>
+inline constexpr std::uint64_t max_code = (std::uint64_t{ 1 } << N) - 1;
+
+// Type computing `N` bit codes of T values without losing code bits
+template<class T, std::size_t N>
+using quantize_type = std::conditional_t<(N < std::numeric_limits<T>::digits), T, double>;
+
+
+// Quantize a value in [0, 1] to `N` bits, values outside are clamped
+template<std::size_t N, class U, class T>
+inline U quantize_unit(const T p_value)
+{
+    using R = quantize_type<T, N>;
+    constexpr auto scale = static_cast<R>(max_code<N>);
+
+    auto result = static_cast<R>(p_value) * scale + static_cast<R>(0.5);
+    result = (result > 0) ? result : static_cast<R>(0);
+    result = (result < scale) ? result : scale;
+    return static_cast<U>(result);
+}
+
+
+// Map a `N` bit code back to [0, 1]
+template<std::size_t N, class T, class U>
+inline T dequantize_unit(const U p_code)
+{
+    using R = quantize_type<T, N>;
+    constexpr auto inverse_scale = static_cast<R>(1) / static_cast<R>(max_code<N>);
+    return static_cast<T>(static_cast<R>(p_code) * inverse_scale);
+}
+
+
+// Encode a unit vector in `B` bits, `B / 2` per axis of the folded octahedron
+template<std::size_t B, class T>
+inline quantized_code<B> encode_octahedral(const T p_x, const T p_y, const T p_z)
+{
+    static_assert(B == 16 || B == 24 || B == 32, "octahedral codes are 16, 24 or 32 bits");
+    constexpr auto N = B / 2;
+
+    // Project on the octahedron
+    const auto inverse_l1 = static_cast<T>(1) / (std::abs(p_x) + std::abs(p_y) + std::abs(p_z));
+    const auto x = p_x * inverse_l1;
+    const auto y = p_y * inverse_l1;
+
+    // Fold the lower half over the upper half
+    const auto lower = p_z < 0;
+    const auto folded_x = (1 - std::abs(y)) * std::copysign(static_cast<T>(1), x);
+    const auto folded_y = (1 - std::abs(x)) * std::copysign(static_cast<T>(1), y);
+    const auto u = lower ? folded_x : x;
+    const auto v = lower ? folded_y : y;
+
+    using U = quantized_code<B>;
+    const auto half = static_cast<T>(0.5);
+    return static_cast<U>(
+        (quantize_unit<N, U>(u * half + half) << N) |
+        quantize_unit<N, U>(v * half + half));
+}
+
+
+// Decode a unit vector encoded in `B` bits
+template<std::size_t B, class T>
+inline void decode_octahedral(const quantized_code<B> p_code, T & p_x, T & p_y, T & p_z)
+{
+    static_assert(B == 16 || B == 24 || B == 32, "octahedral codes are 16, 24 or 32 bits");
+    constexpr auto N = B / 2;
+
+    const auto u = dequantize_unit<N, T>(p_code >> N) * 2 - 1;
+    const auto v = dequantize_unit<N, T>(p_code & max_code<N>) * 2 - 1;
+
+    // Unfold the lower half
+    const auto z = 1 - std::abs(u) - std::abs(v);
+    const auto t = (z < 0) ? -z : static_cast<T>(0);
+    const auto x = u - std::copysign(t, u);
+    const auto y = v - std::copysign(t, v);
+
+    const auto inverse_length = static_cast<T>(1) / std::sqrt(x * x + y * y + z * z);
+    p_x = x * inverse_length;
+    p_y = y * inverse_length;
+    p_z = z * inverse_length;
+}
+
+
+// Per axis mapping of positions to [0, 1] in a box
+template<class T, std::size_t S>
+struct position_range
+{
+    vector<T, S> min;
+    vector<T, S> extent;
+    vector<T, S> inverse_extent;
+};
+
+
+// Get the mapping of positions in a non empty box
+template<class T, std::size_t S>
+position_range<T, S> make_position_range(const aabb<T, S> & p_bounds)
+{
+    FT_ASSERT(!p_bounds.is_empty());
+
+    position_range<T, S> result;
+    result.min = p_bounds.get_min();
+    result.extent = p_bounds.get_extent();
+    for (std::size_t a = 0; a < S; ++a) {
+        result.inverse_extent[a] = (result.extent[a] > 0) ? static_cast<T>(1) / result.extent[a] : static_cast<T>(0);
+    }
+    return result;
+}
+
+
+// Quantize a position with `B` bits per axis
+template<std::size_t B, class T, std::size_t S>
+vector<quantized_code<B>, S> quantize_position(const vector<T, S> & p_position, const position_range<T, S> & p_range)
+{
+    static_assert(B > 0 && B <= 32, "positions are quantized with 1 to 32 bits per axis");
+
+    vector<quantized_code<B>, S> result;
+    for (std::size_t a = 0; a < S; ++a) {
+        result[a] = quantize_unit<B, quantized_code<B>>((p_position[a] - p_range.min[a]) * p_range.inverse_extent[a]);
+    }
+    return result;
+}
+
+
+// Get the position of quantized coordinates
+template<std::size_t B, class T, std::size_t S>
+vector<T, S> dequantize_position(const vector<quantized_code<B>, S> & p_coordinates, const position_range<T, S> & p_range)
+{
+    static_assert(B > 0 && B <= 32, "positions are quantized with 1 to 32 bits per axis");
+
+    vector<T, S> result;
+    for (std::size_t a = 0; a < S; ++a) {
+        result[a] = p_range.min[a] + dequantize_unit<B, T>(p_coordinates[a]) * p_range.extent[a];
+    }
+    return result;
+}
+
+};  // namespace vector_encoding_ns
+};  // namespace details
+};  // namespace math
+};  // namespace ft
+
+
+// Encode a unit vector in `B` bits
+template<std::size_t B, class T>
+ft::math::quantized_code<B> ft::math::encode_octahedral(const vector<T, 3> & p_vector)
+{
+    return details::vector_encoding_ns::encode_octahedral<B>(p_vector[0], p_vector[1], p_vector[2]);
+}
+
+
+// Decode a unit vector encoded in `B` bits
+template<std::size_t B, class T>
+ft::math::vector<T, 3> ft::math::decode_octahedral(const quantized_code<B> p_code)
+{
+    vector<T, 3> result;
+    details::vector_encoding_ns::decode_octahedral<B>(p_code, result[0], result[1], result[2]);
+    return result;
+}
+
+
+// Write a `B` bit code to the first `packed_code_size<B>` bytes of `p_bytes`
+template<std::size_t B>
+void ft::math::store_packed_code(const quantized_code<B> p_code, std::byte * p_bytes)
+{
+    static_assert(B % 8 == 0, "packed codes are whole bytes");
+
+    for (std::size_t b = 0; b < packed_code_size<B>; ++b) {
+        p_bytes[b] = static_cast<std::byte>(p_code >> (8 * b));
+    }
+}
+
+
+// Read a `B` bit code from the first `packed_code_size<B>` bytes of `p_bytes`
+template<std::size_t B>
+ft::math::quantized_code<B> ft::math::load_packed_code(const std::byte * p_bytes)
+{
+    static_assert(B % 8 == 0, "packed codes are whole bytes");
+
+    using U = quantized_code<B>;
+    auto result = U{ 0 };
+    for (std::size_t b = 0; b < packed_code_size<B>; ++b) {
+        result |= static_cast<U>(static_cast<U>(p_bytes[b]) << (8 * b));
+    }
+    return result;
+}
+
+
+// Encode an array of unit vectors in `B` bits each
+template<std::size_t B, class T>
+void ft::math::encode_octahedral_batch(
+    const vector_soa_span<const T, 3> & p_vectors,
+    std::span<quantized_code<B>> p_codes)
+{
+    FT_ASSERT(p_codes.size() >= p_vectors.size());
+
+    const auto x = p_vectors.component(0);
+    const auto y = p_vectors.component(1);
+    const auto z = p_vectors.component(2);
+    for (std::size_t i = 0; i < p_vectors.size(); ++i) {
+        p_codes[i] = details::vector_encoding_ns::encode_octahedral<B>(x[i], y[i], z[i]);
+    }
+}
+
+
+// Decode an array of unit vectors encoded in `B` bits each
+template<std::size_t B, class T>
+void ft::math::decode_octahedral_batch(
+    std::span<const quantized_code<B>> p_codes,
+    const vector_soa_span<T, 3> & p_results)
+{
+    FT_ASSERT(p_results.size() >= p_codes.size());
+
+    const auto x = p_results.component(0);
+    const auto y = p_results.component(1);
+    const auto z = p_results.component(2);
+    for (std::size_t i = 0; i < p_codes.size(); ++i) {
+        details::vector_encoding_ns::decode_octahedral<B>(p_codes[i], x[i], y[i], z[i]);
+    }
+}
+
+
+// Quantize a position in `p_bounds` with `B` bits per axis
+template<std::size_t B, class T, std::size_t S>
+ft::math::vector<ft::math::quantized_code<B>, S> ft::math::quantize_position(const vector<T, S> & p_position, const aabb<T, S> & p_bounds)
+{
+    return details::vector_encoding_ns::quantize_position<B>(p_position, details::vector_encoding_ns::make_position_range(p_bounds));
+}
+
+
+// Get the position of quantized coordinates in `p_bounds`
+template<std::size_t B, class T, std::size_t S>
+ft::math::vector<T, S> ft::math::dequantize_position(const vector<quantized_code<B>, S> & p_coordinates, const aabb<T, S> & p_bounds)
+{
+    return details::vector_encoding_ns::dequantize_position<B>(p_coordinates, details::vector_encoding_ns::make_position_range(p_bounds));
+}
+
+
+// Quantize an array of positions in `p_bounds` with `B` bits per axis
+template<std::size_t B, class T, std::size_t S>
+void ft::math::quantize_positions_batch(
+    std::span<const vector<T, S>> p_positions,
+    const aabb<T, S> & p_bounds,
+    std::span<vector<quantized_code<B>, S>> p_results)
+{
+    FT_ASSERT(p_results.size() >= p_positions.size());
+
+    const auto range = details::vector_encoding_ns::make_position_range(p_bounds);
+    for (std::size_t i = 0; i < p_positions.size(); ++i) {
+        p_results[i] = details::vector_encoding_ns::quantize_position<B>(p_positions[i], range);
+    }
+}
+
+
+// Get the positions of an array of quantized coordinates in `p_bounds`
+template<std::size_t B, class T, std::size_t S>
+void ft::math::dequantize_positions_batch(
+    std::span<const vector<quantized_code<B>, S>> p_coordinates,
+    const aabb<T, S> & p_bounds,
+    std::span<vector<T, S>> p_results)
+{
+    FT_ASSERT(p_results.size() >= p_coordinates.size());
+
+    const auto range = details::vector_encoding_ns::make_position_range(p_bounds);
+    for (std::size_t i = 0; i < p_coordinates.size(); ++i) {
+        p_results[i] = details::vector_encoding_ns::dequantize_position<B>(p_coordinates[i], range);
+    }
+}
+
+
+// Encode an array of unit vectors to a stream of packed `B` bit codes
+template<std::size_t B, class T>
+void ft::math::encode_octahedral_batch(
+    const vector_soa_span<const T, 3> & p_vectors,
+    std::span<std::byte> p_bytes)
+{
+    FT_ASSERT(p_bytes.size() >= p_vectors.size() * packed_code_size<B>);
+
+    const auto x = p_vectors.component(0);
+    const auto y = p_vectors.component(1);
+    const auto z = p_vectors.component(2);
+    for (std::size_t i = 0; i < p_vectors.size(); ++i) {
+        store_packed_code<B>(details::vector_encoding_ns::encode_octahedral<B>(x[i], y[i], z[i]), p_bytes.data() + i * packed_code_size<B>);
+    }
+}
+
+
+// Decode a stream of packed `B` bit codes to an array of unit vectors
+template<std::size_t B, class T>
+void ft::math::decode_octahedral_batch(
+    std::span<const std::byte> p_bytes,
+    const vector_soa_span<T, 3> & p_results)
+{
+    FT_ASSERT(p_bytes.size() % packed_code_size<B> == 0);
+
+    const auto count = p_bytes.size() / packed_code_size<B>;
+    FT_ASSERT(p_results.size() >= count);
+
+    const auto x = p_results.component(0);
+    const auto y = p_results.component(1);
+    const auto z = p_results.component(2);
+    for (std::size_t i = 0; i < count; ++i) {
+        details::vector_encoding_ns::decode_octahedral<B>(load_packed_code<B>(p_bytes.data() + i * packed_code_size<B>), x[i], y[i], z[i]);
+    }
+}
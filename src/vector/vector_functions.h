@@ -5,6 +5,9 @@
 
 #include "vector.hpp"
 
+// standard headers
+#include <span>
+
 namespace ft {
 namespace math {
 
@@ -37,6 +40,11 @@ constexpr T length2(const vector<T, S> & p_ref);
 template<class T, std::size_t S>
 T length(const vector<T, S> & p_ref);
 
+// Get the squared distance between two points
+// Same as `length2(p_left - p_right)` without the temporary vector
+template<class T, std::size_t S>
+constexpr T distance2(const vector<T, S> & p_left, const vector<T, S> & p_right);
+
 // Normalize a vector
 template<class T, std::size_t S>
 void normalize(vector<T, S> & p_vector);
@@ -58,6 +66,16 @@ constexpr T vector_dot(const vector<T, S> & p_left, const vector<T, S> & p_right
 template<std::size_t S, class T>
 constexpr T vector_angle(const vector<T, S> & p_left, const vector<T, S> & p_right);
 
+// Get the angles between pairs of vectors in radians
+// Float and double use `approx_acos` so the loop can be vectorized, other
+//  types call `vector_angle`
+// `p_right` and `p_results` must be at least as large as `p_left`
+template<std::size_t S, class T>
+void vector_angle_batch(
+    std::span<const vector<T, S>> p_left,
+    std::span<const vector<T, S>> p_right,
+    std::span<T> p_results);
+
 };  // namespace math
 };  // namesapce ft
 
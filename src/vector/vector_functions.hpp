@@ -3,8 +3,15 @@
 // Automatically included by vector.hpp
 // Defines free functions associated with vectors
 
+// project headers
+#include "numeric/elementary_functions.h"
+
+// other headers
+#include "error/ft_assert.h"
+
 // standard headers
 #include <cmath>
+#include <type_traits>
 
 namespace ft {
 namespace math {
@@ -100,7 +107,22 @@ constexpr T ft::math::length2(const vector<T, S>& p_ref)
 template<class T, std::size_t S>
 T ft::math::length(const vector<T, S>& p_ref)
 {
-    return std::sqrt(length2(p_ref));
+    // Unqualified so the overloads for other element types are found
+    using std::sqrt;
+    return sqrt(length2(p_ref));
+}
+
+
+// Get the squared distance between two points
+template<class T, std::size_t S>
+constexpr T ft::math::distance2(const vector<T, S>& p_left, const vector<T, S>& p_right)
+{
+    auto result = T{};
+    for (std::size_t i = 0; i < S; ++i) {
+        const auto delta = p_left[i] - p_right[i];
+        result += delta * delta;
+    }
+    return result;
 }
 
 
@@ -144,7 +166,7 @@ constexpr T ft::math::vector_dot(const vector<T, S>& p_left, const vector<T, S>&
     T result = 0;
     for (std::size_t i = 0; i < S; ++i)
     {
-        result = p_left[i] * p_right[i];
+        result += p_left[i] * p_right[i];
     }
     return result;
 }
@@ -155,5 +177,54 @@ constexpr T ft::math::vector_angle(const vector<T, S>& p_left, const vector<T, S
 {
     const auto dot = vector_dot(p_left, p_right);
     const auto length_product = length(p_left) * length(p_right);
-    return std::acos(dot / length_product);
+
+    // Rounding can push the cosine of nearly parallel vectors out of [-1, 1]
+    auto cosine = dot / length_product;
+    cosine = (cosine > 1) ? static_cast<T>(1) : cosine;
+    cosine = (cosine < -1) ? static_cast<T>(-1) : cosine;
+
+    using std::acos;
+    return acos(cosine);
+}
+
+
+// Get the angles between pairs of vectors in radians
+template<std::size_t S, class T>
+void ft::math::vector_angle_batch(
+    std::span<const vector<T, S>> p_left,
+    std::span<const vector<T, S>> p_right,
+    std::span<T> p_results)
+{
+    FT_ASSERT(p_right.size() >= p_left.size());
+    FT_ASSERT(p_results.size() >= p_left.size());
+
+    // Float and double use the branch free arc cosine so the loop is vectorized
+    if constexpr (std::is_same_v<T, float> || std::is_same_v<T, double>)
+    {
+        for (std::size_t i = 0; i < p_left.size(); ++i)
+        {
+            const auto & left = p_left[i];
+            const auto & right = p_right[i];
+            auto dot = static_cast<T>(0);
+            auto left2 = static_cast<T>(0);
+            auto right2 = static_cast<T>(0);
+            for (std::size_t a = 0; a < S; ++a)
+            {
+                dot += left[a] * right[a];
+                left2 += left[a] * left[a];
+                right2 += right[a] * right[a];
+            }
+
+            auto cosine = dot / static_cast<T>(std::sqrt(left2) * std::sqrt(right2));
+            cosine = (cosine > 1) ? static_cast<T>(1) : cosine;
+            cosine = (cosine < -1) ? static_cast<T>(-1) : cosine;
+            p_results[i] = approx_acos(cosine);
+        }
+    }
+    else
+    {
+        for (std::size_t i = 0; i < p_left.size(); ++i) {
+            p_results[i] = vector_angle(p_left[i], p_right[i]);
+        }
+    }
 }
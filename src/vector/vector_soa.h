@@ -0,0 +1,112 @@
+#pragma once
+
+// Non owning views of arrays of vectors and matrices stored as
+//  structures of arrays (one contiguous array per component)
+// Batched kernels read and write these so that consecutive elements
+//  of a component are adjacent in memory and loops can be vectorized
+// Use a `const T` element type for read-only views
+
+// project headers
+#include "matrix/matrix.h"
+#include "vector.h"
+
+// standard headers
+#include <array>
+#include <cstddef>  // std::size_t
+#include <type_traits>
+
+namespace ft {
+namespace math {
+
+template<class T, std::size_t S>
+class vector_soa_span
+{
+public:
+    using value_type = std::remove_const_t<T>;
+    static constexpr auto elements = S;
+
+public:
+    // Default constructor
+    // Makes an empty view
+    constexpr vector_soa_span() = default;
+
+    // View `p_size` vectors whose components are stored in `p_components`
+    constexpr vector_soa_span(const std::array<T *, S> & p_components, const std::size_t p_size);
+
+    // Allow conversion of a mutable view to a read-only view
+    template<class U, class = std::enable_if_t<std::is_same_v<const U, T> && !std::is_same_v<U, T>>>
+    constexpr vector_soa_span(const vector_soa_span<U, S> & p_other);
+
+
+    // Get the number of vectors
+    constexpr std::size_t size() const;
+
+    // Get the array holding component `p_component` of every vector
+    constexpr T * component(const std::size_t p_component) const;
+
+
+    // Read vector `p_index`
+    constexpr vector<value_type, S> get(const std::size_t p_index) const;
+
+    // Write vector `p_index`
+    // Only available for mutable views
+    constexpr void set(const std::size_t p_index, const vector<value_type, S> & p_value) const;
+
+    // Get a view of `p_count` vectors starting at `p_offset`
+    constexpr vector_soa_span subspan(const std::size_t p_offset, const std::size_t p_count) const;
+
+private:
+    // One array per component
+    std::array<T *, S> m_components = {};
+
+    // Number of vectors
+    std::size_t m_size = 0;
+
+};  // class vector_soa_span
+
+
+// View of an array of matrices stored as one array per element
+// Element [row][col] is component row * C + col
+template<class T, std::size_t R, std::size_t C>
+class matrix_soa_span : public vector_soa_span<T, R * C>
+{
+public:
+    using base_type = vector_soa_span<T, R * C>;
+    using typename base_type::value_type;
+    using base_type::base_type;
+    using base_type::component;
+
+    // Make a matrix view over the same arrays as a vector view
+    constexpr matrix_soa_span(const base_type & p_view);
+
+
+    // Get the array holding element [p_row][p_col] of every matrix
+    constexpr T * component(const std::size_t p_row, const std::size_t p_col) const;
+
+    // Read matrix `p_index`
+    constexpr matrix<value_type, R, C> get(const std::size_t p_index) const;
+
+    // Write matrix `p_index`
+    // Only available for mutable views
+    constexpr void set(const std::size_t p_index, const matrix<value_type, R, C> & p_value) const;
+
+    // Get a view of `p_count` matrices starting at `p_offset`
+    constexpr matrix_soa_span subspan(const std::size_t p_offset, const std::size_t p_count) const;
+
+};  // class matrix_soa_span
+
+
+// Map every element of a structure of arrays to an element of another
+// `In` and `Out` are the `vector` or `matrix` types taken and returned by
+//  `p_kernel`, with `I` and `O` components
+// Elements are copied in fixed size blocks to local buffers, which can't
+//  alias, so the compiler vectorizes an inlined kernel across elements even
+//  with its cheapest cost model
+// `p_output` must be at least as large as `p_input` and may alias it
+template<class In, class Out, class T, std::size_t I, std::size_t O, class K>
+void map_soa(const vector_soa_span<const T, I> & p_input, const vector_soa_span<T, O> & p_output, K && p_kernel);
+
+};  // namespace math
+};  // namespace ft
+
+#include "vector_soa.hpp"
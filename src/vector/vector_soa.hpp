@@ -0,0 +1,186 @@
+#pragma once
+
+// Implements the views of vector_soa.h
+
+// project headers
+#include "vector_soa.h"
+#include "matrix/matrix_unroll.h"
+
+// other headers
+#include "error/ft_assert.h"
+
+// standard headers
+#include <algorithm>
+
+namespace ft {
+namespace math {
+namespace details {
+namespace vector_soa_ns {
+
+// Elements mapped per block by `map_soa`
+inline constexpr std::size_t map_block_size = 64;
+
+};  // namespace vector_soa_ns
+};  // namespace details
+
+// View `p_size` vectors whose components are stored in `p_components`
+template<class T, std::size_t S>
+constexpr vector_soa_span<T, S>::vector_soa_span(const std::array<T *, S> & p_components, const std::size_t p_size) :
+    m_components(p_components),
+    m_size(p_size)
+{ }
+
+
+// Allow conversion of a mutable view to a read-only view
+template<class T, std::size_t S>
+template<class U, class>
+constexpr vector_soa_span<T, S>::vector_soa_span(const vector_soa_span<U, S> & p_other) :
+    m_size(p_other.size())
+{
+    for (std::size_t i = 0; i < S; ++i) {
+        m_components[i] = p_other.component(i);
+    }
+}
+
+
+// Get the number of vectors
+template<class T, std::size_t S>
+constexpr std::size_t vector_soa_span<T, S>::size() const
+{
+    return m_size;
+}
+
+
+// Get the array holding component `p_component` of every vector
+template<class T, std::size_t S>
+constexpr T * vector_soa_span<T, S>::component(const std::size_t p_component) const
+{
+    FT_ASSERT(p_component < S);
+    return m_components[p_component];
+}
+
+
+// Read vector `p_index`
+template<class T, std::size_t S>
+constexpr vector<typename vector_soa_span<T, S>::value_type, S>
+vector_soa_span<T, S>::get(const std::size_t p_index) const
+{
+    FT_ASSERT(p_index < m_size);
+    vector<value_type, S> result;
+    for (std::size_t i = 0; i < S; ++i) {
+        result[i] = m_components[i][p_index];
+    }
+    return result;
+}
+
+
+// Write vector `p_index`
+template<class T, std::size_t S>
+constexpr void vector_soa_span<T, S>::set(const std::size_t p_index, const vector<value_type, S> & p_value) const
+{
+    static_assert(std::is_const_v<T> == false, "Can't write to a read-only view");
+    FT_ASSERT(p_index < m_size);
+    for (std::size_t i = 0; i < S; ++i) {
+        m_components[i][p_index] = p_value[i];
+    }
+}
+
+
+// Get a view of `p_count` vectors starting at `p_offset`
+template<class T, std::size_t S>
+constexpr vector_soa_span<T, S> vector_soa_span<T, S>::subspan(const std::size_t p_offset, const std::size_t p_count) const
+{
+    FT_ASSERT(p_offset + p_count <= m_size);
+    auto components = m_components;
+    for (auto & component : components) {
+        component += p_offset;
+    }
+    return { components, p_count };
+}
+
+
+// Make a matrix view over the same arrays as a vector view
+template<class T, std::size_t R, std::size_t C>
+constexpr matrix_soa_span<T, R, C>::matrix_soa_span(const base_type & p_view) :
+    base_type(p_view)
+{ }
+
+
+// Get the array holding element [p_row][p_col] of every matrix
+template<class T, std::size_t R, std::size_t C>
+constexpr T * matrix_soa_span<T, R, C>::component(const std::size_t p_row, const std::size_t p_col) const
+{
+    FT_ASSERT(p_row < R);
+    FT_ASSERT(p_col < C);
+    return base_type::component(p_row * C + p_col);
+}
+
+
+// Read matrix `p_index`
+template<class T, std::size_t R, std::size_t C>
+constexpr matrix<typename matrix_soa_span<T, R, C>::value_type, R, C>
+matrix_soa_span<T, R, C>::get(const std::size_t p_index) const
+{
+    return matrix<value_type, R, C>(base_type::get(p_index));
+}
+
+
+// Write matrix `p_index`
+template<class T, std::size_t R, std::size_t C>
+constexpr void matrix_soa_span<T, R, C>::set(const std::size_t p_index, const matrix<value_type, R, C> & p_value) const
+{
+    base_type::set(p_index, vector<value_type, R * C>(p_value.data()));
+}
+
+
+// Get a view of `p_count` matrices starting at `p_offset`
+template<class T, std::size_t R, std::size_t C>
+constexpr matrix_soa_span<T, R, C> matrix_soa_span<T, R, C>::subspan(const std::size_t p_offset, const std::size_t p_count) const
+{
+    return { base_type::subspan(p_offset, p_count) };
+}
+
+};  // namespace math
+};  // namespace ft
+
+
+// Map every element of a structure of arrays to an element of another
+// The end of the last block holds elements of the previous block, or zeros,
+//  their results are dropped
+template<class In, class Out, class T, std::size_t I, std::size_t O, class K>
+void ft::math::map_soa(const vector_soa_span<const T, I> & p_input, const vector_soa_span<T, O> & p_output, K && p_kernel)
+{
+    using details::vector_soa_ns::map_block_size;
+
+    FT_ASSERT(p_output.size() >= p_input.size());
+
+    constexpr auto input_count = std::integral_constant<std::size_t, I>{};
+    constexpr auto output_count = std::integral_constant<std::size_t, O>{};
+
+    T input_block[I][map_block_size] = {};
+    T output_block[O][map_block_size];
+    for (std::size_t begin = 0; begin < p_input.size(); begin += map_block_size)
+    {
+        const auto count = std::min(map_block_size, p_input.size() - begin);
+        for (std::size_t e = 0; e < I; ++e) {
+            std::copy_n(p_input.component(e) + begin, count, input_block[e]);
+        }
+
+        for (std::size_t i = 0; i < map_block_size; ++i)
+        {
+            In element;
+            for_range(zero_index, input_count, [&](auto e) {
+                element.data()[e] = input_block[e][i];
+            });
+
+            const Out mapped = p_kernel(element);
+            for_range(zero_index, output_count, [&](auto e) {
+                output_block[e][i] = mapped.data()[e];
+            });
+        }
+
+        for (std::size_t e = 0; e < O; ++e) {
+            std::copy_n(output_block[e], count, p_output.component(e) + begin);
+        }
+    }
+}